@@ -48,6 +48,7 @@
 #define CMD_VALUE_REGISTER          "register"
 #define CMD_VALUE_LIST              "list"
 #define CMD_VALUE_UUID              "uuid"
+#define CMD_VALUE_TRACE             "trace"     // 导出LVGL渲染追踪数据
 
 
 typedef struct {
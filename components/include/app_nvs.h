@@ -10,7 +10,7 @@
 /*--------------------------------------------------------------*/
 
 
-// 通用函数，根据数据对象进行NVS存储操作
+// 通用函数，根据数据对象进行NVS存储操作（每次调用都会提交，频繁修改的设置请使用app_settings.h）
 esp_err_t nvs_store_data(const char *namespace, const char *key, 
                         void *data, size_t size);
 // 通用函数，根据数据对象进行NVS读取操作
@@ -0,0 +1,127 @@
+#ifndef APP_SETTINGS_H
+#define APP_SETTINGS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+
+#define SETTINGS_NAMESPACE          "settings"  // 默认NVS命名空间
+#define SETTINGS_MAX_KEYS           16          // RAM缓存最多键数量
+#define SETTINGS_KEY_LEN            16          // 键名长度（含结束符，与NVS_KEY_NAME_MAX_SIZE一致）
+#define SETTINGS_VALUE_MAX          64          // 单个值最大字节数
+#ifndef SETTINGS_COMMIT_DELAY_MS
+#define SETTINGS_COMMIT_DELAY_MS    2000        // 最后一次修改后延时提交时间，可在编译选项中覆盖
+#endif
+
+
+/* ----------------type define----------------*/
+
+/* 缓存值类型，不同类型的同名键视为错误 */
+typedef enum {
+    SETTINGS_TYPE_U8,
+    SETTINGS_TYPE_I32,
+    SETTINGS_TYPE_U32,
+    SETTINGS_TYPE_BLOB,
+} settings_type_t;
+
+/* 一次提交中的单个键 */
+typedef struct {
+    const char *key;
+    const void *data;
+    size_t size;
+} settings_item_t;
+
+/**
+ * 存储后端。默认使用NVS，也可替换为RAM后端用于测量写入量和提交耗时。
+ * load: 读取键值，size为输入缓存大小/输出实际长度，键不存在返回ESP_ERR_NVS_NOT_FOUND
+ * commit: 在一个事务中写入全部键并提交
+ */
+typedef struct {
+    esp_err_t (*load)(void *ctx, const char *namespace, const char *key, void *data, size_t *size);
+    esp_err_t (*commit)(void *ctx, const char *namespace, const settings_item_t *items, size_t count);
+    void *ctx;
+} settings_backend_t;
+
+/* 统计信息，写放大 = key_writes / set_calls */
+typedef struct {
+    uint32_t set_calls;         // 调用set的次数
+    uint32_t set_skipped;       // 值未变化而忽略的次数
+    uint32_t key_writes;        // 实际写入后端的键数
+    uint32_t bytes_written;     // 实际写入后端的字节数
+    uint32_t commits;           // 提交事务次数
+    uint32_t commit_errors;     // 提交失败次数
+    uint32_t last_commit_us;    // 最近一次提交耗时
+    uint32_t max_commit_us;     // 最大提交耗时
+} settings_stats_t;
+
+
+/*--------------function declarations-----------*/
+
+/**
+ * @brief 初始化设置服务
+ *
+ * @param namespace NVS命名空间，NULL使用SETTINGS_NAMESPACE
+ * @param backend 存储后端，NULL使用NVS
+ * @return esp_err_t
+ */
+esp_err_t settings_init(const char *namespace, const settings_backend_t *backend);
+
+/**
+ * @brief 立即提交所有未保存的修改（同时在esp_restart时自动调用）
+ *
+ * @return esp_err_t
+ */
+esp_err_t settings_flush(void);
+
+/**
+ * @brief 丢弃RAM缓存中的所有键（未提交的修改会先提交）
+ *
+ * @return esp_err_t
+ */
+esp_err_t settings_deinit(void);
+
+/**
+ * @brief 读取键值，首次访问时从后端加载，之后直接读缓存
+ *
+ * @return ESP_ERR_NVS_NOT_FOUND 键不存在; ESP_ERR_INVALID_ARG 类型不匹配
+ */
+esp_err_t settings_get_u8(const char *key, uint8_t *value);
+esp_err_t settings_get_i32(const char *key, int32_t *value);
+esp_err_t settings_get_u32(const char *key, uint32_t *value);
+
+/**
+ * @brief 读取blob
+ *
+ * @param size 输入缓存大小，输出实际长度
+ */
+esp_err_t settings_get_blob(const char *key, void *data, size_t *size);
+
+/**
+ * @brief 写入键值，只修改RAM缓存并延时SETTINGS_COMMIT_DELAY_MS批量提交，值未变化时不会写入
+ *
+ * @return esp_err_t
+ */
+esp_err_t settings_set_u8(const char *key, uint8_t value);
+esp_err_t settings_set_i32(const char *key, int32_t value);
+esp_err_t settings_set_u32(const char *key, uint32_t value);
+esp_err_t settings_set_blob(const char *key, const void *data, size_t size);
+
+/**
+ * @brief 获取统计信息
+ *
+ * @param stats
+ * @param reset true：读取后清零
+ */
+void settings_get_stats(settings_stats_t *stats, bool reset);
+
+/**
+ * @brief 获取RAM后端（键值保存在堆上，掉电丢失），用于测试写放大和提交耗时
+ *
+ * @return const settings_backend_t*
+ */
+const settings_backend_t *settings_ram_backend(void);
+
+
+#endif
@@ -1,12 +1,17 @@
 #ifndef HTTP_OTA_H
 #define HTTP_OTA_H
 
+#include <stdint.h>
+
 /**
  * 
- * require components: esp_https_ota app_update
+ * require components: esp_http_client app_update
  * 
  * enabled option esp_http_client in config
  * 
+ * 请求时携带上次的ETag(If-None-Match)，服务器返回304时不下载固件。
+ * 固件可以是原始镜像，也可以是压缩/差分包，格式见ota_stream.h
+ * 
  */
 
 
@@ -22,10 +27,22 @@ typedef enum {
 } ota_service_mode_t;
 
 
+typedef struct {
+    uint32_t received;          // 已下载字节数
+    int32_t total;              // 下载总字节数，-1为未知
+    uint32_t written;           // 已写入分区的固件字节数
+    uint32_t image_size;        // 固件大小，0为未知（原始镜像）
+    uint32_t speed;             // 平均下载速度(Byte/s)
+} ota_progress_t;
+
+/* 进度回调，在OTA任务中调用，操作LVGL需要加锁 */
+typedef void (*ota_progress_callback_t)(const ota_progress_t *progress);
+
 typedef struct {
     char url[256];              // HTTP固件URL
     ota_service_mode_t mode;    // 服务工作模式
     int interval;               // 自动模式下OTA更新间隔(ms)
+    ota_progress_callback_t progress_cb;    // 下载进度回调，可为NULL
 } ota_service_config_t;
 
 
@@ -38,6 +55,13 @@ typedef struct {
  */
 ota_result_t http_ota_wait_result();
 
+/**
+ * @brief 获取当前（或最近一次）OTA的进度，可在UI定时器中查询
+ * 
+ * @param info 
+ */
+void http_ota_get_progress(ota_progress_t *info);
+
 /**
  * @brief 配置OTA服务，确定URL
  * 
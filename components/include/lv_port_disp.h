@@ -17,6 +17,8 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lvgl.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +31,10 @@ extern "C" {
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
+/* Take this mutex around any lvgl call made outside the gui task
+ */
+extern SemaphoreHandle_t xGuiSemaphore;
+
 /* Initialize low level display driver */
 void lv_port_disp_init(void);
 
@@ -0,0 +1,95 @@
+#ifndef OTA_STREAM_H
+#define OTA_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+/**
+ * 流式OTA数据解码，不依赖HTTP和OTA分区，可在主机上单独验证
+ *
+ * 支持的格式（由数据首字节区分）：
+ *  - 0xE9开头：原始固件镜像，直接输出
+ *  - OTA_PKG_MAGIC开头：ota_pkg_header_t + 负载
+ *      flags & OTA_PKG_FLAG_ZLIB  : 负载为zlib压缩流
+ *      flags & OTA_PKG_FLAG_DELTA : (解压后)负载为差分指令，基于当前运行的固件生成新固件
+ *
+ * 差分指令（小端）：
+ *  - OTA_DELTA_OP_COPY   u32 offset, u32 len : 从当前固件offset处复制len字节
+ *  - OTA_DELTA_OP_INSERT u32 len, data[len]  : 插入len字节
+ *
+ * 打包和本地测试服务器见 tools/ota_pack.py
+ */
+
+#define OTA_PKG_MAGIC           0x41544F48      // "HOTA"
+#define OTA_PKG_VERSION         1
+#define OTA_PKG_FLAG_ZLIB       (1 << 0)
+#define OTA_PKG_FLAG_DELTA      (1 << 1)
+
+#define OTA_DELTA_OP_COPY       0x01
+#define OTA_DELTA_OP_INSERT     0x02
+
+
+/* ----------------type define----------------*/
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t flags;
+    uint16_t reserved;
+    uint32_t image_size;            // 解码后的固件大小
+    uint8_t source_sha256[32];      // 差分基准固件（当前运行固件）的SHA256
+} ota_pkg_header_t;
+
+/* 格式确定后传给sink->begin */
+typedef struct {
+    uint8_t flags;                  // OTA_PKG_FLAG_xxx，原始镜像为0
+    uint32_t image_size;            // 原始镜像为0（未知）
+    const uint8_t *source_sha256;   // 仅差分格式有效
+} ota_stream_info_t;
+
+/* 解码输出 */
+typedef struct {
+    esp_err_t (*begin)(void *ctx, const ota_stream_info_t *info);
+    esp_err_t (*write)(void *ctx, const uint8_t *data, size_t len);
+    esp_err_t (*read_source)(void *ctx, uint32_t offset, uint8_t *data, size_t len);   // 差分格式需要
+    void *ctx;
+} ota_stream_sink_t;
+
+typedef struct ota_stream ota_stream_t;
+
+
+/*--------------function declarations-----------*/
+
+/**
+ * @brief 创建解码器（压缩格式会额外申请约43KB内存）
+ *
+ * @param sink 输出
+ * @return ota_stream_t* NULL：内存不足
+ */
+ota_stream_t *ota_stream_create(const ota_stream_sink_t *sink);
+
+/**
+ * @brief 输入一段下载的数据
+ *
+ * @return esp_err_t sink返回的错误或ESP_ERR_INVALID_RESPONSE（数据格式错误）
+ */
+esp_err_t ota_stream_feed(ota_stream_t *stream, const uint8_t *data, size_t len);
+
+/**
+ * @brief 数据全部输入后调用，检查数据是否完整
+ *
+ * @return esp_err_t
+ */
+esp_err_t ota_stream_finish(ota_stream_t *stream);
+
+/**
+ * @brief 获取已输出的固件字节数
+ */
+uint32_t ota_stream_get_written(const ota_stream_t *stream);
+
+void ota_stream_delete(ota_stream_t *stream);
+
+
+#endif
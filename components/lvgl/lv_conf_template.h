@@ -34,6 +34,11 @@
  *Can be also used if the UI is above another layer, e.g. an OSD menu or video player.*/
 #define LV_COLOR_SCREEN_TRANSP 0
 
+/*Let display drivers set `rgb888_out` to render directly into packed 3 bytes/pixel (R, G, B) draw buffers.
+ *With LV_COLOR_DEPTH 16 the channels are in the top bits of the bytes, as 18 bit (RGB666) displays expect.
+ *The draw buffers need 3 bytes per pixel. Requires LV_COLOR_DEPTH 16 or 32.*/
+#define LV_COLOR_RGB888_OUT 0
+
 /* Adjust color mix functions rounding. GPUs might calculate color mix (blending) differently.
  * 0: round down, 64: round up from x.75, 128: round up from half, 192: round up from x.25, 254: round up */
 #define LV_COLOR_MIX_ROUND_OFS 0
@@ -73,6 +78,14 @@
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
+/*1: Keep the memory of the deleted objects in free lists per size to create new objects in it.
+ *Call `lv_obj_pool_flush()` to free them.*/
+#define LV_USE_OBJ_POOL 0
+#if LV_USE_OBJ_POOL
+    /*At most this many bytes are kept in the free lists*/
+    #define LV_OBJ_POOL_MAX_SIZE (16 * 1024)
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -83,6 +96,14 @@
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD 30     /*[ms]*/
 
+/*1: Allow a grid index of the clickable objects per screen for fast pointer hit-testing.
+ *Enable it on a screen with `lv_indev_index_enable(scr, true)`*/
+#define LV_USE_INDEV_INDEX 0
+#if LV_USE_INDEV_INDEX
+    /*Width and height of a grid cell in pixels*/
+    #define LV_INDEV_INDEX_CELL_SIZE 32
+#endif
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #define LV_TICK_CUSTOM 0
@@ -113,14 +134,23 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching a shadow has (shadow size)^2 RAM cost*/
     #define LV_SHADOW_CACHE_SIZE 0
 
+    /*Max. total size of the cached shadows in bytes. The least recently used ones are freed first.*/
+    #define LV_SHADOW_CACHE_BUF_MAX_SIZE (16 * 1024)
+
     /* Set number of maximally cached circle data.
     * The circumference of 1/4 circle are saved for anti-aliasing
-    * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+    * radius * 6 bytes are used per circle (the most often used radiuses are saved)
     * 0: to disable caching */
     #define LV_CIRCLE_CACHE_SIZE 4
+
+    /*Max. total size of the cached circles in bytes*/
+    #define LV_CIRCLE_CACHE_BUF_MAX_SIZE (4 * 1024)
+
+    /*Comma separated list of radii (e.g. "8,12") whose circle is calculated in `lv_init` and never freed*/
+    #define LV_CIRCLE_CACHE_PRESET_RADII ""
 #endif /*LV_DRAW_COMPLEX*/
 
 /**
@@ -172,6 +202,31 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Draw the objects of an invalid area only once into a command list and replay the list for each part
+ *of the draw buffer instead of walking the objects again for every part.
+ *Areas with layers (transformed or semi-transparent widgets) are drawn directly as before.*/
+#define LV_USE_DRAW_REC 0
+#if LV_USE_DRAW_REC
+    /*Maximum size of the command list in bytes. Areas needing more are drawn directly.*/
+    #define LV_DRAW_REC_BUF_MAX_SIZE (32 * 1024)
+#endif
+
+/*Skip the objects (or the parts of them) which are covered by opaque objects drawn later in the same area.
+ *Overdraw statistics are added to the trace as counters.*/
+#define LV_USE_OCCLUSION_CULL 0
+#if LV_USE_OCCLUSION_CULL
+    /*Maximum number of skipped or clipped objects per area. The others are drawn normally.*/
+    #define LV_OCCLUSION_CULL_MAX_OBJ 32
+#endif
+
+/*Allow keeping a bitmap of an object and its children and drawing it while they don't change.
+ *Enable it on an object with `lv_obj_add_flag(obj, LV_OBJ_FLAG_CACHED)`. Requires LV_USE_SNAPSHOT.*/
+#define LV_USE_OBJ_CACHE 0
+#if LV_USE_OBJ_CACHE
+    /*Total size of the bitmaps in bytes. The least recently used bitmaps are dropped to fit.*/
+    #define LV_OBJ_CACHE_MAX_SIZE (256 * 1024)
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -286,6 +341,16 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*1: Record the spans of the refresh (layout, areas, widgets, draw primitives, flushing) to export them
+ *as Chrome trace-event JSON with `lv_trace_export()`. Recording is started with `lv_trace_start()`*/
+#define LV_USE_TRACE 0
+#if LV_USE_TRACE
+    #define LV_TRACE_BUF_SIZE 1024      /*Number of events kept in the ring buffer (16 bytes each on 32 bit targets)*/
+
+    /*1: Show the layout/render/flush/wait time of the last frame as a bar over the screen*/
+    #define LV_USE_TRACE_BAR 0
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #define LV_SPRINTF_CUSTOM 0
 #if LV_SPRINTF_CUSTOM
@@ -483,6 +548,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LINE_CACHE 1     /*Cache the lines of long texts to wrap only the edited lines again and to find the lines to draw or hit test directly*/
 #endif
 
 #define LV_USE_LINE       1
@@ -696,6 +762,13 @@
 
 /*1: Enable a published subscriber based messaging system */
 #define LV_USE_MSG 0
+#if LV_USE_MSG
+    /*1: `lv_msg_post` can be called from other threads too (uses FreeRTOS on ESP-IDF, pthread elsewhere)*/
+    #define LV_MSG_THREAD_SAFE 0
+
+    /*Deliver the posted messages with this period [ms]*/
+    #define LV_MSG_POST_PERIOD LV_DISP_DEF_REFR_PERIOD
+#endif
 
 /*1: Enable Pinyin input method*/
 /*Requires: lv_keyboard*/
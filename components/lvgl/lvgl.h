@@ -35,7 +35,11 @@ extern "C" {
 #include "src/core/lv_obj.h"
 #include "src/core/lv_group.h"
 #include "src/core/lv_indev.h"
+#include "src/core/lv_indev_index.h"
+#include "src/core/lv_obj_cache.h"
+#include "src/core/lv_obj_pool.h"
 #include "src/core/lv_refr.h"
+#include "src/core/lv_trace.h"
 #include "src/core/lv_disp.h"
 #include "src/core/lv_theme.h"
 
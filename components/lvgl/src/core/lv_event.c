@@ -165,10 +165,10 @@ struct _lv_event_dsc_t * lv_obj_add_event_cb(lv_obj_t * obj, lv_event_cb_t event
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_obj_allocate_spec_attr(obj);
 
-    obj->spec_attr->event_dsc_cnt++;
-    obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
-                                               obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
+    obj->spec_attr->event_dsc = _lv_mem_realloc_array(obj->spec_attr->event_dsc, obj->spec_attr->event_dsc_cnt,
+                                                       obj->spec_attr->event_dsc_cnt + 1, sizeof(lv_event_dsc_t));
     LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
+    obj->spec_attr->event_dsc_cnt++;
 
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].cb = event_cb;
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].filter = filter;
@@ -189,10 +189,9 @@ bool lv_obj_remove_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb)
             for(; i < (obj->spec_attr->event_dsc_cnt - 1); i++) {
                 obj->spec_attr->event_dsc[i] = obj->spec_attr->event_dsc[i + 1];
             }
+            obj->spec_attr->event_dsc = _lv_mem_realloc_array(obj->spec_attr->event_dsc, obj->spec_attr->event_dsc_cnt,
+                                                               obj->spec_attr->event_dsc_cnt - 1, sizeof(lv_event_dsc_t));
             obj->spec_attr->event_dsc_cnt--;
-            obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
-                                                       obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
-            LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
             return true;
         }
     }
@@ -214,10 +213,9 @@ bool lv_obj_remove_event_cb_with_user_data(lv_obj_t * obj, lv_event_cb_t event_c
             for(; i < (obj->spec_attr->event_dsc_cnt - 1); i++) {
                 obj->spec_attr->event_dsc[i] = obj->spec_attr->event_dsc[i + 1];
             }
+            obj->spec_attr->event_dsc = _lv_mem_realloc_array(obj->spec_attr->event_dsc, obj->spec_attr->event_dsc_cnt,
+                                                               obj->spec_attr->event_dsc_cnt - 1, sizeof(lv_event_dsc_t));
             obj->spec_attr->event_dsc_cnt--;
-            obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
-                                                       obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
-            LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
             return true;
         }
     }
@@ -239,10 +237,9 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, struct _lv_event_dsc_t * event_dsc)
             for(; i < (obj->spec_attr->event_dsc_cnt - 1); i++) {
                 obj->spec_attr->event_dsc[i] = obj->spec_attr->event_dsc[i + 1];
             }
+            obj->spec_attr->event_dsc = _lv_mem_realloc_array(obj->spec_attr->event_dsc, obj->spec_attr->event_dsc_cnt,
+                                                               obj->spec_attr->event_dsc_cnt - 1, sizeof(lv_event_dsc_t));
             obj->spec_attr->event_dsc_cnt--;
-            obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
-                                                       obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
-            LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
             return true;
         }
     }
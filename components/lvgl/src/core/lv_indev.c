@@ -10,6 +10,7 @@
 #include "lv_disp.h"
 #include "lv_obj.h"
 #include "lv_indev_scroll.h"
+#include "lv_indev_index.h"
 #include "lv_group.h"
 #include "lv_refr.h"
 
@@ -304,6 +305,13 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
     /*If this obj is hidden the children are hidden too so return immediately*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return NULL;
 
+#if LV_USE_INDEV_INDEX
+    /*Let the screen's index answer if it has one*/
+    if(obj->parent == NULL && lv_indev_index_is_enabled(obj)) {
+        if(_lv_indev_index_search(obj, point, &found_p) == LV_RES_OK) return found_p;
+    }
+#endif
+
     lv_point_t p_trans = *point;
     lv_obj_transform_point(obj, &p_trans, false, true);
 
@@ -0,0 +1,502 @@
+/**
+ * @file lv_indev_index.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_indev_index.h"
+#include "lv_disp.h"
+
+#if LV_USE_INDEV_INDEX
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CELL_SIZE           LV_INDEV_INDEX_CELL_SIZE
+#define ENTRY_SIZE_INIT     64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_obj_t * obj;         /*NULL: free slot*/
+    lv_area_t area;         /*The click area, clipped to the display, the object is listed with in the cells*/
+    uint8_t in_grid : 1;    /*The object is listed in the cells of `area`*/
+    uint8_t transformed : 1;
+} lv_indev_index_entry_t;
+
+typedef struct {
+    lv_obj_t ** objs;       /*In no particular order, the lookup sorts out which one is on top*/
+    uint32_t cnt;
+    uint32_t size;
+} lv_indev_index_cell_t;
+
+/**
+ * Uniform grid over the display. Every cell lists the clickable objects whose click area overlaps the cell.
+ * The entries remember where an object is listed, so a moved or changed object updates only its own cells.
+ */
+typedef struct _lv_indev_index_t {
+    lv_indev_index_entry_t * entries;   /*Hash table by object with linear probing*/
+    uint32_t entry_cnt;
+    uint32_t entry_size;                /*Number of slots, a power of 2*/
+    lv_indev_index_cell_t * cells;      /*`col_cnt * row_cnt` cells row by row*/
+    uint32_t transform_cnt;             /*Number of transformed objects, the index can't be used while it's not 0*/
+    lv_coord_t hor_res;                 /*Display resolution the grid was built for*/
+    lv_coord_t ver_res;
+    uint16_t col_cnt;
+    uint16_t row_cnt;
+    uint8_t dirty : 1;                  /*Rebuild everything on the next search*/
+} lv_indev_index_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_indev_index_t * get_index(const lv_obj_t * obj);
+static bool index_build(lv_obj_t * scr, lv_indev_index_t * index);
+static void index_clear(lv_indev_index_t * index);
+static bool tree_add(lv_indev_index_t * index, lv_obj_t * obj);
+static void entry_update(lv_indev_index_t * index, lv_obj_t * obj);
+static void entry_remove(lv_indev_index_t * index, uint32_t slot);
+static uint32_t slot_find(const lv_indev_index_t * index, const lv_obj_t * obj);
+static uint32_t slot_home(const lv_indev_index_t * index, const lv_obj_t * obj);
+static bool slots_grow(lv_indev_index_t * index);
+static bool cells_add(lv_indev_index_t * index, const lv_area_t * area, lv_obj_t * obj);
+static void cells_remove(lv_indev_index_t * index, const lv_area_t * area, const lv_obj_t * obj);
+static bool is_reachable(const lv_obj_t * obj, const lv_point_t * point);
+static bool is_on_top(const lv_obj_t * obj1, const lv_obj_t * obj2);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t index_cnt;  /*Number of screens with index. Lets the object updates return early.*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_indev_index_enable(lv_obj_t * scr, bool en)
+{
+    LV_ASSERT_NULL(scr);
+    if(scr->parent != NULL) {
+        LV_LOG_WARN("the hit-test index can be enabled only on screens");
+        return;
+    }
+
+    if(en == lv_indev_index_is_enabled(scr)) return;
+
+    if(!en) {
+        _lv_indev_index_free(scr);
+        return;
+    }
+
+    lv_obj_allocate_spec_attr(scr);
+    lv_indev_index_t * index = lv_mem_alloc(sizeof(lv_indev_index_t));
+    LV_ASSERT_MALLOC(index);
+    if(index == NULL) return;
+    lv_memset_00(index, sizeof(lv_indev_index_t));
+    index->dirty = 1;
+
+    scr->spec_attr->indev_index = index;
+    index_cnt++;
+}
+
+bool lv_indev_index_is_enabled(const lv_obj_t * scr)
+{
+    return scr->spec_attr && scr->spec_attr->indev_index;
+}
+
+lv_res_t _lv_indev_index_search(lv_obj_t * scr, const lv_point_t * point, lv_obj_t ** found)
+{
+    *found = NULL;
+    lv_indev_index_t * index = scr->spec_attr->indev_index;
+
+    lv_disp_t * disp = lv_obj_get_disp(scr);
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp);
+    lv_coord_t ver_res = lv_disp_get_ver_res(disp);
+    if(index->dirty || index->hor_res != hor_res || index->ver_res != ver_res) {
+        index->hor_res = hor_res;
+        index->ver_res = ver_res;
+        if(!index_build(scr, index)) return LV_RES_INV;
+    }
+
+    /*The search transforms the point for transformed objects, a grid in display coordinates can't follow that*/
+    if(index->transform_cnt) return LV_RES_INV;
+    if(point->x < 0 || point->y < 0 || point->x >= index->hor_res || point->y >= index->ver_res) return LV_RES_INV;
+
+    lv_indev_index_cell_t * cell = &index->cells[(point->y / CELL_SIZE) * index->col_cnt + point->x / CELL_SIZE];
+
+    /*The topmost object is the last one in tree order which is reachable and whose hit-test passes*/
+    uint32_t i;
+    for(i = 0; i < cell->cnt; i++) {
+        lv_obj_t * obj = cell->objs[i];
+        lv_indev_index_entry_t * e = &index->entries[slot_find(index, obj)];
+        if(!_lv_area_is_point_on(&e->area, point, 0)) continue;
+        if(*found && !is_on_top(obj, *found)) continue;
+        if(!is_reachable(obj, point)) continue;
+        if(lv_obj_hit_test(obj, point)) *found = obj;
+    }
+
+    return LV_RES_OK;
+}
+
+void _lv_indev_index_update(lv_obj_t * obj)
+{
+    if(index_cnt == 0) return;
+
+    lv_indev_index_t * index = get_index(obj);
+    if(index == NULL || index->dirty) return;
+
+    entry_update(index, obj);
+}
+
+void _lv_indev_index_remove(lv_obj_t * obj)
+{
+    if(index_cnt == 0) return;
+
+    lv_indev_index_t * index = get_index(obj);
+    if(index == NULL || index->dirty) return;
+
+    uint32_t slot = slot_find(index, obj);
+    if(index->entries[slot].obj) entry_remove(index, slot);
+}
+
+void _lv_indev_index_invalidate(const lv_obj_t * obj)
+{
+    if(index_cnt == 0) return;
+
+    lv_indev_index_t * index = get_index(obj);
+    if(index) index->dirty = 1;
+}
+
+void _lv_indev_index_free(lv_obj_t * scr)
+{
+    if(!lv_indev_index_is_enabled(scr)) return;
+
+    lv_indev_index_t * index = scr->spec_attr->indev_index;
+    index_clear(index);
+    lv_mem_free(index);
+    scr->spec_attr->indev_index = NULL;
+    index_cnt--;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_indev_index_t * get_index(const lv_obj_t * obj)
+{
+    while(obj->parent) obj = obj->parent;
+    return obj->spec_attr ? obj->spec_attr->indev_index : NULL;
+}
+
+/**
+ * Build the index from scratch. Used when it's enabled, on resolution change and when objects moved to another screen.
+ * @param scr       the screen
+ * @param index     its index
+ * @return          false if there was not enough memory
+ */
+static bool index_build(lv_obj_t * scr, lv_indev_index_t * index)
+{
+    index_clear(index);
+
+    index->col_cnt = (index->hor_res + CELL_SIZE - 1) / CELL_SIZE;
+    index->row_cnt = (index->ver_res + CELL_SIZE - 1) / CELL_SIZE;
+    uint32_t cells_size = (uint32_t)index->col_cnt * index->row_cnt * sizeof(lv_indev_index_cell_t);
+    index->cells = lv_mem_alloc(cells_size);
+    LV_ASSERT_MALLOC(index->cells);
+    if(index->cells == NULL) return false;
+    lv_memset_00(index->cells, cells_size);
+
+    index->entries = lv_mem_alloc(ENTRY_SIZE_INIT * sizeof(lv_indev_index_entry_t));
+    LV_ASSERT_MALLOC(index->entries);
+    if(index->entries == NULL) {
+        index_clear(index);
+        return false;
+    }
+    lv_memset_00(index->entries, ENTRY_SIZE_INIT * sizeof(lv_indev_index_entry_t));
+    index->entry_size = ENTRY_SIZE_INIT;
+
+    index->dirty = 0;
+    if(!tree_add(index, scr)) {
+        index_clear(index);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Free the cells and the entries and mark the index to be rebuilt
+ * @param index     the index
+ */
+static void index_clear(lv_indev_index_t * index)
+{
+    if(index->cells) {
+        uint32_t i;
+        uint32_t cell_cnt = (uint32_t)index->col_cnt * index->row_cnt;
+        for(i = 0; i < cell_cnt; i++) {
+            if(index->cells[i].objs) lv_mem_free(index->cells[i].objs);
+        }
+        lv_mem_free(index->cells);
+    }
+    if(index->entries) lv_mem_free(index->entries);
+
+    index->cells = NULL;
+    index->entries = NULL;
+    index->entry_cnt = 0;
+    index->entry_size = 0;
+    index->transform_cnt = 0;
+    index->dirty = 1;
+}
+
+static bool tree_add(lv_indev_index_t * index, lv_obj_t * obj)
+{
+    entry_update(index, obj);
+    if(index->dirty) return false;  /*Out of memory*/
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        if(!tree_add(index, obj->spec_attr->children[i])) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Bring the entry of an object in line with its current click area, flags and layer type.
+ * Only the cells of the old and new click area are touched. If there is not enough memory the index is marked dirty.
+ * @param index     the index of the object's screen
+ * @param obj       the object
+ */
+static void entry_update(lv_indev_index_t * index, lv_obj_t * obj)
+{
+    lv_area_t area;
+    bool in_grid = false;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CLICKABLE)) {
+        lv_area_t disp_area;
+        lv_area_set(&disp_area, 0, 0, index->hor_res - 1, index->ver_res - 1);
+        lv_obj_get_click_area(obj, &area);
+        in_grid = _lv_area_intersect(&area, &area, &disp_area);
+    }
+    bool transformed = _lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM;
+
+    uint32_t slot = slot_find(index, obj);
+    lv_indev_index_entry_t * e = &index->entries[slot];
+    if(e->obj == NULL) {
+        if(!in_grid && !transformed) return;
+
+        /*Keep at least half of the slots free so that the probe sequences stay short*/
+        if((index->entry_cnt + 1) * 2 > index->entry_size) {
+            if(!slots_grow(index)) {
+                index->dirty = 1;
+                return;
+            }
+            slot = slot_find(index, obj);
+            e = &index->entries[slot];
+        }
+        e->obj = obj;
+        e->in_grid = 0;
+        e->transformed = 0;
+        index->entry_cnt++;
+    }
+
+    bool area_changed = !e->in_grid || !in_grid || !_lv_area_is_equal(&e->area, &area);
+    if(e->in_grid && area_changed) {
+        cells_remove(index, &e->area, obj);
+        e->in_grid = 0;
+    }
+    if(in_grid && area_changed) {
+        if(!cells_add(index, &area, obj)) {
+            index->dirty = 1;
+            return;
+        }
+        e->area = area;
+        e->in_grid = 1;
+    }
+
+    if(e->transformed != transformed) {
+        if(transformed) index->transform_cnt++;
+        else index->transform_cnt--;
+        e->transformed = transformed;
+    }
+
+    if(!in_grid && !transformed) entry_remove(index, slot);
+}
+
+static void entry_remove(lv_indev_index_t * index, uint32_t slot)
+{
+    lv_indev_index_entry_t * e = &index->entries[slot];
+    if(e->in_grid) cells_remove(index, &e->area, e->obj);
+    if(e->transformed) index->transform_cnt--;
+    index->entry_cnt--;
+
+    /*Move back the later entries of the probe sequence which would be unreachable after the gap*/
+    uint32_t mask = index->entry_size - 1;
+    uint32_t gap = slot;
+    uint32_t i = slot;
+    while(1) {
+        i = (i + 1) & mask;
+        lv_obj_t * obj = index->entries[i].obj;
+        if(obj == NULL) break;
+
+        uint32_t home = slot_home(index, obj);
+        bool movable = gap <= i ? (home <= gap || home > i) : (home <= gap && home > i);
+        if(movable) {
+            index->entries[gap] = index->entries[i];
+            gap = i;
+        }
+    }
+    index->entries[gap].obj = NULL;
+}
+
+/**
+ * Find the slot of an object or the free slot where it should be added
+ * @param index     the index
+ * @param obj       the object
+ * @return          index of the slot in `index->entries`
+ */
+static uint32_t slot_find(const lv_indev_index_t * index, const lv_obj_t * obj)
+{
+    uint32_t mask = index->entry_size - 1;
+    uint32_t i = slot_home(index, obj);
+    while(index->entries[i].obj && index->entries[i].obj != obj) i = (i + 1) & mask;
+    return i;
+}
+
+/**
+ * The first slot of an object's probe sequence
+ * @param index     the index
+ * @param obj       the object
+ * @return          index of the slot in `index->entries`
+ */
+static uint32_t slot_home(const lv_indev_index_t * index, const lv_obj_t * obj)
+{
+    /*Fibonacci hashing of the pointer without its always 0 low bits*/
+    return (uint32_t)(((lv_uintptr_t)obj >> 3) * 2654435761u) & (index->entry_size - 1);
+}
+
+static bool slots_grow(lv_indev_index_t * index)
+{
+    uint32_t new_size = index->entry_size * 2;
+    lv_indev_index_entry_t * new_entries = lv_mem_alloc(new_size * sizeof(lv_indev_index_entry_t));
+    LV_ASSERT_MALLOC(new_entries);
+    if(new_entries == NULL) return false;
+    lv_memset_00(new_entries, new_size * sizeof(lv_indev_index_entry_t));
+
+    lv_indev_index_entry_t * old_entries = index->entries;
+    uint32_t old_size = index->entry_size;
+    index->entries = new_entries;
+    index->entry_size = new_size;
+
+    uint32_t i;
+    for(i = 0; i < old_size; i++) {
+        if(old_entries[i].obj) index->entries[slot_find(index, old_entries[i].obj)] = old_entries[i];
+    }
+
+    lv_mem_free(old_entries);
+    return true;
+}
+
+static bool cells_add(lv_indev_index_t * index, const lv_area_t * area, lv_obj_t * obj)
+{
+    int32_t row;
+    for(row = area->y1 / CELL_SIZE; row <= area->y2 / CELL_SIZE; row++) {
+        int32_t col;
+        for(col = area->x1 / CELL_SIZE; col <= area->x2 / CELL_SIZE; col++) {
+            lv_indev_index_cell_t * cell = &index->cells[row * index->col_cnt + col];
+            if(cell->cnt == cell->size) {
+                uint32_t new_size = cell->size ? cell->size * 2 : 8;
+                lv_obj_t ** new_objs = lv_mem_realloc(cell->objs, new_size * sizeof(lv_obj_t *));
+                LV_ASSERT_MALLOC(new_objs);
+                if(new_objs == NULL) return false;
+                cell->objs = new_objs;
+                cell->size = new_size;
+            }
+            cell->objs[cell->cnt] = obj;
+            cell->cnt++;
+        }
+    }
+
+    return true;
+}
+
+static void cells_remove(lv_indev_index_t * index, const lv_area_t * area, const lv_obj_t * obj)
+{
+    int32_t row;
+    for(row = area->y1 / CELL_SIZE; row <= area->y2 / CELL_SIZE; row++) {
+        int32_t col;
+        for(col = area->x1 / CELL_SIZE; col <= area->x2 / CELL_SIZE; col++) {
+            lv_indev_index_cell_t * cell = &index->cells[row * index->col_cnt + col];
+            uint32_t i;
+            for(i = 0; i < cell->cnt; i++) {
+                if(cell->objs[i] == obj) {
+                    cell->cnt--;
+                    cell->objs[i] = cell->objs[cell->cnt];
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Tell whether `lv_indev_search_obj` would get to an object while searching for a point:
+ * it skips hidden subtrees and descends only into the ancestors which contain the point or have overflow visible.
+ * @param obj       the object
+ * @param point     the point
+ * @return          true: the search would check the object
+ */
+static bool is_reachable(const lv_obj_t * obj, const lv_point_t * point)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
+
+    const lv_obj_t * parent = obj->parent;
+    while(parent) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_HIDDEN)) return false;
+        if(!lv_obj_has_flag(parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE) &&
+           !_lv_area_is_point_on(&parent->coords, point, 0)) return false;
+        parent = parent->parent;
+    }
+
+    return true;
+}
+
+/**
+ * Tell whether an object comes later in tree (pre-order) order than an other, i.e. the search finds it first
+ * @param obj1      an object
+ * @param obj2      an other object on the same screen
+ * @return          true: `obj1` is on top of `obj2`
+ */
+static bool is_on_top(const lv_obj_t * obj1, const lv_obj_t * obj2)
+{
+    uint32_t depth1 = 0;
+    uint32_t depth2 = 0;
+    const lv_obj_t * p;
+    for(p = obj1->parent; p; p = p->parent) depth1++;
+    for(p = obj2->parent; p; p = p->parent) depth2++;
+
+    /*Go up to the same depth. If one is the ancestor of the other the descendant is on top.*/
+    const lv_obj_t * a1 = obj1;
+    const lv_obj_t * a2 = obj2;
+    uint32_t d;
+    for(d = depth1; d > depth2; d--) a1 = a1->parent;
+    for(d = depth2; d > depth1; d--) a2 = a2->parent;
+    if(a1 == a2) return depth1 > depth2;
+
+    /*Else the later sibling of the common parent is on top*/
+    while(a1->parent != a2->parent) {
+        a1 = a1->parent;
+        a2 = a2->parent;
+    }
+
+    return lv_obj_get_index(a1) > lv_obj_get_index(a2);
+}
+
+#endif /*LV_USE_INDEV_INDEX*/
@@ -0,0 +1,100 @@
+/**
+ * @file lv_indev_index.h
+ *
+ */
+
+#ifndef LV_INDEV_INDEX_H
+#define LV_INDEV_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+
+#if LV_USE_INDEV_INDEX
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Enable or disable the hit-test index of a screen. When enabled, `lv_indev_search_obj` queries a grid
+ * of clickable objects instead of walking the whole object tree. When an object is moved, resized or
+ * made (non-)clickable only its own cells are updated.
+ * @param scr       pointer to a screen (an object without parent, including the top and system layers)
+ * @param en        true: enable, false: disable and free the index
+ */
+void lv_indev_index_enable(lv_obj_t * scr, bool en);
+
+/**
+ * Tell whether a screen has a hit-test index
+ * @param scr       pointer to a screen
+ * @return          true: the index is enabled
+ */
+bool lv_indev_index_is_enabled(const lv_obj_t * scr);
+
+/**
+ * Find the topmost clickable object under a point using the screen's index.
+ * Gives the same result as walking the tree with `lv_indev_search_obj`.
+ * @param scr       pointer to a screen with enabled index
+ * @param point     the point to check, in display coordinates
+ * @param found     the found object or NULL
+ * @return          LV_RES_OK: the index answered the query; LV_RES_INV: the index can't be used, walk the tree
+ */
+lv_res_t _lv_indev_index_search(lv_obj_t * scr, const lv_point_t * point, lv_obj_t ** found);
+
+/**
+ * Update the cells of an object in the index of its screen. Called by LVGL when an object's
+ * click area, `LV_OBJ_FLAG_CLICKABLE` flag or layer type changes.
+ * @param obj       pointer to an object
+ */
+void _lv_indev_index_update(lv_obj_t * obj);
+
+/**
+ * Remove an object from the index of its screen. Called by LVGL when the object is deleted.
+ * @param obj       pointer to an object
+ */
+void _lv_indev_index_remove(lv_obj_t * obj);
+
+/**
+ * Rebuild the index of an object's screen on the next search. Called by LVGL when objects are
+ * moved to another screen.
+ * @param obj       pointer to an object
+ */
+void _lv_indev_index_invalidate(const lv_obj_t * obj);
+
+/**
+ * Free the index of a screen. Called by LVGL when the screen is deleted.
+ * @param scr       pointer to a screen
+ */
+void _lv_indev_index_free(lv_obj_t * scr);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#else /*LV_USE_INDEV_INDEX*/
+
+#define _lv_indev_index_update(obj) LV_UNUSED(obj)
+#define _lv_indev_index_remove(obj) LV_UNUSED(obj)
+#define _lv_indev_index_invalidate(obj) LV_UNUSED(obj)
+
+#endif /*LV_USE_INDEV_INDEX*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_INDEV_INDEX_H*/
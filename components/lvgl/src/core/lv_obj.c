@@ -8,6 +8,9 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "lv_indev_index.h"
+#include "lv_obj_cache.h"
+#include "lv_obj_pool.h"
 #include "lv_refr.h"
 #include "lv_group.h"
 #include "lv_disp.h"
@@ -187,9 +190,14 @@ void lv_init(void)
 
 void lv_deinit(void)
 {
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_cleanup();
+#endif
+
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
+    lv_obj_pool_flush();
     lv_mem_deinit();
     lv_initialized = false;
 
@@ -226,6 +234,11 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
     if(f & LV_OBJ_FLAG_HIDDEN) lv_obj_invalidate(obj);
 
     obj->flags |= f;
+    if(f & LV_OBJ_FLAG_CLICKABLE) _lv_indev_index_update(obj);
+
+#if LV_USE_OBJ_CACHE
+    if(f & LV_OBJ_FLAG_CACHED) _lv_obj_cache_set(obj, true);
+#endif
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
@@ -257,6 +270,11 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
     }
 
     obj->flags &= (~f);
+    if(f & LV_OBJ_FLAG_CLICKABLE) _lv_indev_index_update(obj);
+
+#if LV_USE_OBJ_CACHE
+    if(f & LV_OBJ_FLAG_CACHED) _lv_obj_cache_set(obj, false);
+#endif
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
@@ -343,7 +361,7 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
     if(obj->spec_attr == NULL) {
         static uint32_t x = 0;
         x++;
-        obj->spec_attr = lv_mem_alloc(sizeof(_lv_obj_spec_attr_t));
+        obj->spec_attr = _lv_obj_pool_alloc(sizeof(_lv_obj_spec_attr_t));
         LV_ASSERT_MALLOC(obj->spec_attr);
         if(obj->spec_attr == NULL) return;
 
@@ -446,6 +464,10 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
 
+#if LV_USE_OBJ_CACHE
+    if(obj->flags & LV_OBJ_FLAG_CACHED) _lv_obj_cache_set(obj, false);
+#endif
+
     if(obj->spec_attr) {
         if(obj->spec_attr->children) {
             lv_mem_free(obj->spec_attr->children);
@@ -455,8 +477,11 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             lv_mem_free(obj->spec_attr->event_dsc);
             obj->spec_attr->event_dsc = NULL;
         }
+#if LV_USE_INDEV_INDEX
+        _lv_indev_index_free(obj);
+#endif
 
-        lv_mem_free(obj->spec_attr);
+        _lv_obj_pool_free(obj->spec_attr, sizeof(_lv_obj_spec_attr_t));
         obj->spec_attr = NULL;
     }
 }
@@ -914,7 +939,10 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
 
     lv_mem_buf_release(ts);
 
-    if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_REDRAW) {
+    if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_SCROLLBAR) {
+        lv_obj_scrollbar_invalidate(obj);
+    }
+    else if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_REDRAW) {
         lv_obj_invalidate(obj);
     }
     else if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_LAYOUT) {
@@ -0,0 +1,233 @@
+/**
+ * @file lv_obj_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_cache.h"
+
+#if LV_USE_OBJ_CACHE
+
+#include "lv_disp.h"
+#include "../draw/lv_img_cache.h"
+#include "../extra/others/snapshot/lv_snapshot.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CACHE_CF    LV_IMG_CF_TRUE_COLOR_ALPHA
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_obj_t * obj;
+    lv_img_dsc_t img;           /*The bitmap of the object, `img.data` is NULL if not rendered*/
+    uint32_t buf_size;
+    uint32_t last_used;         /*Tick of the last refresh which needed the bitmap*/
+    uint8_t dirty : 1;          /*The object or its children changed since the bitmap was rendered*/
+} lv_obj_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_obj_cache_entry_t * entry_find(const lv_obj_t * obj);
+static bool entry_is_valid(const lv_obj_cache_entry_t * e);
+static void entry_render(lv_obj_cache_entry_t * e);
+static void entry_free_buf(lv_obj_cache_entry_t * e);
+static bool make_room(uint32_t size, const lv_obj_cache_entry_t * keep);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_obj_cache_entry_t * entries;
+static uint32_t entry_cnt;
+static lv_obj_cache_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_cache_get_stats(lv_obj_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+    stats_out->entry_cnt = entry_cnt;
+}
+
+void _lv_obj_cache_set(lv_obj_t * obj, bool en)
+{
+    lv_obj_cache_entry_t * e = entry_find(obj);
+    if(en) {
+        if(e) return;
+
+        lv_obj_cache_entry_t * new_entries = lv_mem_realloc(entries, (entry_cnt + 1) * sizeof(lv_obj_cache_entry_t));
+        LV_ASSERT_MALLOC(new_entries);
+        if(new_entries == NULL) return;
+        entries = new_entries;
+
+        e = &entries[entry_cnt];
+        entry_cnt++;
+        lv_memset_00(e, sizeof(lv_obj_cache_entry_t));
+        e->obj = obj;
+        e->dirty = 1;
+    }
+    else {
+        if(e == NULL) return;
+
+        entry_free_buf(e);
+        *e = entries[entry_cnt - 1];
+        entry_cnt--;
+        if(entry_cnt == 0) {
+            lv_mem_free(entries);
+            entries = NULL;
+        }
+    }
+}
+
+void _lv_obj_cache_invalidate(const lv_obj_t * obj)
+{
+    if(entry_cnt == 0) return;
+
+    while(obj) {
+        if(obj->flags & LV_OBJ_FLAG_CACHED) {
+            lv_obj_cache_entry_t * e = entry_find(obj);
+            if(e) e->dirty = 1;
+        }
+        obj = obj->parent;
+    }
+}
+
+void _lv_obj_cache_update(lv_disp_t * disp, const lv_area_t * area)
+{
+    uint32_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        lv_obj_cache_entry_t * e = &entries[i];
+
+        /*Only the objects on the visible screens*/
+        lv_obj_t * scr = lv_obj_get_screen(e->obj);
+        if(scr != disp->act_scr && scr != disp->prev_scr && scr != disp->top_layer && scr != disp->sys_layer) continue;
+
+        lv_area_t coords;
+        lv_obj_get_coords(e->obj, &coords);
+        lv_coord_t ext_size = _lv_obj_get_ext_draw_size(e->obj);
+        lv_area_increase(&coords, ext_size, ext_size);
+        if(!_lv_area_is_on(&coords, area)) continue;
+
+        e->last_used = lv_tick_get();
+        if(entry_is_valid(e)) stats.hit_cnt++;
+        else entry_render(e);
+    }
+}
+
+const lv_img_dsc_t * _lv_obj_cache_get(const lv_obj_t * obj)
+{
+    const lv_obj_cache_entry_t * e = entry_find(obj);
+    if(e == NULL || !entry_is_valid(e)) return NULL;
+
+    return &e->img;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_obj_cache_entry_t * entry_find(const lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(entries[i].obj == obj) return &entries[i];
+    }
+    return NULL;
+}
+
+/**
+ * Tell whether the bitmap of an entry can be drawn instead of the object
+ */
+static bool entry_is_valid(const lv_obj_cache_entry_t * e)
+{
+    if(e->dirty || e->img.data == NULL) return false;
+
+    /*The position doesn't matter but the size does*/
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(e->obj);
+    return e->img.header.w == lv_obj_get_width(e->obj) + 2 * ext_size &&
+           e->img.header.h == lv_obj_get_height(e->obj) + 2 * ext_size;
+}
+
+static void entry_render(lv_obj_cache_entry_t * e)
+{
+    uint32_t size = lv_snapshot_buf_size_needed(e->obj, CACHE_CF);
+    if(size == 0 || size > LV_OBJ_CACHE_MAX_SIZE) {
+        /*Too large: draw it normally*/
+        entry_free_buf(e);
+        return;
+    }
+
+    /*The image decoder might have cached the old header*/
+    lv_img_cache_invalidate_src(&e->img);
+
+    if(size != e->buf_size) {
+        entry_free_buf(e);
+        if(!make_room(size, e)) return;
+
+        void * buf = lv_mem_alloc(size);
+        if(buf == NULL) {
+            LV_LOG_WARN("couldn't allocate %"LV_PRIu32" bytes for the bitmap of an object", size);
+            return;
+        }
+        e->img.data = buf;
+        e->buf_size = size;
+        stats.size += size;
+    }
+
+    lv_res_t res = lv_snapshot_take_to_buf(e->obj, CACHE_CF, &e->img, (void *)e->img.data, e->buf_size);
+    if(res != LV_RES_OK) {
+        entry_free_buf(e);
+        return;
+    }
+
+    e->dirty = 0;
+    stats.render_cnt++;
+}
+
+static void entry_free_buf(lv_obj_cache_entry_t * e)
+{
+    if(e->img.data == NULL) return;
+
+    lv_img_cache_invalidate_src(&e->img);
+    lv_mem_free((void *)e->img.data);
+    stats.size -= e->buf_size;
+    e->img.data = NULL;
+    e->buf_size = 0;
+}
+
+/**
+ * Free the least recently used bitmaps until `size` more bytes fit into the budget
+ * @param size      the size of the new bitmap
+ * @param keep      don't free the bitmap of this entry
+ * @return          true: there is enough room
+ */
+static bool make_room(uint32_t size, const lv_obj_cache_entry_t * keep)
+{
+    while(stats.size + size > LV_OBJ_CACHE_MAX_SIZE) {
+        lv_obj_cache_entry_t * lru = NULL;
+        uint32_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            lv_obj_cache_entry_t * e = &entries[i];
+            if(e == keep || e->img.data == NULL) continue;
+            if(lru == NULL || lv_tick_elaps(e->last_used) > lv_tick_elaps(lru->last_used)) lru = e;
+        }
+
+        if(lru == NULL) return false;
+        entry_free_buf(lru);
+    }
+
+    return true;
+}
+
+#endif /*LV_USE_OBJ_CACHE*/
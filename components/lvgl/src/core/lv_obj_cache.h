@@ -0,0 +1,93 @@
+/**
+ * @file lv_obj_cache.h
+ *
+ */
+
+#ifndef LV_OBJ_CACHE_H
+#define LV_OBJ_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+
+#if LV_USE_OBJ_CACHE
+
+#if LV_USE_SNAPSHOT == 0
+#error "LV_USE_OBJ_CACHE requires LV_USE_SNAPSHOT"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hit_cnt;       /*Number of refreshed areas where a bitmap could be drawn as it was*/
+    uint32_t render_cnt;    /*Number of times a bitmap was (re)rendered*/
+    uint32_t size;          /*Total size of the bitmaps in bytes*/
+    uint32_t entry_cnt;     /*Number of objects with LV_OBJ_FLAG_CACHED*/
+} lv_obj_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the statistics of the object bitmap cache
+ * @param stats     the result is written here
+ */
+void lv_obj_cache_get_stats(lv_obj_cache_stats_t * stats);
+
+/**
+ * Start or stop caching an object. Called by LVGL when `LV_OBJ_FLAG_CACHED` is added or cleared
+ * and when the object is deleted.
+ * @param obj       pointer to an object
+ * @param en        true: keep a bitmap of the object; false: free the bitmap
+ */
+void _lv_obj_cache_set(lv_obj_t * obj, bool en);
+
+/**
+ * Mark the bitmaps of an object's cached ancestors (and its own) as outdated.
+ * Called by LVGL when an object is invalidated.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_cache_invalidate(const lv_obj_t * obj);
+
+/**
+ * Render the outdated bitmaps of the objects on an area. Called by `lv_refr.c` before the area is drawn.
+ * @param disp      the display being refreshed
+ * @param area      the area to be refreshed
+ */
+void _lv_obj_cache_update(lv_disp_t * disp, const lv_area_t * area);
+
+/**
+ * Get the bitmap of an object and its children, including the extra draw area (e.g. shadow).
+ * Can be called from more threads at once.
+ * @param obj       pointer to an object with `LV_OBJ_FLAG_CACHED`
+ * @return          the up-to-date bitmap or NULL if the object needs to be drawn normally
+ */
+const lv_img_dsc_t * _lv_obj_cache_get(const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#else /*LV_USE_OBJ_CACHE*/
+
+#define _lv_obj_cache_invalidate(obj) LV_UNUSED(obj)
+
+#endif /*LV_USE_OBJ_CACHE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_CACHE_H*/
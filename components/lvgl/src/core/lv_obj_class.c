@@ -8,6 +8,8 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_theme.h"
+#include "lv_indev_index.h"
+#include "lv_obj_pool.h"
 
 /*********************
  *      DEFINES
@@ -26,7 +28,6 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_obj_construct(lv_obj_t * obj);
-static uint32_t get_instance_size(const lv_obj_class_t * class_p);
 
 /**********************
  *  STATIC VARIABLES
@@ -43,8 +44,8 @@ static uint32_t get_instance_size(const lv_obj_class_t * class_p);
 lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * parent)
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
-    uint32_t s = get_instance_size(class_p);
-    lv_obj_t * obj = lv_mem_alloc(s);
+    uint32_t s = _lv_obj_class_get_instance_size(class_p);
+    lv_obj_t * obj = _lv_obj_pool_alloc(s);
     if(obj == NULL) return NULL;
     lv_memset_00(obj, s);
     obj->class_p = class_p;
@@ -56,7 +57,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         lv_disp_t * disp = lv_disp_get_default();
         if(!disp) {
             LV_LOG_WARN("No display created yet. No place to assign the new screen");
-            lv_mem_free(obj);
+            _lv_obj_pool_free(obj, s);
             return NULL;
         }
 
@@ -85,17 +86,11 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
             lv_obj_allocate_spec_attr(parent);
         }
 
-        if(parent->spec_attr->children == NULL) {
-            parent->spec_attr->children = lv_mem_alloc(sizeof(lv_obj_t *));
-            parent->spec_attr->children[0] = obj;
-            parent->spec_attr->child_cnt = 1;
-        }
-        else {
-            parent->spec_attr->child_cnt++;
-            parent->spec_attr->children = lv_mem_realloc(parent->spec_attr->children,
-                                                         sizeof(lv_obj_t *) * parent->spec_attr->child_cnt);
-            parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
-        }
+        uint32_t child_cnt = parent->spec_attr->child_cnt;
+        parent->spec_attr->children = _lv_mem_realloc_array(parent->spec_attr->children, child_cnt, child_cnt + 1,
+                                                            sizeof(lv_obj_t *));
+        parent->spec_attr->children[child_cnt] = obj;
+        parent->spec_attr->child_cnt++;
     }
 
     return obj;
@@ -113,6 +108,7 @@ void lv_obj_class_init_obj(lv_obj_t * obj)
     lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
 
     lv_obj_refresh_self_size(obj);
+    _lv_indev_index_update(obj);
 
     lv_group_t * def_group = lv_group_get_default();
     if(def_group && lv_obj_is_group_def(obj)) {
@@ -144,6 +140,17 @@ void _lv_obj_destruct(lv_obj_t * obj)
     }
 }
 
+uint32_t _lv_obj_class_get_instance_size(const lv_obj_class_t * class_p)
+{
+    /*Find a base in which instance size is set*/
+    const lv_obj_class_t * base = class_p;
+    while(base && base->instance_size == 0) base = base->base_class;
+
+    if(base == NULL) return 0;  /*Never happens: set at least in `lv_obj` class*/
+
+    return base->instance_size;
+}
+
 bool lv_obj_is_editable(lv_obj_t * obj)
 {
     const lv_obj_class_t * class_p = obj->class_p;
@@ -189,14 +196,3 @@ static void lv_obj_construct(lv_obj_t * obj)
 
     if(obj->class_p->constructor_cb) obj->class_p->constructor_cb(obj->class_p, obj);
 }
-
-static uint32_t get_instance_size(const lv_obj_class_t * class_p)
-{
-    /*Find a base in which instance size is set*/
-    const lv_obj_class_t * base = class_p;
-    while(base && base->instance_size == 0) base = base->base_class;
-
-    if(base == NULL) return 0;  /*Never happens: set at least in `lv_obj` class*/
-
-    return base->instance_size;
-}
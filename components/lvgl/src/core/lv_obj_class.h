@@ -78,6 +78,13 @@ void lv_obj_class_init_obj(struct _lv_obj_t * obj);
 
 void _lv_obj_destruct(struct _lv_obj_t * obj);
 
+/**
+ * Get the size of the objects of a class. It's the `instance_size` of the class or of its closest ancestor setting it.
+ * @param class_p   pointer to a class
+ * @return          size of an object in bytes
+ */
+uint32_t _lv_obj_class_get_instance_size(const struct _lv_obj_class_t * class_p);
+
 bool lv_obj_is_editable(struct _lv_obj_t * obj);
 
 bool lv_obj_is_group_def(struct _lv_obj_t * obj);
@@ -0,0 +1,123 @@
+/**
+ * @file lv_obj_pool.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_pool.h"
+
+#if LV_USE_OBJ_POOL
+
+/*********************
+ *      DEFINES
+ *********************/
+#define POOL_MAX_CNT    16  /*Number of different sizes which can have a free list*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t size;
+    void * free_head;       /*The free elements are linked through their first word*/
+} lv_obj_pool_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_obj_pool_t * pool_find(uint32_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_obj_pool_t pools[POOL_MAX_CNT];
+static uint32_t pool_cnt;
+static lv_obj_pool_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_pool_flush(void)
+{
+    uint32_t i;
+    for(i = 0; i < pool_cnt; i++) {
+        while(pools[i].free_head) {
+            void * p = pools[i].free_head;
+            pools[i].free_head = *(void **)p;
+            lv_mem_free(p);
+        }
+    }
+
+    pool_cnt = 0;
+    stats.size = 0;
+    stats.free_cnt = 0;
+}
+
+void lv_obj_pool_get_stats(lv_obj_pool_stats_t * stats_out)
+{
+    *stats_out = stats;
+}
+
+void * _lv_obj_pool_alloc(uint32_t size)
+{
+    lv_obj_pool_t * pool = pool_find(size);
+    if(pool && pool->free_head) {
+        void * p = pool->free_head;
+        pool->free_head = *(void **)p;
+        stats.hit_cnt++;
+        stats.size -= size;
+        stats.free_cnt--;
+        return p;
+    }
+
+    stats.miss_cnt++;
+    return lv_mem_alloc(size);
+}
+
+void _lv_obj_pool_free(void * p, uint32_t size)
+{
+    if(p == NULL) return;
+
+    lv_obj_pool_t * pool = NULL;
+    if(stats.size + size <= LV_OBJ_POOL_MAX_SIZE && size >= sizeof(void *)) {
+        pool = pool_find(size);
+        if(pool == NULL && pool_cnt < POOL_MAX_CNT) {
+            pool = &pools[pool_cnt];
+            pool->size = size;
+            pool->free_head = NULL;
+            pool_cnt++;
+        }
+    }
+
+    if(pool == NULL) {
+        lv_mem_free(p);
+        return;
+    }
+
+    *(void **)p = pool->free_head;
+    pool->free_head = p;
+    stats.size += size;
+    stats.free_cnt++;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_obj_pool_t * pool_find(uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < pool_cnt; i++) {
+        if(pools[i].size == size) return &pools[i];
+    }
+
+    return NULL;
+}
+
+#endif /*LV_USE_OBJ_POOL*/
@@ -0,0 +1,82 @@
+/**
+ * @file lv_obj_pool.h
+ *
+ */
+
+#ifndef LV_OBJ_POOL_H
+#define LV_OBJ_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_mem.h"
+
+#if LV_USE_OBJ_POOL
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hit_cnt;       /*Number of allocations served from the free lists*/
+    uint32_t miss_cnt;      /*Number of allocations which needed `lv_mem_alloc`*/
+    uint32_t size;          /*Total size of the elements in the free lists in bytes*/
+    uint32_t free_cnt;      /*Number of elements in the free lists*/
+} lv_obj_pool_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Free the memory of the deleted objects kept for the new objects
+ */
+void lv_obj_pool_flush(void);
+
+/**
+ * Get the statistics of the object pool
+ * @param stats     the result is written here
+ */
+void lv_obj_pool_get_stats(lv_obj_pool_stats_t * stats);
+
+/**
+ * Allocate memory for an object, its attributes or local style. Called by LVGL.
+ * @param size      size of the memory in bytes
+ * @return          pointer to the memory or NULL on failure
+ */
+void * _lv_obj_pool_alloc(uint32_t size);
+
+/**
+ * Free memory allocated by `_lv_obj_pool_alloc`. It's kept in a free list while there is space for it.
+ * Called by LVGL.
+ * @param p         pointer to the memory
+ * @param size      the same size as it was allocated with
+ */
+void _lv_obj_pool_free(void * p, uint32_t size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#else /*LV_USE_OBJ_POOL*/
+
+#define lv_obj_pool_flush()
+#define _lv_obj_pool_alloc(size) lv_mem_alloc(size)
+#define _lv_obj_pool_free(p, size) do { LV_UNUSED(size); lv_mem_free(p); } while(0)
+
+#endif /*LV_USE_OBJ_POOL*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_POOL_H*/
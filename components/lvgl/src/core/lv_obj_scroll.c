@@ -11,6 +11,7 @@
 #include "lv_indev.h"
 #include "lv_disp.h"
 #include "lv_indev_scroll.h"
+#include "lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +37,10 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_anim_ready_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+static bool hw_scroll_area_get(lv_obj_t * obj, lv_area_t * area);
+static bool area_is_covered(lv_obj_t * parent, uint32_t start_id, const lv_area_t * area);
+static bool hw_scroll(lv_obj_t * obj, const lv_area_t * area, lv_coord_t dy, const lv_area_t * hor_ori,
+                      const lv_area_t * ver_ori);
 
 /**********************
  *  STATIC VARIABLES
@@ -415,13 +420,22 @@ lv_res_t _lv_obj_scroll_by_raw(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 
     lv_obj_allocate_spec_attr(obj);
 
+    /*Let the display shift the content if it can, the scrollbars are needed from before the scroll too*/
+    lv_area_t hw_area;
+    lv_area_t hor_ori;
+    lv_area_t ver_ori;
+    bool hw = x == 0 && hw_scroll_area_get(obj, &hw_area);
+    if(hw) lv_obj_get_scrollbar_area(obj, &hor_ori, &ver_ori);
+
     obj->spec_attr->scroll.x += x;
     obj->spec_attr->scroll.y += y;
 
     lv_obj_move_children_by(obj, x, y, true);
+    if(hw) hw = hw_scroll(obj, &hw_area, y, &hor_ori, &ver_ori);
+
     lv_res_t res = lv_event_send(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RES_OK) return res;
-    lv_obj_invalidate(obj);
+    if(!hw) lv_obj_invalidate(obj);
     return LV_RES_OK;
 }
 
@@ -798,3 +812,173 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+/**
+ * Get the rows of an object which look the same after scrolling, only shifted.
+ * It's possible only if the display can shift the content of full width areas
+ * and nothing else is drawn there.
+ * @param obj       pointer to an object
+ * @param area      store the area to shift here
+ * @return          true: the object can be scrolled by the display
+ */
+static bool hw_scroll_area_get(lv_obj_t * obj, lv_area_t * area)
+{
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    lv_disp_drv_t * drv = disp->driver;
+    if(drv->hw_scroll_cb == NULL) return false;
+    if(drv->direct_mode || drv->full_refresh || drv->rotated != LV_DISP_ROT_NONE) return false;
+    if(disp->rendering_in_progress || disp->prev_scr || !lv_disp_is_invalidation_enabled(disp)) return false;
+    if(lv_obj_get_screen(obj) != disp->act_scr) return false;
+
+    /*Widgets can draw things which stay in place*/
+    const lv_obj_class_t * class_p = obj->class_p;
+    while(class_p && class_p != &lv_obj_class) {
+        if(class_p->event_cb) return false;
+        class_p = class_p->base_class;
+    }
+
+    /*The background has to hide everything behind and be the same in every row*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_img_src(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_blend_mode(obj, LV_PART_MAIN) != LV_BLEND_MODE_NORMAL) return false;
+
+    lv_obj_t * parent = obj;
+    while(parent) {
+        if(_lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Floating children stay in place*/
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING) && !lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) return false;
+    }
+
+    /*The rounded corners and the top and bottom borders don't scroll*/
+    lv_coord_t h = lv_obj_get_height(obj);
+    lv_coord_t r = LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN), h / 2);
+    lv_coord_t bw = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_border_side_t side = lv_obj_get_style_border_side(obj, LV_PART_MAIN);
+    *area = obj->coords;
+    area->y1 += LV_MAX(r, (side & LV_BORDER_SIDE_TOP) ? bw : 0);
+    area->y2 -= LV_MAX(r, (side & LV_BORDER_SIDE_BOTTOM) ? bw : 0);
+    if(!lv_obj_area_is_visible(obj, area)) return false;
+    if(area->x1 > 0 || area->x2 < lv_disp_get_hor_res(disp) - 1) return false;
+
+    /*Nothing can be drawn on it later*/
+    lv_obj_t * child = obj;
+    parent = lv_obj_get_parent(obj);
+    while(parent) {
+        if(area_is_covered(parent, lv_obj_get_index(child) + 1, area)) return false;
+
+        lv_area_t hor;
+        lv_area_t ver;
+        lv_obj_get_scrollbar_area(parent, &hor, &ver);
+        if(_lv_area_is_on(&hor, area) || _lv_area_is_on(&ver, area)) return false;
+
+        child = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    if(area_is_covered(disp->top_layer, 0, area)) return false;
+    if(area_is_covered(disp->sys_layer, 0, area)) return false;
+
+    return true;
+}
+
+/**
+ * Tell if a visible child of an object is drawn on an area
+ * @param parent    pointer to an object
+ * @param start_id  check the children from this index
+ * @param area      the area to check
+ * @return          true: a child is on the area
+ */
+static bool area_is_covered(lv_obj_t * parent, uint32_t start_id, const lv_area_t * area)
+{
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(parent);
+    for(i = start_id; i < child_cnt; i++) {
+        lv_obj_t * child = parent->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+
+        lv_area_t child_area = child->coords;
+        lv_coord_t ext_size = _lv_obj_get_ext_draw_size(child);
+        lv_area_increase(&child_area, ext_size, ext_size);
+        lv_obj_get_transformed_area(child, &child_area, false, false);
+        if(_lv_area_is_on(&child_area, area)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Ask the display to shift an area and invalidate what was not shifted correctly
+ * @param obj       pointer to the scrolled object. Its children are already moved.
+ * @param area      the area to shift, from `hw_scroll_area_get()`
+ * @param dy        scroll the content by this many pixels down
+ * @param hor_ori   the horizontal scrollbar's area before the scroll
+ * @param ver_ori   the vertical scrollbar's area before the scroll
+ * @return          true: the display has shifted the area
+ */
+static bool hw_scroll(lv_obj_t * obj, const lv_area_t * area, lv_coord_t dy, const lv_area_t * hor_ori,
+                      const lv_area_t * ver_ori)
+{
+    if(LV_ABS(dy) >= lv_area_get_height(area)) return false;
+
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    uint16_t inv_p = disp->inv_p;
+    if(!disp->driver->hw_scroll_cb(disp->driver, area, dy)) return false;
+
+    /*The areas not redrawn yet were shifted too*/
+    uint16_t i;
+    for(i = 0; i < inv_p; i++) {
+        lv_area_t inv_area;
+        if(!_lv_area_intersect(&inv_area, &disp->inv_areas[i], area)) continue;
+        lv_area_move(&inv_area, 0, dy);
+        if(_lv_area_intersect(&inv_area, &inv_area, area)) _lv_inv_area(disp, &inv_area);
+    }
+
+    /*The uncovered rows*/
+    lv_area_t a = *area;
+    if(dy < 0) a.y1 = area->y2 + dy + 1;
+    else a.y2 = area->y1 + dy - 1;
+    lv_obj_invalidate_area(obj, &a);
+
+    /*The rows of the object which were not shifted*/
+    a = obj->coords;
+    a.y2 = area->y1 - 1;
+    lv_obj_invalidate_area(obj, &a);
+    a = obj->coords;
+    a.y1 = area->y2 + 1;
+    lv_obj_invalidate_area(obj, &a);
+
+    /*The scrollbars were shifted too but they have to stay in place*/
+    lv_area_t hor;
+    lv_area_t ver;
+    lv_obj_get_scrollbar_area(obj, &hor, &ver);
+    if(lv_area_get_size(ver_ori) > 0) {
+        a = *ver_ori;
+        a.y1 = area->y1;
+        a.y2 = area->y2;
+        lv_obj_invalidate_area(obj, &a);
+    }
+    if(lv_area_get_size(&ver) > 0) {
+        a = ver;
+        a.y1 = area->y1;
+        a.y2 = area->y2;
+        lv_obj_invalidate_area(obj, &a);
+    }
+    if(lv_area_get_size(hor_ori) > 0) {
+        lv_obj_invalidate_area(obj, hor_ori);
+        a = *hor_ori;
+        lv_area_move(&a, 0, dy);
+        lv_obj_invalidate_area(obj, &a);
+    }
+    if(lv_area_get_size(&hor) > 0) lv_obj_invalidate_area(obj, &hor);
+
+    return true;
+}
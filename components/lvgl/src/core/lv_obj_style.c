@@ -8,6 +8,8 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_disp.h"
+#include "lv_indev_index.h"
+#include "lv_obj_pool.h"
 #include "../misc/lv_gc.h"
 
 /*********************
@@ -128,7 +130,7 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
         if(obj->styles[i].is_local || obj->styles[i].is_trans) {
             lv_style_reset(obj->styles[i].style);
-            lv_mem_free(obj->styles[i].style);
+            _lv_obj_pool_free(obj->styles[i].style, sizeof(lv_style_t));
             obj->styles[i].style = NULL;
         }
 
@@ -201,6 +203,7 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
             lv_obj_allocate_spec_attr(obj);
             obj->spec_attr->layer_type = layer_type;
         }
+        _lv_indev_index_update(obj);
     }
 
     if(prop == LV_STYLE_PROP_ANY || is_ext_draw) {
@@ -445,7 +448,10 @@ _lv_style_state_cmp_t _lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t sta
             else if(lv_style_get_prop(style, LV_STYLE_SHADOW_OFS_Y, &v)) res = _LV_STYLE_STATE_CMP_DIFF_DRAW_PAD;
             else if(lv_style_get_prop(style, LV_STYLE_SHADOW_SPREAD, &v)) res = _LV_STYLE_STATE_CMP_DIFF_DRAW_PAD;
             else if(lv_style_get_prop(style, LV_STYLE_LINE_WIDTH, &v)) res = _LV_STYLE_STATE_CMP_DIFF_DRAW_PAD;
-            else if(res == _LV_STYLE_STATE_CMP_SAME) res = _LV_STYLE_STATE_CMP_DIFF_REDRAW;
+            else if(lv_obj_style_get_selector_part(obj->styles[i].selector) == LV_PART_SCROLLBAR) {
+                if(res == _LV_STYLE_STATE_CMP_SAME) res = _LV_STYLE_STATE_CMP_DIFF_SCROLLBAR;
+            }
+            else if(res <= _LV_STYLE_STATE_CMP_DIFF_SCROLLBAR) res = _LV_STYLE_STATE_CMP_DIFF_REDRAW;
         }
     }
 
@@ -529,7 +535,7 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
     }
 
     lv_memset_00(&obj->styles[i], sizeof(_lv_obj_style_t));
-    obj->styles[i].style = lv_mem_alloc(sizeof(lv_style_t));
+    obj->styles[i].style = _lv_obj_pool_alloc(sizeof(lv_style_t));
     lv_style_init(obj->styles[i].style);
     obj->styles[i].is_local = 1;
     obj->styles[i].selector = selector;
@@ -561,7 +567,7 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
     }
 
     lv_memset_00(&obj->styles[0], sizeof(_lv_obj_style_t));
-    obj->styles[0].style = lv_mem_alloc(sizeof(lv_style_t));
+    obj->styles[0].style = _lv_obj_pool_alloc(sizeof(lv_style_t));
     lv_style_init(obj->styles[0].style);
     obj->styles[0].is_trans = 1;
     obj->styles[0].selector = selector;
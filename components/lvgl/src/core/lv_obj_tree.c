@@ -10,6 +10,8 @@
 
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "lv_indev_index.h"
+#include "lv_obj_pool.h"
 #include "../misc/lv_anim.h"
 #include "../misc/lv_gc.h"
 #include "../misc/lv_async.h"
@@ -28,6 +30,7 @@
  **********************/
 static void lv_obj_del_async_cb(void * obj);
 static void obj_del_core(lv_obj_t * obj);
+static void del_children(lv_obj_t * obj);
 static lv_obj_tree_walk_res_t walk_core(lv_obj_t * obj, lv_obj_tree_walk_cb_t cb, void * user_data);
 
 /**********************
@@ -89,11 +92,7 @@ void lv_obj_clean(lv_obj_t * obj)
 
     lv_obj_invalidate(obj);
 
-    lv_obj_t * child = lv_obj_get_child(obj, 0);
-    while(child) {
-        obj_del_core(child);
-        child = lv_obj_get_child(obj, 0);
-    }
+    del_children(obj);
     /*Just to remove scroll animations if any*/
     lv_obj_scroll_to(obj, 0, 0, LV_ANIM_OFF);
     if(obj->spec_attr) {
@@ -154,23 +153,25 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     for(i = lv_obj_get_index(obj); i <= (int32_t)lv_obj_get_child_cnt(old_parent) - 2; i++) {
         old_parent->spec_attr->children[i] = old_parent->spec_attr->children[i + 1];
     }
+    old_parent->spec_attr->children = _lv_mem_realloc_array(old_parent->spec_attr->children,
+                                                            old_parent->spec_attr->child_cnt,
+                                                            old_parent->spec_attr->child_cnt - 1, sizeof(lv_obj_t *));
     old_parent->spec_attr->child_cnt--;
-    if(old_parent->spec_attr->child_cnt) {
-        old_parent->spec_attr->children = lv_mem_realloc(old_parent->spec_attr->children,
-                                                         old_parent->spec_attr->child_cnt * (sizeof(lv_obj_t *)));
-    }
-    else {
-        lv_mem_free(old_parent->spec_attr->children);
-        old_parent->spec_attr->children = NULL;
-    }
 
     /*Add the child to the new parent as the last (newest child)*/
+    parent->spec_attr->children = _lv_mem_realloc_array(parent->spec_attr->children, parent->spec_attr->child_cnt,
+                                                        parent->spec_attr->child_cnt + 1, sizeof(lv_obj_t *));
+    parent->spec_attr->children[parent->spec_attr->child_cnt] = obj;
     parent->spec_attr->child_cnt++;
-    parent->spec_attr->children = lv_mem_realloc(parent->spec_attr->children,
-                                                 parent->spec_attr->child_cnt * (sizeof(lv_obj_t *)));
-    parent->spec_attr->children[lv_obj_get_child_cnt(parent) - 1] = obj;
 
     obj->parent = parent;
+#if LV_USE_INDEV_INDEX
+    /*The index doesn't depend on the tree order, only moving to another screen needs a rebuild*/
+    if(lv_obj_get_screen(old_parent) != lv_obj_get_screen(parent)) {
+        _lv_indev_index_invalidate(old_parent);
+        _lv_indev_index_invalidate(parent);
+    }
+#endif
 
     /*Notify the original parent because one of its children is lost*/
     lv_obj_readjust_scroll(old_parent, LV_ANIM_OFF);
@@ -238,6 +239,12 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
 
     parent->spec_attr->children[index1] = obj2;
     parent2->spec_attr->children[index2] = obj1;
+#if LV_USE_INDEV_INDEX
+    if(lv_obj_get_screen(parent) != lv_obj_get_screen(parent2)) {
+        _lv_indev_index_invalidate(parent);
+        _lv_indev_index_invalidate(parent2);
+    }
+#endif
 
     lv_event_send(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_event_send(parent, LV_EVENT_CHILD_CREATED, obj2);
@@ -360,12 +367,10 @@ static void obj_del_core(lv_obj_t * obj)
     lv_res_t res = lv_event_send(obj, LV_EVENT_DELETE, NULL);
     if(res == LV_RES_INV) return;
 
+    _lv_indev_index_remove(obj);
+
     /*Recursively delete the children*/
-    lv_obj_t * child = lv_obj_get_child(obj, 0);
-    while(child) {
-        obj_del_core(child);
-        child = lv_obj_get_child(obj, 0);
-    }
+    del_children(obj);
 
     lv_group_t * group = lv_obj_get_group(obj);
 
@@ -385,7 +390,9 @@ static void obj_del_core(lv_obj_t * obj)
         indev = lv_indev_get_next(indev);
     }
 
-    /*All children deleted. Now clean up the object specific data*/
+    /*All children deleted. Now clean up the object specific data.
+     *Get the size first as the destructors set the base classes.*/
+    uint32_t size = _lv_obj_class_get_instance_size(obj->class_p);
     _lv_obj_destruct(obj);
 
     /*Remove the screen for the screen list*/
@@ -411,15 +418,28 @@ static void obj_del_core(lv_obj_t * obj)
         for(i = id; i < obj->parent->spec_attr->child_cnt - 1; i++) {
             obj->parent->spec_attr->children[i] = obj->parent->spec_attr->children[i + 1];
         }
+        obj->parent->spec_attr->children = _lv_mem_realloc_array(obj->parent->spec_attr->children,
+                                                                 obj->parent->spec_attr->child_cnt,
+                                                                 obj->parent->spec_attr->child_cnt - 1, sizeof(lv_obj_t *));
         obj->parent->spec_attr->child_cnt--;
-        obj->parent->spec_attr->children = lv_mem_realloc(obj->parent->spec_attr->children,
-                                                          obj->parent->spec_attr->child_cnt * sizeof(lv_obj_t *));
     }
 
     /*Free the object itself*/
-    lv_mem_free(obj);
+    _lv_obj_pool_free(obj, size);
 }
 
+/**
+ * Delete the children of an object from the first one.
+ * @param obj   pointer to an object
+ */
+static void del_children(lv_obj_t * obj)
+{
+    lv_obj_t * child = lv_obj_get_child(obj, 0);
+    while(child) {
+        obj_del_core(child);
+        child = lv_obj_get_child(obj, 0);
+    }
+}
 
 static lv_obj_tree_walk_res_t walk_core(lv_obj_t * obj, lv_obj_tree_walk_cb_t cb, void * user_data)
 {
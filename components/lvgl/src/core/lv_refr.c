@@ -18,6 +18,8 @@
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../extra/others/snapshot/lv_snapshot.h"
+#include "lv_trace.h"
+#include "lv_obj_cache.h"
 
 #include "esp_log.h"
 
@@ -28,6 +30,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Number of opaque areas kept to test the objects drawn before them*/
+#define OCCLUDER_MAX    8
 
 /**********************
  *      TYPEDEFS
@@ -50,6 +54,18 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+typedef struct {
+    lv_obj_t * act_scr;         /*The top most objects which fully cover the draw buffer*/
+    lv_obj_t * prev_scr;
+} refr_top_objs_t;
+
+#if LV_USE_OCCLUSION_CULL
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;             /*The part of the object which is not covered. Invalid if fully covered.*/
+} occl_visible_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -57,9 +73,28 @@ static void lv_refr_join_area(void);
 static void refr_invalid_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void refr_area_end(void);
+static void refr_area_part_draw(lv_draw_ctx_t * draw_ctx, const refr_top_objs_t * tops);
+static void refr_get_top_objs(const lv_area_t * area_p, refr_top_objs_t * tops);
+#if LV_USE_DRAW_REC
+    static bool refr_record(lv_draw_ctx_t * draw_ctx, const lv_area_t * area_p);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+static void refr_obj_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+#if LV_USE_OBJ_CACHE
+    static void refr_obj_cached(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, const lv_img_dsc_t * img);
+#endif
+#if LV_USE_OCCLUSION_CULL
+    static void occl_update(const lv_area_t * area_p);
+    static void occl_younger_siblings(lv_obj_t * obj, const lv_area_t * clip);
+    static void occl_obj(lv_obj_t * obj, const lv_area_t * clip, const lv_area_t * clip_full, bool masked);
+    static void occl_count_culled(lv_obj_t * obj, const lv_area_t * clip);
+    static bool occl_trim(lv_area_t * area);
+    static void occl_add(const lv_area_t * area);
+    static const lv_area_t * occl_get_visible(const lv_obj_t * obj);
+#endif
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
@@ -70,12 +105,28 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
 #if LV_USE_MEM_MONITOR
     static void mem_monitor_init(mem_monitor_t * mem_monitor);
 #endif
+#if LV_USE_TRACE && LV_USE_TRACE_BAR
+    static void trace_bar_draw_event_cb(lv_event_t * e);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+#if LV_USE_DRAW_REC
+    static bool refr_recorded;    /*The objects of the area being refreshed are recorded*/
+#endif
+
+#if LV_USE_OCCLUSION_CULL
+    static bool occl_enabled = true;
+    static lv_area_t occluders[OCCLUDER_MAX];   /*Opaque areas of the objects visited so far, i.e. drawn later*/
+    static uint32_t occluder_cnt;
+    static occl_visible_t occl_visible[LV_OCCLUSION_CULL_MAX_OBJ];
+    static uint32_t occl_visible_cnt;
+    static lv_refr_occlusion_stats_t occl_stats;        /*Of the frame being refreshed*/
+    static lv_refr_occlusion_stats_t occl_stats_last;
+#endif
 
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
@@ -85,6 +136,12 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static mem_monitor_t    mem_monitor;
 #endif
 
+#if LV_USE_TRACE && LV_USE_TRACE_BAR
+    static lv_obj_t * trace_bar;
+    static uint32_t trace_bar_last_time;
+    static lv_trace_frame_t trace_bar_frame;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -306,12 +363,18 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
+#if LV_USE_TRACE
+    _lv_trace_frame_begin();
+#endif
+
     /*Refresh the screen's layout if required*/
+    LV_TRACE_BEGIN("layout");
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
 
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
+    LV_TRACE_END();
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
@@ -325,6 +388,10 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     refr_invalid_areas();
 
+#if LV_USE_TRACE
+    _lv_trace_frame_end();
+#endif
+
     /*If refresh happened ...*/
     if(disp_refr->inv_p != 0) {
 
@@ -344,10 +411,6 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
 
-#if LV_DRAW_COMPLEX
-    _lv_draw_mask_cleanup();
-#endif
-
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
     lv_obj_t * perf_label = perf_monitor.perf_label;
     if(perf_label == NULL) {
@@ -436,6 +499,29 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     }
 #endif
 
+#if LV_USE_TRACE && LV_USE_TRACE_BAR
+    if(lv_trace_is_running()) {
+        if(trace_bar == NULL) {
+            trace_bar = lv_obj_create(lv_layer_sys());
+            lv_obj_remove_style_all(trace_bar);
+            lv_obj_clear_flag(trace_bar, LV_OBJ_FLAG_CLICKABLE);
+            lv_obj_set_size(trace_bar, lv_pct(100), 6);
+            lv_obj_align(trace_bar, LV_ALIGN_TOP_MID, 0, 0);
+            lv_obj_add_event_cb(trace_bar, trace_bar_draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+        }
+
+        if(lv_tick_elaps(trace_bar_last_time) > 300) {
+            trace_bar_last_time = lv_tick_get();
+            lv_trace_get_worst_frame(&trace_bar_frame);
+            lv_obj_invalidate(trace_bar);
+        }
+    }
+    else if(trace_bar) {
+        lv_obj_del(trace_bar);
+        trace_bar = NULL;
+    }
+#endif
+
     REFR_TRACE("finished");
 }
 
@@ -455,6 +541,18 @@ uint32_t lv_refr_get_fps_avg(void)
 }
 #endif
 
+#if LV_USE_OCCLUSION_CULL
+void lv_refr_occlusion_cull_enable(bool en)
+{
+    occl_enabled = en;
+}
+
+void lv_refr_get_occlusion_stats(lv_refr_occlusion_stats_t * stats)
+{
+    *stats = occl_stats_last;
+}
+#endif
+
 
 /**********************
  *   STATIC FUNCTIONS
@@ -506,6 +604,10 @@ static void refr_invalid_areas(void)
 
     if(disp_refr->inv_p == 0) return;
 
+#if LV_USE_OCCLUSION_CULL
+    lv_memset_00(&occl_stats, sizeof(occl_stats));
+#endif
+
     /*Find the last area which will be drawn*/
     int32_t i;
     int32_t last_i = 0;
@@ -538,6 +640,14 @@ static void refr_invalid_areas(void)
     }
 
     disp_refr->rendering_in_progress = false;
+
+#if LV_USE_OCCLUSION_CULL
+    occl_stats_last = occl_stats;
+    if(occl_stats.area_px) {
+        LV_TRACE_COUNTER("overdraw %", (int32_t)(((uint64_t)occl_stats.drawn_px * 100) / occl_stats.area_px));
+        LV_TRACE_COUNTER("culled px", (int32_t)occl_stats.culled_px);
+    }
+#endif
 }
 
 /**
@@ -546,6 +656,8 @@ static void refr_invalid_areas(void)
  */
 static void refr_area(const lv_area_t * area_p)
 {
+    LV_TRACE_BEGIN("refr_area");
+
     lv_draw_ctx_t * draw_ctx = disp_refr->driver->draw_ctx;
     draw_ctx->buf = disp_refr->driver->draw_buf->buf_act;
 
@@ -559,13 +671,21 @@ static void refr_area(const lv_area_t * area_p)
         if(disp_refr->driver->full_refresh) {
             disp_refr->driver->draw_buf->last_part = 1;
             draw_ctx->clip_area = &disp_area;
-            refr_area_part(draw_ctx);
         }
         else {
             disp_refr->driver->draw_buf->last_part = disp_refr->driver->draw_buf->last_area;
             draw_ctx->clip_area = area_p;
-            refr_area_part(draw_ctx);
         }
+
+#if LV_USE_OBJ_CACHE
+        _lv_obj_cache_update(disp_refr, draw_ctx->clip_area);
+#endif
+#if LV_USE_OCCLUSION_CULL
+        occl_update(draw_ctx->clip_area);
+#endif
+        refr_area_part(draw_ctx);
+        refr_area_end();
+        LV_TRACE_END();
         return;
     }
 
@@ -578,6 +698,23 @@ static void refr_area(const lv_area_t * area_p)
 
     int32_t max_row = get_max_row(disp_refr, w, h);
 
+    lv_area_t area_clipped = *area_p;
+    area_clipped.y2 = y2;
+    LV_UNUSED(area_clipped);    /*If none of the caches below are enabled*/
+#if LV_USE_OBJ_CACHE
+    _lv_obj_cache_update(disp_refr, &area_clipped);
+#endif
+#if LV_USE_OCCLUSION_CULL
+    occl_update(&area_clipped);
+#endif
+
+#if LV_USE_DRAW_REC
+    /*Walk the objects only once if the area is drawn in more parts*/
+    if(h > max_row) {
+        refr_recorded = refr_record(draw_ctx, &area_clipped);
+    }
+#endif
+
     lv_coord_t row;
     lv_coord_t row_last = 0;
     lv_area_t sub_area;
@@ -609,6 +746,25 @@ static void refr_area(const lv_area_t * area_p)
         disp_refr->driver->draw_buf->last_part = 1;
         refr_area_part(draw_ctx);
     }
+
+    refr_area_end();
+    LV_TRACE_END();
+}
+
+/**
+ * Clean up after an area is refreshed
+ */
+static void refr_area_end(void)
+{
+#if LV_USE_DRAW_REC
+    if(refr_recorded) {
+        _lv_draw_rec_clear();
+        refr_recorded = false;
+    }
+#endif
+#if LV_USE_OCCLUSION_CULL
+    occl_visible_cnt = 0;
+#endif
 }
 
 static void refr_area_part(lv_draw_ctx_t * draw_ctx)
@@ -624,9 +780,11 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if((draw_buf->buf1 && !draw_buf->buf2) ||
        (draw_buf->buf1 && draw_buf->buf2 && full_sized)) {
+        LV_TRACE_BEGIN("wait_flush");
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+        LV_TRACE_END();
 
         /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
@@ -641,14 +799,69 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
 #endif
     }
 
-    lv_obj_t * top_act_scr = NULL;
-    lv_obj_t * top_prev_scr = NULL;
+#if LV_USE_DRAW_REC
+    /*The objects are already recorded for the whole area: only replay them on this part*/
+    if(refr_recorded) {
+        _lv_draw_rec_replay(draw_ctx);
+
+        draw_buf_flush(disp_refr);
+        return;
+    }
+#endif
+
+    refr_top_objs_t tops;
+    refr_get_top_objs(draw_ctx->buf_area, &tops);
+    refr_area_part_draw(draw_ctx, &tops);
 
-    /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
+    draw_buf_flush(disp_refr);
+}
+
+/**
+ * Get the top most objects of the screens which fully cover an area
+ * @param area_p    the area to cover
+ * @param tops      the result is written here, an object is NULL if not found
+ */
+static void refr_get_top_objs(const lv_area_t * area_p, refr_top_objs_t * tops)
+{
+    tops->act_scr = lv_refr_get_top_obj(area_p, lv_disp_get_scr_act(disp_refr));
+    tops->prev_scr = NULL;
     if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
+        tops->prev_scr = lv_refr_get_top_obj(area_p, disp_refr->prev_scr);
     }
+}
+
+#if LV_USE_DRAW_REC
+/**
+ * Draw the objects of an area into a command list to replay it on each part of the area
+ * @param draw_ctx      the display's draw context
+ * @param area_p        the area to record
+ * @return              true: recorded; false: draw the parts directly
+ */
+static bool refr_record(lv_draw_ctx_t * draw_ctx, const lv_area_t * area_p)
+{
+    lv_draw_ctx_t * rec_ctx = _lv_draw_rec_begin(draw_ctx, area_p);
+    if(rec_ctx == NULL) return false;
+
+    LV_TRACE_BEGIN("record");
+    refr_top_objs_t tops;
+    refr_get_top_objs(area_p, &tops);
+    refr_area_part_draw(rec_ctx, &tops);
+    lv_res_t res = _lv_draw_rec_end();
+    LV_TRACE_END();
+
+    return res == LV_RES_OK;
+}
+#endif
+
+/**
+ * Draw the background, the screens and the layers on `draw_ctx->clip_area`
+ * @param draw_ctx      the draw context
+ * @param tops          the top most objects of the screens which cover the draw buffer
+ */
+static void refr_area_part_draw(lv_draw_ctx_t * draw_ctx, const refr_top_objs_t * tops)
+{
+    lv_obj_t * top_act_scr = tops->act_scr;
+    lv_obj_t * top_prev_scr = tops->prev_scr;
 
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
@@ -710,8 +923,6 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
-
-    draw_buf_flush(disp_refr);
 }
 
 /**
@@ -881,21 +1092,61 @@ static void layer_alpha_test(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_l
 }
 
 
-void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+#if LV_USE_OCCLUSION_CULL
+    /*Draw only the part which is not covered by opaque objects drawn later*/
+    const lv_area_t * visible = occl_get_visible(obj);
+    if(visible) {
+        const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+        lv_area_t clip_visible;
+        if(!_lv_area_intersect(&clip_visible, clip_area_ori, visible)) return;
+
+        draw_ctx->clip_area = &clip_visible;
+        refr_obj_draw(draw_ctx, obj);
+        draw_ctx->clip_area = clip_area_ori;
+        return;
+    }
+#endif
+
+    refr_obj_draw(draw_ctx, obj);
+}
+
+static void refr_obj_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    LV_TRACE_OBJ_BEGIN(obj);
+
+#if LV_USE_OBJ_CACHE
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHED)) {
+        const lv_img_dsc_t * img = _lv_obj_cache_get(obj);
+        if(img) {
+            refr_obj_cached(draw_ctx, obj, img);
+            LV_TRACE_END();
+            return;
+        }
+    }
+#endif
+
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(draw_ctx, obj);
     }
     else {
         lv_opa_t opa = lv_obj_get_style_opa(obj, 0);
-        if(opa < LV_OPA_MIN) return;
+        if(opa < LV_OPA_MIN) {
+            LV_TRACE_END();
+            return;
+        }
 
         lv_area_t layer_area_full;
         lv_res_t res = layer_get_area(draw_ctx, obj, layer_type, &layer_area_full);
-        if(res != LV_RES_OK) return;
+        if(res != LV_RES_OK) {
+            LV_TRACE_END();
+            return;
+        }
 
         lv_draw_layer_flags_t flags = LV_DRAW_LAYER_FLAG_HAS_ALPHA;
 
@@ -912,6 +1163,7 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         lv_draw_layer_ctx_t * layer_ctx = lv_draw_layer_create(draw_ctx, &layer_area_full, flags);
         if(layer_ctx == NULL) {
             LV_LOG_WARN("Couldn't create a new layer context");
+            LV_TRACE_END();
             return;
         }
         lv_point_t pivot = {
@@ -964,9 +1216,320 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 
         lv_draw_layer_destroy(draw_ctx, layer_ctx);
     }
+
+    LV_TRACE_END();
 }
 
 
+#if LV_USE_OBJ_CACHE
+/**
+ * Draw the retained bitmap of an object instead of the object and its children.
+ * The opacity and the transformation are applied here instead of drawing a layer.
+ * @param draw_ctx  the draw context
+ * @param obj       pointer to an object with `LV_OBJ_FLAG_CACHED`
+ * @param img       the bitmap of the object
+ */
+static void refr_obj_cached(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, const lv_img_dsc_t * img)
+{
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    draw_dsc.opa = lv_obj_get_style_opa(obj, 0);
+    if(draw_dsc.opa < LV_OPA_MIN) return;
+
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_area_increase(&coords, ext_draw_size, ext_draw_size);
+
+    if(_lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) {
+        lv_point_t pivot = {
+            .x = lv_obj_get_style_transform_pivot_x(obj, 0),
+            .y = lv_obj_get_style_transform_pivot_y(obj, 0)
+        };
+
+        if(LV_COORD_IS_PCT(pivot.x)) {
+            pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
+        }
+        if(LV_COORD_IS_PCT(pivot.y)) {
+            pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
+        }
+
+        /*Relative to the bitmap*/
+        draw_dsc.pivot.x = pivot.x + ext_draw_size;
+        draw_dsc.pivot.y = pivot.y + ext_draw_size;
+        draw_dsc.angle = lv_obj_get_style_transform_angle(obj, 0);
+        if(draw_dsc.angle > 3600) draw_dsc.angle -= 3600;
+        else if(draw_dsc.angle < 0) draw_dsc.angle += 3600;
+        draw_dsc.zoom = lv_obj_get_style_transform_zoom(obj, 0);
+    }
+
+    draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    draw_dsc.antialias = disp_refr->driver->antialiasing;
+
+    lv_draw_img(draw_ctx, &draw_dsc, &coords, img);
+}
+#endif
+
+#if LV_USE_OCCLUSION_CULL
+/**
+ * Find the objects of an area which are covered by opaque objects drawn later.
+ * The objects are visited in the reverse order of drawing, so when an object is reached
+ * all the opaque areas above it are already known.
+ * @param area_p    the area to be refreshed
+ */
+static void occl_update(const lv_area_t * area_p)
+{
+    occluder_cnt = 0;
+    occl_visible_cnt = 0;
+    occl_stats.area_px += lv_area_get_size(area_p);
+
+    refr_top_objs_t tops;
+    refr_get_top_objs(area_p, &tops);
+
+    /*The display background is drawn too*/
+    if(tops.act_scr == NULL && tops.prev_scr == NULL) occl_stats.drawn_px += lv_area_get_size(area_p);
+
+    lv_obj_t * top_act_scr = tops.act_scr ? tops.act_scr : disp_refr->act_scr;
+    lv_obj_t * top_prev_scr = tops.prev_scr ? tops.prev_scr : disp_refr->prev_scr;
+
+    lv_obj_t * layers[4];
+    uint32_t layer_cnt = 0;
+    layers[layer_cnt++] = lv_disp_get_layer_sys(disp_refr);
+    layers[layer_cnt++] = lv_disp_get_layer_top(disp_refr);
+    if(disp_refr->draw_prev_over_act) {
+        if(top_prev_scr) layers[layer_cnt++] = top_prev_scr;
+        layers[layer_cnt++] = top_act_scr;
+    }
+    else {
+        layers[layer_cnt++] = top_act_scr;
+        if(top_prev_scr) layers[layer_cnt++] = top_prev_scr;
+    }
+
+    /*Same as `refr_obj_and_children` backwards*/
+    uint32_t i;
+    for(i = 0; i < layer_cnt; i++) {
+        occl_younger_siblings(layers[i], area_p);
+        occl_obj(layers[i], area_p, area_p, false);
+    }
+}
+
+/**
+ * Visit the younger siblings of an object and of its parents, from the screen inwards
+ * @param obj       the top object of a screen
+ * @param clip      the area to be refreshed
+ */
+static void occl_younger_siblings(lv_obj_t * obj, const lv_area_t * clip)
+{
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    if(parent == NULL) return;
+
+    /*The younger siblings of the parent are drawn later*/
+    occl_younger_siblings(parent, clip);
+
+    int32_t id = lv_obj_get_index(obj);
+    int32_t i;
+    for(i = lv_obj_get_child_cnt(parent) - 1; i > id; i--) {
+        occl_obj(parent->spec_attr->children[i], clip, clip, false);
+    }
+}
+
+/**
+ * Cull or clip an object covered by the known opaque areas, visit its children
+ * and add its own opaque area.
+ * @param obj           the object to visit
+ * @param clip          the area where the object would be drawn (as in `lv_obj_redraw`)
+ * @param clip_full     the same without culling, for the statistics
+ * @param masked        true: a parent masks the children (e.g. clip corner), they can't cover anything
+ */
+static void occl_obj(lv_obj_t * obj, const lv_area_t * clip, const lv_area_t * clip_full, bool masked)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    lv_area_t obj_coords_ext;
+    lv_obj_get_coords(obj, &obj_coords_ext);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
+    lv_area_t area;
+    lv_area_t area_full;
+    bool visible = _lv_area_intersect(&area, clip, &obj_coords_ext);
+    bool visible_full = _lv_area_intersect(&area_full, clip_full, &obj_coords_ext);
+    bool overflow = lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+
+    /*Transformed or semi-transparent objects and their children are drawn into a layer: leave them as they are*/
+    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) {
+        if(visible) occl_stats.drawn_px += lv_area_get_size(&area);
+        if(visible_full) occl_stats.culled_px += lv_area_get_size(&area_full) - (visible ? lv_area_get_size(&area) : 0);
+        return;
+    }
+
+    lv_area_t clip_children;
+    lv_area_t clip_children_full;
+    bool refr_children = true;
+    bool count_children = true;
+    if(overflow) {
+        /*The children can be anywhere, it's not known what to skip*/
+        clip_children = *clip;
+        clip_children_full = *clip_full;
+    }
+    else {
+        if(!visible_full) return;
+        if(!visible) {
+            occl_count_culled(obj, clip_full);
+            return;
+        }
+
+        lv_area_t visible_area = area;
+        bool covered = occl_trim(&visible_area) == false;
+        bool trimmed = !covered && !_lv_area_is_in(&area, &visible_area, 0);
+        if((covered || trimmed) && occl_visible_cnt < LV_OCCLUSION_CULL_MAX_OBJ) {
+            occl_visible_t * v = &occl_visible[occl_visible_cnt];
+            occl_visible_cnt++;
+            v->obj = obj;
+            if(covered) {
+                lv_area_set(&v->area, 0, 0, -1, -1);
+                occl_count_culled(obj, clip_full);
+                return;
+            }
+            v->area = visible_area;
+            area = visible_area;
+        }
+
+        refr_children = _lv_area_intersect(&clip_children, &area, &obj->coords);
+        count_children = _lv_area_intersect(&clip_children_full, clip_full, &obj->coords);
+    }
+
+    if(visible) occl_stats.drawn_px += lv_area_get_size(&area);
+    if(visible_full) occl_stats.culled_px += lv_area_get_size(&area_full) - (visible ? lv_area_get_size(&area) : 0);
+
+    /*Only the fully opaque middle part of rounded objects covers*/
+    lv_area_t cover_area = obj->coords;
+    lv_coord_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    lv_coord_t short_side = LV_MIN(lv_area_get_width(&obj->coords), lv_area_get_height(&obj->coords));
+    r = LV_MIN(r, short_side / 2);
+    cover_area.y1 += r;
+    cover_area.y2 -= r;
+    bool can_cover = !masked && visible && _lv_area_intersect(&cover_area, &cover_area, &area);
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_NOT_COVER;
+    if(!masked) {
+        info.res = LV_COVER_RES_COVER;
+        info.area = can_cover ? &cover_area : &obj->coords;
+        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+    }
+
+    bool masked_children = masked || info.res == LV_COVER_RES_MASKED;
+    int32_t i;
+    for(i = lv_obj_get_child_cnt(obj) - 1; i >= 0; i--) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(refr_children) occl_obj(child, &clip_children, &clip_children_full, masked_children);
+        else if(count_children) occl_count_culled(child, &clip_children_full);
+    }
+
+    if(can_cover && info.res == LV_COVER_RES_COVER) occl_add(&cover_area);
+}
+
+/**
+ * Add the drawn area of an object and its children to the culled statistics
+ * @param obj       a fully covered object
+ * @param clip      the area where the object would be drawn
+ */
+static void occl_count_culled(lv_obj_t * obj, const lv_area_t * clip)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&area, ext_draw_size, ext_draw_size);
+    if(_lv_area_intersect(&area, clip, &area)) occl_stats.culled_px += lv_area_get_size(&area);
+
+    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return;
+
+    lv_area_t clip_children;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) clip_children = *clip;
+    else if(!_lv_area_intersect(&clip_children, clip, &obj->coords)) return;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        occl_count_culled(obj->spec_attr->children[i], &clip_children);
+    }
+}
+
+/**
+ * Remove the covered sides of an area
+ * @param area      the area to drawn, the covered parts are cut off from it
+ * @return          false: the area is fully covered
+ */
+static bool occl_trim(lv_area_t * area)
+{
+    if(!occl_enabled) return true;
+
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        uint32_t i;
+        for(i = 0; i < occluder_cnt; i++) {
+            const lv_area_t * o = &occluders[i];
+            if(!_lv_area_is_on(area, o)) continue;
+            if(_lv_area_is_in(area, o, 0)) return false;
+
+            /*If a whole side is covered the area becomes smaller*/
+            if(o->x1 <= area->x1 && o->x2 >= area->x2) {
+                if(o->y1 <= area->y1) area->y1 = o->y2 + 1;
+                else if(o->y2 >= area->y2) area->y2 = o->y1 - 1;
+                else continue;
+                changed = true;
+            }
+            else if(o->y1 <= area->y1 && o->y2 >= area->y2) {
+                if(o->x1 <= area->x1) area->x1 = o->x2 + 1;
+                else if(o->x2 >= area->x2) area->x2 = o->x1 - 1;
+                else continue;
+                changed = true;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Add an opaque area. If there are too many the smallest one is dropped.
+ * @param area      an area fully covered by an object
+ */
+static void occl_add(const lv_area_t * area)
+{
+    if(occluder_cnt < OCCLUDER_MAX) {
+        occluders[occluder_cnt] = *area;
+        occluder_cnt++;
+        return;
+    }
+
+    uint32_t min_i = 0;
+    uint32_t i;
+    for(i = 1; i < OCCLUDER_MAX; i++) {
+        if(lv_area_get_size(&occluders[i]) < lv_area_get_size(&occluders[min_i])) min_i = i;
+    }
+
+    if(lv_area_get_size(area) > lv_area_get_size(&occluders[min_i])) occluders[min_i] = *area;
+}
+
+/**
+ * Get the part of an object which is not covered by opaque objects drawn later
+ * @param obj       the object being drawn
+ * @return          the visible part or NULL if nothing is covered
+ */
+static const lv_area_t * occl_get_visible(const lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = 0; i < occl_visible_cnt; i++) {
+        if(occl_visible[i].obj == obj) return &occl_visible[i].area;
+    }
+    return NULL;
+}
+#endif
+
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h)
 {
     int32_t max_row = (uint32_t)disp->driver->draw_buf->size / area_w;
@@ -1171,9 +1734,11 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             /*Flush the completed area to the display*/
             call_flush_cb(drv, area, rot_buf == NULL ? color_p : rot_buf);
             /*FIXME: Rotation forces legacy behavior where rendering and flushing are done serially*/
+            LV_TRACE_BEGIN("wait_flush");
             while(draw_buf->flushing) {
                 if(drv->wait_cb) drv->wait_cb(drv);
             }
+            LV_TRACE_END();
             color_p += area_w * height;
             row += height;
         }
@@ -1197,9 +1762,11 @@ static void draw_buf_flush(lv_disp_t * disp)
      * and driver is ready to receive the new buffer */
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if(draw_buf->buf1 && draw_buf->buf2 && !full_sized) {
+        LV_TRACE_BEGIN("wait_flush");
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+        LV_TRACE_END();
     }
 
     draw_buf->flushing = 1;
@@ -1243,7 +1810,9 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+    LV_TRACE_BEGIN("flush_cb");
     drv->flush_cb(drv, &offset_area, color_p);
+    LV_TRACE_END();
 }
 
 #if LV_USE_PERF_MONITOR
@@ -1268,3 +1837,47 @@ static void mem_monitor_init(mem_monitor_t * _mem_monitor)
 }
 #endif
 
+
+#if LV_USE_TRACE && LV_USE_TRACE_BAR
+/**
+ * Draw the breakdown of the slowest recent frame: layout, rendering, flush_cb and waiting for the flush.
+ * The full width is two refresh periods and the white mark is at one period.
+ */
+static void trace_bar_draw_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+
+    uint32_t period = disp->refr_timer ? disp->refr_timer->period : LV_DISP_DEF_REFR_PERIOD;
+    uint32_t full = LV_MAX(period, 1) * 2000;
+    lv_coord_t w = lv_obj_get_width(obj);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_black();
+    dsc.bg_opa = LV_OPA_50;
+    lv_draw_rect(draw_ctx, &dsc, &obj->coords);
+
+    const uint32_t times[] = {trace_bar_frame.layout, trace_bar_frame.render, trace_bar_frame.flush, trace_bar_frame.wait};
+    const uint32_t colors[] = {0x2196F3, 0x4CAF50, 0xFF9800, 0xF44336};
+    dsc.bg_opa = LV_OPA_COVER;
+
+    lv_area_t a = obj->coords;
+    uint32_t i;
+    for(i = 0; i < sizeof(times) / sizeof(times[0]); i++) {
+        lv_coord_t seg_w = (lv_coord_t)(((uint64_t)LV_MIN(times[i], full) * w) / full);
+        if(seg_w <= 0) continue;
+        a.x2 = LV_MIN(a.x1 + seg_w - 1, obj->coords.x2);
+        dsc.bg_color = lv_color_hex(colors[i]);
+        lv_draw_rect(draw_ctx, &dsc, &a);
+        a.x1 = a.x2 + 1;
+        if(a.x1 > obj->coords.x2) break;
+    }
+
+    a.x1 = obj->coords.x1 + w / 2;
+    a.x2 = a.x1 + 1;
+    dsc.bg_color = lv_color_white();
+    lv_draw_rect(draw_ctx, &dsc, &a);
+}
+#endif
@@ -26,6 +26,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_OCCLUSION_CULL
+/**
+ * Overdraw statistics of a refreshed frame
+ */
+typedef struct {
+    uint32_t area_px;       /*Size of the refreshed areas*/
+    uint32_t drawn_px;      /*Sum of the drawn areas of the objects. `drawn_px / area_px` is the overdraw.*/
+    uint32_t culled_px;     /*Sum of the areas not drawn because opaque objects drawn later covered them*/
+} lv_refr_occlusion_stats_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -98,6 +109,22 @@ void lv_refr_reset_fps_counter(void);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+#if LV_USE_OCCLUSION_CULL
+/**
+ * Enable or disable skipping the objects covered by opaque objects drawn later (enabled by default).
+ * The statistics are collected in both cases.
+ * @param en    true: enable; false: draw all objects
+ */
+void lv_refr_occlusion_cull_enable(bool en);
+
+/**
+ * Get the overdraw statistics of the last refreshed frame. They are also added to the trace
+ * as the "overdraw %" and "culled px" counters.
+ * @param stats     the result is written here
+ */
+void lv_refr_get_occlusion_stats(lv_refr_occlusion_stats_t * stats);
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
@@ -0,0 +1,397 @@
+/**
+ * @file lv_trace.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_trace.h"
+
+#if LV_USE_TRACE
+
+#include "../../lvgl.h"
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+    #include "esp_timer.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if defined(ESP_PLATFORM)
+    #define TRACE_TIME()    ((uint32_t)esp_timer_get_time())
+#else
+    #define TRACE_TIME()    (lv_tick_get() * 1000)
+#endif
+
+#if defined(__GNUC__)
+    #define TRACE_BARRIER() __sync_synchronize()
+#else
+    #define TRACE_BARRIER()
+#endif
+
+#define EXPORT_BUF_SIZE     256
+#define FRAME_MAX_DEPTH     32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t ts;                                /*Time stamp [us], wraps around*/
+    const char * name;
+    const struct _lv_obj_class_t * class_p;
+    int32_t value;                              /*Of counters*/
+    lv_trace_ph_t ph;
+} lv_trace_event_t;
+
+typedef struct {
+    const lv_obj_class_t * class_p;
+    const char * name;
+} lv_trace_class_name_t;
+
+typedef struct {
+    lv_trace_write_cb_t write_cb;
+    void * user_data;
+    char buf[EXPORT_BUF_SIZE];
+    uint32_t len;
+    bool error;
+} lv_trace_export_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static const char * class_name(const lv_obj_class_t * class_p);
+static void export_write(lv_trace_export_t * exp, const char * str);
+static void export_flush(lv_trace_export_t * exp);
+static lv_res_t file_write_cb(const char * buf, uint32_t len, void * user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/*Single producer ring buffer: only LVGL's thread writes it, `head` is the number of events ever written*/
+static lv_trace_event_t events[LV_TRACE_BUF_SIZE];
+static volatile uint32_t head;
+static volatile bool running;
+
+static uint32_t frame_start;
+static lv_fs_file_t export_file;
+static lv_trace_frame_t worst_frame;
+
+#define CLASS_NAME(n) {&lv_##n##_class, #n}
+static const lv_trace_class_name_t class_names[] = {
+    CLASS_NAME(obj),
+#if LV_USE_ARC
+    CLASS_NAME(arc),
+#endif
+#if LV_USE_BAR
+    CLASS_NAME(bar),
+#endif
+#if LV_USE_BTN
+    CLASS_NAME(btn),
+#endif
+#if LV_USE_BTNMATRIX
+    CLASS_NAME(btnmatrix),
+#endif
+#if LV_USE_CANVAS
+    CLASS_NAME(canvas),
+#endif
+#if LV_USE_CHECKBOX
+    CLASS_NAME(checkbox),
+#endif
+#if LV_USE_IMG
+    CLASS_NAME(img),
+#endif
+#if LV_USE_LABEL
+    CLASS_NAME(label),
+#endif
+#if LV_USE_LINE
+    CLASS_NAME(line),
+#endif
+#if LV_USE_ROLLER
+    CLASS_NAME(roller),
+#endif
+#if LV_USE_SLIDER
+    CLASS_NAME(slider),
+#endif
+#if LV_USE_SWITCH
+    CLASS_NAME(switch),
+#endif
+#if LV_USE_TEXTAREA
+    CLASS_NAME(textarea),
+#endif
+#if LV_USE_TABLE
+    CLASS_NAME(table),
+#endif
+#if LV_USE_CHART
+    CLASS_NAME(chart),
+#endif
+#if LV_USE_KEYBOARD
+    CLASS_NAME(keyboard),
+#endif
+#if LV_USE_LED
+    CLASS_NAME(led),
+#endif
+#if LV_USE_LIST
+    CLASS_NAME(list),
+    CLASS_NAME(list_btn),
+    CLASS_NAME(list_text),
+#endif
+#if LV_USE_METER
+    CLASS_NAME(meter),
+#endif
+#if LV_USE_MSGBOX
+    CLASS_NAME(msgbox),
+#endif
+#if LV_USE_SPINNER
+    CLASS_NAME(spinner),
+#endif
+#if LV_USE_TABVIEW
+    CLASS_NAME(tabview),
+#endif
+#if LV_USE_TILEVIEW
+    CLASS_NAME(tileview),
+#endif
+#if LV_USE_WIN
+    CLASS_NAME(win),
+#endif
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_trace_start(void)
+{
+    lv_trace_clear();
+    running = true;
+}
+
+void lv_trace_stop(void)
+{
+    running = false;
+}
+
+bool lv_trace_is_running(void)
+{
+    return running;
+}
+
+void lv_trace_clear(void)
+{
+    head = 0;
+    frame_start = 0;
+    lv_memset_00(&worst_frame, sizeof(worst_frame));
+}
+
+void _lv_trace_record(lv_trace_ph_t ph, const char * name, const struct _lv_obj_class_t * class_p)
+{
+    if(!running) return;
+
+    uint32_t h = head;
+    lv_trace_event_t * e = &events[h % LV_TRACE_BUF_SIZE];
+    e->ts = TRACE_TIME();
+    e->name = name;
+    e->class_p = class_p;
+    e->ph = ph;
+
+    /*Publish the event only when it's completely written*/
+    TRACE_BARRIER();
+    head = h + 1;
+}
+
+void _lv_trace_counter(const char * name, int32_t value)
+{
+    if(!running) return;
+
+    uint32_t h = head;
+    lv_trace_event_t * e = &events[h % LV_TRACE_BUF_SIZE];
+    e->ts = TRACE_TIME();
+    e->name = name;
+    e->class_p = NULL;
+    e->value = value;
+    e->ph = LV_TRACE_PH_COUNTER;
+
+    TRACE_BARRIER();
+    head = h + 1;
+}
+
+uint32_t lv_trace_export(lv_trace_write_cb_t write_cb, void * user_data)
+{
+    lv_trace_export_t exp;
+    exp.write_cb = write_cb;
+    exp.user_data = user_data;
+    exp.len = 0;
+    exp.error = false;
+
+    uint32_t h = head;
+    uint32_t i = h > LV_TRACE_BUF_SIZE ? h - LV_TRACE_BUF_SIZE : 0;
+    uint32_t cnt = 0;
+    uint32_t ts_start = 0;
+
+    export_write(&exp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for(; i < h && !exp.error; i++) {
+        lv_trace_event_t e = events[i % LV_TRACE_BUF_SIZE];
+
+        /*Skip the event if the producer overwrote it while it was copied*/
+        TRACE_BARRIER();
+        if(head - i > LV_TRACE_BUF_SIZE) continue;
+
+        if(cnt == 0) ts_start = e.ts;
+
+        char line[128];
+        uint32_t ts = e.ts - ts_start;
+        if(e.ph == LV_TRACE_PH_BEGIN) {
+            const char * name = e.class_p ? class_name(e.class_p) : e.name;
+            lv_snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"B\",\"pid\":1,\"tid\":1,\"ts\":%"LV_PRIu32"}",
+                        cnt ? ",\n" : "", name, e.class_p ? "obj" : "lvgl", ts);
+        }
+        else if(e.ph == LV_TRACE_PH_COUNTER) {
+            lv_snprintf(line, sizeof(line),
+                        "%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":%"LV_PRIu32",\"args\":{\"value\":%"LV_PRId32"}}",
+                        cnt ? ",\n" : "", e.name, ts, e.value);
+        }
+        else {
+            lv_snprintf(line, sizeof(line), "%s{\"ph\":\"E\",\"pid\":1,\"tid\":1,\"ts\":%"LV_PRIu32"}",
+                        cnt ? ",\n" : "", ts);
+        }
+        export_write(&exp, line);
+        cnt++;
+    }
+    export_write(&exp, "\n]}\n");
+    export_flush(&exp);
+
+    return cnt;
+}
+
+lv_res_t lv_trace_export_to_file(const char * path)
+{
+    lv_fs_res_t res = lv_fs_open(&export_file, path, LV_FS_MODE_WR);
+    if(res != LV_FS_RES_OK) {
+        LV_LOG_WARN("can't open %s", path);
+        return LV_RES_INV;
+    }
+
+    bool error = false;
+    lv_trace_export(file_write_cb, &error);
+    lv_fs_close(&export_file);
+
+    return error ? LV_RES_INV : LV_RES_OK;
+}
+
+void lv_trace_get_worst_frame(lv_trace_frame_t * frame)
+{
+    *frame = worst_frame;
+    lv_memset_00(&worst_frame, sizeof(worst_frame));
+}
+
+void _lv_trace_frame_begin(void)
+{
+    frame_start = head;
+}
+
+void _lv_trace_frame_end(void)
+{
+    if(!running) return;
+
+    uint32_t h = head;
+    uint32_t i = frame_start;
+    if(h - i > LV_TRACE_BUF_SIZE) i = h - LV_TRACE_BUF_SIZE;
+
+    /*Match the begin and end events and sum the time of the interesting spans*/
+    const char * stack_name[FRAME_MAX_DEPTH];
+    uint32_t stack_ts[FRAME_MAX_DEPTH];
+    uint32_t depth = 0;
+    uint32_t refr_area = 0;
+    lv_trace_frame_t frame;
+    lv_memset_00(&frame, sizeof(frame));
+
+    for(; i < h; i++) {
+        const lv_trace_event_t * e = &events[i % LV_TRACE_BUF_SIZE];
+        if(e->ph == LV_TRACE_PH_BEGIN) {
+            if(depth < FRAME_MAX_DEPTH) {
+                stack_name[depth] = e->name;
+                stack_ts[depth] = e->ts;
+            }
+            depth++;
+        }
+        else if(e->ph == LV_TRACE_PH_END && depth > 0) {
+            depth--;
+            if(depth >= FRAME_MAX_DEPTH) continue;
+            uint32_t d = e->ts - stack_ts[depth];
+            const char * name = stack_name[depth];
+            if(name == NULL) continue;  /*Object spans*/
+            if(strcmp(name, "layout") == 0) frame.layout += d;
+            else if(strcmp(name, "refr_area") == 0) refr_area += d;
+            else if(strcmp(name, "flush_cb") == 0) frame.flush += d;
+            else if(strcmp(name, "wait_flush") == 0) frame.wait += d;
+        }
+    }
+
+    /*Flushing and waiting happen inside `refr_area`*/
+    if(refr_area > frame.flush + frame.wait) frame.render = refr_area - frame.flush - frame.wait;
+
+    uint32_t total = frame.layout + frame.render + frame.flush + frame.wait;
+    uint32_t worst = worst_frame.layout + worst_frame.render + worst_frame.flush + worst_frame.wait;
+    if(total >= worst) worst_frame = frame;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the name of a class. Classes not in the list (e.g. custom widgets) get the name of their
+ * first known ancestor class.
+ */
+static const char * class_name(const lv_obj_class_t * class_p)
+{
+    while(class_p) {
+        uint32_t i;
+        for(i = 0; i < sizeof(class_names) / sizeof(class_names[0]); i++) {
+            if(class_names[i].class_p == class_p) return class_names[i].name;
+        }
+        class_p = class_p->base_class;
+    }
+    return "unknown";
+}
+
+static void export_write(lv_trace_export_t * exp, const char * str)
+{
+    uint32_t len = strlen(str);
+    if(exp->len + len > EXPORT_BUF_SIZE) export_flush(exp);
+
+    lv_memcpy(&exp->buf[exp->len], str, len);
+    exp->len += len;
+}
+
+static void export_flush(lv_trace_export_t * exp)
+{
+    if(exp->len == 0 || exp->error) {
+        exp->len = 0;
+        return;
+    }
+
+    if(exp->write_cb(exp->buf, exp->len, exp->user_data) != LV_RES_OK) exp->error = true;
+    exp->len = 0;
+}
+
+static lv_res_t file_write_cb(const char * buf, uint32_t len, void * user_data)
+{
+    bool * error = user_data;
+    uint32_t bw;
+    lv_fs_res_t res = lv_fs_write(&export_file, buf, len, &bw);
+    if(res != LV_FS_RES_OK || bw != len) {
+        LV_LOG_WARN("couldn't write the trace");
+        *error = true;
+        return LV_RES_INV;
+    }
+    return LV_RES_OK;
+}
+
+#endif /*LV_USE_TRACE*/
@@ -0,0 +1,153 @@
+/**
+ * @file lv_trace.h
+ *
+ */
+
+#ifndef LV_TRACE_H
+#define LV_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if LV_USE_TRACE
+
+#include "../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_class_t;
+
+enum {
+    LV_TRACE_PH_BEGIN,
+    LV_TRACE_PH_END,
+    LV_TRACE_PH_COUNTER,
+};
+typedef uint8_t lv_trace_ph_t;
+
+/**
+ * Receives a piece of the exported JSON text
+ * @param buf           the text, not '\0' terminated
+ * @param len           length of the text in bytes
+ * @param user_data     the `user_data` passed to `lv_trace_export`
+ * @return              LV_RES_OK: continue; LV_RES_INV: stop the export
+ */
+typedef lv_res_t (*lv_trace_write_cb_t)(const char * buf, uint32_t len, void * user_data);
+
+/**
+ * Time spent in the main parts of a refreshed frame, in microseconds
+ */
+typedef struct {
+    uint32_t layout;
+    uint32_t render;        /*`refr_area` without the time spent in `flush_cb` and waiting for the flush*/
+    uint32_t flush;
+    uint32_t wait;
+} lv_trace_frame_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start recording. The events are written into a ring buffer of `LV_TRACE_BUF_SIZE` entries,
+ * so only the last events are kept.
+ */
+void lv_trace_start(void);
+
+/**
+ * Stop recording. The recorded events are kept until `lv_trace_clear` or the next `lv_trace_start`.
+ */
+void lv_trace_stop(void);
+
+/**
+ * Tell whether events are being recorded
+ * @return      true: recording
+ */
+bool lv_trace_is_running(void);
+
+/**
+ * Drop the recorded events
+ */
+void lv_trace_clear(void);
+
+/**
+ * Export the recorded events in Chrome trace-event JSON format (open it in `chrome://tracing` or Perfetto).
+ * Recording doesn't need to be stopped and this function can be called from an other thread than LVGL's:
+ * the events overwritten during the export are skipped.
+ * @param write_cb      called with the consecutive pieces of the JSON text
+ * @param user_data     passed to `write_cb`
+ * @return              number of exported events
+ */
+uint32_t lv_trace_export(lv_trace_write_cb_t write_cb, void * user_data);
+
+/**
+ * Export the recorded events into a file with LVGL's file system interface, e.g. "S:/trace.json"
+ * @param path      path to the file, including the drive letter
+ * @return          LV_RES_OK: the file was written; LV_RES_INV: error
+ */
+lv_res_t lv_trace_export_to_file(const char * path);
+
+/**
+ * Get the breakdown of the slowest frame refreshed since the previous call. Used by the trace bar overlay.
+ * @param frame     the result is written here
+ */
+void lv_trace_get_worst_frame(lv_trace_frame_t * frame);
+
+/**
+ * Record the beginning or the end of a span. Use the `LV_TRACE_...` macros instead.
+ * @param ph        LV_TRACE_PH_BEGIN or LV_TRACE_PH_END
+ * @param name      name of the span, must be a string constant. Not used with LV_TRACE_PH_END.
+ * @param class_p   if not NULL the span is named after this widget class
+ */
+void _lv_trace_record(lv_trace_ph_t ph, const char * name, const struct _lv_obj_class_t * class_p);
+
+/**
+ * Record the value of a counter. Use `LV_TRACE_COUNTER` instead.
+ * @param name      name of the counter, must be a string constant
+ * @param value     the current value
+ */
+void _lv_trace_counter(const char * name, int32_t value);
+
+/**
+ * Mark the beginning and the end of a refreshed frame. Called by `_lv_disp_refr_timer`.
+ */
+void _lv_trace_frame_begin(void);
+void _lv_trace_frame_end(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_TRACE_BEGIN(name)        _lv_trace_record(LV_TRACE_PH_BEGIN, name, NULL)
+#define LV_TRACE_OBJ_BEGIN(obj)     _lv_trace_record(LV_TRACE_PH_BEGIN, NULL, (obj)->class_p)
+#define LV_TRACE_END()              _lv_trace_record(LV_TRACE_PH_END, NULL, NULL)
+#define LV_TRACE_COUNTER(name, value)   _lv_trace_counter(name, value)
+
+#else /*LV_USE_TRACE*/
+
+#define LV_TRACE_BEGIN(name)
+#define LV_TRACE_OBJ_BEGIN(obj)
+#define LV_TRACE_END()
+#define LV_TRACE_COUNTER(name, value)
+
+#endif /*LV_USE_TRACE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TRACE_H*/
@@ -39,7 +39,9 @@
 
 void lv_draw_init(void)
 {
-    /*Nothing to init now*/
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_init();
+#endif
 }
 
 void lv_draw_wait_for_finish(lv_draw_ctx_t * draw_ctx)
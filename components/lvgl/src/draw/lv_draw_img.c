@@ -11,6 +11,7 @@
 #include "../hal/lv_hal_disp.h"
 #include "../misc/lv_log.h"
 #include "../core/lv_refr.h"
+#include "../core/lv_trace.h"
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
 
@@ -74,6 +75,7 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
 
     lv_res_t res = LV_RES_INV;
 
+    LV_TRACE_BEGIN("draw_img");
     if(draw_ctx->draw_img) {
         res = draw_ctx->draw_img(draw_ctx, dsc, coords, src);
     }
@@ -81,6 +83,7 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
     if(res != LV_RES_OK) {
         res = decode_and_draw(draw_ctx, dsc, coords, src);
     }
+    LV_TRACE_END();
 
     if(res != LV_RES_OK) {
         LV_LOG_WARN("Image draw error");
@@ -11,6 +11,7 @@
 #include "../misc/lv_math.h"
 #include "../hal/lv_hal_disp.h"
 #include "../core/lv_refr.h"
+#include "../core/lv_trace.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
 
@@ -101,6 +102,8 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, draw_ctx->clip_area);
     if(!clip_ok) return;
 
+    LV_TRACE_BEGIN("draw_label");
+
     lv_text_align_t align = dsc->align;
     lv_base_dir_t base_dir = dsc->bidi_dir;
 
@@ -167,7 +170,10 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
             hint->coord_y    = coords->y1;
         }
 
-        if(txt[line_start] == '\0') return;
+        if(txt[line_start] == '\0') {
+            LV_TRACE_END();
+            return;
+        }
     }
 
     /*Align to middle*/
@@ -355,9 +361,11 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         /*Go the next line position*/
         pos.y += line_height;
 
-        if(pos.y > draw_ctx->clip_area->y2) return;
+        if(pos.y > draw_ctx->clip_area->y2) break;
     }
 
+    LV_TRACE_END();
+
     LV_ASSERT_MEM_INTEGRITY();
 }
 
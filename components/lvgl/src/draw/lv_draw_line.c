@@ -8,6 +8,7 @@
  *********************/
 #include <stdbool.h>
 #include "../core/lv_refr.h"
+#include "../core/lv_trace.h"
 #include "../misc/lv_math.h"
 
 /*********************
@@ -48,7 +49,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_line(struct _lv_draw_ctx_t * draw_ctx, const
     if(dsc->width == 0) return;
     if(dsc->opa <= LV_OPA_MIN) return;
 
+    LV_TRACE_BEGIN("draw_line");
     draw_ctx->draw_line(draw_ctx, dsc, point1, point2);
+    LV_TRACE_END();
 }
 
 /**********************
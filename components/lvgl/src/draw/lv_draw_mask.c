@@ -17,8 +17,15 @@
  *      DEFINES
  *********************/
 #define CIRCLE_CACHE_LIFE_MAX   1000
+#define CIRCLE_CACHE_LIFE_PRESET    INT32_MAX
 #define CIRCLE_CACHE_AGING(life, r)   life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
 
+/*A radius can be stored only in this many entries starting from its hash*/
+#define CIRCLE_CACHE_WAYS       LV_MIN(4, LV_CIRCLE_CACHE_SIZE)
+#define CIRCLE_BUF_SIZE(r)      ((r) * 6 + 6)
+
+#define CIRCLE_PRESETS  LV_GC_ROOT(_lv_circle_presets)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -56,6 +63,9 @@ static void circ_init(lv_point_t * c, lv_coord_t * tmp, lv_coord_t radius);
 static bool circ_cont(lv_point_t * c);
 static void circ_next(lv_point_t * c, lv_coord_t * tmp);
 static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radius);
+static _lv_draw_mask_radius_circle_dsc_t * circle_cache_get(lv_coord_t radius);
+static void circle_cache_free(_lv_draw_mask_radius_circle_dsc_t * c);
+static void circle_preset_add_list(const char * radii);
 static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t y, lv_coord_t * len,
                                 lv_coord_t * x_start);
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
@@ -63,6 +73,7 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t circle_cache_size;     /*Size of the cached circles' buffers*/
 
 /**********************
  *      MACROS
@@ -217,7 +228,7 @@ void lv_draw_mask_free_param(void * p)
                 lv_mem_free(radius_p->circle->cir_opa);
                 lv_mem_free(radius_p->circle);
             }
-            else {
+            else if(radius_p->circle->life != CIRCLE_CACHE_LIFE_PRESET) {
                 radius_p->circle->used_cnt--;
             }
         }
@@ -228,6 +239,11 @@ void lv_draw_mask_free_param(void * p)
     }
 }
 
+void _lv_draw_mask_init(void)
+{
+    circle_preset_add_list(LV_CIRCLE_CACHE_PRESET_RADII);
+}
+
 void _lv_draw_mask_cleanup(void)
 {
     uint8_t i;
@@ -237,6 +253,33 @@ void _lv_draw_mask_cleanup(void)
         }
         lv_memset_00(&LV_GC_ROOT(_lv_circle_cache[i]), sizeof(LV_GC_ROOT(_lv_circle_cache[i])));
     }
+    circle_cache_size = 0;
+
+    for(i = 0; i < _LV_CIRCLE_PRESET_MAX; i++) {
+        if(CIRCLE_PRESETS[i].buf) {
+            lv_mem_free(CIRCLE_PRESETS[i].buf);
+        }
+        lv_memset_00(&CIRCLE_PRESETS[i], sizeof(CIRCLE_PRESETS[i]));
+    }
+}
+
+void lv_draw_mask_circle_preset_add(lv_coord_t radius)
+{
+    if(radius <= 0) return;
+
+    uint32_t i;
+    for(i = 0; i < _LV_CIRCLE_PRESET_MAX; i++) {
+        if(CIRCLE_PRESETS[i].radius == radius) return;
+        if(CIRCLE_PRESETS[i].radius == 0) break;
+    }
+
+    if(i == _LV_CIRCLE_PRESET_MAX) {
+        LV_LOG_WARN("no place for a new circle preset (_LV_CIRCLE_PRESET_MAX)");
+        return;
+    }
+
+    circ_calc_aa4(&CIRCLE_PRESETS[i], radius);
+    CIRCLE_PRESETS[i].life = CIRCLE_CACHE_LIFE_PRESET;
 }
 
 /**
@@ -490,42 +533,7 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
         return;
     }
 
-    uint32_t i;
-
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).radius == radius) {
-            LV_GC_ROOT(_lv_circle_cache[i]).used_cnt++;
-            CIRCLE_CACHE_AGING(LV_GC_ROOT(_lv_circle_cache[i]).life, radius);
-            param->circle = &LV_GC_ROOT(_lv_circle_cache[i]);
-            return;
-        }
-    }
-
-    /*If not found find a free entry with lowest life*/
-    _lv_draw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).used_cnt == 0) {
-            if(!entry) entry = &LV_GC_ROOT(_lv_circle_cache[i]);
-            else if(LV_GC_ROOT(_lv_circle_cache[i]).life < entry->life) entry = &LV_GC_ROOT(_lv_circle_cache[i]);
-        }
-    }
-
-    if(!entry) {
-        entry = lv_mem_alloc(sizeof(_lv_draw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        lv_memset_00(entry, sizeof(_lv_draw_mask_radius_circle_dsc_t));
-        entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
-    }
-
-    param->circle = entry;
-
-    circ_calc_aa4(param->circle, radius);
+    param->circle = circle_cache_get(radius);
 }
 
 /**
@@ -1369,7 +1377,7 @@ static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radi
     /*Allocate buffers*/
     if(c->buf) lv_mem_free(c->buf);
 
-    c->buf = lv_mem_alloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+    c->buf = lv_mem_alloc(CIRCLE_BUF_SIZE(radius));  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
     LV_ASSERT_MALLOC(c->buf);
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
@@ -1509,6 +1517,106 @@ static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radi
     lv_mem_buf_release(cir_x);
 }
 
+/**
+ * Get the circle data of a radius from the presets or the cache.
+ * Calculate it if not cached.
+ * @param radius    the radius of the circle
+ * @return          the circle data. Its `life` is negative if it's a temporary entry which need to be freed.
+ */
+static _lv_draw_mask_radius_circle_dsc_t * circle_cache_get(lv_coord_t radius)
+{
+    uint32_t i;
+    for(i = 0; i < _LV_CIRCLE_PRESET_MAX && CIRCLE_PRESETS[i].radius != 0; i++) {
+        if(CIRCLE_PRESETS[i].radius == radius) return &CIRCLE_PRESETS[i];
+    }
+
+    _lv_draw_mask_radius_circle_dsc_t * entry = NULL;
+#if LV_CIRCLE_CACHE_SIZE > 0
+    /*The radius can be only in a few entries after its hash*/
+    _lv_draw_mask_radius_circle_dsc_t * cache = LV_GC_ROOT(_lv_circle_cache);
+    uint32_t hash = (uint32_t)radius % LV_CIRCLE_CACHE_SIZE;
+    for(i = 0; i < CIRCLE_CACHE_WAYS; i++) {
+        _lv_draw_mask_radius_circle_dsc_t * c = &cache[(hash + i) % LV_CIRCLE_CACHE_SIZE];
+        if(c->radius == radius) {
+            c->used_cnt++;
+            CIRCLE_CACHE_AGING(c->life, radius);
+            return c;
+        }
+    }
+
+    /*If not found use an empty or not used entry with the lowest life from there*/
+    for(i = 0; i < CIRCLE_CACHE_WAYS; i++) {
+        _lv_draw_mask_radius_circle_dsc_t * c = &cache[(hash + i) % LV_CIRCLE_CACHE_SIZE];
+        if(c->used_cnt != 0) continue;
+        if(entry == NULL || c->life < entry->life) entry = c;
+    }
+
+    if(entry) {
+        circle_cache_free(entry);
+
+        /*Free the least used other circles if the new one doesn't fit*/
+        uint32_t size = CIRCLE_BUF_SIZE(radius);
+        while(circle_cache_size + size > LV_CIRCLE_CACHE_BUF_MAX_SIZE) {
+            _lv_draw_mask_radius_circle_dsc_t * lru = NULL;
+            for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
+                if(cache[i].buf == NULL || cache[i].used_cnt != 0) continue;
+                if(lru == NULL || cache[i].life < lru->life) lru = &cache[i];
+            }
+            if(lru == NULL) {
+                entry = NULL;
+                break;
+            }
+            circle_cache_free(lru);
+        }
+    }
+#endif
+
+    if(!entry) {
+        entry = lv_mem_alloc(sizeof(_lv_draw_mask_radius_circle_dsc_t));
+        LV_ASSERT_MALLOC(entry);
+        lv_memset_00(entry, sizeof(_lv_draw_mask_radius_circle_dsc_t));
+        circ_calc_aa4(entry, radius);
+        entry->life = -1;
+    }
+    else {
+        circ_calc_aa4(entry, radius);
+        circle_cache_size += CIRCLE_BUF_SIZE(radius);
+        entry->used_cnt++;
+        entry->life = 0;
+        CIRCLE_CACHE_AGING(entry->life, radius);
+    }
+
+    return entry;
+}
+
+static void circle_cache_free(_lv_draw_mask_radius_circle_dsc_t * c)
+{
+    if(c->buf == NULL) return;
+
+    lv_mem_free(c->buf);
+    circle_cache_size -= CIRCLE_BUF_SIZE(c->radius);
+    lv_memset_00(c, sizeof(_lv_draw_mask_radius_circle_dsc_t));
+}
+
+/**
+ * Add presets from a list like "8,10,16"
+ * @param radii     comma separated list of radii
+ */
+static void circle_preset_add_list(const char * radii)
+{
+    while(*radii) {
+        lv_coord_t r = 0;
+        while(*radii >= '0' && *radii <= '9') {
+            r = r * 10 + (*radii - '0');
+            radii++;
+        }
+        lv_draw_mask_circle_preset_add(r);
+
+        /*Skip the separator*/
+        while(*radii && (*radii < '0' || *radii > '9')) radii++;
+    }
+}
+
 static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t y, lv_coord_t * len,
                                 lv_coord_t * x_start)
 {
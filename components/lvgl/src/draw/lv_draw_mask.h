@@ -29,6 +29,9 @@ extern "C" {
 # define _LV_MASK_MAX_NUM     1
 #endif
 
+/*Max. number of circles added by `lv_draw_mask_circle_preset_add`*/
+#define _LV_CIRCLE_PRESET_MAX   8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -164,6 +167,7 @@ typedef struct  {
 } _lv_draw_mask_radius_circle_dsc_t;
 
 typedef _lv_draw_mask_radius_circle_dsc_t _lv_draw_mask_radius_circle_dsc_arr_t[LV_CIRCLE_CACHE_SIZE];
+typedef _lv_draw_mask_radius_circle_dsc_t _lv_draw_mask_circle_preset_arr_t[_LV_CIRCLE_PRESET_MAX];
 
 typedef struct {
     /*The first element must be the common descriptor*/
@@ -288,11 +292,22 @@ void * lv_draw_mask_remove_custom(void * custom_id);
 void lv_draw_mask_free_param(void * p);
 
 /**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
+ * Called by LVGL in `lv_draw_init` to calculate the circles of `LV_CIRCLE_CACHE_PRESET_RADII`
+ */
+void _lv_draw_mask_init(void);
+
+/**
+ * Called by LVGL in `lv_deinit` to free the cached circles
  */
 void _lv_draw_mask_cleanup(void);
 
+/**
+ * Calculate the anti-aliased circle of a radius once and keep it for all radius masks.
+ * Useful for the radii used by the theme. Should be called before drawing.
+ * @param radius    the radius of the circle
+ */
+void lv_draw_mask_circle_preset_add(lv_coord_t radius);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -0,0 +1,642 @@
+/**
+ * @file lv_draw_rec.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_rec.h"
+
+#if LV_USE_DRAW_REC
+
+#include "lv_draw.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_log.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Keep the commands aligned for the pointers in them*/
+#define CMD_ALIGN(size)     (((size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+#define BUF_SIZE_MIN        1024
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+enum {
+    CMD_RECT,
+    CMD_BG,
+    CMD_ARC,
+    CMD_LABEL_DSC,      /*Descriptor of the next `CMD_LETTER`s*/
+    CMD_LETTER,
+    CMD_IMG,
+    CMD_LINE,
+    CMD_POLYGON,
+    CMD_MASKS,          /*The masks of the next drawing commands*/
+};
+typedef uint8_t cmd_type_t;
+
+typedef struct {
+    cmd_type_t type;
+    uint32_t size;          /*Size of the whole command in bytes*/
+    lv_area_t clip;         /*The clip area when the command was recorded*/
+} cmd_head_t;
+
+typedef struct {
+    cmd_head_t head;
+    lv_draw_rect_dsc_t dsc;
+    lv_area_t coords;
+} cmd_rect_t;
+
+typedef struct {
+    cmd_head_t head;
+    lv_draw_arc_dsc_t dsc;
+    lv_point_t center;
+    uint16_t radius;
+    uint16_t start_angle;
+    uint16_t end_angle;
+} cmd_arc_t;
+
+typedef struct {
+    cmd_head_t head;
+    lv_draw_label_dsc_t dsc;
+} cmd_label_dsc_t;
+
+typedef struct {
+    cmd_head_t head;
+    lv_point_t pos;
+    uint32_t letter;
+} cmd_letter_t;
+
+typedef struct {
+    cmd_head_t head;
+    lv_draw_img_dsc_t dsc;
+    lv_area_t coords;
+    const void * src;
+} cmd_img_t;
+
+typedef struct {
+    cmd_head_t head;
+    lv_draw_line_dsc_t dsc;
+    lv_point_t point1;
+    lv_point_t point2;
+} cmd_line_t;
+
+typedef struct {
+    cmd_head_t head;
+    lv_draw_rect_dsc_t dsc;
+    uint16_t point_cnt;
+    lv_point_t points[];
+} cmd_polygon_t;
+
+/*The copy of the mask parameters follow the header, each aligned with `CMD_ALIGN`*/
+typedef struct {
+    cmd_head_t head;
+    uint32_t cnt;
+} cmd_masks_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * cmd_add(lv_draw_ctx_t * draw_ctx, cmd_type_t type, uint32_t size);
+static void rec_fail(const char * reason);
+static void rec_draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void rec_draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void rec_draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                         uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+static void rec_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                            uint32_t letter);
+static lv_res_t rec_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                             const void * src);
+static void rec_draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                                 const lv_area_t * coords, const uint8_t * map_p, lv_img_cf_t color_format);
+static void rec_draw_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                          const lv_point_t * point2);
+static void rec_draw_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                             uint16_t point_cnt);
+static void rec_buffer_copy(lv_draw_ctx_t * draw_ctx, void * dest_buf, lv_coord_t dest_stride,
+                            const lv_area_t * dest_area, void * src_buf, lv_coord_t src_stride, const lv_area_t * src_area);
+static lv_draw_layer_ctx_t * rec_layer_init(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
+                                            lv_draw_layer_flags_t flags);
+#if LV_DRAW_COMPLEX
+    static bool masks_update(lv_draw_ctx_t * draw_ctx);
+    static uint32_t mask_param_size(const void * param);
+    static void masks_release(void);
+    static void masks_set(const cmd_masks_t * masks, int16_t * ids, uint32_t * id_cnt);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static bool enabled = true;
+static bool recording;
+static bool failed;
+static lv_draw_ctx_t rec_ctx;
+static lv_area_t rec_area;
+
+static uint8_t * buf;
+static uint32_t buf_size;
+static uint32_t buf_len;
+static uint32_t label_dsc_ofs;      /*Offset of the last `CMD_LABEL_DSC` + 1 or 0 if none*/
+static uint32_t masks_ofs;          /*Offset of the last `CMD_MASKS` + 1 or 0 if none*/
+static lv_draw_rec_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_rec_enable(bool en)
+{
+    enabled = en;
+}
+
+bool lv_draw_rec_is_enabled(void)
+{
+    return enabled;
+}
+
+void lv_draw_rec_get_stats(lv_draw_rec_stats_t * stats_out)
+{
+    *stats_out = stats;
+}
+
+lv_draw_ctx_t * _lv_draw_rec_begin(lv_draw_ctx_t * draw_ctx, const lv_area_t * area)
+{
+    if(!enabled || recording) return NULL;
+
+    _lv_draw_rec_clear();
+
+    recording = true;
+    failed = false;
+    rec_area = *area;
+    stats.cmd_cnt = 0;
+    stats.size = 0;
+    stats.replay_cnt = 0;
+
+    /*Draw "into" the whole area. Only the drawing callbacks are used, everything else is NULL.*/
+    lv_memset_00(&rec_ctx, sizeof(rec_ctx));
+    rec_ctx.buf = draw_ctx->buf;
+    rec_ctx.buf_area = &rec_area;
+    rec_ctx.clip_area = &rec_area;
+    rec_ctx.draw_rect = draw_ctx->draw_rect ? rec_draw_rect : NULL;
+    rec_ctx.draw_bg = draw_ctx->draw_bg ? rec_draw_bg : NULL;
+    rec_ctx.draw_arc = draw_ctx->draw_arc ? rec_draw_arc : NULL;
+    rec_ctx.draw_letter = draw_ctx->draw_letter ? rec_draw_letter : NULL;
+    rec_ctx.draw_img = rec_draw_img;
+    rec_ctx.draw_img_decoded = rec_draw_img_decoded;
+    rec_ctx.draw_line = draw_ctx->draw_line ? rec_draw_line : NULL;
+    rec_ctx.draw_polygon = draw_ctx->draw_polygon ? rec_draw_polygon : NULL;
+    rec_ctx.buffer_copy = rec_buffer_copy;
+    rec_ctx.layer_init = rec_layer_init;
+    rec_ctx.layer_instance_size = LV_MAX(draw_ctx->layer_instance_size, sizeof(lv_draw_layer_ctx_t));
+    rec_ctx.user_data = draw_ctx->user_data;
+
+    return &rec_ctx;
+}
+
+lv_res_t _lv_draw_rec_end(void)
+{
+    recording = false;
+    if(failed) {
+        stats.fail_cnt++;
+        _lv_draw_rec_clear();
+        return LV_RES_INV;
+    }
+
+    stats.size = buf_len;
+    return LV_RES_OK;
+}
+
+void _lv_draw_rec_replay(lv_draw_ctx_t * draw_ctx)
+{
+    const lv_area_t * clip_ori = draw_ctx->clip_area;
+    const cmd_label_dsc_t * label_dsc = NULL;
+#if LV_DRAW_COMPLEX
+    const cmd_masks_t * masks_want = NULL;
+    const cmd_masks_t * masks_have = NULL;
+    int16_t mask_ids[_LV_MASK_MAX_NUM];
+    uint32_t mask_id_cnt = 0;
+#endif
+
+    stats.replay_cnt++;
+
+    uint32_t ofs = 0;
+    while(ofs < buf_len) {
+        const cmd_head_t * head = (const cmd_head_t *)&buf[ofs];
+        ofs += head->size;
+
+        if(head->type == CMD_LABEL_DSC) {
+            label_dsc = (const cmd_label_dsc_t *)head;
+            continue;
+        }
+
+        if(head->type == CMD_MASKS) {
+#if LV_DRAW_COMPLEX
+            masks_want = (const cmd_masks_t *)head;
+#endif
+            continue;
+        }
+
+        lv_area_t clip;
+        if(!_lv_area_intersect(&clip, &head->clip, clip_ori)) continue;
+
+        if(head->type == CMD_LETTER) {
+            /*Skip the letters out of the clip area the same way `lv_draw_label` skips the lines*/
+            const cmd_letter_t * cmd = (const cmd_letter_t *)head;
+            if(cmd->pos.y > clip.y2) continue;
+            if(cmd->pos.y + label_dsc->dsc.font->line_height < clip.y1) continue;
+        }
+
+#if LV_DRAW_COMPLEX
+        if(masks_want != masks_have) {
+            masks_set(masks_want, mask_ids, &mask_id_cnt);
+            masks_have = masks_want;
+        }
+#endif
+
+        draw_ctx->clip_area = &clip;
+        switch(head->type) {
+            case CMD_RECT: {
+                    const cmd_rect_t * cmd = (const cmd_rect_t *)head;
+                    draw_ctx->draw_rect(draw_ctx, &cmd->dsc, &cmd->coords);
+                    break;
+                }
+            case CMD_BG: {
+                    const cmd_rect_t * cmd = (const cmd_rect_t *)head;
+                    draw_ctx->draw_bg(draw_ctx, &cmd->dsc, &cmd->coords);
+                    break;
+                }
+            case CMD_ARC: {
+                    const cmd_arc_t * cmd = (const cmd_arc_t *)head;
+                    draw_ctx->draw_arc(draw_ctx, &cmd->dsc, &cmd->center, cmd->radius, cmd->start_angle, cmd->end_angle);
+                    break;
+                }
+            case CMD_LETTER: {
+                    const cmd_letter_t * cmd = (const cmd_letter_t *)head;
+                    draw_ctx->draw_letter(draw_ctx, &label_dsc->dsc, &cmd->pos, cmd->letter);
+                    break;
+                }
+            case CMD_IMG: {
+                    /*Decode here because the decoded image might be closed since recording*/
+                    const cmd_img_t * cmd = (const cmd_img_t *)head;
+                    lv_draw_img(draw_ctx, &cmd->dsc, &cmd->coords, cmd->src);
+                    break;
+                }
+            case CMD_LINE: {
+                    const cmd_line_t * cmd = (const cmd_line_t *)head;
+                    draw_ctx->draw_line(draw_ctx, &cmd->dsc, &cmd->point1, &cmd->point2);
+                    break;
+                }
+            case CMD_POLYGON: {
+                    const cmd_polygon_t * cmd = (const cmd_polygon_t *)head;
+                    draw_ctx->draw_polygon(draw_ctx, &cmd->dsc, cmd->points, cmd->point_cnt);
+                    break;
+                }
+            default:
+                break;
+        }
+    }
+
+#if LV_DRAW_COMPLEX
+    masks_set(NULL, mask_ids, &mask_id_cnt);
+#endif
+    draw_ctx->clip_area = clip_ori;
+}
+
+void _lv_draw_rec_clear(void)
+{
+#if LV_DRAW_COMPLEX
+    masks_release();
+#endif
+    buf_len = 0;
+    label_dsc_ofs = 0;
+    masks_ofs = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Append a command to the list
+ * @param draw_ctx      the recording draw context
+ * @param type          type of the command
+ * @param size          size of the command's struct
+ * @return              the command with its header filled, or NULL if it couldn't be added
+ */
+static void * cmd_add(lv_draw_ctx_t * draw_ctx, cmd_type_t type, uint32_t size)
+{
+    if(failed) return NULL;
+
+#if LV_DRAW_COMPLEX
+    /*The masks are global and added/removed around the drawing calls: save them with the commands*/
+    if(type != CMD_MASKS && type != CMD_LABEL_DSC && !masks_update(draw_ctx)) return NULL;
+#endif
+
+    size = CMD_ALIGN(size);
+    if(buf_len + size > buf_size) {
+        uint32_t new_size = LV_MAX(buf_size * 2, BUF_SIZE_MIN);
+        while(new_size < buf_len + size) new_size *= 2;
+        if(new_size > LV_DRAW_REC_BUF_MAX_SIZE) {
+            rec_fail("the command list is full");
+            return NULL;
+        }
+
+        uint8_t * new_buf = lv_mem_realloc(buf, new_size);
+        if(new_buf == NULL) {
+            rec_fail("out of memory");
+            return NULL;
+        }
+        buf = new_buf;
+        buf_size = new_size;
+    }
+
+    cmd_head_t * head = (cmd_head_t *)&buf[buf_len];
+    head->type = type;
+    head->size = size;
+    head->clip = *draw_ctx->clip_area;
+    buf_len += size;
+    stats.cmd_cnt++;
+
+    return head;
+}
+
+static void rec_fail(const char * reason)
+{
+    if(!failed) {
+        LV_LOG_INFO("drawing directly: %s", reason);
+        LV_UNUSED(reason);
+    }
+    failed = true;
+}
+
+static void rec_draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    cmd_rect_t * cmd = cmd_add(draw_ctx, CMD_RECT, sizeof(cmd_rect_t));
+    if(cmd == NULL) return;
+    cmd->dsc = *dsc;
+    cmd->coords = *coords;
+}
+
+static void rec_draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    cmd_rect_t * cmd = cmd_add(draw_ctx, CMD_BG, sizeof(cmd_rect_t));
+    if(cmd == NULL) return;
+    cmd->dsc = *dsc;
+    cmd->coords = *coords;
+}
+
+static void rec_draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                         uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    cmd_arc_t * cmd = cmd_add(draw_ctx, CMD_ARC, sizeof(cmd_arc_t));
+    if(cmd == NULL) return;
+    cmd->dsc = *dsc;
+    cmd->center = *center;
+    cmd->radius = radius;
+    cmd->start_angle = start_angle;
+    cmd->end_angle = end_angle;
+}
+
+static void rec_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                            uint32_t letter)
+{
+    /*Save the descriptor only if it has changed, typically once per label*/
+    if(label_dsc_ofs == 0 ||
+       memcmp(&((const cmd_label_dsc_t *)&buf[label_dsc_ofs - 1])->dsc, dsc, sizeof(*dsc)) != 0) {
+        uint32_t ofs = buf_len;
+        cmd_label_dsc_t * cmd_dsc = cmd_add(draw_ctx, CMD_LABEL_DSC, sizeof(cmd_label_dsc_t));
+        if(cmd_dsc == NULL) return;
+        cmd_dsc->dsc = *dsc;
+        label_dsc_ofs = ofs + 1;
+    }
+
+    cmd_letter_t * cmd = cmd_add(draw_ctx, CMD_LETTER, sizeof(cmd_letter_t));
+    if(cmd == NULL) return;
+    cmd->pos = *pos_p;
+    cmd->letter = letter;
+}
+
+static lv_res_t rec_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                             const void * src)
+{
+    cmd_img_t * cmd = cmd_add(draw_ctx, CMD_IMG, sizeof(cmd_img_t));
+    if(cmd) {
+        cmd->dsc = *dsc;
+        cmd->coords = *coords;
+        cmd->src = src;
+    }
+
+    /*Don't decode the image now*/
+    return LV_RES_OK;
+}
+
+static void rec_draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                                 const lv_area_t * coords, const uint8_t * map_p, lv_img_cf_t color_format)
+{
+    LV_UNUSED(draw_ctx);
+    LV_UNUSED(dsc);
+    LV_UNUSED(coords);
+    LV_UNUSED(map_p);
+    LV_UNUSED(color_format);
+
+    /*The decoded buffer might not exist when the commands are replayed*/
+    rec_fail("decoded image");
+}
+
+static void rec_draw_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                          const lv_point_t * point2)
+{
+    cmd_line_t * cmd = cmd_add(draw_ctx, CMD_LINE, sizeof(cmd_line_t));
+    if(cmd == NULL) return;
+    cmd->dsc = *dsc;
+    cmd->point1 = *point1;
+    cmd->point2 = *point2;
+}
+
+static void rec_draw_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                             uint16_t point_cnt)
+{
+    cmd_polygon_t * cmd = cmd_add(draw_ctx, CMD_POLYGON, sizeof(cmd_polygon_t) + point_cnt * sizeof(lv_point_t));
+    if(cmd == NULL) return;
+    cmd->dsc = *dsc;
+    cmd->point_cnt = point_cnt;
+    lv_memcpy(cmd->points, points, point_cnt * sizeof(lv_point_t));
+}
+
+static void rec_buffer_copy(lv_draw_ctx_t * draw_ctx, void * dest_buf, lv_coord_t dest_stride,
+                            const lv_area_t * dest_area, void * src_buf, lv_coord_t src_stride, const lv_area_t * src_area)
+{
+    LV_UNUSED(draw_ctx);
+    LV_UNUSED(dest_buf);
+    LV_UNUSED(dest_stride);
+    LV_UNUSED(dest_area);
+    LV_UNUSED(src_buf);
+    LV_UNUSED(src_stride);
+    LV_UNUSED(src_area);
+
+    rec_fail("buffer copy");
+}
+
+static lv_draw_layer_ctx_t * rec_layer_init(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
+                                            lv_draw_layer_flags_t flags)
+{
+    LV_UNUSED(draw_ctx);
+    LV_UNUSED(flags);
+
+    /*The content of a layer is blended as an image: it can't be replayed in parts.
+     *Let the caller go through the layer in one step, nothing is drawn anyway.*/
+    rec_fail("layer");
+    layer_ctx->area_act = layer_ctx->area_full;
+    layer_ctx->max_row_with_alpha = lv_area_get_height(&layer_ctx->area_full);
+    layer_ctx->max_row_with_no_alpha = layer_ctx->max_row_with_alpha;
+    return layer_ctx;
+}
+
+#if LV_DRAW_COMPLEX
+
+/**
+ * Add a `CMD_MASKS` if the active masks are different from the ones saved last time
+ * @param draw_ctx      the recording draw context
+ * @return              false: a mask couldn't be saved
+ */
+static bool masks_update(lv_draw_ctx_t * draw_ctx)
+{
+    _lv_draw_mask_saved_t * list = LV_GC_ROOT(_lv_draw_mask_list);
+
+    /*Compare with the last saved masks*/
+    uint32_t cnt = 0;
+    uint32_t size = sizeof(cmd_masks_t);
+    bool same = true;
+    const cmd_masks_t * last = masks_ofs ? (const cmd_masks_t *)&buf[masks_ofs - 1] : NULL;
+    const uint8_t * last_param = last ? (const uint8_t *)last + CMD_ALIGN(sizeof(cmd_masks_t)) : NULL;
+    while(cnt < _LV_MASK_MAX_NUM && list[cnt].param) {
+        uint32_t param_size = mask_param_size(list[cnt].param);
+        if(param_size == 0) {
+            rec_fail("mask with external data");
+            return false;
+        }
+
+        if(same) {
+            if(last == NULL || cnt >= last->cnt || memcmp(last_param, list[cnt].param, param_size) != 0) same = false;
+            else last_param += CMD_ALIGN(param_size);
+        }
+        size = CMD_ALIGN(size) + param_size;
+        cnt++;
+    }
+
+    if(same && cnt == (last ? last->cnt : 0)) return true;
+
+    uint32_t ofs = buf_len;
+    cmd_masks_t * cmd = cmd_add(draw_ctx, CMD_MASKS, size);
+    if(cmd == NULL) return false;
+
+    uint8_t * param = (uint8_t *)cmd + CMD_ALIGN(sizeof(cmd_masks_t));
+    uint32_t i;
+    cmd->cnt = 0;
+    for(i = 0; i < cnt; i++) {
+        uint32_t param_size = mask_param_size(list[i].param);
+        lv_memcpy(param, list[i].param, param_size);
+
+        /*Keep the circle in the cache until the commands are dropped*/
+        lv_draw_mask_radius_param_t * radius_p = (lv_draw_mask_radius_param_t *)param;
+        if(radius_p->dsc.type == LV_DRAW_MASK_TYPE_RADIUS && radius_p->circle) {
+            if(radius_p->circle->life < 0) {
+                /*Not in the cache, it's freed by the owner of the mask*/
+                radius_p->circle = NULL;
+                cmd->cnt = i;
+                rec_fail("uncached radius mask");
+                return false;
+            }
+            radius_p->circle->used_cnt++;
+        }
+        param += CMD_ALIGN(param_size);
+        cmd->cnt = i + 1;
+    }
+    masks_ofs = ofs + 1;
+
+    return true;
+}
+
+/**
+ * Get the size of a mask parameter if the mask can be saved
+ * @param param     pointer to a mask parameter
+ * @return          size of the parameter, or 0 if the mask refers to other data (map and polygon masks)
+ */
+static uint32_t mask_param_size(const void * param)
+{
+    const _lv_draw_mask_common_dsc_t * dsc = param;
+    switch(dsc->type) {
+        case LV_DRAW_MASK_TYPE_LINE:
+            return sizeof(lv_draw_mask_line_param_t);
+        case LV_DRAW_MASK_TYPE_ANGLE:
+            return sizeof(lv_draw_mask_angle_param_t);
+        case LV_DRAW_MASK_TYPE_RADIUS:
+            return sizeof(lv_draw_mask_radius_param_t);
+        case LV_DRAW_MASK_TYPE_FADE:
+            return sizeof(lv_draw_mask_fade_param_t);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Release the cached circles referenced by the saved radius masks
+ */
+static void masks_release(void)
+{
+    uint32_t ofs = 0;
+    while(ofs < buf_len) {
+        const cmd_head_t * head = (const cmd_head_t *)&buf[ofs];
+        ofs += head->size;
+        if(head->type != CMD_MASKS) continue;
+
+        const cmd_masks_t * cmd = (const cmd_masks_t *)head;
+        uint8_t * param = (uint8_t *)cmd + CMD_ALIGN(sizeof(cmd_masks_t));
+        uint32_t i;
+        for(i = 0; i < cmd->cnt; i++) {
+            lv_draw_mask_radius_param_t * radius_p = (lv_draw_mask_radius_param_t *)param;
+            if(radius_p->dsc.type == LV_DRAW_MASK_TYPE_RADIUS && radius_p->circle) {
+                radius_p->circle->used_cnt--;
+            }
+            param += CMD_ALIGN(mask_param_size(param));
+        }
+    }
+}
+
+/**
+ * Replace the masks added for the previous commands with the saved ones
+ * @param masks     the masks to add or NULL to only remove the previous ones
+ * @param ids       IDs of the masks added by the previous call
+ * @param id_cnt    number of elements in `ids`
+ */
+static void masks_set(const cmd_masks_t * masks, int16_t * ids, uint32_t * id_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < *id_cnt; i++) {
+        lv_draw_mask_remove_id(ids[i]);
+    }
+    *id_cnt = 0;
+
+    if(masks == NULL) return;
+
+    /*The parameters are only read by the masks so they are used from the command list directly*/
+    uint8_t * param = (uint8_t *)masks + CMD_ALIGN(sizeof(cmd_masks_t));
+    for(i = 0; i < masks->cnt; i++) {
+        ids[i] = lv_draw_mask_add(param, NULL);
+        param += CMD_ALIGN(mask_param_size(param));
+    }
+    *id_cnt = masks->cnt;
+}
+
+#endif /*LV_DRAW_COMPLEX*/
+
+#endif /*LV_USE_DRAW_REC*/
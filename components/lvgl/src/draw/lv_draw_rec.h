@@ -0,0 +1,102 @@
+/**
+ * @file lv_draw_rec.h
+ *
+ */
+
+#ifndef LV_DRAW_REC_H
+#define LV_DRAW_REC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_DRAW_REC
+
+#include "../misc/lv_area.h"
+#include "../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_draw_ctx_t;
+
+/**
+ * Statistics of the last recorded area
+ */
+typedef struct {
+    uint32_t cmd_cnt;       /*Number of recorded commands*/
+    uint32_t size;          /*Size of the command list in bytes*/
+    uint32_t replay_cnt;    /*Number of times the list was replayed, i.e. buffer parts drawn from it*/
+    uint32_t fail_cnt;      /*Number of areas which couldn't be recorded since the start (drawn directly instead)*/
+} lv_draw_rec_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Enable or disable recording. If enabled (default), the objects of an invalid area which is rendered
+ * in more parts are drawn only once into a command list, and the list is replayed for each part.
+ * @param en    true: enable; false: draw each part directly
+ */
+void lv_draw_rec_enable(bool en);
+
+/**
+ * Tell whether recording is enabled
+ * @return      true: enabled
+ */
+bool lv_draw_rec_is_enabled(void);
+
+/**
+ * Get the statistics of the recorder
+ * @param stats     the result is written here
+ */
+void lv_draw_rec_get_stats(lv_draw_rec_stats_t * stats);
+
+/**
+ * Start recording the drawing of an area. Used by `lv_refr.c`.
+ * @param draw_ctx  the draw context of the display, the recorded commands will be replayed on it
+ * @param area      the area to record
+ * @return          a draw context to draw the objects with, or NULL if recording is not possible
+ */
+struct _lv_draw_ctx_t * _lv_draw_rec_begin(struct _lv_draw_ctx_t * draw_ctx, const lv_area_t * area);
+
+/**
+ * Finish recording.
+ * @return      LV_RES_OK: the command list is ready to replay;
+ *              LV_RES_INV: something could not be recorded (e.g. a layer), the area needs to be drawn directly
+ */
+lv_res_t _lv_draw_rec_end(void);
+
+/**
+ * Execute the recorded commands on `draw_ctx->clip_area`
+ * @param draw_ctx      the draw context to draw to
+ */
+void _lv_draw_rec_replay(struct _lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Drop the recorded commands
+ */
+void _lv_draw_rec_clear(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_REC*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_REC_H*/
@@ -43,6 +43,13 @@ typedef struct {
     uint32_t has_alpha : 1;
 } lv_draw_sw_layer_ctx_t;
 
+typedef struct {
+    uint32_t hit_cnt;       /*Number of shadow corners taken from the cache*/
+    uint32_t miss_cnt;      /*Number of shadow corners which had to be blurred*/
+    uint32_t size;          /*Total size of the cached corners in bytes*/
+    uint32_t entry_cnt;     /*Number of cached corners*/
+} lv_draw_sw_shadow_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -58,6 +65,18 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
 void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
 void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+
+/**
+ * Get the statistics of the shadow corner cache. All zero if `LV_SHADOW_CACHE_SIZE` is 0.
+ * @param stats     the result is written here
+ */
+void lv_draw_sw_shadow_cache_get_stats(lv_draw_sw_shadow_cache_stats_t * stats);
+
+/**
+ * Free all cached shadow corners
+ */
+void lv_draw_sw_shadow_cache_clear(void);
+
 void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
                        uint32_t letter);
 
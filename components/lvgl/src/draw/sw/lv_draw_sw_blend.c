@@ -63,6 +63,12 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif /*LV_DRAW_COMPLEX*/
 
+#if LV_COLOR_RGB888_OUT
+static void blend_rgb888(uint8_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                         const lv_draw_sw_blend_dsc_t * dsc, const lv_color_t * src_buf, lv_coord_t src_stride,
+                         const lv_opa_t * mask, lv_coord_t mask_stride);
+#endif /*LV_COLOR_RGB888_OUT*/
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -116,8 +122,18 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, cons
 
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     lv_color_t * dest_buf = draw_ctx->buf;
+#if LV_COLOR_RGB888_OUT
+    bool rgb888 = _lv_draw_sw_buf_is_rgb888(draw_ctx);
+#else
+    bool rgb888 = false;
+#endif
     if(disp->driver->set_px_cb == NULL) {
-        if(disp->driver->screen_transp == 0) {
+        if(rgb888) {
+            uint8_t * dest_buf8 = (uint8_t *) dest_buf;
+            dest_buf8 += (dest_stride * (blend_area.y1 - draw_ctx->buf_area->y1) + (blend_area.x1 - draw_ctx->buf_area->x1)) * 3;
+            dest_buf = (lv_color_t *)dest_buf8;
+        }
+        else if(disp->driver->screen_transp == 0) {
             dest_buf += dest_stride * (blend_area.y1 - draw_ctx->buf_area->y1) + (blend_area.x1 - draw_ctx->buf_area->x1);
         }
         else {
@@ -169,6 +185,11 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, cons
             map_set_px(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa, mask, mask_stride);
         }
     }
+#if LV_COLOR_RGB888_OUT
+    else if(rgb888) {
+        blend_rgb888((uint8_t *)dest_buf, &blend_area, dest_stride, dsc, src_buf, src_stride, mask, mask_stride);
+    }
+#endif
 #if LV_COLOR_SCREEN_TRANSP
     else if(disp->driver->screen_transp) {
         if(dsc->src_buf == NULL) {
@@ -200,6 +221,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, cons
 }
 
 
+#if LV_COLOR_RGB888_OUT
+bool _lv_draw_sw_buf_is_rgb888(lv_draw_ctx_t * draw_ctx)
+{
+    /*Layers, snapshots and canvases draw to their own `lv_color_t` buffers*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp == NULL || !disp->driver->rgb888_out || disp->driver->draw_buf == NULL) return false;
+    return draw_ctx->buf == disp->driver->draw_buf->buf_act;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -1046,3 +1077,137 @@ static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color
 
 #endif
 
+#if LV_COLOR_RGB888_OUT
+/**
+ * Blend into a packed 3 bytes/pixel buffer.
+ * The result is exactly what `lv_draw_sw_rgb888_set()` would make from a normal buffer:
+ * the colors are mixed the same way as in `fill_normal()` and `map_normal()`, and the other cases
+ * are unpacked row by row, blended by the `lv_color_t` functions and packed again.
+ */
+static void blend_rgb888(uint8_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                         const lv_draw_sw_blend_dsc_t * dsc, const lv_color_t * src_buf, lv_coord_t src_stride,
+                         const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+    int32_t x;
+    int32_t y;
+    lv_opa_t opa = dsc->opa;
+    lv_color_t color = dsc->color;
+    bool normal = dsc->blend_mode == LV_BLEND_MODE_NORMAL;
+
+    /*Nothing to mix, only pack the colors*/
+    if(normal && mask == NULL && opa >= LV_OPA_MAX) {
+        if(src_buf == NULL) {
+            uint8_t px[3];
+            lv_draw_sw_rgb888_set(px, color);
+            for(y = 0; y < h; y++) {
+                uint8_t * d = dest_buf;
+                for(x = 0; x < w; x++) {
+                    d[0] = px[0];
+                    d[1] = px[1];
+                    d[2] = px[2];
+                    d += 3;
+                }
+                dest_buf += dest_stride * 3;
+            }
+        }
+        else {
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    lv_draw_sw_rgb888_set(&dest_buf[x * 3], src_buf[x]);
+                }
+                dest_buf += dest_stride * 3;
+                src_buf += src_stride;
+            }
+        }
+        return;
+    }
+
+    /*Masked fill: only the covered pixels are read*/
+    if(normal && src_buf == NULL && mask) {
+        uint8_t px[3];
+        lv_draw_sw_rgb888_set(px, color);
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                if(mask[x] == LV_OPA_TRANSP) continue;
+
+                lv_opa_t opa_tmp;
+                if(opa >= LV_OPA_MAX) opa_tmp = mask[x];
+                else opa_tmp = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+
+                uint8_t * d = &dest_buf[x * 3];
+                if(opa_tmp == LV_OPA_COVER) {
+                    d[0] = px[0];
+                    d[1] = px[1];
+                    d[2] = px[2];
+                }
+                else {
+                    lv_draw_sw_rgb888_set(d, lv_color_mix(color, lv_draw_sw_rgb888_get(d), opa_tmp));
+                }
+            }
+            dest_buf += dest_stride * 3;
+            mask += mask_stride;
+        }
+        return;
+    }
+
+    /*Image with opacity and/or mask*/
+    if(normal && src_buf) {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                uint8_t * d = &dest_buf[x * 3];
+                if(mask == NULL) {
+                    lv_draw_sw_rgb888_set(d, lv_color_mix(src_buf[x], lv_draw_sw_rgb888_get(d), opa));
+                }
+                else if(mask[x] == LV_OPA_TRANSP) {
+                    continue;
+                }
+                else if(opa > LV_OPA_MAX) {
+                    if(mask[x] == LV_OPA_COVER) lv_draw_sw_rgb888_set(d, src_buf[x]);
+                    else lv_draw_sw_rgb888_set(d, lv_color_mix(src_buf[x], lv_draw_sw_rgb888_get(d), mask[x]));
+                }
+                else {
+                    lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+                    lv_draw_sw_rgb888_set(d, lv_color_mix(src_buf[x], lv_draw_sw_rgb888_get(d), opa_tmp));
+                }
+            }
+            dest_buf += dest_stride * 3;
+            src_buf += src_stride;
+            if(mask) mask += mask_stride;
+        }
+        return;
+    }
+
+    /*Fill with opacity and the other blend modes*/
+    lv_color_t * line = lv_mem_buf_get(w * sizeof(lv_color_t));
+    lv_area_t line_area;
+    lv_area_set(&line_area, 0, 0, w - 1, 0);
+
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            line[x] = lv_draw_sw_rgb888_get(&dest_buf[x * 3]);
+        }
+
+        if(normal) {
+            fill_normal(line, &line_area, w, color, opa, mask, w);
+        }
+#if LV_DRAW_COMPLEX
+        else {
+            if(src_buf == NULL) fill_blended(line, &line_area, w, color, opa, mask, w, dsc->blend_mode);
+            else map_blended(line, &line_area, w, src_buf, src_stride, opa, mask, w, dsc->blend_mode);
+        }
+#endif
+
+        for(x = 0; x < w; x++) {
+            lv_draw_sw_rgb888_set(&dest_buf[x * 3], line[x]);
+        }
+
+        dest_buf += dest_stride * 3;
+        if(src_buf) src_buf += src_stride;
+        if(mask) mask += mask_stride;
+    }
+
+    lv_mem_buf_release(line);
+}
+#endif /*LV_COLOR_RGB888_OUT*/
@@ -58,6 +58,59 @@ void lv_draw_sw_blend(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_d
  */
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
 
+#if LV_COLOR_RGB888_OUT
+/**
+ * Tell whether the draw context renders into a packed 3 bytes/pixel buffer of the display
+ * (the display driver's `rgb888_out` is set)
+ * @param draw_ctx      pointer to a draw context
+ * @return              true: `draw_ctx->buf` has 3 bytes/pixel
+ */
+bool _lv_draw_sw_buf_is_rgb888(struct _lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Write an RGB565 color to a pixel of a packed 3 bytes/pixel buffer.
+ * The channels are in the top bits of the bytes and the lowest bits of red and blue
+ * repeat their most significant bit, the same as converting RGB565 for an RGB666 display.
+ * @param buf       pointer to the 3 bytes of the pixel
+ * @param color     the color to write
+ */
+static inline void lv_draw_sw_rgb888_set_16(uint8_t * buf, lv_color16_t color)
+{
+    uint8_t r = LV_COLOR_GET_R16(color);
+    uint8_t b = LV_COLOR_GET_B16(color);
+    buf[0] = (uint8_t)((r << 3) | ((r & 0x10) >> 2));
+    buf[1] = (uint8_t)(LV_COLOR_GET_G16(color) << 2);
+    buf[2] = (uint8_t)((b << 3) | ((b & 0x10) >> 2));
+}
+
+/**
+ * Write a color to a pixel of a packed 3 bytes/pixel buffer.
+ * With 16 bit color depth it's `lv_draw_sw_rgb888_set_16()`.
+ * @param buf       pointer to the 3 bytes of the pixel
+ * @param color     the color to write
+ */
+static inline void lv_draw_sw_rgb888_set(uint8_t * buf, lv_color_t color)
+{
+#if LV_COLOR_DEPTH == 16
+    lv_draw_sw_rgb888_set_16(buf, color);
+#else
+    buf[0] = LV_COLOR_GET_R(color);
+    buf[1] = LV_COLOR_GET_G(color);
+    buf[2] = LV_COLOR_GET_B(color);
+#endif
+}
+
+/**
+ * Read a pixel of a packed 3 bytes/pixel buffer. It's the exact inverse of `lv_draw_sw_rgb888_set()`.
+ * @param buf       pointer to the 3 bytes of the pixel
+ * @return          the color of the pixel
+ */
+static inline lv_color_t lv_draw_sw_rgb888_get(const uint8_t * buf)
+{
+    return lv_color_make(buf[0], buf[1], buf[2]);
+}
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -424,10 +424,16 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
     lv_color_t * dest_buf_tmp = draw_ctx->buf;
 
     /*Set a pointer on draw_buf to the first pixel of the letter*/
-    dest_buf_tmp += ((pos->y - draw_ctx->buf_area->y1) * dest_buf_stride) + pos->x - draw_ctx->buf_area->x1;
+    int32_t dest_ofs = ((pos->y - draw_ctx->buf_area->y1) * dest_buf_stride) + pos->x - draw_ctx->buf_area->x1;
 
     /*If the letter is partially out of mask the move there on draw_buf*/
-    dest_buf_tmp += (row_start * dest_buf_stride) + col_start / 3;
+    dest_ofs += (row_start * dest_buf_stride) + col_start / 3;
+    dest_buf_tmp += dest_ofs;
+
+#if LV_COLOR_RGB888_OUT
+    /*The background is read from packed 3 bytes/pixel buffers too*/
+    uint8_t * dest_buf8_tmp = _lv_draw_sw_buf_is_rgb888(draw_ctx) ? (uint8_t *)draw_ctx->buf + dest_ofs * 3 : NULL;
+#endif
 
     lv_area_t mask_area;
     lv_area_copy(&mask_area, &map_area);
@@ -479,12 +485,17 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
                 subpx_cnt = 0;
 
                 lv_color_t res_color;
+#if LV_COLOR_RGB888_OUT
+                lv_color_t bg_color = dest_buf8_tmp ? lv_draw_sw_rgb888_get(dest_buf8_tmp) : *dest_buf_tmp;
+#else
+                lv_color_t bg_color = *dest_buf_tmp;
+#endif
 #if LV_COLOR_16_SWAP == 0
-                uint8_t bg_rgb[3] = {dest_buf_tmp->ch.red, dest_buf_tmp->ch.green, dest_buf_tmp->ch.blue};
+                uint8_t bg_rgb[3] = {bg_color.ch.red, bg_color.ch.green, bg_color.ch.blue};
 #else
-                uint8_t bg_rgb[3] = {dest_buf_tmp->ch.red,
-                                     (dest_buf_tmp->ch.green_h << 3) + dest_buf_tmp->ch.green_l,
-                                     dest_buf_tmp->ch.blue
+                uint8_t bg_rgb[3] = {bg_color.ch.red,
+                                     (bg_color.ch.green_h << 3) + bg_color.ch.green_l,
+                                     bg_color.ch.blue
                                     };
 #endif
 
@@ -515,6 +526,9 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
                 /*Next mask byte*/
                 mask_p++;
                 dest_buf_tmp++;
+#if LV_COLOR_RGB888_OUT
+                if(dest_buf8_tmp) dest_buf8_tmp += 3;
+#endif
             }
 
             /*Go to the next column*/
@@ -557,6 +571,9 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
 
         /*Next row in draw_buf*/
         dest_buf_tmp += dest_buf_stride - (col_end - col_start) / 3;
+#if LV_COLOR_RGB888_OUT
+        if(dest_buf8_tmp) dest_buf8_tmp += (dest_buf_stride - (col_end - col_start) / 3) * 3;
+#endif
     }
 
     /*Flush the last part*/
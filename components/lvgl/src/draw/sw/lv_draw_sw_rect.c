@@ -19,11 +19,30 @@
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
+#define SHADOW_CACHE_ENTRY_CNT  16
 
+/*Fully covered or transparent parts of a masked line at least this long are blended without the mask*/
+#define BLEND_RUN_MIN           16
+
+#if LV_DRAW_COMPLEX && defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
+    #define SHADOW_CACHE    1
+#else
+    #define SHADOW_CACHE    0
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if SHADOW_CACHE
+typedef struct {
+    lv_opa_t * buf;             /*The blurred corner, NULL if the entry is free*/
+    uint32_t life;              /*The least recently used entry has the smallest value*/
+    lv_coord_t corner_size;
+    lv_coord_t r;
+    lv_coord_t w;               /*Size of the blurred rectangle. Above `2 * corner_size` it doesn't affect the corner*/
+    lv_coord_t h;
+} shadow_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -37,11 +56,19 @@ static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * ds
 #if LV_DRAW_COMPLEX
 LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
                                               const lv_area_t * coords);
+LV_ATTRIBUTE_FAST_MEM static void blend_mask_runs(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
 #endif
 
+#if SHADOW_CACHE
+static shadow_cache_entry_t * shadow_cache_find(lv_coord_t corner_size, lv_coord_t r, const lv_area_t * core_area);
+static void shadow_cache_add(const lv_opa_t * sh_buf, lv_coord_t corner_size, lv_coord_t r,
+                             const lv_area_t * core_area);
+static void shadow_cache_free(shadow_cache_entry_t * e);
+#endif
+
 void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
                          lv_coord_t rout, lv_coord_t rin, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 
@@ -52,10 +79,10 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+#if SHADOW_CACHE
+    static shadow_cache_entry_t sh_cache[SHADOW_CACHE_ENTRY_CNT];
+    static uint32_t sh_cache_life;
+    static lv_draw_sw_shadow_cache_stats_t sh_cache_stats;
 #endif
 
 /**********************
@@ -85,13 +112,37 @@ void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, c
 void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
 #if LV_COLOR_SCREEN_TRANSP && LV_COLOR_DEPTH == 32
-    lv_memset_00(draw_ctx->buf, lv_area_get_size(draw_ctx->buf_area) * sizeof(lv_color_t));
+#if LV_COLOR_RGB888_OUT
+    uint32_t px_size = _lv_draw_sw_buf_is_rgb888(draw_ctx) ? 3 : sizeof(lv_color_t);
+#else
+    uint32_t px_size = sizeof(lv_color_t);
+#endif
+    lv_memset_00(draw_ctx->buf, lv_area_get_size(draw_ctx->buf_area) * px_size);
 #endif
 
     draw_bg(draw_ctx, dsc, coords);
     draw_bg_img(draw_ctx, dsc, coords);
 }
 
+void lv_draw_sw_shadow_cache_get_stats(lv_draw_sw_shadow_cache_stats_t * stats)
+{
+#if SHADOW_CACHE
+    *stats = sh_cache_stats;
+#else
+    lv_memset_00(stats, sizeof(lv_draw_sw_shadow_cache_stats_t));
+#endif
+}
+
+void lv_draw_sw_shadow_cache_clear(void)
+{
+#if SHADOW_CACHE
+    uint32_t i;
+    for(i = 0; i < SHADOW_CACHE_ENTRY_CNT; i++) {
+        shadow_cache_free(&sh_cache[i]);
+    }
+#endif
+}
+
 
 /**********************
  *   STATIC FUNCTIONS
@@ -233,7 +284,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             if(dither_func) dither_func(grad, blend_area.x1,  h - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[h - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_mask_runs(draw_ctx, &blend_dsc);
         }
         goto bg_clean_up;
     }
@@ -259,7 +310,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             if(dither_func) dither_func(grad, blend_area.x1,  top_y - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[top_y - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_mask_runs(draw_ctx, &blend_dsc);
         }
 
         if(bottom_y <= clipped_coords.y2) {
@@ -270,7 +321,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             if(dither_func) dither_func(grad, blend_area.x1,  bottom_y - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[bottom_y - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_mask_runs(draw_ctx, &blend_dsc);
         }
     }
 
@@ -309,7 +360,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             if(dither_func) dither_func(grad, blend_area.x1,  h - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[h - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_mask_runs(draw_ctx, &blend_dsc);
         }
     }
 
@@ -430,6 +481,69 @@ static void draw_border(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc
 }
 
 #if LV_DRAW_COMPLEX
+/**
+ * Blend a masked line. The long fully covered and fully transparent parts of the mask
+ * are filled without the mask or skipped.
+ * @param draw_ctx      pointer to a draw context
+ * @param dsc           `blend_area` is one line and the mask has to start at its first pixel
+ */
+LV_ATTRIBUTE_FAST_MEM static void blend_mask_runs(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    if(dsc->mask_buf == NULL || dsc->mask_res != LV_DRAW_MASK_RES_CHANGED) {
+        lv_draw_sw_blend(draw_ctx, dsc);
+        return;
+    }
+
+    const lv_area_t * line_area = dsc->blend_area;
+    const lv_opa_t * mask = dsc->mask_buf;
+    lv_coord_t w = lv_area_get_width(line_area);
+
+    lv_area_t run_area = *line_area;
+    lv_draw_sw_blend_dsc_t run_dsc = *dsc;
+    run_dsc.blend_area = &run_area;
+
+    lv_coord_t masked_start = 0;    /*Start of the part not blended yet*/
+    lv_coord_t i = 0;
+    while(i < w) {
+        lv_opa_t v = mask[i];
+        if(v != LV_OPA_TRANSP && v != LV_OPA_COVER) {
+            i++;
+            continue;
+        }
+
+        lv_coord_t run_start = i;
+        while(i < w && mask[i] == v) i++;
+        if(i - run_start < BLEND_RUN_MIN) continue;
+
+        /*Blend the part before the run with the mask*/
+        if(run_start > masked_start) {
+            run_area.x1 = line_area->x1 + masked_start;
+            run_area.x2 = line_area->x1 + run_start - 1;
+            run_dsc.mask_buf = dsc->mask_buf;
+            run_dsc.src_buf = dsc->src_buf ? dsc->src_buf + masked_start : NULL;
+            lv_draw_sw_blend(draw_ctx, &run_dsc);
+        }
+
+        /*Fill the covered run without the mask and skip the transparent one*/
+        if(v == LV_OPA_COVER) {
+            run_area.x1 = line_area->x1 + run_start;
+            run_area.x2 = line_area->x1 + i - 1;
+            run_dsc.mask_buf = NULL;
+            run_dsc.src_buf = dsc->src_buf ? dsc->src_buf + run_start : NULL;
+            lv_draw_sw_blend(draw_ctx, &run_dsc);
+        }
+        masked_start = i;
+    }
+
+    if(w > masked_start) {
+        run_area.x1 = line_area->x1 + masked_start;
+        run_area.x2 = line_area->x2;
+        run_dsc.mask_buf = dsc->mask_buf;
+        run_dsc.src_buf = dsc->src_buf ? dsc->src_buf + masked_start : NULL;
+        lv_draw_sw_blend(draw_ctx, &run_dsc);
+    }
+}
+
 LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
                                               const lv_area_t * coords)
 {
@@ -486,22 +600,24 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
+    shadow_cache_entry_t * cached = shadow_cache_find(corner_size, r_sh, &core_area);
+    if(cached) {
         /*Use the cache if available*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        lv_memcpy(sh_buf, cached->buf, corner_size * corner_size);
+        cached->life = ++sh_cache_life;
+        sh_cache_stats.hit_cnt++;
     }
     else {
+        sh_cache_stats.miss_cnt++;
+    }
+
+    if(!cached) {
         /*A larger buffer is required for calculation*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+        if(corner_size <= LV_SHADOW_CACHE_SIZE) shadow_cache_add(sh_buf, corner_size, r_sh, &core_area);
     }
 #else
     sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
@@ -1111,6 +1227,83 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
 }
 #endif
 
+#if SHADOW_CACHE
+/**
+ * Find a cached shadow corner
+ * @param corner_size   shadow width + radius
+ * @param r             the clamped radius of the shadow
+ * @param core_area     the rectangle which is blurred
+ * @return              the entry or NULL if not cached
+ */
+static shadow_cache_entry_t * shadow_cache_find(lv_coord_t corner_size, lv_coord_t r, const lv_area_t * core_area)
+{
+    lv_coord_t w = LV_MIN(lv_area_get_width(core_area), 2 * corner_size);
+    lv_coord_t h = LV_MIN(lv_area_get_height(core_area), 2 * corner_size);
+
+    uint32_t i;
+    for(i = 0; i < SHADOW_CACHE_ENTRY_CNT; i++) {
+        shadow_cache_entry_t * e = &sh_cache[i];
+        if(e->buf && e->corner_size == corner_size && e->r == r && e->w == w && e->h == h) return e;
+    }
+
+    return NULL;
+}
+
+/**
+ * Save a shadow corner. Free the least recently used ones if the cache is full.
+ * @param sh_buf        the blurred corner
+ * @param corner_size   shadow width + radius
+ * @param r             the clamped radius of the shadow
+ * @param core_area     the rectangle which was blurred
+ */
+static void shadow_cache_add(const lv_opa_t * sh_buf, lv_coord_t corner_size, lv_coord_t r,
+                             const lv_area_t * core_area)
+{
+    uint32_t size = (uint32_t)corner_size * corner_size;
+    if(size > LV_SHADOW_CACHE_BUF_MAX_SIZE) return;
+
+    shadow_cache_entry_t * e = NULL;
+    while(true) {
+        shadow_cache_entry_t * lru = NULL;
+        e = NULL;
+        uint32_t i;
+        for(i = 0; i < SHADOW_CACHE_ENTRY_CNT; i++) {
+            if(sh_cache[i].buf == NULL) {
+                if(e == NULL) e = &sh_cache[i];
+            }
+            else if(lru == NULL || sh_cache[i].life < lru->life) {
+                lru = &sh_cache[i];
+            }
+        }
+
+        if(e && sh_cache_stats.size + size <= LV_SHADOW_CACHE_BUF_MAX_SIZE) break;
+        shadow_cache_free(lru);
+    }
+
+    e->buf = lv_mem_alloc(size);
+    if(e->buf) {
+        lv_memcpy(e->buf, sh_buf, size);
+        e->corner_size = corner_size;
+        e->r = r;
+        e->w = LV_MIN(lv_area_get_width(core_area), 2 * corner_size);
+        e->h = LV_MIN(lv_area_get_height(core_area), 2 * corner_size);
+        e->life = ++sh_cache_life;
+        sh_cache_stats.size += size;
+        sh_cache_stats.entry_cnt++;
+    }
+}
+
+static void shadow_cache_free(shadow_cache_entry_t * e)
+{
+    if(e->buf == NULL) return;
+
+    lv_mem_free(e->buf);
+    e->buf = NULL;
+    sh_cache_stats.size -= (uint32_t)e->corner_size * e->corner_size;
+    sh_cache_stats.entry_cnt--;
+}
+#endif
+
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
     if(dsc->outline_opa <= LV_OPA_MIN) return;
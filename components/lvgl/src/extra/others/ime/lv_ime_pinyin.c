@@ -33,12 +33,13 @@ static void init_pinyin_dict(lv_obj_t * obj, lv_pinyin_dict_t * dict);
 static void pinyin_input_proc(lv_obj_t * obj);
 static void pinyin_page_proc(lv_obj_t * obj, uint16_t btn);
 static char * pinyin_search_matching(lv_obj_t * obj, char * py_str, uint16_t * cand_num);
+static uint16_t pinyin_trie_search(lv_obj_t * obj, const char * py_str);
+static uint16_t pinyin_trie_get_child(const lv_ime_pinyin_node_t * trie, uint16_t node, char c);
 static void pinyin_ime_clear_data(lv_obj_t * obj);
 
 #if LV_IME_PINYIN_USE_K9_MODE
     static void pinyin_k9_init_data(lv_obj_t * obj);
     static void pinyin_k9_get_legal_py(lv_obj_t * obj, char * k9_input, const char * py9_map[]);
-    static bool pinyin_k9_is_valid_py(lv_obj_t * obj, char * py_str);
     static void pinyin_k9_fill_cand(lv_obj_t * obj);
     static void pinyin_k9_cand_page_proc(lv_obj_t * obj, uint16_t dir);
 #endif
@@ -57,14 +58,14 @@ const lv_obj_class_t lv_ime_pinyin_class = {
 };
 
 #if LV_IME_PINYIN_USE_K9_MODE
-static char * lv_btnm_def_pinyin_k9_map[LV_IME_PINYIN_K9_CAND_TEXT_NUM + 20] = {\
+static char * lv_btnm_def_pinyin_k9_map[LV_IME_PINYIN_K9_CAND_TEXT_NUM + 21] = {\
                                                                                 ",\0", "1#\0",  "abc \0", "def\0",  LV_SYMBOL_BACKSPACE"\0", "\n\0",
                                                                                 ".\0", "ghi\0", "jkl\0", "mno\0",  LV_SYMBOL_KEYBOARD"\0", "\n\0",
                                                                                 "?\0", "pqrs\0", "tuv\0", "wxyz\0",  LV_SYMBOL_NEW_LINE"\0", "\n\0",
                                                                                 LV_SYMBOL_LEFT"\0", "\0"
                                                                                };
 
-static lv_btnmatrix_ctrl_t default_kb_ctrl_k9_map[LV_IME_PINYIN_K9_CAND_TEXT_NUM + 16] = { 1 };
+static lv_btnmatrix_ctrl_t default_kb_ctrl_k9_map[LV_IME_PINYIN_K9_CAND_TEXT_NUM + 17] = { 1 };
 static char   lv_pinyin_k9_cand_str[LV_IME_PINYIN_K9_CAND_TEXT_NUM + 2][LV_IME_PINYIN_K9_MAX_INPUT] = {0};
 #endif
 
@@ -467,8 +468,8 @@ void lv_ime_pinyin_set_mode(lv_obj_t * obj, lv_ime_pinyin_mode_t mode)
 #if LV_IME_PINYIN_USE_K9_MODE
     if(pinyin_ime->mode == LV_IME_PINYIN_MODE_K9) {
         pinyin_k9_init_data(obj);
-        lv_keyboard_set_map(pinyin_ime->kb, LV_KEYBOARD_MODE_USER_1, (const char *)lv_btnm_def_pinyin_k9_map,
-                            (const)default_kb_ctrl_k9_map);
+        lv_keyboard_set_map(pinyin_ime->kb, LV_KEYBOARD_MODE_USER_1, (const char **)lv_btnm_def_pinyin_k9_map,
+                            default_kb_ctrl_k9_map);
         lv_keyboard_set_mode(pinyin_ime->kb, LV_KEYBOARD_MODE_USER_1);
     }
 #endif
@@ -559,8 +560,9 @@ static void lv_ime_pinyin_constructor(const lv_obj_class_t * class_p, lv_obj_t *
     pinyin_ime->ta_count = 0;
     pinyin_ime->cand_num = 0;
     lv_memset_00(pinyin_ime->input_char, sizeof(pinyin_ime->input_char));
-    lv_memset_00(pinyin_ime->py_num, sizeof(pinyin_ime->py_num));
-    lv_memset_00(pinyin_ime->py_pos, sizeof(pinyin_ime->py_pos));
+    pinyin_ime->dict = NULL;
+    pinyin_ime->trie = NULL;
+    pinyin_ime->search_len = 0;
 
     lv_obj_set_size(obj, LV_PCT(100), LV_PCT(55));
     lv_obj_align(obj, LV_ALIGN_BOTTOM_MID, 0, 0);
@@ -625,6 +627,13 @@ static void lv_ime_pinyin_destructor(const lv_obj_class_t * class_p, lv_obj_t *
 
     if(lv_obj_is_valid(pinyin_ime->cand_panel))
         lv_obj_del(pinyin_ime->cand_panel);
+
+    lv_mem_free(pinyin_ime->trie);
+    pinyin_ime->trie = NULL;
+
+#if LV_IME_PINYIN_USE_K9_MODE
+    _lv_ll_clear(&pinyin_ime->k9_legal_py_ll);
+#endif
 }
 
 
@@ -713,10 +722,10 @@ static void lv_ime_pinyin_kb_event(lv_event_t * e)
         }
         else if(strcmp(txt, LV_SYMBOL_KEYBOARD) == 0) {
             if(pinyin_ime->mode == LV_IME_PINYIN_MODE_K26) {
-                lv_ime_pinyin_set_mode(pinyin_ime, LV_IME_PINYIN_MODE_K9);
+                lv_ime_pinyin_set_mode(obj, LV_IME_PINYIN_MODE_K9);
             }
             else {
-                lv_ime_pinyin_set_mode(pinyin_ime, LV_IME_PINYIN_MODE_K26);
+                lv_ime_pinyin_set_mode(obj, LV_IME_PINYIN_MODE_K26);
                 lv_keyboard_set_mode(pinyin_ime->kb, LV_KEYBOARD_MODE_TEXT_LOWER);
             }
             pinyin_ime_clear_data(obj);
@@ -868,38 +877,60 @@ static void lv_ime_pinyin_style_change_event(lv_event_t * e)
 }
 
 
+/**
+ * Build a prefix tree from the dictionary. Each node stores the first entry starting with its prefix
+ * so a pinyin can be looked up letter by letter without comparing it with the other entries.
+ */
 static void init_pinyin_dict(lv_obj_t * obj, lv_pinyin_dict_t * dict)
 {
     lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
 
-    char headletter = 'a';
-    uint16_t offset_sum = 0;
-    uint16_t offset_count = 0;
-    uint16_t letter_calc = 0;
-
     pinyin_ime->dict = dict;
-
-    for(uint16_t i = 0; ; i++) {
-        if((NULL == (dict[i].py)) || (NULL == (dict[i].py_mb))) {
-            headletter = dict[i - 1].py[0];
-            letter_calc = headletter - 'a';
-            pinyin_ime->py_num[letter_calc] = offset_count;
-            break;
-        }
-
-        if(headletter == (dict[i].py[0])) {
-            offset_count++;
-        }
-        else {
-            headletter = dict[i].py[0];
-            letter_calc = headletter - 'a';
-            pinyin_ime->py_num[letter_calc - 1] = offset_count;
-            offset_sum += offset_count;
-            pinyin_ime->py_pos[letter_calc] = offset_sum;
-
-            offset_count = 1;
+    pinyin_ime->search_len = 0;
+    lv_mem_free(pinyin_ime->trie);
+    pinyin_ime->trie = NULL;
+    if(dict == NULL) return;
+
+    /*There can't be more nodes than letters in the dictionary (+1 for the root)*/
+    uint32_t node_max = 1;
+    uint32_t i;
+    for(i = 0; (dict[i].py != NULL) && (dict[i].py_mb != NULL); i++) {
+        node_max += strlen(dict[i].py);
+    }
+    if(node_max > UINT16_MAX) node_max = UINT16_MAX;
+
+    lv_ime_pinyin_node_t * trie = lv_mem_alloc(node_max * sizeof(lv_ime_pinyin_node_t));
+    LV_ASSERT_MALLOC(trie);
+    if(trie == NULL) return;
+
+    uint16_t node_cnt = 1;
+    lv_memset_00(&trie[0], sizeof(lv_ime_pinyin_node_t));
+
+    for(i = 0; (dict[i].py != NULL) && (dict[i].py_mb != NULL) && (i <= UINT16_MAX); i++) {
+        uint16_t node = 0;
+        const char * py;
+        for(py = dict[i].py; *py != '\0'; py++) {
+            uint16_t child = pinyin_trie_get_child(trie, node, *py);
+            if(child == 0) {
+                if(node_cnt == node_max) {
+                    LV_LOG_WARN("init_pinyin_dict: the dictionary is too large");
+                    break;
+                }
+                /*The entries are added in order so the first one with a new prefix creates its node*/
+                child = node_cnt++;
+                trie[child].c = *py;
+                trie[child].dict_id = i;
+                trie[child].child = 0;
+                trie[child].sibling = trie[node].child;
+                trie[node].child = child;
+            }
+            node = child;
         }
     }
+
+    /*Release the unused nodes*/
+    pinyin_ime->trie = lv_mem_realloc(trie, node_cnt * sizeof(lv_ime_pinyin_node_t));
+    if(pinyin_ime->trie == NULL) pinyin_ime->trie = trie;
 }
 
 
@@ -907,37 +938,64 @@ static char * pinyin_search_matching(lv_obj_t * obj, char * py_str, uint16_t * c
 {
     lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
 
-    lv_pinyin_dict_t * cpHZ;
-    uint8_t index, len = 0, offset;
-    volatile uint8_t count = 0;
-
     if(*py_str == '\0')    return NULL;
     if(*py_str == 'i')     return NULL;
     if(*py_str == 'u')     return NULL;
     if(*py_str == 'v')     return NULL;
 
-    offset = py_str[0] - 'a';
-    len = strlen(py_str);
+    uint16_t node = pinyin_trie_search(obj, py_str);
+    if(node == 0) return NULL;
 
-    cpHZ  = &pinyin_ime->dict[pinyin_ime->py_pos[offset]];
-    count = pinyin_ime->py_num[offset];
+    const char * py_mb = pinyin_ime->dict[pinyin_ime->trie[node].dict_id].py_mb;
 
-    while(count--) {
-        for(index = 0; index < len; index++) {
-            if(*(py_str + index) != *((cpHZ->py) + index)) {
-                break;
-            }
-        }
+    // The Chinese character in UTF-8 encoding format is 3 bytes
+    *cand_num = strlen(py_mb) / 3;
+    return (char *)py_mb;
+}
 
-        // perfect match
-        if(len == 1 || index == len) {
-            // The Chinese character in UTF-8 encoding format is 3 bytes
-            * cand_num = strlen((const char *)(cpHZ->py_mb)) / 3;
-            return (char *)(cpHZ->py_mb);
+/**
+ * Find the node of a pinyin in the prefix tree.
+ * The nodes of the common prefix with the previous search are reused,
+ * so typing or deleting a letter steps at most one node.
+ * @param obj     pointer to a Pinyin input method object
+ * @param py_str  the pinyin to find
+ * @return        index of the node of `py_str` or 0 if no entry starts with `py_str`
+ */
+static uint16_t pinyin_trie_search(lv_obj_t * obj, const char * py_str)
+{
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
+    if(pinyin_ime->trie == NULL) return 0;
+
+    uint8_t len = 0;
+    while(len < pinyin_ime->search_len && py_str[len] == pinyin_ime->search_str[len]) len++;
+
+    uint16_t node = len > 0 ? pinyin_ime->search_path[len - 1] : 0;
+    while(py_str[len] != '\0') {
+        if(len >= sizeof(pinyin_ime->search_str)) {
+            node = 0;
+            break;
         }
-        cpHZ++;
+
+        node = pinyin_trie_get_child(pinyin_ime->trie, node, py_str[len]);
+        if(node == 0) break;
+
+        pinyin_ime->search_str[len] = py_str[len];
+        pinyin_ime->search_path[len] = node;
+        len++;
+    }
+    pinyin_ime->search_len = len;
+
+    return node;
+}
+
+static uint16_t pinyin_trie_get_child(const lv_ime_pinyin_node_t * trie, uint16_t node, char c)
+{
+    uint16_t child;
+    for(child = trie[node].child; child != 0; child = trie[child].sibling) {
+        if(trie[child].c == c) return child;
     }
-    return NULL;
+
+    return 0;
 }
 
 static void pinyin_ime_clear_data(lv_obj_t * obj)
@@ -968,7 +1026,7 @@ static void pinyin_ime_clear_data(lv_obj_t * obj)
 #if LV_IME_PINYIN_USE_K9_MODE
 static void pinyin_k9_init_data(lv_obj_t * obj)
 {
-    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
+    LV_UNUSED(obj);
 
     uint16_t py_str_i = 0;
     uint16_t btnm_i = 0;
@@ -997,21 +1055,26 @@ static void pinyin_k9_init_data(lv_obj_t * obj)
     default_kb_ctrl_k9_map[LV_IME_PINYIN_K9_CAND_TEXT_NUM + 16] = LV_KEYBOARD_CTRL_BTN_FLAGS | 1;
 }
 
+/**
+ * Collect the pinyins which can be typed with the keys in `k9_input`.
+ * Only the letters continuing a prefix of the dictionary are tried,
+ * so the combinations are dropped at their first invalid letter.
+ */
 static void pinyin_k9_get_legal_py(lv_obj_t * obj, char * k9_input, const char * py9_map[])
 {
     lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
 
     uint16_t len = strlen(k9_input);
 
-    if((len == 0) || (len >= LV_IME_PINYIN_K9_MAX_INPUT)) {
+    if((len == 0) || (len >= LV_IME_PINYIN_K9_MAX_INPUT) || (pinyin_ime->trie == NULL)) {
         return;
     }
 
     char py_comp[LV_IME_PINYIN_K9_MAX_INPUT] = {0};
-    int mark[LV_IME_PINYIN_K9_MAX_INPUT] = {0};
+    uint16_t node[LV_IME_PINYIN_K9_MAX_INPUT] = {0};   /*node[i]: the node of the first i letters*/
+    uint8_t mark[LV_IME_PINYIN_K9_MAX_INPUT] = {0};
     int index = 0;
-    int flag = 0;
-    int count = 0;
+    uint32_t count = 0;
 
     uint32_t ll_len = 0;
     ime_pinyin_k9_py_str_t * ll_index = NULL;
@@ -1021,25 +1084,32 @@ static void pinyin_k9_get_legal_py(lv_obj_t * obj, char * k9_input, const char *
 
     while(index != -1) {
         if(index == len) {
-            if(pinyin_k9_is_valid_py(obj, py_comp)) {
-                if((count >= ll_len) || (ll_len == 0)) {
-                    ll_index = _lv_ll_ins_tail(&pinyin_ime->k9_legal_py_ll);
-                    strcpy(ll_index->py_str, py_comp);
-                }
-                else if((count < ll_len)) {
-                    strcpy(ll_index->py_str, py_comp);
-                    ll_index = _lv_ll_get_next(&pinyin_ime->k9_legal_py_ll, ll_index);
-                }
-                count++;
+            if((count >= ll_len) || (ll_len == 0)) {
+                ll_index = _lv_ll_ins_tail(&pinyin_ime->k9_legal_py_ll);
+                strcpy(ll_index->py_str, py_comp);
+            }
+            else if((count < ll_len)) {
+                strcpy(ll_index->py_str, py_comp);
+                ll_index = _lv_ll_get_next(&pinyin_ime->k9_legal_py_ll, ll_index);
             }
+            count++;
             index--;
         }
         else {
-            flag = mark[index];
-            if(flag < strlen(py9_map[k9_input[index] - '2'])) {
-                py_comp[index] = py9_map[k9_input[index] - '2'][flag];
-                mark[index] = mark[index] + 1;
-                index++;
+            const char * letters = py9_map[k9_input[index] - '2'];
+            char c = letters[mark[index]];
+            if(c != '\0') {
+                mark[index]++;
+
+                /*No pinyin starts with 'i', 'u' or 'v'*/
+                if(index == 0 && (c == 'i' || c == 'u' || c == 'v')) continue;
+
+                uint16_t child = pinyin_trie_get_child(pinyin_ime->trie, node[index], c);
+                if(child != 0) {
+                    py_comp[index] = c;
+                    index++;
+                    if(index < len) node[index] = child;
+                }
             }
             else {
                 mark[index] = 0;
@@ -1055,44 +1125,6 @@ static void pinyin_k9_get_legal_py(lv_obj_t * obj, char * k9_input, const char *
 }
 
 
-/*true: visible; false: not visible*/
-static bool pinyin_k9_is_valid_py(lv_obj_t * obj, char * py_str)
-{
-    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)obj;
-
-    lv_pinyin_dict_t * cpHZ = NULL;
-    uint8_t index = 0, len = 0, offset = 0;
-    uint16_t ret = 1;
-    volatile uint8_t count = 0;
-
-    if(*py_str == '\0')    return false;
-    if(*py_str == 'i')     return false;
-    if(*py_str == 'u')     return false;
-    if(*py_str == 'v')     return false;
-
-    offset = py_str[0] - 'a';
-    len = strlen(py_str);
-
-    cpHZ  = &pinyin_ime->dict[pinyin_ime->py_pos[offset]];
-    count = pinyin_ime->py_num[offset];
-
-    while(count--) {
-        for(index = 0; index < len; index++) {
-            if(*(py_str + index) != *((cpHZ->py) + index)) {
-                break;
-            }
-        }
-
-        // perfect match
-        if(len == 1 || index == len) {
-            return true;
-        }
-        cpHZ++;
-    }
-    return false;
-}
-
-
 static void pinyin_k9_fill_cand(lv_obj_t * obj)
 {
     static uint16_t len = 0;
@@ -1141,7 +1173,6 @@ static void pinyin_k9_cand_page_proc(lv_obj_t * obj, uint16_t dir)
 
     if((ll_len > LV_IME_PINYIN_K9_CAND_TEXT_NUM) && (pinyin_ime->k9_legal_py_count > LV_IME_PINYIN_K9_CAND_TEXT_NUM)) {
         ime_pinyin_k9_py_str_t * ll_index = NULL;
-        uint16_t tmp_btn_str_len = 0;
         int count = 0;
 
         ll_index = _lv_ll_get_head(&pinyin_ime->k9_legal_py_ll);
@@ -36,6 +36,14 @@ typedef struct {
     const char * const py_mb;
 } lv_pinyin_dict_t;
 
+/*A node of the prefix tree built from the dictionary*/
+typedef struct {
+    uint16_t child;     /*Index of the first child node, 0: no children*/
+    uint16_t sibling;   /*Index of the next node with the same parent, 0: last one*/
+    uint16_t dict_id;   /*The first dictionary entry whose pinyin starts with the prefix of this node*/
+    char c;             /*The last letter of the prefix*/
+} lv_ime_pinyin_node_t;
+
 /*Data of 9-key input(k9) mode*/
 typedef struct {
     char py_str[7];
@@ -47,6 +55,7 @@ typedef struct {
     lv_obj_t * kb;
     lv_obj_t * cand_panel;
     lv_pinyin_dict_t * dict;
+    lv_ime_pinyin_node_t * trie; /* Prefix tree of the dictionary, the root is `trie[0]` */
     lv_ll_t k9_legal_py_ll;
     char * cand_str;            /* Candidate string */
     char   input_char[16];      /* Input box character */
@@ -59,8 +68,9 @@ typedef struct {
     uint16_t ta_count;          /* The number of characters entered in the text box this time */
     uint16_t cand_num;          /* Number of candidates */
     uint16_t py_page;           /* Current pinyin map pages(k26) */
-    uint16_t py_num[26];        /* Number and length of Pinyin */
-    uint16_t py_pos[26];        /* Pinyin position */
+    uint16_t search_path[16];   /* Trie node of each prefix of `search_str` */
+    char     search_str[16];    /* The pinyin looked up last time */
+    uint8_t  search_len;        /* Length of the valid part of `search_str` */
     uint8_t  mode : 1;          /* Set mode, 1: 26-key input(k26), 0: 9-key input(k9). Default: 1. */
 } lv_ime_pinyin_t;
 
@@ -10,11 +10,22 @@
 #if LV_USE_MSG
 
 #include "../../../misc/lv_assert.h"
-#include "../../../misc/lv_ll.h"
+#include "../../../misc/lv_timer.h"
+
+#if LV_MSG_THREAD_SAFE
+    #if defined(ESP_PLATFORM)
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/semphr.h"
+    #else
+        #include <pthread.h>
+    #endif
+#endif
 
 /*********************
  *      DEFINES
  *********************/
+/*Number of hash buckets at the first subscription. Doubled when there are more topics than buckets.*/
+#define BUCKET_CNT_INIT     16
 
 /**********************
  *      TYPEDEFS
@@ -25,20 +36,57 @@ typedef struct {
     lv_msg_subscribe_cb_t callback;
     void * user_data;
     void * _priv_data;      /*Internal: used only store 'obj' in lv_obj_subscribe*/
+    uint8_t removed : 1;    /*Unsubscribed while the message was being sent to the subscribers*/
 } sub_dsc_t;
 
+/*The subscribers of a message ID*/
+typedef struct _topic_t {
+    struct _topic_t * next;         /*Next topic in the same hash bucket*/
+    struct _topic_t * next_posted;  /*Next topic with a posted message*/
+    const void * posted_payload;    /*Payload of the last posted message*/
+    sub_dsc_t ** subs;              /*The subscribers in the order of subscription*/
+    uint32_t sub_cnt;
+    uint32_t sub_size;
+    uint32_t msg_id;
+    uint16_t notifying;             /*Nesting level of sending a message to the subscribers*/
+    uint8_t has_removed;            /*Some subscribers are only marked as removed*/
+    uint8_t posted;                 /*A posted message is waiting for delivery. Not a bit field as it's set under lock.*/
+} topic_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
-static void notify(lv_msg_t * m);
+static void notify(topic_t * t, lv_msg_t * m);
+static topic_t * topic_find(uint32_t msg_id);
+static topic_t * topic_create(uint32_t msg_id);
+static void topic_remove_if_unused(topic_t * t);
+static void sub_remove(topic_t * t, uint32_t i);
+static uint32_t unsubscribe_obj(topic_t * t, lv_obj_t * obj);
+static bool buckets_resize(uint32_t cnt);
+static uint32_t hash(uint32_t msg_id);
+static void post_timer_cb(lv_timer_t * timer);
+static void lock(void);
+static void unlock(void);
 static void obj_notify_cb(void * s, lv_msg_t * m);
 static void obj_delete_event_cb(lv_event_t * e);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-static lv_ll_t subs_ll;
+static topic_t ** buckets;
+static uint32_t bucket_cnt;
+static uint32_t topic_cnt;
+static topic_t * posted_head;
+static topic_t * posted_tail;
+
+#if LV_MSG_THREAD_SAFE
+    #if defined(ESP_PLATFORM)
+        static SemaphoreHandle_t mutex;
+    #else
+        static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    #endif
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -56,20 +104,53 @@ lv_event_code_t LV_EVENT_MSG_RECEIVED;
 void lv_msg_init(void)
 {
     LV_EVENT_MSG_RECEIVED = lv_event_register_id();
-    _lv_ll_init(&subs_ll, sizeof(sub_dsc_t));
+
+    buckets = NULL;
+    bucket_cnt = 0;
+    topic_cnt = 0;
+    posted_head = NULL;
+    posted_tail = NULL;
+
+#if LV_MSG_THREAD_SAFE && defined(ESP_PLATFORM)
+    if(mutex == NULL) mutex = xSemaphoreCreateMutex();
+    LV_ASSERT_NULL(mutex);
+#endif
+
+    lv_timer_create(post_timer_cb, LV_MSG_POST_PERIOD, NULL);
 }
 
 void * lv_msg_subsribe(uint32_t msg_id, lv_msg_subscribe_cb_t cb, void * user_data)
 {
-    sub_dsc_t * s = _lv_ll_ins_tail(&subs_ll);
+    topic_t * t = topic_find(msg_id);
+    if(t == NULL) t = topic_create(msg_id);
+    if(t == NULL) return NULL;
+
+    if(t->sub_cnt == t->sub_size) {
+        uint32_t size = t->sub_size ? t->sub_size * 2 : 2;
+        sub_dsc_t ** subs = lv_mem_realloc(t->subs, size * sizeof(sub_dsc_t *));
+        LV_ASSERT_MALLOC(subs);
+        if(subs == NULL) {
+            topic_remove_if_unused(t);
+            return NULL;
+        }
+        t->subs = subs;
+        t->sub_size = size;
+    }
+
+    sub_dsc_t * s = lv_mem_alloc(sizeof(sub_dsc_t));
     LV_ASSERT_MALLOC(s);
-    if(s == NULL) return NULL;
+    if(s == NULL) {
+        topic_remove_if_unused(t);
+        return NULL;
+    }
 
     lv_memset_00(s, sizeof(*s));
 
     s->msg_id = msg_id;
     s->callback = cb;
     s->user_data = user_data;
+    t->subs[t->sub_cnt] = s;
+    t->sub_cnt++;
     return s;
 }
 
@@ -90,24 +171,44 @@ void * lv_msg_subsribe_obj(uint32_t msg_id, lv_obj_t * obj, void * user_data)
 void lv_msg_unsubscribe(void * s)
 {
     LV_ASSERT_NULL(s);
-    _lv_ll_remove(&subs_ll, s);
-    lv_mem_free(s);
+    sub_dsc_t * sub = s;
+    topic_t * t = topic_find(sub->msg_id);
+    LV_ASSERT_NULL(t);
+    if(t == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < t->sub_cnt; i++) {
+        if(t->subs[i] == sub) {
+            sub_remove(t, i);
+            break;
+        }
+    }
+
+    topic_remove_if_unused(t);
 }
 
 uint32_t lv_msg_unsubscribe_obj(uint32_t msg_id, lv_obj_t * obj)
 {
+    if(msg_id != LV_MSG_ID_ANY) {
+        topic_t * t = topic_find(msg_id);
+        if(t == NULL) return 0;
+
+        uint32_t cnt = unsubscribe_obj(t, obj);
+        topic_remove_if_unused(t);
+        return cnt;
+    }
+
     uint32_t cnt = 0;
-    sub_dsc_t * s = _lv_ll_get_head(&subs_ll);
-    while(s) {
-        sub_dsc_t * s_next = _lv_ll_get_next(&subs_ll, s);
-        if(s->callback == obj_notify_cb &&
-           (s->msg_id == LV_MSG_ID_ANY || s->msg_id == msg_id) &&
-           (obj == NULL || s->_priv_data == obj)) {
-            lv_msg_unsubscribe(s);
-            cnt++;
+    uint32_t b;
+    for(b = 0; b < bucket_cnt; b++) {
+        topic_t * t = buckets[b];
+        while(t) {
+            /*The topic might be removed so get the next one while it's surely valid*/
+            topic_t * t_next = t->next;
+            cnt += unsubscribe_obj(t, obj);
+            topic_remove_if_unused(t);
+            t = t_next;
         }
-
-        s = s_next;
     }
 
     return cnt;
@@ -115,11 +216,34 @@ uint32_t lv_msg_unsubscribe_obj(uint32_t msg_id, lv_obj_t * obj)
 
 void lv_msg_send(uint32_t msg_id, const void * payload)
 {
+    topic_t * t = topic_find(msg_id);
+    if(t == NULL) return;   /*No subscribers*/
+
     lv_msg_t m;
     lv_memset_00(&m, sizeof(m));
     m.id = msg_id;
     m.payload = payload;
-    notify(&m);
+    notify(t, &m);
+}
+
+void lv_msg_post(uint32_t msg_id, const void * payload)
+{
+    lock();
+
+    /*Only the topics are modified under the lock, the subscribers are not touched here*/
+    topic_t * t = topic_find(msg_id);
+    if(t) {
+        t->posted_payload = payload;
+        if(!t->posted) {
+            t->posted = 1;
+            t->next_posted = NULL;
+            if(posted_tail) posted_tail->next_posted = t;
+            else posted_head = t;
+            posted_tail = t;
+        }
+    }
+
+    unlock();
 }
 
 uint32_t lv_msg_get_id(lv_msg_t * m)
@@ -152,16 +276,240 @@ lv_msg_t * lv_event_get_msg(lv_event_t * e)
  *   STATIC FUNCTIONS
  **********************/
 
-static void notify(lv_msg_t * m)
+static void notify(topic_t * t, lv_msg_t * m)
 {
-    sub_dsc_t * s;
-    _LV_LL_READ(&subs_ll, s) {
-        if(s->msg_id == m->id && s->callback) {
-            m->user_data = s->user_data;
-            m->_priv_data = s->_priv_data;
-            s->callback(s, m);
+    /*The subscribers can't be removed from the array while it's being iterated,
+     *and the subscribers added in the callbacks will get only the next message*/
+    t->notifying++;
+    uint32_t cnt = t->sub_cnt;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        sub_dsc_t * s = t->subs[i];
+        if(s->removed || s->callback == NULL) continue;
+
+        m->user_data = s->user_data;
+        m->_priv_data = s->_priv_data;
+        s->callback(s, m);
+    }
+    t->notifying--;
+    if(t->notifying > 0) return;
+
+    /*Really remove the subscribers unsubscribed in the callbacks*/
+    if(t->has_removed) {
+        uint32_t j = 0;
+        for(i = 0; i < t->sub_cnt; i++) {
+            if(t->subs[i]->removed) lv_mem_free(t->subs[i]);
+            else t->subs[j++] = t->subs[i];
         }
+        t->sub_cnt = j;
+        t->has_removed = 0;
     }
+
+    topic_remove_if_unused(t);
+}
+
+/**
+ * Get the subscribers of a message ID
+ * @param msg_id    the message ID
+ * @return          the topic of `msg_id` or NULL if it has no subscribers
+ */
+static topic_t * topic_find(uint32_t msg_id)
+{
+    if(bucket_cnt == 0) return NULL;
+
+    topic_t * t = buckets[hash(msg_id) & (bucket_cnt - 1)];
+    while(t) {
+        if(t->msg_id == msg_id) return t;
+        t = t->next;
+    }
+
+    return NULL;
+}
+
+static topic_t * topic_create(uint32_t msg_id)
+{
+    if(topic_cnt >= bucket_cnt) {
+        /*With the initial buckets it's fatal, later the chains are just longer*/
+        if(!buckets_resize(bucket_cnt ? bucket_cnt * 2 : BUCKET_CNT_INIT) && bucket_cnt == 0) return NULL;
+    }
+
+    topic_t * t = lv_mem_alloc(sizeof(topic_t));
+    LV_ASSERT_MALLOC(t);
+    if(t == NULL) return NULL;
+
+    lv_memset_00(t, sizeof(topic_t));
+    t->msg_id = msg_id;
+
+    lock();
+    uint32_t b = hash(msg_id) & (bucket_cnt - 1);
+    t->next = buckets[b];
+    buckets[b] = t;
+    topic_cnt++;
+    unlock();
+
+    return t;
+}
+
+/**
+ * Free a topic if it has no subscribers and it's not used by the sending or posting
+ * @param t         pointer to a topic
+ */
+static void topic_remove_if_unused(topic_t * t)
+{
+    if(t->sub_cnt > 0 || t->notifying > 0) return;
+
+    lock();
+    if(t->posted) {
+        unlock();
+        return;
+    }
+
+    topic_t ** p = &buckets[hash(t->msg_id) & (bucket_cnt - 1)];
+    while(*p != t) p = &(*p)->next;
+    *p = t->next;
+    topic_cnt--;
+    unlock();
+
+    lv_mem_free(t->subs);
+    lv_mem_free(t);
+}
+
+/**
+ * Unsubscribe the `i`th subscriber of a topic. It's only marked as removed if the topic is being notified.
+ * @param t         pointer to a topic
+ * @param i         index of the subscriber
+ */
+static void sub_remove(topic_t * t, uint32_t i)
+{
+    sub_dsc_t * s = t->subs[i];
+    if(t->notifying > 0) {
+        s->removed = 1;
+        t->has_removed = 1;
+        return;
+    }
+
+    memmove(&t->subs[i], &t->subs[i + 1], (t->sub_cnt - i - 1) * sizeof(sub_dsc_t *));
+    t->sub_cnt--;
+    lv_mem_free(s);
+}
+
+/**
+ * Unsubscribe an object from a topic. The topic is not removed even if it becomes unused.
+ * @param t         pointer to a topic
+ * @param obj       the object to unsubscribe or NULL for any object
+ * @return          number of unsubscriptions
+ */
+static uint32_t unsubscribe_obj(topic_t * t, lv_obj_t * obj)
+{
+    uint32_t cnt = 0;
+    uint32_t i = t->sub_cnt;
+    while(i > 0) {
+        i--;
+        sub_dsc_t * s = t->subs[i];
+        if(!s->removed && s->callback == obj_notify_cb && (obj == NULL || s->_priv_data == obj)) {
+            sub_remove(t, i);
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * Allocate new hash buckets and distribute the topics in them
+ * @param cnt       number of buckets, power of 2
+ * @return          true: success; false: out of memory, the old buckets are kept
+ */
+static bool buckets_resize(uint32_t cnt)
+{
+    topic_t ** new_buckets = lv_mem_alloc(cnt * sizeof(topic_t *));
+    LV_ASSERT_MALLOC(new_buckets);
+    if(new_buckets == NULL) return false;
+    lv_memset_00(new_buckets, cnt * sizeof(topic_t *));
+
+    lock();
+    uint32_t b;
+    for(b = 0; b < bucket_cnt; b++) {
+        topic_t * t = buckets[b];
+        while(t) {
+            topic_t * t_next = t->next;
+            uint32_t new_b = hash(t->msg_id) & (cnt - 1);
+            t->next = new_buckets[new_b];
+            new_buckets[new_b] = t;
+            t = t_next;
+        }
+    }
+
+    topic_t ** old_buckets = buckets;
+    buckets = new_buckets;
+    bucket_cnt = cnt;
+    unlock();
+
+    lv_mem_free(old_buckets);
+    return true;
+}
+
+static uint32_t hash(uint32_t msg_id)
+{
+    /*Mix the bits as the IDs are often multiples of a power of 2*/
+    msg_id ^= msg_id >> 16;
+    msg_id *= 0x45d9f3bU;
+    msg_id ^= msg_id >> 16;
+    return msg_id;
+}
+
+/**
+ * Deliver the messages posted since the last call
+ * @param timer     pointer to the timer
+ */
+static void post_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+
+    /*The messages posted by the subscribers are delivered only next time*/
+    lock();
+    topic_t * t = posted_head;
+    posted_head = NULL;
+    posted_tail = NULL;
+    unlock();
+
+    while(t) {
+        /*If it's posted again in the meantime the newer payload is delivered now*/
+        lock();
+        topic_t * t_next = t->next_posted;
+        lv_msg_t m;
+        lv_memset_00(&m, sizeof(m));
+        m.id = t->msg_id;
+        m.payload = t->posted_payload;
+        t->posted = 0;
+        unlock();
+
+        /*The topic might be removed if it has no subscribers anymore, but not the other posted ones*/
+        notify(t, &m);
+        t = t_next;
+    }
+}
+
+static void lock(void)
+{
+#if LV_MSG_THREAD_SAFE
+#if defined(ESP_PLATFORM)
+    xSemaphoreTake(mutex, portMAX_DELAY);
+#else
+    pthread_mutex_lock(&mutex);
+#endif
+#endif
+}
+
+static void unlock(void)
+{
+#if LV_MSG_THREAD_SAFE
+#if defined(ESP_PLATFORM)
+    xSemaphoreGive(mutex);
+#else
+    pthread_mutex_unlock(&mutex);
+#endif
+#endif
 }
 
 static void obj_notify_cb(void * s, lv_msg_t * m)
@@ -173,17 +521,7 @@ static void obj_notify_cb(void * s, lv_msg_t * m)
 static void obj_delete_event_cb(lv_event_t * e)
 {
     lv_obj_t * obj = lv_event_get_target(e);
-
-    sub_dsc_t * s = _lv_ll_get_head(&subs_ll);
-    sub_dsc_t * s_next;
-    while(s) {
-        /*On unsubscribe the list changes s becomes invalid so get next item while it's surely valid*/
-        s_next = _lv_ll_get_next(&subs_ll, s);
-        if(s->_priv_data == obj) {
-            lv_msg_unsubscribe(s);
-        }
-        s = s_next;
-    }
+    lv_msg_unsubscribe_obj(LV_MSG_ID_ANY, obj);
 }
 
 #endif /*LV_USE_MSG*/
@@ -87,6 +87,15 @@ uint32_t lv_msg_unsubscribe_obj(uint32_t msg_id, lv_obj_t * obj);
  */
 void lv_msg_send(uint32_t msg_id, const void * payload);
 
+/**
+ * Post a message to deliver it later from `lv_timer_handler()` in every `LV_MSG_POST_PERIOD` milliseconds.
+ * If the same message ID is posted more times until then only the last payload is delivered once.
+ * With `LV_MSG_THREAD_SAFE` it can be called from other threads too.
+ * @param msg_id        ID of the message to post
+ * @param payload       pointer to the data to send. It should be valid until the message is delivered.
+ */
+void lv_msg_post(uint32_t msg_id, const void * payload);
+
 /**
  * Get the ID of a message object. Typically used in the subscriber callback.
  * @param m             pointer to a message object
@@ -43,7 +43,6 @@
 typedef struct {
     lv_style_t scr;
     lv_style_t scrollbar;
-    lv_style_t scrollbar_scrolled;
     lv_style_t card;
     lv_style_t btn;
 
@@ -54,27 +53,18 @@ typedef struct {
     lv_style_t bg_color_secondary_muted;
     lv_style_t bg_color_grey;
     lv_style_t bg_color_white;
-    lv_style_t pressed;
-    lv_style_t disabled;
-    lv_style_t pad_zero;
     lv_style_t pad_tiny;
     lv_style_t pad_small;
     lv_style_t pad_normal;
     lv_style_t pad_gap;
     lv_style_t line_space_large;
-    lv_style_t text_align_center;
     lv_style_t outline_primary;
     lv_style_t outline_secondary;
-    lv_style_t circle;
-    lv_style_t no_radius;
-    lv_style_t clip_corner;
 #if LV_THEME_DEFAULT_GROW
     lv_style_t grow;
 #endif
     lv_style_t transition_delayed;
     lv_style_t transition_normal;
-    lv_style_t anim;
-    lv_style_t anim_fast;
 
     /*Parts*/
     lv_style_t knob;
@@ -89,10 +79,6 @@ typedef struct {
     lv_style_t chart_series, chart_indic, chart_ticks, chart_bg;
 #endif
 
-#if LV_USE_DROPDOWN
-    lv_style_t dropdown_list;
-#endif
-
 #if LV_USE_CHECKBOX
     lv_style_t cb_marker, cb_marker_checked;
 #endif
@@ -126,12 +112,12 @@ typedef struct {
 #endif
 
 #if LV_USE_MENU
-    lv_style_t menu_bg, menu_cont, menu_sidebar_cont, menu_main_cont, menu_page, menu_header_cont, menu_header_btn,
-               menu_section, menu_pressed, menu_separator;
+    lv_style_t menu_cont, menu_sidebar_cont, menu_header_cont, menu_header_btn, menu_section, menu_pressed,
+               menu_separator;
 #endif
 
 #if LV_USE_MSGBOX
-    lv_style_t msgbox_bg, msgbox_btn_bg, msgbox_backdrop_bg;
+    lv_style_t msgbox_btn_bg, msgbox_backdrop_bg;
 #endif
 
 #if LV_USE_KEYBOARD
@@ -148,6 +134,27 @@ typedef struct {
 #if LV_USE_LED
     lv_style_t led;
 #endif
+
+    /*The styles a widget uses with the same selector combined into one*/
+#if LV_USE_BTN
+    lv_style_t btn_main, btn_pressed;
+#endif
+
+#if LV_USE_BAR
+    lv_style_t bar_main, bar_indic;
+#endif
+
+#if LV_USE_SLIDER
+    lv_style_t slider_knob, slider_knob_pressed;
+#endif
+
+#if LV_USE_CHECKBOX
+    lv_style_t cb_indic, cb_indic_checked, cb_indic_pressed;
+#endif
+
+#if LV_USE_SWITCH
+    lv_style_t sw_main, sw_indic, sw_indic_checked, sw_knob;
+#endif
 } my_theme_styles_t;
 
 typedef struct {
@@ -166,6 +173,9 @@ typedef enum {
  **********************/
 static void theme_apply(lv_theme_t * th, lv_obj_t * obj);
 static void style_init_reset(lv_style_t * style);
+static void style_combine(lv_style_t * style, const lv_style_t * src[], uint32_t src_cnt);
+static lv_color_t dark_color_filter_cb(const lv_color_filter_dsc_t * f, lv_color_t c, lv_opa_t opa);
+static lv_color_t grey_filter_cb(const lv_color_filter_dsc_t * f, lv_color_t color, lv_opa_t opa);
 
 /**********************
  *  STATIC VARIABLES
@@ -179,10 +189,145 @@ static lv_color_t color_card;
 static lv_color_t color_grey;
 static bool inited = false;
 
+#if TRANSITION_TIME
+static const lv_style_prop_t trans_props[] = {
+    LV_STYLE_BG_OPA, LV_STYLE_BG_COLOR,
+    LV_STYLE_TRANSFORM_WIDTH, LV_STYLE_TRANSFORM_HEIGHT,
+    LV_STYLE_TRANSLATE_Y, LV_STYLE_TRANSLATE_X,
+    LV_STYLE_TRANSFORM_ZOOM, LV_STYLE_TRANSFORM_ANGLE,
+    LV_STYLE_COLOR_FILTER_OPA, LV_STYLE_COLOR_FILTER_DSC,
+    0
+};
+
+static const lv_style_transition_dsc_t trans_delayed = {
+    .props = trans_props,
+    .path_xcb = lv_anim_path_linear,
+    .time = TRANSITION_TIME,
+    .delay = 70,
+};
+
+static const lv_style_transition_dsc_t trans_normal = {
+    .props = trans_props,
+    .path_xcb = lv_anim_path_linear,
+    .time = TRANSITION_TIME,
+    .delay = 0,
+};
+#endif
+
+static const lv_color_filter_dsc_t dark_filter = {.filter_cb = dark_color_filter_cb};
+static const lv_color_filter_dsc_t grey_filter = {.filter_cb = grey_filter_cb};
+
+/*The styles which don't depend on the display, the colors or the mode are constant so they stay in ROM*/
+static const lv_style_const_prop_t scrollbar_scrolled_props[] = {
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+};
+static LV_STYLE_CONST_INIT(scrollbar_scrolled, scrollbar_scrolled_props);
+
+static const lv_style_const_prop_t pressed_props[] = {
+    LV_STYLE_CONST_COLOR_FILTER_DSC(&dark_filter),
+    LV_STYLE_CONST_COLOR_FILTER_OPA(35),
+};
+static LV_STYLE_CONST_INIT(pressed, pressed_props);
+
+static const lv_style_const_prop_t disabled_props[] = {
+    LV_STYLE_CONST_COLOR_FILTER_DSC(&grey_filter),
+    LV_STYLE_CONST_COLOR_FILTER_OPA(LV_OPA_50),
+};
+static LV_STYLE_CONST_INIT(disabled, disabled_props);
+
+static const lv_style_const_prop_t clip_corner_props[] = {
+    LV_STYLE_CONST_CLIP_CORNER(true),
+    LV_STYLE_CONST_BORDER_POST(true),
+};
+static LV_STYLE_CONST_INIT(clip_corner, clip_corner_props);
+
+static const lv_style_const_prop_t text_align_center_props[] = {
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_CENTER),
+};
+static LV_STYLE_CONST_INIT(text_align_center, text_align_center_props);
+
+static const lv_style_const_prop_t pad_zero_props[] = {
+    LV_STYLE_CONST_PAD_TOP(0),
+    LV_STYLE_CONST_PAD_BOTTOM(0),
+    LV_STYLE_CONST_PAD_LEFT(0),
+    LV_STYLE_CONST_PAD_RIGHT(0),
+    LV_STYLE_CONST_PAD_ROW(0),
+    LV_STYLE_CONST_PAD_COLUMN(0),
+};
+static LV_STYLE_CONST_INIT(pad_zero, pad_zero_props);
+
+static const lv_style_const_prop_t circle_props[] = {
+    LV_STYLE_CONST_RADIUS(LV_RADIUS_CIRCLE),
+};
+static LV_STYLE_CONST_INIT(circle, circle_props);
+
+static const lv_style_const_prop_t no_radius_props[] = {
+    LV_STYLE_CONST_RADIUS(0),
+};
+static LV_STYLE_CONST_INIT(no_radius, no_radius_props);
+
+static const lv_style_const_prop_t anim_props[] = {
+    LV_STYLE_CONST_ANIM_TIME(200),
+};
+static LV_STYLE_CONST_INIT(anim, anim_props);
+
+static const lv_style_const_prop_t anim_fast_props[] = {
+    LV_STYLE_CONST_ANIM_TIME(120),
+};
+static LV_STYLE_CONST_INIT(anim_fast, anim_fast_props);
+
+#if LV_USE_DROPDOWN
+static const lv_style_const_prop_t dropdown_list_props[] = {
+    LV_STYLE_CONST_MAX_HEIGHT(LV_DPI_DEF * 2),
+};
+static LV_STYLE_CONST_INIT(dropdown_list, dropdown_list_props);
+#endif
+
+#if LV_USE_MENU
+static const lv_style_const_prop_t menu_bg_props[] = {
+    LV_STYLE_CONST_PAD_TOP(0),
+    LV_STYLE_CONST_PAD_BOTTOM(0),
+    LV_STYLE_CONST_PAD_LEFT(0),
+    LV_STYLE_CONST_PAD_RIGHT(0),
+    LV_STYLE_CONST_PAD_ROW(0),
+    LV_STYLE_CONST_PAD_COLUMN(0),
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_CLIP_CORNER(true),
+    LV_STYLE_CONST_BORDER_SIDE(LV_BORDER_SIDE_NONE),
+};
+static LV_STYLE_CONST_INIT(menu_bg, menu_bg_props);
+
+static const lv_style_const_prop_t menu_main_cont_props[] = {
+    LV_STYLE_CONST_PAD_TOP(0),
+    LV_STYLE_CONST_PAD_BOTTOM(0),
+    LV_STYLE_CONST_PAD_LEFT(0),
+    LV_STYLE_CONST_PAD_RIGHT(0),
+    LV_STYLE_CONST_PAD_ROW(0),
+    LV_STYLE_CONST_PAD_COLUMN(0),
+};
+static LV_STYLE_CONST_INIT(menu_main_cont, menu_main_cont_props);
+
+static const lv_style_const_prop_t menu_page_props[] = {
+    LV_STYLE_CONST_PAD_LEFT(0),
+    LV_STYLE_CONST_PAD_RIGHT(0),
+    LV_STYLE_CONST_PAD_ROW(0),
+    LV_STYLE_CONST_PAD_COLUMN(0),
+};
+static LV_STYLE_CONST_INIT(menu_page, menu_page_props);
+#endif
+
+#if LV_USE_MSGBOX
+static const lv_style_const_prop_t msgbox_bg_props[] = {
+    LV_STYLE_CONST_MAX_WIDTH(LV_PCT(100)),
+};
+static LV_STYLE_CONST_INIT(msgbox_bg, msgbox_bg_props);
+#endif
+
 
 /**********************
  *      MACROS
  **********************/
+#define COMBINE(style, src) style_combine(style, src, sizeof(src) / sizeof(src[0]))
 
 /**********************
  *   STATIC FUNCTIONS
@@ -204,15 +349,6 @@ static lv_color_t grey_filter_cb(const lv_color_filter_dsc_t * f, lv_color_t col
 
 static void style_init(void)
 {
-    static const lv_style_prop_t trans_props[] = {
-        LV_STYLE_BG_OPA, LV_STYLE_BG_COLOR,
-        LV_STYLE_TRANSFORM_WIDTH, LV_STYLE_TRANSFORM_HEIGHT,
-        LV_STYLE_TRANSLATE_Y, LV_STYLE_TRANSLATE_X,
-        LV_STYLE_TRANSFORM_ZOOM, LV_STYLE_TRANSFORM_ANGLE,
-        LV_STYLE_COLOR_FILTER_OPA, LV_STYLE_COLOR_FILTER_DSC,
-        0
-    };
-
     color_scr = theme.flags & MODE_DARK ? DARK_COLOR_SCR : LIGHT_COLOR_SCR;
     color_text = theme.flags & MODE_DARK ? DARK_COLOR_TEXT : LIGHT_COLOR_TEXT;
     color_card = theme.flags & MODE_DARK ? DARK_COLOR_CARD : LIGHT_COLOR_CARD;
@@ -221,12 +357,6 @@ static void style_init(void)
     style_init_reset(&styles->transition_delayed);
     style_init_reset(&styles->transition_normal);
 #if TRANSITION_TIME
-    static lv_style_transition_dsc_t trans_delayed;
-    lv_style_transition_dsc_init(&trans_delayed, trans_props, lv_anim_path_linear, TRANSITION_TIME, 70, NULL);
-
-    static lv_style_transition_dsc_t trans_normal;
-    lv_style_transition_dsc_init(&trans_normal, trans_props, lv_anim_path_linear, TRANSITION_TIME, 0, NULL);
-
     lv_style_set_transition(&styles->transition_delayed, &trans_delayed); /*Go back to default state with delay*/
 
     lv_style_set_transition(&styles->transition_normal, &trans_normal); /*Go back to default state with delay*/
@@ -245,9 +375,6 @@ static void style_init(void)
     lv_style_set_transition(&styles->scrollbar, &trans_normal);
 #endif
 
-    style_init_reset(&styles->scrollbar_scrolled);
-    lv_style_set_bg_opa(&styles->scrollbar_scrolled,  LV_OPA_COVER);
-
     style_init_reset(&styles->scr);
     lv_style_set_bg_opa(&styles->scr, LV_OPA_COVER);
     lv_style_set_bg_color(&styles->scr, color_scr);
@@ -297,24 +424,6 @@ static void style_init(void)
     lv_style_set_pad_column(&styles->btn, lv_disp_dpx(theme.disp, 5));
     lv_style_set_pad_row(&styles->btn, lv_disp_dpx(theme.disp, 5));
 
-    static lv_color_filter_dsc_t dark_filter;
-    lv_color_filter_dsc_init(&dark_filter, dark_color_filter_cb);
-
-    static lv_color_filter_dsc_t grey_filter;
-    lv_color_filter_dsc_init(&grey_filter, grey_filter_cb);
-
-    style_init_reset(&styles->pressed);
-    lv_style_set_color_filter_dsc(&styles->pressed, &dark_filter);
-    lv_style_set_color_filter_opa(&styles->pressed, 35);
-
-    style_init_reset(&styles->disabled);
-    lv_style_set_color_filter_dsc(&styles->disabled, &grey_filter);
-    lv_style_set_color_filter_opa(&styles->disabled, LV_OPA_50);
-
-    style_init_reset(&styles->clip_corner);
-    lv_style_set_clip_corner(&styles->clip_corner, true);
-    lv_style_set_border_post(&styles->clip_corner, true);
-
     style_init_reset(&styles->pad_normal);
     lv_style_set_pad_all(&styles->pad_normal, PAD_DEF);
     lv_style_set_pad_row(&styles->pad_normal, PAD_DEF);
@@ -331,14 +440,6 @@ static void style_init(void)
     style_init_reset(&styles->line_space_large);
     lv_style_set_text_line_space(&styles->line_space_large, lv_disp_dpx(theme.disp, 20));
 
-    style_init_reset(&styles->text_align_center);
-    lv_style_set_text_align(&styles->text_align_center, LV_TEXT_ALIGN_CENTER);
-
-    style_init_reset(&styles->pad_zero);
-    lv_style_set_pad_all(&styles->pad_zero, 0);
-    lv_style_set_pad_row(&styles->pad_zero, 0);
-    lv_style_set_pad_column(&styles->pad_zero, 0);
-
     style_init_reset(&styles->pad_tiny);
     lv_style_set_pad_all(&styles->pad_tiny, PAD_TINY);
     lv_style_set_pad_row(&styles->pad_tiny, PAD_TINY);
@@ -374,12 +475,6 @@ static void style_init(void)
     lv_style_set_bg_opa(&styles->bg_color_white, LV_OPA_COVER);
     lv_style_set_text_color(&styles->bg_color_white, color_text);
 
-    style_init_reset(&styles->circle);
-    lv_style_set_radius(&styles->circle, LV_RADIUS_CIRCLE);
-
-    style_init_reset(&styles->no_radius);
-    lv_style_set_radius(&styles->no_radius, 0);
-
 #if LV_THEME_DEFAULT_GROW
     style_init_reset(&styles->grow);
     lv_style_set_transform_width(&styles->grow, lv_disp_dpx(theme.disp, 3));
@@ -392,12 +487,6 @@ static void style_init(void)
     lv_style_set_pad_all(&styles->knob, lv_disp_dpx(theme.disp, 6));
     lv_style_set_radius(&styles->knob, LV_RADIUS_CIRCLE);
 
-    style_init_reset(&styles->anim);
-    lv_style_set_anim_time(&styles->anim, 200);
-
-    style_init_reset(&styles->anim_fast);
-    lv_style_set_anim_time(&styles->anim_fast, 120);
-
 #if LV_USE_ARC
     style_init_reset(&styles->arc_indic);
     lv_style_set_arc_color(&styles->arc_indic, color_grey);
@@ -406,12 +495,10 @@ static void style_init(void)
 
     style_init_reset(&styles->arc_indic_primary);
     lv_style_set_arc_color(&styles->arc_indic_primary, theme.color_primary);
+    lv_style_set_arc_width(&styles->arc_indic_primary, lv_disp_dpx(theme.disp, 15));
+    lv_style_set_arc_rounded(&styles->arc_indic_primary, true);
 #endif
 
-#if LV_USE_DROPDOWN
-    style_init_reset(&styles->dropdown_list);
-    lv_style_set_max_height(&styles->dropdown_list, LV_DPI_DEF * 2);
-#endif
 #if LV_USE_CHECKBOX
     style_init_reset(&styles->cb_marker);
     lv_style_set_pad_all(&styles->cb_marker, lv_disp_dpx(theme.disp, 3));
@@ -465,13 +552,6 @@ static void style_init(void)
 #endif
 
 #if LV_USE_MENU
-    style_init_reset(&styles->menu_bg);
-    lv_style_set_pad_all(&styles->menu_bg, 0);
-    lv_style_set_pad_gap(&styles->menu_bg, 0);
-    lv_style_set_radius(&styles->menu_bg, 0);
-    lv_style_set_clip_corner(&styles->menu_bg, true);
-    lv_style_set_border_side(&styles->menu_bg, LV_BORDER_SIDE_NONE);
-
     style_init_reset(&styles->menu_section);
     lv_style_set_radius(&styles->menu_section, RADIUS_DEFAULT);
     lv_style_set_clip_corner(&styles->menu_section, true);
@@ -496,10 +576,6 @@ static void style_init(void)
     lv_style_set_border_color(&styles->menu_sidebar_cont, color_text);
     lv_style_set_border_side(&styles->menu_sidebar_cont, LV_BORDER_SIDE_RIGHT);
 
-    style_init_reset(&styles->menu_main_cont);
-    lv_style_set_pad_all(&styles->menu_main_cont, 0);
-    lv_style_set_pad_gap(&styles->menu_main_cont, 0);
-
     style_init_reset(&styles->menu_header_cont);
     lv_style_set_pad_hor(&styles->menu_header_cont, PAD_SMALL);
     lv_style_set_pad_ver(&styles->menu_header_cont, PAD_TINY);
@@ -512,10 +588,6 @@ static void style_init(void)
     lv_style_set_bg_opa(&styles->menu_header_btn, LV_OPA_TRANSP);
     lv_style_set_text_color(&styles->menu_header_btn, color_text);
 
-    style_init_reset(&styles->menu_page);
-    lv_style_set_pad_hor(&styles->menu_page, 0);
-    lv_style_set_pad_gap(&styles->menu_page, 0);
-
     style_init_reset(&styles->menu_pressed);
     lv_style_set_bg_opa(&styles->menu_pressed, LV_OPA_20);
     lv_style_set_bg_color(&styles->menu_pressed, lv_palette_main(LV_PALETTE_GREY));
@@ -587,9 +659,6 @@ static void style_init(void)
     style_init_reset(&styles->msgbox_btn_bg);
     lv_style_set_pad_all(&styles->msgbox_btn_bg, lv_disp_dpx(theme.disp, 4));
 
-    style_init_reset(&styles->msgbox_bg);
-    lv_style_set_max_width(&styles->msgbox_bg, lv_pct(100));
-
     style_init_reset(&styles->msgbox_backdrop_bg);
     lv_style_set_bg_color(&styles->msgbox_backdrop_bg, lv_palette_main(LV_PALETTE_GREY));
     lv_style_set_bg_opa(&styles->msgbox_backdrop_bg, LV_OPA_50);
@@ -639,6 +708,70 @@ static void style_init(void)
     lv_style_set_shadow_color(&styles->led, lv_color_white());
     lv_style_set_shadow_spread(&styles->led, lv_disp_dpx(theme.disp, 5));
 #endif
+
+    /*Combine the styles which are added with the same selector so that the widgets store and search less styles*/
+#if LV_USE_BTN
+    const lv_style_t * btn_main[] = {&styles->btn, &styles->bg_color_primary, &styles->transition_delayed};
+    COMBINE(&styles->btn_main, btn_main);
+
+    const lv_style_t * btn_pressed[] = {&pressed, &styles->transition_normal,
+#if LV_THEME_DEFAULT_GROW
+                                        &styles->grow,
+#endif
+                                       };
+    COMBINE(&styles->btn_pressed, btn_pressed);
+#endif
+
+#if LV_USE_BAR
+    const lv_style_t * bar_main[] = {&styles->bg_color_primary_muted, &circle};
+    COMBINE(&styles->bar_main, bar_main);
+
+    const lv_style_t * bar_indic[] = {&styles->bg_color_primary, &circle};
+    COMBINE(&styles->bar_indic, bar_indic);
+#endif
+
+#if LV_USE_SLIDER
+    const lv_style_t * slider_knob[] = {&styles->knob, &styles->transition_delayed};
+    COMBINE(&styles->slider_knob, slider_knob);
+
+    const lv_style_t * slider_knob_pressed[] = {
+#if LV_THEME_DEFAULT_GROW
+        &styles->grow,
+#endif
+        &styles->transition_normal
+    };
+    COMBINE(&styles->slider_knob_pressed, slider_knob_pressed);
+#endif
+
+#if LV_USE_CHECKBOX
+    const lv_style_t * cb_indic[] = {&styles->cb_marker, &styles->transition_delayed};
+    COMBINE(&styles->cb_indic, cb_indic);
+
+    const lv_style_t * cb_indic_checked[] = {&styles->bg_color_primary, &styles->cb_marker_checked};
+    COMBINE(&styles->cb_indic_checked, cb_indic_checked);
+
+    const lv_style_t * cb_indic_pressed[] = {&pressed,
+#if LV_THEME_DEFAULT_GROW
+                                             &styles->grow,
+#endif
+                                             &styles->transition_normal
+                                            };
+    COMBINE(&styles->cb_indic_pressed, cb_indic_pressed);
+#endif
+
+#if LV_USE_SWITCH
+    const lv_style_t * sw_main[] = {&styles->bg_color_grey, &circle, &anim_fast};
+    COMBINE(&styles->sw_main, sw_main);
+
+    const lv_style_t * sw_indic[] = {&circle, &styles->transition_normal};
+    COMBINE(&styles->sw_indic, sw_indic);
+
+    const lv_style_t * sw_indic_checked[] = {&styles->bg_color_primary, &styles->transition_normal};
+    COMBINE(&styles->sw_indic_checked, sw_indic_checked);
+
+    const lv_style_t * sw_knob[] = {&styles->knob, &styles->bg_color_white, &styles->switch_knob};
+    COMBINE(&styles->sw_knob, sw_knob);
+#endif
 }
 
 /**********************
@@ -702,7 +835,7 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
     if(lv_obj_get_parent(obj) == NULL) {
         lv_obj_add_style(obj, &styles->scr, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
         return;
     }
 
@@ -717,24 +850,24 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
         else if(lv_obj_check_type(lv_obj_get_parent(parent), &lv_tabview_class)) {
             lv_obj_add_style(obj, &styles->pad_normal, 0);
             lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-            lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+            lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
             return;
         }
 #endif
 
 #if LV_USE_WIN
         /*Header*/
-        if(lv_obj_get_index(obj) == 0 && lv_obj_check_type(lv_obj_get_parent(obj), &lv_win_class)) {
+        if(lv_obj_check_type(lv_obj_get_parent(obj), &lv_win_class) && lv_obj_get_index(obj) == 0) {
             lv_obj_add_style(obj, &styles->bg_color_grey, 0);
             lv_obj_add_style(obj, &styles->pad_tiny, 0);
             return;
         }
         /*Content*/
-        else if(lv_obj_get_index(obj) == 1 && lv_obj_check_type(lv_obj_get_parent(obj), &lv_win_class)) {
+        else if(lv_obj_check_type(lv_obj_get_parent(obj), &lv_win_class) && lv_obj_get_index(obj) == 1) {
             lv_obj_add_style(obj, &styles->scr, 0);
             lv_obj_add_style(obj, &styles->pad_normal, 0);
             lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-            lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+            lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
             return;
         }
 #endif
@@ -749,21 +882,15 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
 
         lv_obj_add_style(obj, &styles->card, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
     }
 #if LV_USE_BTN
     else if(lv_obj_check_type(obj, &lv_btn_class)) {
-        lv_obj_add_style(obj, &styles->btn, 0);
-        lv_obj_add_style(obj, &styles->bg_color_primary, 0);
-        lv_obj_add_style(obj, &styles->transition_delayed, 0);
-        lv_obj_add_style(obj, &styles->pressed, LV_STATE_PRESSED);
-        lv_obj_add_style(obj, &styles->transition_normal, LV_STATE_PRESSED);
+        lv_obj_add_style(obj, &styles->btn_main, 0);
+        lv_obj_add_style(obj, &styles->btn_pressed, LV_STATE_PRESSED);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
-#if LV_THEME_DEFAULT_GROW
-        lv_obj_add_style(obj, &styles->grow, LV_STATE_PRESSED);
-#endif
         lv_obj_add_style(obj, &styles->bg_color_secondary, LV_STATE_CHECKED);
-        lv_obj_add_style(obj, &styles->disabled, LV_STATE_DISABLED);
+        lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_STATE_DISABLED);
 
 #if LV_USE_MENU
         if(lv_obj_check_type(lv_obj_get_parent(obj), &lv_menu_sidebar_header_cont_class) ||
@@ -788,8 +915,8 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
             lv_obj_add_style(obj, &styles->msgbox_btn_bg, 0);
             lv_obj_add_style(obj, &styles->pad_gap, 0);
             lv_obj_add_style(obj, &styles->btn, LV_PART_ITEMS);
-            lv_obj_add_style(obj, &styles->pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
-            lv_obj_add_style(obj, &styles->disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
+            lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+            lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
             lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_ITEMS | LV_STATE_CHECKED);
             lv_obj_add_style(obj, &styles->bg_color_primary_muted, LV_PART_ITEMS | LV_STATE_FOCUS_KEY);
             lv_obj_add_style(obj, &styles->bg_color_secondary_muted, LV_PART_ITEMS | LV_STATE_EDITED);
@@ -801,7 +928,7 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
             lv_obj_add_style(obj, &styles->bg_color_white, 0);
             lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
             lv_obj_add_style(obj, &styles->tab_bg_focus, LV_STATE_FOCUS_KEY);
-            lv_obj_add_style(obj, &styles->pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+            lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
             lv_obj_add_style(obj, &styles->bg_color_primary_muted, LV_PART_ITEMS | LV_STATE_CHECKED);
             lv_obj_add_style(obj, &styles->tab_btn, LV_PART_ITEMS | LV_STATE_CHECKED);
             lv_obj_add_style(obj, &styles->outline_primary, LV_PART_ITEMS | LV_STATE_FOCUS_KEY);
@@ -817,8 +944,8 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
             lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
             lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
             lv_obj_add_style(obj, &styles->calendar_btnm_day, LV_PART_ITEMS);
-            lv_obj_add_style(obj, &styles->pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
-            lv_obj_add_style(obj, &styles->disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
+            lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+            lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
             lv_obj_add_style(obj, &styles->outline_primary, LV_PART_ITEMS | LV_STATE_FOCUS_KEY);
             lv_obj_add_style(obj, &styles->outline_secondary, LV_PART_ITEMS | LV_STATE_EDITED);
             return;
@@ -828,8 +955,8 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
         lv_obj_add_style(obj, &styles->btn, LV_PART_ITEMS);
-        lv_obj_add_style(obj, &styles->disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
-        lv_obj_add_style(obj, &styles->pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+        lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
+        lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
         lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_ITEMS | LV_STATE_CHECKED);
         lv_obj_add_style(obj, &styles->outline_primary, LV_PART_ITEMS | LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_PART_ITEMS | LV_STATE_EDITED);
@@ -838,45 +965,37 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
 
 #if LV_USE_BAR
     else if(lv_obj_check_type(obj, &lv_bar_class)) {
-        lv_obj_add_style(obj, &styles->bg_color_primary_muted, 0);
-        lv_obj_add_style(obj, &styles->circle, 0);
+        lv_obj_add_style(obj, &styles->bar_main, 0);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
-        lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_INDICATOR);
-        lv_obj_add_style(obj, &styles->circle, LV_PART_INDICATOR);
+        lv_obj_add_style(obj, &styles->bar_indic, LV_PART_INDICATOR);
     }
 #endif
 
 #if LV_USE_SLIDER
     else if(lv_obj_check_type(obj, &lv_slider_class)) {
-        lv_obj_add_style(obj, &styles->bg_color_primary_muted, 0);
-        lv_obj_add_style(obj, &styles->circle, 0);
+        lv_obj_add_style(obj, &styles->bar_main, 0);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
-        lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_INDICATOR);
-        lv_obj_add_style(obj, &styles->circle, LV_PART_INDICATOR);
-        lv_obj_add_style(obj, &styles->knob, LV_PART_KNOB);
-#if LV_THEME_DEFAULT_GROW
-        lv_obj_add_style(obj, &styles->grow, LV_PART_KNOB | LV_STATE_PRESSED);
-#endif
-        lv_obj_add_style(obj, &styles->transition_delayed, LV_PART_KNOB);
-        lv_obj_add_style(obj, &styles->transition_normal, LV_PART_KNOB | LV_STATE_PRESSED);
+        lv_obj_add_style(obj, &styles->bar_indic, LV_PART_INDICATOR);
+        lv_obj_add_style(obj, &styles->slider_knob, LV_PART_KNOB);
+        lv_obj_add_style(obj, &styles->slider_knob_pressed, LV_PART_KNOB | LV_STATE_PRESSED);
     }
 #endif
 
 #if LV_USE_TABLE
     else if(lv_obj_check_type(obj, &lv_table_class)) {
         lv_obj_add_style(obj, &styles->card, 0);
-        lv_obj_add_style(obj, &styles->pad_zero, 0);
-        lv_obj_add_style(obj, &styles->no_radius, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&pad_zero, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&no_radius, 0);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
         lv_obj_add_style(obj, &styles->bg_color_white, LV_PART_ITEMS);
         lv_obj_add_style(obj, &styles->table_cell, LV_PART_ITEMS);
         lv_obj_add_style(obj, &styles->pad_normal, LV_PART_ITEMS);
-        lv_obj_add_style(obj, &styles->pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+        lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
         lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_ITEMS | LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->bg_color_secondary, LV_PART_ITEMS | LV_STATE_EDITED);
     }
@@ -886,36 +1005,23 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
     else if(lv_obj_check_type(obj, &lv_checkbox_class)) {
         lv_obj_add_style(obj, &styles->pad_gap, 0);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
-        lv_obj_add_style(obj, &styles->disabled, LV_PART_INDICATOR | LV_STATE_DISABLED);
-        lv_obj_add_style(obj, &styles->cb_marker, LV_PART_INDICATOR);
-        lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_INDICATOR | LV_STATE_CHECKED);
-        lv_obj_add_style(obj, &styles->cb_marker_checked, LV_PART_INDICATOR | LV_STATE_CHECKED);
-        lv_obj_add_style(obj, &styles->pressed, LV_PART_INDICATOR | LV_STATE_PRESSED);
-#if LV_THEME_DEFAULT_GROW
-        lv_obj_add_style(obj, &styles->grow, LV_PART_INDICATOR | LV_STATE_PRESSED);
-#endif
-        lv_obj_add_style(obj, &styles->transition_normal, LV_PART_INDICATOR | LV_STATE_PRESSED);
-        lv_obj_add_style(obj, &styles->transition_delayed, LV_PART_INDICATOR);
+        lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_PART_INDICATOR | LV_STATE_DISABLED);
+        lv_obj_add_style(obj, &styles->cb_indic, LV_PART_INDICATOR);
+        lv_obj_add_style(obj, &styles->cb_indic_checked, LV_PART_INDICATOR | LV_STATE_CHECKED);
+        lv_obj_add_style(obj, &styles->cb_indic_pressed, LV_PART_INDICATOR | LV_STATE_PRESSED);
     }
 #endif
 
 #if LV_USE_SWITCH
     else if(lv_obj_check_type(obj, &lv_switch_class)) {
-        lv_obj_add_style(obj, &styles->bg_color_grey, 0);
-        lv_obj_add_style(obj, &styles->circle, 0);
-        lv_obj_add_style(obj, &styles->anim_fast, 0);
-        lv_obj_add_style(obj, &styles->disabled, LV_STATE_DISABLED);
+        lv_obj_add_style(obj, &styles->sw_main, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_STATE_DISABLED);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
-        lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_INDICATOR | LV_STATE_CHECKED);
-        lv_obj_add_style(obj, &styles->circle, LV_PART_INDICATOR);
-        lv_obj_add_style(obj, &styles->disabled, LV_PART_INDICATOR | LV_STATE_DISABLED);
-        lv_obj_add_style(obj, &styles->knob, LV_PART_KNOB);
-        lv_obj_add_style(obj, &styles->bg_color_white, LV_PART_KNOB);
-        lv_obj_add_style(obj, &styles->switch_knob, LV_PART_KNOB);
-        lv_obj_add_style(obj, &styles->disabled, LV_PART_KNOB | LV_STATE_DISABLED);
-
-        lv_obj_add_style(obj, &styles->transition_normal, LV_PART_INDICATOR | LV_STATE_CHECKED);
-        lv_obj_add_style(obj, &styles->transition_normal, LV_PART_INDICATOR);
+        lv_obj_add_style(obj, &styles->sw_indic_checked, LV_PART_INDICATOR | LV_STATE_CHECKED);
+        lv_obj_add_style(obj, &styles->sw_indic, LV_PART_INDICATOR);
+        lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_PART_INDICATOR | LV_STATE_DISABLED);
+        lv_obj_add_style(obj, &styles->sw_knob, LV_PART_KNOB);
+        lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_PART_KNOB | LV_STATE_DISABLED);
     }
 #endif
 
@@ -925,7 +1031,7 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
         lv_obj_add_style(obj, &styles->pad_small, 0);
         lv_obj_add_style(obj, &styles->chart_bg, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
         lv_obj_add_style(obj, &styles->chart_series, LV_PART_ITEMS);
         lv_obj_add_style(obj, &styles->chart_indic, LV_PART_INDICATOR);
         lv_obj_add_style(obj, &styles->chart_ticks, LV_PART_TICKS);
@@ -936,9 +1042,9 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
 #if LV_USE_ROLLER
     else if(lv_obj_check_type(obj, &lv_roller_class)) {
         lv_obj_add_style(obj, &styles->card, 0);
-        lv_obj_add_style(obj, &styles->anim, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&anim, 0);
         lv_obj_add_style(obj, &styles->line_space_large, 0);
-        lv_obj_add_style(obj, &styles->text_align_center, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&text_align_center, 0);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
         lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_SELECTED);
@@ -951,28 +1057,27 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
         lv_obj_add_style(obj, &styles->pad_small, 0);
         lv_obj_add_style(obj, &styles->transition_delayed, 0);
         lv_obj_add_style(obj, &styles->transition_normal, LV_STATE_PRESSED);
-        lv_obj_add_style(obj, &styles->pressed, LV_STATE_PRESSED);
+        lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_STATE_PRESSED);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
         lv_obj_add_style(obj, &styles->transition_normal, LV_PART_INDICATOR);
     }
     else if(lv_obj_check_type(obj, &lv_dropdownlist_class)) {
         lv_obj_add_style(obj, &styles->card, 0);
-        lv_obj_add_style(obj, &styles->clip_corner, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&clip_corner, 0);
         lv_obj_add_style(obj, &styles->line_space_large, 0);
-        lv_obj_add_style(obj, &styles->dropdown_list, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&dropdown_list, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
         lv_obj_add_style(obj, &styles->bg_color_white, LV_PART_SELECTED);
         lv_obj_add_style(obj, &styles->bg_color_primary, LV_PART_SELECTED | LV_STATE_CHECKED);
-        lv_obj_add_style(obj, &styles->pressed, LV_PART_SELECTED | LV_STATE_PRESSED);
+        lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_PART_SELECTED | LV_STATE_PRESSED);
     }
 #endif
 
 #if LV_USE_ARC
     else if(lv_obj_check_type(obj, &lv_arc_class)) {
         lv_obj_add_style(obj, &styles->arc_indic, 0);
-        lv_obj_add_style(obj, &styles->arc_indic, LV_PART_INDICATOR);
         lv_obj_add_style(obj, &styles->arc_indic_primary, LV_PART_INDICATOR);
         lv_obj_add_style(obj, &styles->knob, LV_PART_KNOB);
     }
@@ -982,7 +1087,6 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
 #if LV_USE_SPINNER
     else if(lv_obj_check_type(obj, &lv_spinner_class)) {
         lv_obj_add_style(obj, &styles->arc_indic, 0);
-        lv_obj_add_style(obj, &styles->arc_indic, LV_PART_INDICATOR);
         lv_obj_add_style(obj, &styles->arc_indic_primary, LV_PART_INDICATOR);
     }
 #endif
@@ -990,7 +1094,7 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
 #if LV_USE_METER
     else if(lv_obj_check_type(obj, &lv_meter_class)) {
         lv_obj_add_style(obj, &styles->card, 0);
-        lv_obj_add_style(obj, &styles->circle, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&circle, 0);
         lv_obj_add_style(obj, &styles->meter_indic, LV_PART_INDICATOR);
     }
 #endif
@@ -999,11 +1103,11 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
     else if(lv_obj_check_type(obj, &lv_textarea_class)) {
         lv_obj_add_style(obj, &styles->card, 0);
         lv_obj_add_style(obj, &styles->pad_small, 0);
-        lv_obj_add_style(obj, &styles->disabled, LV_STATE_DISABLED);
+        lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_STATE_DISABLED);
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
         lv_obj_add_style(obj, &styles->ta_cursor, LV_PART_CURSOR | LV_STATE_FOCUSED);
         lv_obj_add_style(obj, &styles->ta_placeholder, LV_PART_TEXTAREA_PLACEHOLDER);
     }
@@ -1012,7 +1116,7 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
 #if LV_USE_CALENDAR
     else if(lv_obj_check_type(obj, &lv_calendar_class)) {
         lv_obj_add_style(obj, &styles->card, 0);
-        lv_obj_add_style(obj, &styles->pad_zero, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&pad_zero, 0);
     }
 #endif
 
@@ -1035,10 +1139,10 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
         lv_obj_add_style(obj, &styles->outline_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->outline_secondary, LV_STATE_EDITED);
         lv_obj_add_style(obj, &styles->btn, LV_PART_ITEMS);
-        lv_obj_add_style(obj, &styles->disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
+        lv_obj_add_style(obj, (lv_style_t *)&disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
         lv_obj_add_style(obj, &styles->bg_color_white, LV_PART_ITEMS);
         lv_obj_add_style(obj, &styles->keyboard_btn_bg, LV_PART_ITEMS);
-        lv_obj_add_style(obj, &styles->pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+        lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
         lv_obj_add_style(obj, &styles->bg_color_grey, LV_PART_ITEMS | LV_STATE_CHECKED);
         lv_obj_add_style(obj, &styles->bg_color_primary_muted, LV_PART_ITEMS | LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->bg_color_secondary_muted, LV_PART_ITEMS | LV_STATE_EDITED);
@@ -1049,7 +1153,7 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
         lv_obj_add_style(obj, &styles->card, 0);
         lv_obj_add_style(obj, &styles->list_bg, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
         return;
     }
     else if(lv_obj_check_type(obj, &lv_list_text_class)) {
@@ -1062,24 +1166,24 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
         lv_obj_add_style(obj, &styles->bg_color_primary, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->list_item_grow, LV_STATE_FOCUS_KEY);
         lv_obj_add_style(obj, &styles->list_item_grow, LV_STATE_PRESSED);
-        lv_obj_add_style(obj, &styles->pressed, LV_STATE_PRESSED);
+        lv_obj_add_style(obj, (lv_style_t *)&pressed, LV_STATE_PRESSED);
 
     }
 #endif
 #if LV_USE_MENU
     else if(lv_obj_check_type(obj, &lv_menu_class)) {
         lv_obj_add_style(obj, &styles->card, 0);
-        lv_obj_add_style(obj, &styles->menu_bg, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&menu_bg, 0);
     }
     else if(lv_obj_check_type(obj, &lv_menu_sidebar_cont_class)) {
         lv_obj_add_style(obj, &styles->menu_sidebar_cont, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
     }
     else if(lv_obj_check_type(obj, &lv_menu_main_cont_class)) {
-        lv_obj_add_style(obj, &styles->menu_main_cont, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&menu_main_cont, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
     }
     else if(lv_obj_check_type(obj, &lv_menu_cont_class)) {
         lv_obj_add_style(obj, &styles->menu_cont, 0);
@@ -1093,9 +1197,9 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
         lv_obj_add_style(obj, &styles->menu_header_cont, 0);
     }
     else if(lv_obj_check_type(obj, &lv_menu_page_class)) {
-        lv_obj_add_style(obj, &styles->menu_page, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&menu_page, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
     }
     else if(lv_obj_check_type(obj, &lv_menu_section_class)) {
         lv_obj_add_style(obj, &styles->menu_section, 0);
@@ -1107,7 +1211,7 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
 #if LV_USE_MSGBOX
     else if(lv_obj_check_type(obj, &lv_msgbox_class)) {
         lv_obj_add_style(obj, &styles->card, 0);
-        lv_obj_add_style(obj, &styles->msgbox_bg, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&msgbox_bg, 0);
         return;
     }
     else if(lv_obj_check_type(obj, &lv_msgbox_backdrop_class)) {
@@ -1127,24 +1231,24 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
     else if(lv_obj_check_type(obj, &lv_tileview_class)) {
         lv_obj_add_style(obj, &styles->scr, 0);
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
     }
     else if(lv_obj_check_type(obj, &lv_tileview_tile_class)) {
         lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
-        lv_obj_add_style(obj, &styles->scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+        lv_obj_add_style(obj, (lv_style_t *)&scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
     }
 #endif
 
 #if LV_USE_TABVIEW
     else if(lv_obj_check_type(obj, &lv_tabview_class)) {
         lv_obj_add_style(obj, &styles->scr, 0);
-        lv_obj_add_style(obj, &styles->pad_zero, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&pad_zero, 0);
     }
 #endif
 
 #if LV_USE_WIN
     else if(lv_obj_check_type(obj, &lv_win_class)) {
-        lv_obj_add_style(obj, &styles->clip_corner, 0);
+        lv_obj_add_style(obj, (lv_style_t *)&clip_corner, 0);
     }
 #endif
 
@@ -1178,4 +1282,32 @@ static void style_init_reset(lv_style_t * style)
     }
 }
 
+static void style_combine(lv_style_t * style, const lv_style_t * src[], uint32_t src_cnt)
+{
+    style_init_reset(style);
+
+    /*Copy the properties in the order of the styles so the later ones overwrite the earlier ones
+     *just like if the styles were added one by one*/
+    uint32_t i;
+    for(i = 0; i < src_cnt; i++) {
+        const lv_style_t * s = src[i];
+        uint32_t j;
+        if(s->prop1 == LV_STYLE_PROP_ANY) {
+            for(j = 0; j < s->prop_cnt; j++) {
+                lv_style_set_prop(style, LV_STYLE_PROP_ID_MASK(s->v_p.const_props[j].prop), s->v_p.const_props[j].value);
+            }
+        }
+        else if(s->prop_cnt == 1) {
+            lv_style_set_prop(style, LV_STYLE_PROP_ID_MASK(s->prop1), s->v_p.value1);
+        }
+        else if(s->prop_cnt > 1) {
+            const lv_style_value_t * values = _lv_style_get_values(s);
+            const uint16_t * props = _lv_style_get_props(s);
+            for(j = 0; j < s->prop_cnt; j++) {
+                lv_style_set_prop(style, LV_STYLE_PROP_ID_MASK(props[j]), values[j]);
+            }
+        }
+    }
+}
+
 #endif
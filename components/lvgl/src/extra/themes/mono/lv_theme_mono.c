@@ -225,13 +225,13 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
 
 #if LV_USE_WIN
         /*Header*/
-        if(lv_obj_get_index(obj) == 0 && lv_obj_check_type(lv_obj_get_parent(obj), &lv_win_class)) {
+        if(lv_obj_check_type(lv_obj_get_parent(obj), &lv_win_class) && lv_obj_get_index(obj) == 0) {
             lv_obj_add_style(obj, &styles->card, 0);
             lv_obj_add_style(obj, &styles->no_radius, 0);
             return;
         }
         /*Content*/
-        else if(lv_obj_get_index(obj) == 1 && lv_obj_check_type(lv_obj_get_parent(obj), &lv_win_class)) {
+        else if(lv_obj_check_type(lv_obj_get_parent(obj), &lv_win_class) && lv_obj_get_index(obj) == 1) {
             lv_obj_add_style(obj, &styles->card, 0);
             lv_obj_add_style(obj, &styles->no_radius, 0);
             lv_obj_add_style(obj, &styles->scrollbar, LV_PART_SCROLLBAR);
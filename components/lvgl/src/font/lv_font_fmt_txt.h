@@ -195,6 +195,10 @@ typedef struct {
 
     /*Cache the last letter and is glyph id*/
     lv_font_fmt_txt_glyph_cache_t * cache;
+
+    /*If set, it's used instead of `glyph_bitmap` to get the (maybe compressed) bitmap of a glyph.
+     *E.g. to read the bitmaps from a file only when they are drawn.*/
+    const uint8_t * (*get_bitmap_data_cb)(const struct _lv_font_t * font, uint32_t gid);
 } lv_font_fmt_txt_dsc_t;
 
 /**********************
@@ -14,15 +14,51 @@
 #include "../misc/lv_fs.h"
 #include "lv_font_loader.h"
 
+/*********************
+ *      DEFINES
+ *********************/
+/*Read this many bytes at once while parsing the tables*/
+#define READER_BUF_SIZE 1024
+
 /**********************
  *      TYPEDEFS
  **********************/
 typedef struct {
-    lv_fs_file_t * fp;
-    int8_t bit_pos;
+    lv_fs_file_t * fp;      /*NULL if the whole section is in `buf`*/
+    uint8_t * buf;
+    uint32_t buf_start;     /*File position of `buf[0]`*/
+    uint32_t buf_len;       /*Number of valid bytes in `buf`*/
+    uint32_t pos;           /*File position of the next read*/
+} font_reader_t;
+
+typedef struct {
+    font_reader_t * reader;
+    uint8_t bit_cnt;        /*Unread bits in `byte_value`*/
     uint8_t byte_value;
 } bit_iterator_t;
 
+typedef struct {
+    uint32_t gid;           /*0: unused slot*/
+    uint32_t used;          /*Value of `use_cnt` when the glyph was last used*/
+    uint32_t size;
+    uint8_t * data;
+} glyph_page_t;
+
+/*Descriptor of the fonts loaded by `lv_font_load_paged()`*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;      /*Must be the first to be used as a normal font descriptor*/
+    lv_fs_file_t file;
+    uint32_t glyph_start;           /*File position of the glyph table*/
+    uint32_t * glyph_offset;        /*Offset of the glyphs in the glyph table, one more item marks the end*/
+    uint8_t glyph_header_bits;
+    glyph_page_t * pages;           /*Cached glyph bitmaps*/
+    uint32_t page_cnt;
+    uint32_t cache_size;
+    uint32_t cached_size;
+    uint32_t use_cnt;
+    uint32_t last_page;             /*Returned last. Can't be freed as still in use.*/
+} font_paged_dsc_t;
+
 typedef struct font_header_bin {
     uint32_t version;
     uint16_t tables_count;
@@ -63,9 +99,13 @@ typedef struct cmap_table_bin {
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
-int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
+static lv_font_t * font_load(const char * font_name, bool paged, uint32_t cache_size);
+static lv_fs_res_t reader_read(font_reader_t * r, void * data, uint32_t len);
+static bit_iterator_t init_bit_iterator(font_reader_t * reader);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool paged, uint32_t cache_size);
+static bool load_font_tables(font_reader_t * reader, lv_font_t * font);
+static int32_t load_kern(font_reader_t * reader, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
+static const uint8_t * paged_bitmap_get(const lv_font_t * font, uint32_t gid);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -85,29 +125,20 @@ static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res
  */
 lv_font_t * lv_font_load(const char * font_name)
 {
-    lv_fs_file_t file;
-    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
-    if(res != LV_FS_RES_OK)
-        return NULL;
-
-    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
-    if(font) {
-        memset(font, 0, sizeof(lv_font_t));
-        if(!lvgl_load_font(&file, font)) {
-            LV_LOG_WARN("Error loading font file: %s\n", font_name);
-            /*
-            * When `lvgl_load_font` fails it can leak some pointers.
-            * All non-null pointers can be assumed as allocated and
-            * `lv_font_free` should free them correctly.
-            */
-            lv_font_free(font);
-            font = NULL;
-        }
-    }
-
-    lv_fs_close(&file);
+    return font_load(font_name, false, 0);
+}
 
-    return font;
+/**
+ * Loads a `lv_font_t` object from a binary font file but leaves the glyph bitmaps in the file.
+ * They are read when a glyph is drawn and the recently used ones are kept in RAM.
+ * The file is open until the font is freed.
+ * @param font_name filename where the font file is located
+ * @param cache_size keep max. this many bytes of glyph bitmaps in RAM
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_paged(const char * font_name, uint32_t cache_size)
+{
+    return font_load(font_name, true, cache_size);
 }
 
 /**
@@ -169,6 +200,15 @@ void lv_font_free(lv_font_t * font)
             if(NULL != dsc->glyph_bitmap) {
                 lv_mem_free((void *)dsc->glyph_bitmap);
             }
+            if(dsc->get_bitmap_data_cb == paged_bitmap_get) {
+                font_paged_dsc_t * pdsc = (font_paged_dsc_t *)dsc;
+                for(uint32_t i = 0; i < pdsc->page_cnt; i++) {
+                    if(pdsc->pages[i].data) lv_mem_free(pdsc->pages[i].data);
+                }
+                if(pdsc->pages) lv_mem_free(pdsc->pages);
+                if(pdsc->glyph_offset) lv_mem_free(pdsc->glyph_offset);
+                if(pdsc->file.file_d) lv_fs_close(&pdsc->file);
+            }
             if(NULL != dsc->glyph_dsc) {
                 lv_mem_free((void *)dsc->glyph_dsc);
             }
@@ -182,11 +222,79 @@ void lv_font_free(lv_font_t * font)
  *   STATIC FUNCTIONS
  **********************/
 
-static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp)
+static lv_font_t * font_load(const char * font_name, bool paged, uint32_t cache_size)
+{
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK)
+        return NULL;
+
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    if(font) {
+        memset(font, 0, sizeof(lv_font_t));
+        if(!lvgl_load_font(&file, font, paged, cache_size)) {
+            LV_LOG_WARN("Error loading font file: %s\n", font_name);
+            /*
+            * When `lvgl_load_font` fails it can leak some pointers.
+            * All non-null pointers can be assumed as allocated and
+            * `lv_font_free` should free them correctly.
+            */
+            lv_font_free(font);
+            font = NULL;
+        }
+        else if(paged) {
+            /*The glyph bitmaps will be read from the file*/
+            ((font_paged_dsc_t *)font->dsc)->file = file;
+            return font;
+        }
+    }
+
+    lv_fs_close(&file);
+
+    return font;
+}
+
+static lv_fs_res_t reader_read(font_reader_t * r, void * data, uint32_t len)
+{
+    if(r->pos >= r->buf_start && r->pos - r->buf_start + len <= r->buf_len) {
+        lv_memcpy(data, &r->buf[r->pos - r->buf_start], len);
+        r->pos += len;
+        return LV_FS_RES_OK;
+    }
+
+    /*Out of the section*/
+    if(r->fp == NULL) return LV_FS_RES_INV_PARAM;
+
+    lv_fs_res_t res = lv_fs_seek(r->fp, r->pos, LV_FS_SEEK_SET);
+    if(res != LV_FS_RES_OK) return res;
+
+    /*Read large blocks directly to their place*/
+    uint32_t br;
+    if(len >= READER_BUF_SIZE) {
+        res = lv_fs_read(r->fp, data, len, &br);
+        if(res != LV_FS_RES_OK) return res;
+        if(br != len) return LV_FS_RES_UNKNOWN;
+        r->pos += len;
+        return LV_FS_RES_OK;
+    }
+
+    r->buf_start = r->pos;
+    r->buf_len = 0;
+    res = lv_fs_read(r->fp, r->buf, READER_BUF_SIZE, &br);
+    if(res != LV_FS_RES_OK) return res;
+    r->buf_len = br;
+    if(br < len) return LV_FS_RES_UNKNOWN;
+
+    lv_memcpy(data, r->buf, len);
+    r->pos += len;
+    return LV_FS_RES_OK;
+}
+
+static bit_iterator_t init_bit_iterator(font_reader_t * reader)
 {
     bit_iterator_t it;
-    it.fp = fp;
-    it.bit_pos = -1;
+    it.reader = reader;
+    it.bit_cnt = 0;
     it.byte_value = 0;
     return it;
 }
@@ -194,20 +302,20 @@ static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp)
 static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res)
 {
     unsigned int value = 0;
-    while(n_bits--) {
-        it->byte_value = it->byte_value << 1;
-        it->bit_pos--;
-
-        if(it->bit_pos < 0) {
-            it->bit_pos = 7;
-            *res = lv_fs_read(it->fp, &(it->byte_value), 1, NULL);
+    while(n_bits > 0) {
+        if(it->bit_cnt == 0) {
+            *res = reader_read(it->reader, &it->byte_value, 1);
             if(*res != LV_FS_RES_OK) {
                 return 0;
             }
+            it->bit_cnt = 8;
         }
-        int8_t bit = (it->byte_value & 0x80) ? 1 : 0;
 
-        value |= (bit << n_bits);
+        /*Take as many bits from the current byte as possible*/
+        int bits = LV_MIN(n_bits, it->bit_cnt);
+        it->bit_cnt -= bits;
+        value = (value << bits) | ((it->byte_value >> it->bit_cnt) & ((1u << bits) - 1));
+        n_bits -= bits;
     }
     *res = LV_FS_RES_OK;
     return value;
@@ -222,15 +330,15 @@ static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res)
     return value;
 }
 
-static int read_label(lv_fs_file_t * fp, int start, const char * label)
+static int read_label(font_reader_t * reader, int start, const char * label)
 {
-    lv_fs_seek(fp, start, LV_FS_SEEK_SET);
+    reader->pos = start;
 
     uint32_t length;
     char buf[4];
 
-    if(lv_fs_read(fp, &length, 4, NULL) != LV_FS_RES_OK
-       || lv_fs_read(fp, buf, 4, NULL) != LV_FS_RES_OK
+    if(reader_read(reader, &length, 4) != LV_FS_RES_OK
+       || reader_read(reader, buf, 4) != LV_FS_RES_OK
        || memcmp(label, buf, 4) != 0) {
         LV_LOG_WARN("Error reading '%s' label.", label);
         return -1;
@@ -239,18 +347,15 @@ static int read_label(lv_fs_file_t * fp, int start, const char * label)
     return length;
 }
 
-static bool load_cmaps_tables(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
+static bool load_cmaps_tables(font_reader_t * reader, lv_font_fmt_txt_dsc_t * font_dsc,
                               uint32_t cmaps_start, cmap_table_bin_t * cmap_table)
 {
-    if(lv_fs_read(fp, cmap_table, font_dsc->cmap_num * sizeof(cmap_table_bin_t), NULL) != LV_FS_RES_OK) {
+    if(reader_read(reader, cmap_table, font_dsc->cmap_num * sizeof(cmap_table_bin_t)) != LV_FS_RES_OK) {
         return false;
     }
 
     for(unsigned int i = 0; i < font_dsc->cmap_num; ++i) {
-        lv_fs_res_t res = lv_fs_seek(fp, cmaps_start + cmap_table[i].data_offset, LV_FS_SEEK_SET);
-        if(res != LV_FS_RES_OK) {
-            return false;
-        }
+        reader->pos = cmaps_start + cmap_table[i].data_offset;
 
         lv_font_fmt_txt_cmap_t * cmap = (lv_font_fmt_txt_cmap_t *) & (font_dsc->cmaps[i]);
 
@@ -266,7 +371,7 @@ static bool load_cmaps_tables(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_ds
 
                     cmap->glyph_id_ofs_list = glyph_id_ofs_list;
 
-                    if(lv_fs_read(fp, glyph_id_ofs_list, ids_size, NULL) != LV_FS_RES_OK) {
+                    if(reader_read(reader, glyph_id_ofs_list, ids_size) != LV_FS_RES_OK) {
                         return false;
                     }
 
@@ -283,7 +388,7 @@ static bool load_cmaps_tables(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_ds
                     cmap->unicode_list = unicode_list;
                     cmap->list_length = cmap_table[i].data_entries_count;
 
-                    if(lv_fs_read(fp, unicode_list, list_size, NULL) != LV_FS_RES_OK) {
+                    if(reader_read(reader, unicode_list, list_size) != LV_FS_RES_OK) {
                         return false;
                     }
 
@@ -292,7 +397,7 @@ static bool load_cmaps_tables(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_ds
 
                         cmap->glyph_id_ofs_list = buf;
 
-                        if(lv_fs_read(fp, buf, sizeof(uint16_t) * cmap->list_length, NULL) != LV_FS_RES_OK) {
+                        if(reader_read(reader, buf, sizeof(uint16_t) * cmap->list_length) != LV_FS_RES_OK) {
                             return false;
                         }
                     }
@@ -306,15 +411,15 @@ static bool load_cmaps_tables(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_ds
     return true;
 }
 
-static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint32_t cmaps_start)
+static int32_t load_cmaps(font_reader_t * reader, lv_font_fmt_txt_dsc_t * font_dsc, uint32_t cmaps_start)
 {
-    int32_t cmaps_length = read_label(fp, cmaps_start, "cmap");
+    int32_t cmaps_length = read_label(reader, cmaps_start, "cmap");
     if(cmaps_length < 0) {
         return -1;
     }
 
     uint32_t cmaps_subtables_count;
-    if(lv_fs_read(fp, &cmaps_subtables_count, sizeof(uint32_t), NULL) != LV_FS_RES_OK) {
+    if(reader_read(reader, &cmaps_subtables_count, sizeof(uint32_t)) != LV_FS_RES_OK) {
         return -1;
     }
 
@@ -328,21 +433,38 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
 
     cmap_table_bin_t * cmaps_tables = lv_mem_alloc(sizeof(cmap_table_bin_t) * font_dsc->cmap_num);
 
-    bool success = load_cmaps_tables(fp, font_dsc, cmaps_start, cmaps_tables);
+    bool success = load_cmaps_tables(reader, font_dsc, cmaps_start, cmaps_tables);
 
     lv_mem_free(cmaps_tables);
 
     return success ? cmaps_length : -1;
 }
 
-static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
+/*The bitmaps start right after the header of the glyphs which can end in the middle of a byte.
+ *Shift the bitmap to start at the MSB of `dst`. `dst` can be the same or before `src`.*/
+static void align_bitmap(uint8_t * dst, const uint8_t * src, uint32_t size, uint8_t shift)
+{
+    if(shift == 0) {
+        memmove(dst, src, size);
+        return;
+    }
+
+    for(uint32_t k = 0; k < size - 1; ++k) {
+        dst[k] = (src[k] << shift) | (src[k + 1] >> (8 - shift));
+    }
+    dst[size - 1] = src[size - 1] << shift;
+}
+
+static int32_t load_glyph(font_reader_t * reader, lv_font_fmt_txt_dsc_t * font_dsc,
                           uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
 {
-    int32_t glyph_length = read_label(fp, start, "glyf");
+    int32_t glyph_length = read_label(reader, start, "glyf");
     if(glyph_length < 0) {
         return -1;
     }
 
+    bool paged = font_dsc->get_bitmap_data_cb == paged_bitmap_get;
+
     lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = (lv_font_fmt_txt_glyph_dsc_t *)
                                               lv_mem_alloc(loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t));
 
@@ -350,17 +472,38 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
 
     font_dsc->glyph_dsc = glyph_dsc;
 
-    int cur_bmp_size = 0;
-
-    for(unsigned int i = 0; i < loca_count; ++i) {
-        lv_font_fmt_txt_glyph_dsc_t * gdsc = &glyph_dsc[i];
+    /*If the bitmaps are loaded too read the whole table at once and parse it from the memory.
+     *The bitmaps are moved to the beginning of the same buffer later.*/
+    uint8_t * glyph_bmp = NULL;
+    font_reader_t mem_reader;
+    if(!paged) {
+        glyph_bmp = (uint8_t *)lv_mem_alloc(glyph_length);
+        font_dsc->glyph_bitmap = glyph_bmp;
+        if(glyph_bmp == NULL) {
+            return -1;
+        }
 
-        lv_fs_res_t res = lv_fs_seek(fp, start + glyph_offset[i], LV_FS_SEEK_SET);
-        if(res != LV_FS_RES_OK) {
+        reader->pos = start;
+        if(reader_read(reader, glyph_bmp, glyph_length) != LV_FS_RES_OK) {
             return -1;
         }
 
-        bit_iterator_t bit_it = init_bit_iterator(fp);
+        mem_reader.fp = NULL;
+        mem_reader.buf = glyph_bmp;
+        mem_reader.buf_start = start;
+        mem_reader.buf_len = glyph_length;
+        reader = &mem_reader;
+    }
+
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+    uint32_t cur_bmp_size = 0;
+
+    for(unsigned int i = 0; i < loca_count; ++i) {
+        lv_font_fmt_txt_glyph_dsc_t * gdsc = &glyph_dsc[i];
+
+        reader->pos = start + glyph_offset[i];
+        bit_iterator_t bit_it = init_bit_iterator(reader);
+        lv_fs_res_t res;
 
         if(header->advance_width_bits == 0) {
             gdsc->adv_w = header->default_advance_width;
@@ -396,10 +539,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             return -1;
         }
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-        int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
-        int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
-
         if(i == 0) {
             gdsc->adv_w = 0;
             gdsc->box_w = 0;
@@ -408,63 +547,45 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             gdsc->ofs_y = 0;
         }
 
-        gdsc->bitmap_index = cur_bmp_size;
-        if(gdsc->box_w * gdsc->box_h != 0) {
-            cur_bmp_size += bmp_size;
+        if(!paged) {
+            gdsc->bitmap_index = cur_bmp_size;
         }
-    }
 
-    uint8_t * glyph_bmp = (uint8_t *)lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
-
-    font_dsc->glyph_bitmap = glyph_bmp;
-
-    cur_bmp_size = 0;
-
-    for(unsigned int i = 1; i < loca_count; ++i) {
-        lv_fs_res_t res = lv_fs_seek(fp, start + glyph_offset[i], LV_FS_SEEK_SET);
-        if(res != LV_FS_RES_OK) {
-            return -1;
+        if(gdsc->box_w * gdsc->box_h == 0) {
+            continue;
         }
-        bit_iterator_t bit_it = init_bit_iterator(fp);
-
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
 
-        read_bits(&bit_it, nbits, &res);
-        if(res != LV_FS_RES_OK) {
+        uint32_t next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
+        if(next_offset > (uint32_t)glyph_length || glyph_offset[i] + nbits / 8 >= next_offset) {
+            LV_LOG_WARN("Invalid offset of glyph %d.", i);
             return -1;
         }
 
-        if(glyph_dsc[i].box_w * glyph_dsc[i].box_h == 0) {
-            continue;
+        if(!paged) {
+            cur_bmp_size += next_offset - glyph_offset[i] - nbits / 8;
         }
+    }
 
-        int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
-        int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
+    if(paged) {
+        return glyph_length;
+    }
 
-        if(nbits % 8 == 0) {  /*Fast path*/
-            if(lv_fs_read(fp, &glyph_bmp[cur_bmp_size], bmp_size, NULL) != LV_FS_RES_OK) {
-                return -1;
-            }
+    for(unsigned int i = 1; i < loca_count; ++i) {
+        if(glyph_dsc[i].box_w * glyph_dsc[i].box_h == 0) {
+            continue;
         }
-        else {
-            for(int k = 0; k < bmp_size - 1; ++k) {
-                glyph_bmp[cur_bmp_size + k] = read_bits(&bit_it, 8, &res);
-                if(res != LV_FS_RES_OK) {
-                    return -1;
-                }
-            }
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
-            if(res != LV_FS_RES_OK) {
-                return -1;
-            }
-
-            /*The last fragment should be on the MSB but read_bits() will place it to the LSB*/
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = glyph_bmp[cur_bmp_size + bmp_size - 1] << (nbits % 8);
 
-        }
+        uint32_t next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
+        uint32_t bmp_start = glyph_offset[i] + nbits / 8;
+        align_bitmap(&glyph_bmp[glyph_dsc[i].bitmap_index], &glyph_bmp[bmp_start], next_offset - bmp_start, nbits % 8);
+    }
 
-        cur_bmp_size += bmp_size;
+    /*Free the unused end of the buffer*/
+    if(cur_bmp_size > 0) {
+        glyph_bmp = lv_mem_realloc(glyph_bmp, cur_bmp_size);
+        if(glyph_bmp) font_dsc->glyph_bitmap = glyph_bmp;
     }
+
     return glyph_length;
 }
 
@@ -480,23 +601,49 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool paged, uint32_t cache_size)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+    size_t dsc_size = paged ? sizeof(font_paged_dsc_t) : sizeof(lv_font_fmt_txt_dsc_t);
+    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)lv_mem_alloc(dsc_size);
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(font_dsc, 0, dsc_size);
 
     font->dsc = font_dsc;
 
+    if(paged) {
+        font_paged_dsc_t * pdsc = (font_paged_dsc_t *)font_dsc;
+        font_dsc->get_bitmap_data_cb = paged_bitmap_get;
+        pdsc->cache_size = cache_size;
+        pdsc->last_page = UINT32_MAX;
+    }
+
+    font_reader_t reader;
+    memset(&reader, 0, sizeof(font_reader_t));
+    reader.fp = fp;
+    reader.buf = lv_mem_alloc(READER_BUF_SIZE);
+    if(reader.buf == NULL) {
+        return false;
+    }
+
+    bool success = load_font_tables(&reader, font);
+
+    lv_mem_free(reader.buf);
+
+    return success;
+}
+
+static bool load_font_tables(font_reader_t * reader, lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+
     /*header*/
-    int32_t header_length = read_label(fp, 0, "head");
+    int32_t header_length = read_label(reader, 0, "head");
     if(header_length < 0) {
         return false;
     }
 
     font_header_bin_t font_header;
-    if(lv_fs_read(fp, &font_header, sizeof(font_header_bin_t), NULL) != LV_FS_RES_OK) {
+    if(reader_read(reader, &font_header, sizeof(font_header_bin_t)) != LV_FS_RES_OK) {
         return false;
     }
 
@@ -514,38 +661,44 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     /*cmaps*/
     uint32_t cmaps_start = header_length;
-    int32_t cmaps_length = load_cmaps(fp, font_dsc, cmaps_start);
+    int32_t cmaps_length = load_cmaps(reader, font_dsc, cmaps_start);
     if(cmaps_length < 0) {
         return false;
     }
 
     /*loca*/
     uint32_t loca_start = cmaps_start + cmaps_length;
-    int32_t loca_length = read_label(fp, loca_start, "loca");
+    int32_t loca_length = read_label(reader, loca_start, "loca");
     if(loca_length < 0) {
         return false;
     }
 
     uint32_t loca_count;
-    if(lv_fs_read(fp, &loca_count, sizeof(uint32_t), NULL) != LV_FS_RES_OK) {
+    if(reader_read(reader, &loca_count, sizeof(uint32_t)) != LV_FS_RES_OK) {
         return false;
     }
 
     bool failed = false;
     uint32_t * glyph_offset = lv_mem_alloc(sizeof(uint32_t) * (loca_count + 1));
+    if(glyph_offset == NULL) {
+        return false;
+    }
 
     if(font_header.index_to_loc_format == 0) {
-        for(unsigned int i = 0; i < loca_count; ++i) {
-            uint16_t offset;
-            if(lv_fs_read(fp, &offset, sizeof(uint16_t), NULL) != LV_FS_RES_OK) {
-                failed = true;
-                break;
+        /*Read the 16 bit offsets to the beginning of the array and widen them from the end*/
+        if(reader_read(reader, glyph_offset, loca_count * sizeof(uint16_t)) != LV_FS_RES_OK) {
+            failed = true;
+        }
+        else {
+            for(unsigned int i = loca_count; i > 0; --i) {
+                uint16_t offset;
+                memcpy(&offset, (uint8_t *)glyph_offset + (i - 1) * sizeof(uint16_t), sizeof(uint16_t));
+                glyph_offset[i - 1] = offset;
             }
-            glyph_offset[i] = offset;
         }
     }
     else if(font_header.index_to_loc_format == 1) {
-        if(lv_fs_read(fp, glyph_offset, loca_count * sizeof(uint32_t), NULL) != LV_FS_RES_OK) {
+        if(reader_read(reader, glyph_offset, loca_count * sizeof(uint32_t)) != LV_FS_RES_OK) {
             failed = true;
         }
     }
@@ -562,9 +715,19 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     /*glyph*/
     uint32_t glyph_start = loca_start + loca_length;
     int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
-
-    lv_mem_free(glyph_offset);
+                               reader, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+
+    if(glyph_length >= 0 && font_dsc->get_bitmap_data_cb == paged_bitmap_get) {
+        /*Keep the offsets to find the bitmaps in the file*/
+        font_paged_dsc_t * pdsc = (font_paged_dsc_t *)font_dsc;
+        glyph_offset[loca_count] = glyph_length;
+        pdsc->glyph_offset = glyph_offset;
+        pdsc->glyph_start = glyph_start;
+        pdsc->glyph_header_bits = font_header.advance_width_bits + 2 * font_header.xy_bits + 2 * font_header.wh_bits;
+    }
+    else {
+        lv_mem_free(glyph_offset);
+    }
 
     if(glyph_length < 0) {
         return false;
@@ -579,22 +742,22 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     uint32_t kern_start = glyph_start + glyph_length;
 
-    int32_t kern_length = load_kern(fp, font_dsc, font_header.glyph_id_format, kern_start);
+    int32_t kern_length = load_kern(reader, font_dsc, font_header.glyph_id_format, kern_start);
 
     return kern_length >= 0;
 }
 
-int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start)
+static int32_t load_kern(font_reader_t * reader, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start)
 {
-    int32_t kern_length = read_label(fp, start, "kern");
+    int32_t kern_length = read_label(reader, start, "kern");
     if(kern_length < 0) {
         return -1;
     }
 
     uint8_t kern_format_type;
     int32_t padding;
-    if(lv_fs_read(fp, &kern_format_type, sizeof(uint8_t), NULL) != LV_FS_RES_OK ||
-       lv_fs_read(fp, &padding, 3 * sizeof(uint8_t), NULL) != LV_FS_RES_OK) {
+    if(reader_read(reader, &kern_format_type, sizeof(uint8_t)) != LV_FS_RES_OK ||
+       reader_read(reader, &padding, 3 * sizeof(uint8_t)) != LV_FS_RES_OK) {
         return -1;
     }
 
@@ -607,7 +770,7 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
         font_dsc->kern_classes = 0;
 
         uint32_t glyph_entries;
-        if(lv_fs_read(fp, &glyph_entries, sizeof(uint32_t), NULL) != LV_FS_RES_OK) {
+        if(reader_read(reader, &glyph_entries, sizeof(uint32_t)) != LV_FS_RES_OK) {
             return -1;
         }
 
@@ -627,11 +790,11 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
         kern_pair->glyph_ids = glyph_ids;
         kern_pair->values = values;
 
-        if(lv_fs_read(fp, glyph_ids, ids_size, NULL) != LV_FS_RES_OK) {
+        if(reader_read(reader, glyph_ids, ids_size) != LV_FS_RES_OK) {
             return -1;
         }
 
-        if(lv_fs_read(fp, values, glyph_entries, NULL) != LV_FS_RES_OK) {
+        if(reader_read(reader, values, glyph_entries) != LV_FS_RES_OK) {
             return -1;
         }
     }
@@ -648,9 +811,9 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
         uint8_t kern_table_rows;
         uint8_t kern_table_cols;
 
-        if(lv_fs_read(fp, &kern_class_mapping_length, sizeof(uint16_t), NULL) != LV_FS_RES_OK ||
-           lv_fs_read(fp, &kern_table_rows, sizeof(uint8_t), NULL) != LV_FS_RES_OK ||
-           lv_fs_read(fp, &kern_table_cols, sizeof(uint8_t), NULL) != LV_FS_RES_OK) {
+        if(reader_read(reader, &kern_class_mapping_length, sizeof(uint16_t)) != LV_FS_RES_OK ||
+           reader_read(reader, &kern_table_rows, sizeof(uint8_t)) != LV_FS_RES_OK ||
+           reader_read(reader, &kern_table_cols, sizeof(uint8_t)) != LV_FS_RES_OK) {
             return -1;
         }
 
@@ -666,9 +829,9 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
         kern_classes->right_class_cnt = kern_table_cols;
         kern_classes->class_pair_values = kern_values;
 
-        if(lv_fs_read(fp, kern_left, kern_class_mapping_length, NULL) != LV_FS_RES_OK ||
-           lv_fs_read(fp, kern_right, kern_class_mapping_length, NULL) != LV_FS_RES_OK ||
-           lv_fs_read(fp, kern_values, kern_values_length, NULL) != LV_FS_RES_OK) {
+        if(reader_read(reader, kern_left, kern_class_mapping_length) != LV_FS_RES_OK ||
+           reader_read(reader, kern_right, kern_class_mapping_length) != LV_FS_RES_OK ||
+           reader_read(reader, kern_values, kern_values_length) != LV_FS_RES_OK) {
             return -1;
         }
     }
@@ -679,3 +842,95 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 
     return kern_length;
 }
+
+/*Read the bitmap of a glyph into the cache and return its index in `pages`*/
+static uint32_t page_load(font_paged_dsc_t * pdsc, uint32_t gid)
+{
+    uint32_t bmp_start = pdsc->glyph_offset[gid] + pdsc->glyph_header_bits / 8;
+    uint32_t size = pdsc->glyph_offset[gid + 1] - bmp_start;
+
+    /*Free the least recently used bitmaps to make room*/
+    uint32_t i;
+    while(pdsc->cached_size + size > pdsc->cache_size) {
+        uint32_t lru = UINT32_MAX;
+        for(i = 0; i < pdsc->page_cnt; i++) {
+            if(pdsc->pages[i].gid == 0 || pdsc->last_page == i) continue;
+            if(lru == UINT32_MAX || pdsc->pages[i].used < pdsc->pages[lru].used) lru = i;
+        }
+        if(lru == UINT32_MAX) break;
+
+        lv_mem_free(pdsc->pages[lru].data);
+        pdsc->cached_size -= pdsc->pages[lru].size;
+        lv_memset_00(&pdsc->pages[lru], sizeof(glyph_page_t));
+    }
+
+    uint8_t * data = lv_mem_alloc(size);
+    LV_ASSERT_MALLOC(data);
+    if(data == NULL) return UINT32_MAX;
+
+    uint32_t br = 0;
+    lv_fs_res_t res = lv_fs_seek(&pdsc->file, pdsc->glyph_start + bmp_start, LV_FS_SEEK_SET);
+    if(res == LV_FS_RES_OK) res = lv_fs_read(&pdsc->file, data, size, &br);
+    if(res != LV_FS_RES_OK || br != size) {
+        LV_LOG_WARN("Couldn't read the bitmap of glyph %d.", (int)gid);
+        lv_mem_free(data);
+        return UINT32_MAX;
+    }
+
+    align_bitmap(data, data, size, pdsc->glyph_header_bits % 8);
+
+    /*Use a free slot or add a new one*/
+    for(i = 0; i < pdsc->page_cnt && pdsc->pages[i].gid != 0; i++);
+    if(i == pdsc->page_cnt) {
+        glyph_page_t * pages = lv_mem_realloc(pdsc->pages, (pdsc->page_cnt + 1) * sizeof(glyph_page_t));
+        LV_ASSERT_MALLOC(pages);
+        if(pages == NULL) {
+            lv_mem_free(data);
+            return UINT32_MAX;
+        }
+        pdsc->pages = pages;
+        pdsc->page_cnt++;
+    }
+
+    pdsc->pages[i].gid = gid;
+    pdsc->pages[i].size = size;
+    pdsc->pages[i].data = data;
+    pdsc->cached_size += size;
+
+    return i;
+}
+
+/*Used as `get_bitmap_data_cb` of the fonts loaded by `lv_font_load_paged()`*/
+static const uint8_t * paged_bitmap_get(const lv_font_t * font, uint32_t gid)
+{
+    font_paged_dsc_t * pdsc = (font_paged_dsc_t *)font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &pdsc->dsc.glyph_dsc[gid];
+    if(gdsc->box_w * gdsc->box_h == 0) return NULL;
+
+    uint32_t page_id = UINT32_MAX;
+    if(pdsc->last_page != UINT32_MAX && pdsc->pages[pdsc->last_page].gid == gid) {
+        page_id = pdsc->last_page;
+    }
+    else {
+        uint32_t i;
+        for(i = 0; i < pdsc->page_cnt; i++) {
+            if(pdsc->pages[i].gid == gid) {
+                page_id = i;
+                break;
+            }
+        }
+        /*Not needed anymore*/
+        pdsc->last_page = UINT32_MAX;
+        if(page_id == UINT32_MAX) page_id = page_load(pdsc, gid);
+    }
+
+    const uint8_t * data = NULL;
+    if(page_id != UINT32_MAX) {
+        pdsc->use_cnt++;
+        pdsc->pages[page_id].used = pdsc->use_cnt;
+        pdsc->last_page = page_id;
+        data = pdsc->pages[page_id].data;
+    }
+
+    return data;
+}
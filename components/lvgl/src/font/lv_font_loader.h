@@ -27,6 +27,7 @@ extern "C" {
  **********************/
 
 lv_font_t * lv_font_load(const char * fontName);
+lv_font_t * lv_font_load_paged(const char * font_name, uint32_t cache_size);
 void lv_font_free(lv_font_t * font);
 
 /**********************
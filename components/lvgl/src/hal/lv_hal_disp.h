@@ -98,6 +98,8 @@ typedef struct _lv_disp_drv_t {
     uint32_t rotated : 2;            /**< 1: turn the display by 90 degree. @warning Does not update coordinates for you!*/
     uint32_t screen_transp : 1;      /**Handle if the screen doesn't have a solid (opa == LV_OPA_COVER) background.
                                        * Use only if required because it's slower.*/
+    uint32_t rgb888_out : 1;         /**< 1: the draw buffers hold packed R, G, B bytes (3 bytes/pixel).
+                                       * Needs `LV_COLOR_RGB888_OUT 1`. See `lv_draw_sw_rgb888_set()`.*/
 
     uint32_t dpi : 10;              /** DPI (dot per inch) of the display. Default value is `LV_DPI_DEF`.*/
 
@@ -136,6 +138,11 @@ typedef struct _lv_disp_drv_t {
     /** OPTIONAL: called when start rendering */
     void (*render_start_cb)(struct _lv_disp_drv_t * disp_drv);
 
+    /** OPTIONAL: Called when the content of a full width area is scrolled vertically by `dy` pixels.
+     * Return true if the display itself shifted the current content of the area (e.g. with a hardware scroll),
+     * then only the uncovered rows are redrawn. The later flushes still use the screen's coordinates.*/
+    bool (*hw_scroll_cb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dy);
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_CHROMA_KEY` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
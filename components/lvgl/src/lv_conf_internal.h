@@ -90,6 +90,17 @@
     #endif
 #endif
 
+/*Let display drivers set `rgb888_out` to render directly into packed 3 bytes/pixel (R, G, B) draw buffers.
+ *With LV_COLOR_DEPTH 16 the channels are in the top bits of the bytes, as 18 bit (RGB666) displays expect.
+ *The draw buffers need 3 bytes per pixel. Requires LV_COLOR_DEPTH 16 or 32.*/
+#ifndef LV_COLOR_RGB888_OUT
+    #ifdef CONFIG_LV_COLOR_RGB888_OUT
+        #define LV_COLOR_RGB888_OUT CONFIG_LV_COLOR_RGB888_OUT
+    #else
+        #define LV_COLOR_RGB888_OUT 0
+    #endif
+#endif
+
 /* Adjust color mix functions rounding. GPUs might calculate color mix (blending) differently.
  * 0: round down, 64: round up from x.75, 128: round up from half, 192: round up from x.25, 254: round up */
 #ifndef LV_COLOR_MIX_ROUND_OFS
@@ -207,6 +218,26 @@
     #endif
 #endif
 
+/*1: Keep the memory of the deleted objects in free lists per size to create new objects in it.
+ *Call `lv_obj_pool_flush()` to free them.*/
+#ifndef LV_USE_OBJ_POOL
+    #ifdef CONFIG_LV_USE_OBJ_POOL
+        #define LV_USE_OBJ_POOL CONFIG_LV_USE_OBJ_POOL
+    #else
+        #define LV_USE_OBJ_POOL 0
+    #endif
+#endif
+#if LV_USE_OBJ_POOL
+    /*At most this many bytes are kept in the free lists*/
+    #ifndef LV_OBJ_POOL_MAX_SIZE
+        #ifdef CONFIG_LV_OBJ_POOL_MAX_SIZE
+            #define LV_OBJ_POOL_MAX_SIZE CONFIG_LV_OBJ_POOL_MAX_SIZE
+        #else
+            #define LV_OBJ_POOL_MAX_SIZE (16 * 1024)
+        #endif
+    #endif
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -229,6 +260,26 @@
     #endif
 #endif
 
+/*1: Allow a grid index of the clickable objects per screen for fast pointer hit-testing.
+ *Enable it on a screen with `lv_indev_index_enable(scr, true)`*/
+#ifndef LV_USE_INDEV_INDEX
+    #ifdef CONFIG_LV_USE_INDEV_INDEX
+        #define LV_USE_INDEV_INDEX CONFIG_LV_USE_INDEV_INDEX
+    #else
+        #define LV_USE_INDEV_INDEX 0
+    #endif
+#endif
+#if LV_USE_INDEV_INDEX
+    /*Width and height of a grid cell in pixels*/
+    #ifndef LV_INDEV_INDEX_CELL_SIZE
+        #ifdef CONFIG_LV_INDEV_INDEX_CELL_SIZE
+            #define LV_INDEV_INDEX_CELL_SIZE CONFIG_LV_INDEV_INDEX_CELL_SIZE
+        #else
+            #define LV_INDEV_INDEX_CELL_SIZE 32
+        #endif
+    #endif
+#endif
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #ifndef LV_TICK_CUSTOM
@@ -293,7 +344,7 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching a shadow has (shadow size)^2 RAM cost*/
     #ifndef LV_SHADOW_CACHE_SIZE
         #ifdef CONFIG_LV_SHADOW_CACHE_SIZE
             #define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -302,9 +353,18 @@
         #endif
     #endif
 
+    /*Max. total size of the cached shadows in bytes. The least recently used ones are freed first.*/
+    #ifndef LV_SHADOW_CACHE_BUF_MAX_SIZE
+        #ifdef CONFIG_LV_SHADOW_CACHE_BUF_MAX_SIZE
+            #define LV_SHADOW_CACHE_BUF_MAX_SIZE CONFIG_LV_SHADOW_CACHE_BUF_MAX_SIZE
+        #else
+            #define LV_SHADOW_CACHE_BUF_MAX_SIZE (16 * 1024)
+        #endif
+    #endif
+
     /* Set number of maximally cached circle data.
     * The circumference of 1/4 circle are saved for anti-aliasing
-    * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+    * radius * 6 bytes are used per circle (the most often used radiuses are saved)
     * 0: to disable caching */
     #ifndef LV_CIRCLE_CACHE_SIZE
         #ifdef CONFIG_LV_CIRCLE_CACHE_SIZE
@@ -313,6 +373,24 @@
             #define LV_CIRCLE_CACHE_SIZE 4
         #endif
     #endif
+
+    /*Max. total size of the cached circles in bytes*/
+    #ifndef LV_CIRCLE_CACHE_BUF_MAX_SIZE
+        #ifdef CONFIG_LV_CIRCLE_CACHE_BUF_MAX_SIZE
+            #define LV_CIRCLE_CACHE_BUF_MAX_SIZE CONFIG_LV_CIRCLE_CACHE_BUF_MAX_SIZE
+        #else
+            #define LV_CIRCLE_CACHE_BUF_MAX_SIZE (4 * 1024)
+        #endif
+    #endif
+
+    /*Comma separated list of radii (e.g. "8,12") whose circle is calculated in `lv_init` and never freed*/
+    #ifndef LV_CIRCLE_CACHE_PRESET_RADII
+        #ifdef CONFIG_LV_CIRCLE_CACHE_PRESET_RADII
+            #define LV_CIRCLE_CACHE_PRESET_RADII CONFIG_LV_CIRCLE_CACHE_PRESET_RADII
+        #else
+            #define LV_CIRCLE_CACHE_PRESET_RADII ""
+        #endif
+    #endif
 #endif /*LV_DRAW_COMPLEX*/
 
 /**
@@ -412,6 +490,67 @@
     #endif
 #endif
 
+/*Draw the objects of an invalid area only once into a command list and replay the list for each part
+ *of the draw buffer instead of walking the objects again for every part.
+ *Areas with layers (transformed or semi-transparent widgets) are drawn directly as before.*/
+#ifndef LV_USE_DRAW_REC
+    #ifdef CONFIG_LV_USE_DRAW_REC
+        #define LV_USE_DRAW_REC CONFIG_LV_USE_DRAW_REC
+    #else
+        #define LV_USE_DRAW_REC 0
+    #endif
+#endif
+#if LV_USE_DRAW_REC
+    /*Maximum size of the command list in bytes. Areas needing more are drawn directly.*/
+    #ifndef LV_DRAW_REC_BUF_MAX_SIZE
+        #ifdef CONFIG_LV_DRAW_REC_BUF_MAX_SIZE
+            #define LV_DRAW_REC_BUF_MAX_SIZE CONFIG_LV_DRAW_REC_BUF_MAX_SIZE
+        #else
+            #define LV_DRAW_REC_BUF_MAX_SIZE (32 * 1024)
+        #endif
+    #endif
+#endif
+
+/*Skip the objects (or the parts of them) which are covered by opaque objects drawn later in the same area.
+ *Overdraw statistics are added to the trace as counters.*/
+#ifndef LV_USE_OCCLUSION_CULL
+    #ifdef CONFIG_LV_USE_OCCLUSION_CULL
+        #define LV_USE_OCCLUSION_CULL CONFIG_LV_USE_OCCLUSION_CULL
+    #else
+        #define LV_USE_OCCLUSION_CULL 0
+    #endif
+#endif
+#if LV_USE_OCCLUSION_CULL
+    /*Maximum number of skipped or clipped objects per area. The others are drawn normally.*/
+    #ifndef LV_OCCLUSION_CULL_MAX_OBJ
+        #ifdef CONFIG_LV_OCCLUSION_CULL_MAX_OBJ
+            #define LV_OCCLUSION_CULL_MAX_OBJ CONFIG_LV_OCCLUSION_CULL_MAX_OBJ
+        #else
+            #define LV_OCCLUSION_CULL_MAX_OBJ 32
+        #endif
+    #endif
+#endif
+
+/*Allow keeping a bitmap of an object and its children and drawing it while they don't change.
+ *Enable it on an object with `lv_obj_add_flag(obj, LV_OBJ_FLAG_CACHED)`. Requires LV_USE_SNAPSHOT.*/
+#ifndef LV_USE_OBJ_CACHE
+    #ifdef CONFIG_LV_USE_OBJ_CACHE
+        #define LV_USE_OBJ_CACHE CONFIG_LV_USE_OBJ_CACHE
+    #else
+        #define LV_USE_OBJ_CACHE 0
+    #endif
+#endif
+#if LV_USE_OBJ_CACHE
+    /*Total size of the bitmaps in bytes. The least recently used bitmaps are dropped to fit.*/
+    #ifndef LV_OBJ_CACHE_MAX_SIZE
+        #ifdef CONFIG_LV_OBJ_CACHE_MAX_SIZE
+            #define LV_OBJ_CACHE_MAX_SIZE CONFIG_LV_OBJ_CACHE_MAX_SIZE
+        #else
+            #define LV_OBJ_CACHE_MAX_SIZE (256 * 1024)
+        #endif
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -776,6 +915,34 @@
     #endif
 #endif
 
+/*1: Record the spans of the refresh (layout, areas, widgets, draw primitives, flushing) to export them
+ *as Chrome trace-event JSON with `lv_trace_export()`. Recording is started with `lv_trace_start()`*/
+#ifndef LV_USE_TRACE
+    #ifdef CONFIG_LV_USE_TRACE
+        #define LV_USE_TRACE CONFIG_LV_USE_TRACE
+    #else
+        #define LV_USE_TRACE 0
+    #endif
+#endif
+#if LV_USE_TRACE
+    #ifndef LV_TRACE_BUF_SIZE
+        #ifdef CONFIG_LV_TRACE_BUF_SIZE
+            #define LV_TRACE_BUF_SIZE CONFIG_LV_TRACE_BUF_SIZE
+        #else
+            #define LV_TRACE_BUF_SIZE 1024      /*Number of events kept in the ring buffer (16 bytes each on 32 bit targets)*/
+        #endif
+    #endif
+
+    /*1: Show the layout/render/flush/wait time of the last frame as a bar over the screen*/
+    #ifndef LV_USE_TRACE_BAR
+        #ifdef CONFIG_LV_USE_TRACE_BAR
+            #define LV_USE_TRACE_BAR CONFIG_LV_USE_TRACE_BAR
+        #else
+            #define LV_USE_TRACE_BAR 0
+        #endif
+    #endif
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #ifndef LV_SPRINTF_CUSTOM
     #ifdef CONFIG_LV_SPRINTF_CUSTOM
@@ -1477,6 +1644,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_LINE_CACHE
+                #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+            #else
+                #define LV_LABEL_LINE_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_LINE_CACHE 1     /*Cache the lines of long texts to wrap only the edited lines again and to find the lines to draw or hit test directly*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LINE
@@ -2258,6 +2436,25 @@
         #define LV_USE_MSG 0
     #endif
 #endif
+#if LV_USE_MSG
+    /*1: `lv_msg_post` can be called from other threads too (uses FreeRTOS on ESP-IDF, pthread elsewhere)*/
+    #ifndef LV_MSG_THREAD_SAFE
+        #ifdef CONFIG_LV_MSG_THREAD_SAFE
+            #define LV_MSG_THREAD_SAFE CONFIG_LV_MSG_THREAD_SAFE
+        #else
+            #define LV_MSG_THREAD_SAFE 0
+        #endif
+    #endif
+
+    /*Deliver the posted messages with this period [ms]*/
+    #ifndef LV_MSG_POST_PERIOD
+        #ifdef CONFIG_LV_MSG_POST_PERIOD
+            #define LV_MSG_POST_PERIOD CONFIG_LV_MSG_POST_PERIOD
+        #else
+            #define LV_MSG_POST_PERIOD LV_DISP_DEF_REFR_PERIOD
+        #endif
+    #endif
+#endif
 
 /*1: Enable Pinyin input method*/
 /*Requires: lv_keyboard*/
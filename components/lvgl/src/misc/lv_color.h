@@ -27,6 +27,10 @@ extern "C" {
 #error "LV_COLOR_16_SWAP requires LV_COLOR_DEPTH == 16. Set it in lv_conf.h"
 #endif
 
+#if LV_COLOR_RGB888_OUT && LV_COLOR_DEPTH != 16 && LV_COLOR_DEPTH != 32
+#error "LV_COLOR_RGB888_OUT requires LV_COLOR_DEPTH 16 or 32. Set it in lv_conf.h"
+#endif
+
 #include <stdint.h>
 
 /*********************
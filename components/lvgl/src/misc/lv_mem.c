@@ -49,6 +49,7 @@
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 #endif
+static uint32_t array_cap(uint32_t cnt);
 
 /**********************
  *  STATIC VARIABLES
@@ -216,6 +217,24 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     return new_p;
 }
 
+void * _lv_mem_realloc_array(void * data, uint32_t old_cnt, uint32_t new_cnt, size_t elem_size)
+{
+    uint32_t old_cap = array_cap(old_cnt);
+    uint32_t new_cap = array_cap(new_cnt);
+    if(data && data != &zero_mem && old_cap == new_cap) return data;
+
+    if(new_cap == 0) {
+        lv_mem_free(data);
+        return NULL;
+    }
+
+    void * new_p = lv_mem_realloc(data, new_cap * elem_size);
+    /*If it couldn't be shrunk the old, larger memory is still fine*/
+    if(new_p == NULL && new_cap < old_cap) return data;
+
+    return new_p;
+}
+
 lv_res_t lv_mem_test(void)
 {
     if(zero_mem != ZERO_MEM_SENTINEL) {
@@ -277,7 +296,7 @@ void * lv_mem_buf_get(uint32_t size)
 {
     if(size == 0) return NULL;
 
-    MEM_TRACE("begin, getting %ld bytes", size);
+    MEM_TRACE("begin, getting %lu bytes", (unsigned long)size);
 
     /*Try to find a free buffer with suitable size*/
     int8_t i_guess = -1;
@@ -564,3 +583,17 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
     }
 }
 #endif
+
+/**
+ * Get the number of elements to allocate memory for in `_lv_mem_realloc_array`
+ * @param cnt   number of elements
+ * @return      `cnt` rounded up to a power of 2
+ */
+static uint32_t array_cap(uint32_t cnt)
+{
+    if(cnt <= 2) return cnt;
+
+    uint32_t cap = 4;
+    while(cap < cnt) cap <<= 1;
+    return cap;
+}
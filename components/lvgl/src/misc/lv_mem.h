@@ -88,6 +88,18 @@ void lv_mem_free(void * data);
  */
 void * lv_mem_realloc(void * data_p, size_t new_size);
 
+/**
+ * Resize an array which grows and shrinks one element at a time.
+ * The memory is allocated for the next power of 2 elements, so it's reallocated only
+ * when the number of elements crosses a power of 2.
+ * @param data      pointer to the array allocated by this function for `old_cnt` elements, or NULL
+ * @param old_cnt   the current number of elements
+ * @param new_cnt   the new number of elements
+ * @param elem_size size of an element in bytes
+ * @return          pointer to the array, NULL if `new_cnt` is 0 or on failure
+ */
+void * _lv_mem_realloc_array(void * data, uint32_t old_cnt, uint32_t new_cnt, size_t elem_size);
+
 /**
  *
  * @return
@@ -30,6 +30,10 @@ static void lv_style_set_prop_helper(lv_style_prop_t prop, lv_style_value_t valu
                                      lv_style_value_t * value_storage);
 static void lv_style_set_prop_meta_helper(lv_style_prop_t prop, lv_style_value_t value, uint16_t * prop_storage,
                                           lv_style_value_t * value_storage);
+static bool find_prop(const lv_style_t * style, lv_style_prop_t prop_id, uint32_t * index);
+static size_t props_size(uint32_t prop_cnt);
+static void set_bitmap(lv_style_t * style, lv_style_prop_t prop_id);
+static void update_bitmap(lv_style_t * style);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -238,45 +242,39 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
         return false;
     }
 
-    uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    uint16_t * old_props = (uint16_t *)tmp;
     uint32_t i;
-    for(i = 0; i < style->prop_cnt; i++) {
-        if(LV_STYLE_PROP_ID_MASK(old_props[i]) == prop) {
-            lv_style_value_t * old_values = (lv_style_value_t *)style->v_p.values_and_props;
-
-            if(style->prop_cnt == 2) {
-                style->prop_cnt = 1;
-                style->prop1 = i == 0 ? old_props[1] : old_props[0];
-                style->v_p.value1 = i == 0 ? old_values[1] : old_values[0];
-            }
-            else {
-                size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
-                uint8_t * new_values_and_props = lv_mem_alloc(size);
-                if(new_values_and_props == NULL) return false;
-                style->v_p.values_and_props = new_values_and_props;
-                style->prop_cnt--;
-
-                tmp = new_values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-                uint16_t * new_props = (uint16_t *)tmp;
-                lv_style_value_t * new_values = (lv_style_value_t *)new_values_and_props;
-
-                uint32_t j;
-                for(i = j = 0; j <= style->prop_cnt;
-                    j++) { /*<=: because prop_cnt already reduced but all the old props. needs to be checked.*/
-                    if(old_props[j] != prop) {
-                        new_values[i] = old_values[j];
-                        new_props[i++] = old_props[j];
-                    }
-                }
-            }
-
-            lv_mem_free(old_values);
-            return true;
-        }
+    if(!find_prop(style, prop, &i)) return false;
+
+    uint16_t * props = _lv_style_get_props(style);
+    lv_style_value_t * values = _lv_style_get_values(style);
+    if(style->prop_cnt == 2) {
+        uint16_t prop_rest = props[1 - i];
+        lv_style_value_t value_rest = values[1 - i];
+        lv_mem_free(style->v_p.values_and_props);
+        style->prop_cnt = 1;
+        style->prop1 = prop_rest;
+        style->v_p.value1 = value_rest;
+        return true;
     }
 
-    return false;
+    /*Remove the value and move the props to their new place before the last value too*/
+    uint32_t cnt = style->prop_cnt;
+    uint32_t j;
+    for(j = i; j < cnt - 1; j++) {
+        values[j] = values[j + 1];
+    }
+    uint16_t * new_props = (uint16_t *)&values[cnt - 1];
+    for(j = 0; j < cnt; j++) {
+        if(j < i) new_props[j] = props[j];
+        else if(j > i) new_props[j - 1] = props[j];
+    }
+    style->prop_cnt--;
+
+    uint8_t * values_and_props = lv_mem_realloc(style->v_p.values_and_props, props_size(style->prop_cnt));
+    if(values_and_props) style->v_p.values_and_props = values_and_props;
+    update_bitmap(style);
+
+    return true;
 }
 
 void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
@@ -423,56 +421,53 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
-        uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint16_t * props = (uint16_t *)tmp;
-        int32_t i;
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(LV_STYLE_PROP_ID_MASK(props[i]) == prop_id) {
-                lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                value_adjustment_helper(prop_and_meta, value, &props[i], &values[i]);
-                return;
-            }
+        uint32_t i;
+        if(find_prop(style, prop_id, &i)) {
+            value_adjustment_helper(prop_and_meta, value, &_lv_style_get_props(style)[i], &_lv_style_get_values(style)[i]);
+            return;
         }
 
-        size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
-        uint8_t * values_and_props = lv_mem_realloc(style->v_p.values_and_props, size);
+        uint32_t cnt = style->prop_cnt;
+        uint8_t * values_and_props = lv_mem_realloc(style->v_p.values_and_props, props_size(cnt + 1));
         if(values_and_props == NULL) return;
         style->v_p.values_and_props = values_and_props;
 
-        tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        props = (uint16_t *)tmp;
-        /*Shift all props to make place for the value before them*/
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            props[i + sizeof(lv_style_value_t) / sizeof(uint16_t)] = props[i];
+        /*Move the props after the new value and leave a gap for the new prop at its sorted position.
+         *Go from the end as the props are moved to a higher address.*/
+        uint16_t * props = _lv_style_get_props(style);
+        lv_style_value_t * values = _lv_style_get_values(style);
+        uint16_t * new_props = (uint16_t *)&values[cnt + 1];
+        int32_t j;
+        for(j = cnt - 1; j >= 0; j--) {
+            new_props[j < (int32_t)i ? j : j + 1] = props[j];
+        }
+        for(j = cnt - 1; j >= (int32_t)i; j--) {
+            values[j + 1] = values[j];
         }
         style->prop_cnt++;
 
-        /*Go to the new position wit the props*/
-        tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        props = (uint16_t *)tmp;
-        lv_style_value_t * values = (lv_style_value_t *)values_and_props;
-
-        /*Set the new property and value*/
-        value_adjustment_helper(prop_and_meta, value, &props[style->prop_cnt - 1], &values[style->prop_cnt - 1]);
+        value_adjustment_helper(prop_and_meta, value, &new_props[i], &values[i]);
+        set_bitmap(style, prop_id);
     }
     else if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop_id) {
             value_adjustment_helper(prop_and_meta, value, &style->prop1, &style->v_p.value1);
             return;
         }
-        size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
-        uint8_t * values_and_props = lv_mem_alloc(size);
+        uint8_t * values_and_props = lv_mem_alloc(props_size(2));
         if(values_and_props == NULL) return;
-        lv_style_value_t value_tmp = style->v_p.value1;
+        uint16_t prop1 = style->prop1;
+        lv_style_value_t value1 = style->v_p.value1;
         style->v_p.values_and_props = values_and_props;
-        style->prop_cnt++;
-
-        uint8_t * tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint16_t * props = (uint16_t *)tmp;
-        lv_style_value_t * values = (lv_style_value_t *)values_and_props;
-        props[0] = style->prop1;
-        values[0] = value_tmp;
-        value_adjustment_helper(prop_and_meta, value, &props[1], &values[1]);
+        style->prop_cnt = 2;
+
+        uint16_t * props = _lv_style_get_props(style);
+        lv_style_value_t * values = _lv_style_get_values(style);
+        uint32_t i = LV_STYLE_PROP_ID_MASK(prop1) < prop_id ? 1 : 0;
+        props[1 - i] = prop1;
+        values[1 - i] = value1;
+        value_adjustment_helper(prop_and_meta, value, &props[i], &values[i]);
+        update_bitmap(style);
     }
     else {
         style->prop_cnt = 1;
@@ -483,3 +478,48 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
     style->has_group |= 1 << group;
 }
 
+/**
+ * Find a property in a style with more than one property
+ * @param style     pointer to a style
+ * @param prop_id   the ID of the property to find
+ * @param index     the index of the property if found, else the index where it should be inserted to keep the order
+ * @return          true: the property was found
+ */
+static bool find_prop(const lv_style_t * style, lv_style_prop_t prop_id, uint32_t * index)
+{
+    const uint16_t * props = _lv_style_get_props(style);
+    uint32_t min = 0;
+    uint32_t max = style->prop_cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) >> 1;
+        if(LV_STYLE_PROP_ID_MASK(props[mid]) < prop_id) min = mid + 1;
+        else max = mid;
+    }
+
+    *index = min;
+    return min < style->prop_cnt && LV_STYLE_PROP_ID_MASK(props[min]) == prop_id;
+}
+
+static size_t props_size(uint32_t prop_cnt)
+{
+    return _LV_STYLE_BITMAP_SIZE + prop_cnt * (sizeof(lv_style_value_t) + sizeof(uint16_t));
+}
+
+static void set_bitmap(lv_style_t * style, lv_style_prop_t prop_id)
+{
+    uint32_t bit = prop_id & 0x3F;
+    _lv_style_get_bitmap(style)[bit >> 5] |= (uint32_t)1 << (bit & 0x1F);
+}
+
+static void update_bitmap(lv_style_t * style)
+{
+    uint32_t * bitmap = _lv_style_get_bitmap(style);
+    bitmap[0] = 0;
+    bitmap[1] = 0;
+
+    const uint16_t * props = _lv_style_get_props(style);
+    uint32_t i;
+    for(i = 0; i < style->prop_cnt; i++) {
+        set_bitmap(style, LV_STYLE_PROP_ID_MASK(props[i]));
+    }
+}
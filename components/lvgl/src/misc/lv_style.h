@@ -30,6 +30,9 @@ extern "C" {
 
 #define LV_STYLE_SENTINEL_VALUE     0xAABBCCDD
 
+/*Size of the presence bitmap at the beginning of the property array*/
+#define _LV_STYLE_BITMAP_SIZE       (2 * sizeof(uint32_t))
+
 /**
  * Flags for style behavior
  *
@@ -322,7 +325,8 @@ typedef struct {
 #endif
 
     /*If there is only one property store it directly.
-     *For more properties allocate an array*/
+     *For more properties allocate an array with a presence bitmap, the values and the property IDs
+     *sorted by ID (see `_lv_style_get_values()` and `_lv_style_get_props()`)*/
     union {
         lv_style_value_t value1;
         uint8_t * values_and_props;
@@ -435,6 +439,38 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+/**
+ * Get the presence bitmap of a style with more than one property.
+ * Bit `prop_id & 0x3F` is set if a property with that ID (or an other ID with the same lower 6 bits) is in the style.
+ * @param style pointer to a style with `prop_cnt > 1`
+ * @return pointer to two words of bitmap
+ */
+static inline uint32_t * _lv_style_get_bitmap(const lv_style_t * style)
+{
+    return (uint32_t *)style->v_p.values_and_props;
+}
+
+/**
+ * Get the values of a style with more than one property.
+ * @param style pointer to a style with `prop_cnt > 1`
+ * @return pointer to the `prop_cnt` values
+ */
+static inline lv_style_value_t * _lv_style_get_values(const lv_style_t * style)
+{
+    return (lv_style_value_t *)(style->v_p.values_and_props + _LV_STYLE_BITMAP_SIZE);
+}
+
+/**
+ * Get the property IDs (with meta) of a style with more than one property.
+ * @param style pointer to a style with `prop_cnt > 1`
+ * @return pointer to the `prop_cnt` properties sorted by ID
+ */
+static inline uint16_t * _lv_style_get_props(const lv_style_t * style)
+{
+    return (uint16_t *)(style->v_p.values_and_props + _LV_STYLE_BITMAP_SIZE +
+                        style->prop_cnt * sizeof(lv_style_value_t));
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -467,20 +503,25 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
     if(style->prop_cnt == 0) return LV_STYLE_RES_NOT_FOUND;
 
     if(style->prop_cnt > 1) {
-        uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint16_t * props = (uint16_t *)tmp;
-        uint32_t i;
-        for(i = 0; i < style->prop_cnt; i++) {
-            lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[i]);
-            if(prop_id == prop) {
-                if(props[i] & LV_STYLE_PROP_META_INHERIT)
+        /*Most of the look ups are for properties which are not in the style. Reject them quickly.*/
+        uint32_t bit = prop & 0x3F;
+        if((_lv_style_get_bitmap(style)[bit >> 5] & ((uint32_t)1 << (bit & 0x1F))) == 0) return LV_STYLE_RES_NOT_FOUND;
+
+        const uint16_t * props = _lv_style_get_props(style);
+        int32_t min = 0;
+        int32_t max = style->prop_cnt - 1;
+        while(min <= max) {
+            int32_t mid = (min + max) >> 1;
+            lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[mid]);
+            if(prop_id < prop) min = mid + 1;
+            else if(prop_id > prop) max = mid - 1;
+            else {
+                if(props[mid] & LV_STYLE_PROP_META_INHERIT)
                     return LV_STYLE_RES_INHERIT;
-                if(props[i] & LV_STYLE_PROP_META_INITIAL)
+                if(props[mid] & LV_STYLE_PROP_META_INITIAL)
                     *value = lv_style_prop_get_default(prop_id);
-                else {
-                    lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                    *value = values[i];
-                }
+                else
+                    *value = _lv_style_get_values(style)[mid];
                 return LV_STYLE_RES_FOUND;
             }
         }
@@ -11,6 +11,7 @@
 #include "lv_mem.h"
 #include "lv_ll.h"
 #include "lv_gc.h"
+#include "../core/lv_trace.h"
 
 /*********************
  *      DEFINES
@@ -81,6 +82,8 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         return 1;
     }
 
+    LV_TRACE_BEGIN("timer_handler");
+
     static uint32_t idle_period_start = 0;
     static uint32_t busy_time         = 0;
 
@@ -141,7 +144,9 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
 
     already_running = false; /*Release the mutex*/
 
-    TIMER_TRACE("finished (%ld ms until the next timer call)", time_till_next);
+    LV_TRACE_END();
+
+    TIMER_TRACE("finished (%lu ms until the next timer call)", (unsigned long)time_till_next);
     return time_till_next;
 }
 
@@ -418,17 +418,13 @@ void _lv_txt_ins(char * txt_buf, uint32_t pos, const char * ins_txt)
     size_t ins_len = strlen(ins_txt);
     if(ins_len == 0) return;
 
-    size_t new_len = ins_len + old_len;
     pos              = _lv_txt_encoded_get_byte_id(txt_buf, pos); /*Convert to byte index instead of letter index*/
 
-    /*Copy the second part into the end to make place to text to insert*/
-    size_t i;
-    for(i = new_len; i >= pos + ins_len; i--) {
-        txt_buf[i] = txt_buf[i - ins_len];
-    }
+    /*Move the second part (with the closing '\0') to the end to make place to text to insert*/
+    memmove(&txt_buf[pos + ins_len], &txt_buf[pos], old_len - pos + 1);
 
     /*Copy the text into the new space*/
-    lv_memcpy_small(txt_buf + pos, ins_txt, ins_len);
+    lv_memcpy(txt_buf + pos, ins_txt, ins_len);
 }
 
 void _lv_txt_cut(char * txt, uint32_t pos, uint32_t len)
@@ -440,11 +436,8 @@ void _lv_txt_cut(char * txt, uint32_t pos, uint32_t len)
     pos = _lv_txt_encoded_get_byte_id(txt, pos); /*Convert to byte index instead of letter index*/
     len = _lv_txt_encoded_get_byte_id(&txt[pos], len);
 
-    /*Copy the second part into the end to make place to text to insert*/
-    uint32_t i;
-    for(i = pos; i <= old_len - len; i++) {
-        txt[i] = txt[i + len];
-    }
+    /*Move the second part (with the closing '\0') to the place of the removed text*/
+    memmove(&txt[pos], &txt[pos + len], old_len - pos - len + 1);
 }
 
 char * _lv_txt_set_text_vfmt(const char * fmt, va_list ap)
@@ -24,6 +24,16 @@
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct _lv_canvas_batch_t {
+    lv_disp_t disp;
+    lv_disp_drv_t driver;
+    lv_area_t clip_area;
+    lv_area_t inv_area;         /*Union of the areas drawn in the batch*/
+    uint16_t nest_cnt;
+    uint8_t inv : 1;            /*1: `inv_area` is set*/
+    uint8_t single : 1;         /*1: on the stack of one drawing function, invalidate the whole canvas at the end*/
+    uint8_t antialiasing : 1;   /*The original anti-aliasing setting of the fake display*/
+} lv_canvas_batch_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -32,6 +42,14 @@ static void lv_canvas_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
 static void lv_canvas_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void init_fake_disp(lv_obj_t * canvas, lv_disp_t * disp, lv_disp_drv_t * drv, lv_area_t * clip_area);
 static void deinit_fake_disp(lv_obj_t * canvas, lv_disp_t * disp);
+static bool batch_init(lv_obj_t * canvas, lv_canvas_batch_t * batch);
+static void batch_open(lv_obj_t * canvas);
+static void batch_close(lv_obj_t * canvas);
+static lv_canvas_batch_t * batch_begin(lv_obj_t * canvas, lv_canvas_batch_t * single_batch);
+static lv_disp_t * batch_set_refreshing(lv_canvas_batch_t * batch, bool antialias);
+static void add_inv_area(lv_obj_t * canvas, const lv_area_t * area);
+static void invalidate_buf_area(lv_obj_t * canvas, const lv_area_t * area);
+static void get_points_area(const lv_point_t points[], uint32_t point_cnt, lv_coord_t ext, lv_area_t * area);
 
 /**********************
  *  STATIC VARIABLES
@@ -75,6 +93,15 @@ void lv_canvas_set_buffer(lv_obj_t * obj, void * buf, lv_coord_t w, lv_coord_t h
     canvas->dsc.header.h  = h;
     canvas->dsc.data      = buf;
 
+    /*Draw to the new buffer in the rest of the batch*/
+    if(canvas->batch) {
+        deinit_fake_disp(obj, &canvas->batch->disp);
+        if(!batch_init(obj, canvas->batch)) {
+            lv_mem_free(canvas->batch);
+            canvas->batch = NULL;
+        }
+    }
+
     lv_img_set_src(obj, &canvas->dsc);
     lv_img_cache_invalidate_src(&canvas->dsc);
 }
@@ -86,7 +113,9 @@ void lv_canvas_set_px_color(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_color
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
     lv_img_buf_set_px_color(&canvas->dsc, x, y, c);
-    lv_obj_invalidate(obj);
+
+    lv_area_t a = {x, y, x, y};
+    add_inv_area(obj, &a);
 }
 
 void lv_canvas_set_px_opa(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_opa_t opa)
@@ -96,7 +125,9 @@ void lv_canvas_set_px_opa(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_opa_t o
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
     lv_img_buf_set_px_alpha(&canvas->dsc, x, y, opa);
-    lv_obj_invalidate(obj);
+
+    lv_area_t a = {x, y, x, y};
+    add_inv_area(obj, &a);
 }
 
 void lv_canvas_set_palette(lv_obj_t * obj, uint8_t id, lv_color_t c)
@@ -106,7 +137,7 @@ void lv_canvas_set_palette(lv_obj_t * obj, uint8_t id, lv_color_t c)
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
     lv_img_buf_set_palette(&canvas->dsc, id, c);
-    lv_obj_invalidate(obj);
+    add_inv_area(obj, NULL);
 }
 
 /*=====================
@@ -207,7 +238,7 @@ void lv_canvas_transform(lv_obj_t * obj, lv_img_dsc_t * src_img, int16_t angle,
     lv_mem_free(cbuf);
     lv_mem_free(abuf);
 
-    lv_obj_invalidate(obj);
+    add_inv_area(obj, NULL);
 
 #else
     LV_UNUSED(obj);
@@ -346,7 +377,7 @@ void lv_canvas_blur_hor(lv_obj_t * obj, const lv_area_t * area, uint16_t r)
             if(has_alpha) asum += opa;
         }
     }
-    lv_obj_invalidate(obj);
+    add_inv_area(obj, &a);
 
     lv_mem_buf_release(line_buf);
 }
@@ -479,7 +510,7 @@ void lv_canvas_blur_ver(lv_obj_t * obj, const lv_area_t * area, uint16_t r)
         }
     }
 
-    lv_obj_invalidate(obj);
+    add_inv_area(obj, &a);
 
     lv_mem_buf_release(col_buf);
 }
@@ -510,7 +541,21 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
         }
     }
 
-    lv_obj_invalidate(canvas);
+    add_inv_area(canvas, NULL);
+}
+
+void lv_canvas_draw_begin(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    batch_open(obj);
+}
+
+void lv_canvas_draw_end(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    batch_close(obj);
 }
 
 void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
@@ -525,22 +570,15 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
+    /*Create a dummy display to fool the lv_draw function (or use the one of the open batch).
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t single_batch;
+    lv_canvas_batch_t * batch = batch_begin(canvas, &single_batch);
+    if(batch == NULL) return;
 
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
     lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->bg_color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
-    }
+    bool antialias = dsc->header.cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED || draw_dsc->bg_color.full != ctransp.full;
 
     lv_area_t coords;
     coords.x1 = x;
@@ -548,13 +586,28 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
     coords.x2 = x + w - 1;
     coords.y2 = y + h - 1;
 
-    lv_draw_rect(driver.draw_ctx, draw_dsc, &coords);
-
+    lv_disp_t * refr_ori = batch_set_refreshing(batch, antialias);
+    lv_draw_rect(batch->driver.draw_ctx, draw_dsc, &coords);
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    deinit_fake_disp(canvas, &fake_disp);
+    /*Add the outline and the shadow to the drawn area*/
+    lv_area_t a;
+    lv_area_copy(&a, &coords);
+    if(draw_dsc->outline_width && draw_dsc->outline_opa > LV_OPA_MIN) {
+        lv_coord_t ext = LV_MAX(draw_dsc->outline_width + draw_dsc->outline_pad, 0);
+        lv_area_increase(&a, ext, ext);
+    }
+    if(draw_dsc->shadow_width && draw_dsc->shadow_opa > LV_OPA_MIN) {
+        lv_area_t sh_area;
+        lv_area_copy(&sh_area, &coords);
+        lv_coord_t ext = LV_MAX(draw_dsc->shadow_width / 2 + 1 + draw_dsc->shadow_spread, 0);
+        lv_area_increase(&sh_area, ext, ext);
+        lv_area_move(&sh_area, draw_dsc->shadow_ofs_x, draw_dsc->shadow_ofs_y);
+        _lv_area_join(&a, &a, &sh_area);
+    }
+    add_inv_area(canvas, &a);
 
-    lv_obj_invalidate(canvas);
+    batch_close(canvas);
 }
 
 void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
@@ -569,28 +622,29 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
+    /*Create a dummy display to fool the lv_draw function (or use the one of the open batch).
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t single_batch;
+    lv_canvas_batch_t * batch = batch_begin(canvas, &single_batch);
+    if(batch == NULL) return;
 
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + max_w - 1;
     coords.y2 = dsc->header.h - 1;
-    lv_draw_label(driver.draw_ctx, draw_dsc, &coords, txt, NULL);
 
+    lv_disp_t * refr_ori = batch_set_refreshing(batch, true);
+    lv_draw_label(batch->driver.draw_ctx, draw_dsc, &coords, txt, NULL);
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    deinit_fake_disp(canvas, &fake_disp);
+    /*The letters are clipped only to the canvas, so be generous with the overhanging glyphs*/
+    if(draw_dsc->flag & LV_TEXT_FLAG_EXPAND) coords.x2 = dsc->header.w - 1;
+    lv_coord_t ext = lv_font_get_line_height(draw_dsc->font);
+    lv_area_increase(&coords, ext, ext);
+    add_inv_area(canvas, &coords);
 
-    lv_obj_invalidate(canvas);
+    batch_close(canvas);
 }
 
 void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const void * src,
@@ -611,15 +665,12 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
         LV_LOG_WARN("lv_canvas_draw_img: Couldn't get the image data.");
         return;
     }
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    /*Create a dummy display to fool the lv_draw function (or use the one of the open batch).
+     *It will think it draws to real screen.*/
+    lv_canvas_batch_t single_batch;
+    lv_canvas_batch_t * batch = batch_begin(canvas, &single_batch);
+    if(batch == NULL) return;
 
     lv_area_t coords;
     coords.x1 = x;
@@ -627,13 +678,18 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
     coords.x2 = x + header.w - 1;
     coords.y2 = y + header.h - 1;
 
-    lv_draw_img(driver.draw_ctx, draw_dsc, &coords, src);
-
+    lv_disp_t * refr_ori = batch_set_refreshing(batch, true);
+    lv_draw_img(batch->driver.draw_ctx, draw_dsc, &coords, src);
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    deinit_fake_disp(canvas, &fake_disp);
+    if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        _lv_img_buf_get_transformed_area(&coords, header.w, header.h, draw_dsc->angle, draw_dsc->zoom,
+                                         &draw_dsc->pivot);
+        lv_area_move(&coords, x, y);
+    }
+    add_inv_area(canvas, &coords);
 
-    lv_obj_invalidate(canvas);
+    batch_close(canvas);
 }
 
 void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
@@ -648,34 +704,30 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    if(point_cnt == 0) return;
 
+    /*Create a dummy display to fool the lv_draw function (or use the one of the open batch).
+     *It will think it draws to real screen.*/
+    lv_canvas_batch_t single_batch;
+    lv_canvas_batch_t * batch = batch_begin(canvas, &single_batch);
+    if(batch == NULL) return;
 
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
     lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
-    }
+    bool antialias = dsc->header.cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED || draw_dsc->color.full != ctransp.full;
 
+    lv_disp_t * refr_ori = batch_set_refreshing(batch, antialias);
     uint32_t i;
     for(i = 0; i < point_cnt - 1; i++) {
-        lv_draw_line(driver.draw_ctx, draw_dsc, &points[i], &points[i + 1]);
+        lv_draw_line(batch->driver.draw_ctx, draw_dsc, &points[i], &points[i + 1]);
     }
-
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    deinit_fake_disp(canvas, &fake_disp);
+    lv_area_t a;
+    get_points_area(points, point_cnt, draw_dsc->width / 2 + 1, &a);
+    add_inv_area(canvas, &a);
 
-    lv_obj_invalidate(canvas);
+    batch_close(canvas);
 }
 
 void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
@@ -690,30 +742,27 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
+    if(point_cnt == 0) return;
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    /*Create a dummy display to fool the lv_draw function (or use the one of the open batch).
+     *It will think it draws to real screen.*/
+    lv_canvas_batch_t single_batch;
+    lv_canvas_batch_t * batch = batch_begin(canvas, &single_batch);
+    if(batch == NULL) return;
 
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
     lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->bg_color.full == ctransp.full) {
-        fake_disp.driver->antialiasing = 0;
-    }
-
-    lv_draw_polygon(driver.draw_ctx, draw_dsc, points, point_cnt);
+    bool antialias = dsc->header.cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED || draw_dsc->bg_color.full != ctransp.full;
 
+    lv_disp_t * refr_ori = batch_set_refreshing(batch, antialias);
+    lv_draw_polygon(batch->driver.draw_ctx, draw_dsc, points, point_cnt);
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    deinit_fake_disp(canvas, &fake_disp);
+    lv_area_t a;
+    get_points_area(points, point_cnt, 1, &a);
+    add_inv_area(canvas, &a);
 
-    lv_obj_invalidate(canvas);
+    batch_close(canvas);
 }
 
 void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t r, int32_t start_angle,
@@ -729,24 +778,25 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
+    /*Create a dummy display to fool the lv_draw function (or use the one of the open batch).
      *It will think it draws to real screen.*/
-    lv_disp_t fake_disp;
-    lv_disp_drv_t driver;
-    lv_area_t clip_area;
-    init_fake_disp(canvas, &fake_disp, &driver, &clip_area);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&fake_disp);
+    lv_canvas_batch_t single_batch;
+    lv_canvas_batch_t * batch = batch_begin(canvas, &single_batch);
+    if(batch == NULL) return;
 
+    lv_disp_t * refr_ori = batch_set_refreshing(batch, true);
     lv_point_t p = {x, y};
-    lv_draw_arc(driver.draw_ctx, draw_dsc, &p, r,  start_angle, end_angle);
-
+    lv_draw_arc(batch->driver.draw_ctx, draw_dsc, &p, r,  start_angle, end_angle);
     _lv_refr_set_disp_refreshing(refr_ori);
 
-    deinit_fake_disp(canvas, &fake_disp);
+    lv_area_t a;
+    a.x1 = x - r;
+    a.y1 = y - r;
+    a.x2 = x + r;
+    a.y2 = y + r;
+    add_inv_area(canvas, &a);
 
-    lv_obj_invalidate(canvas);
+    batch_close(canvas);
 #else
     LV_UNUSED(canvas);
     LV_UNUSED(x);
@@ -776,6 +826,7 @@ static void lv_canvas_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     canvas->dsc.header.w           = 0;
     canvas->dsc.data_size          = 0;
     canvas->dsc.data               = NULL;
+    canvas->batch                  = NULL;
 
     lv_img_set_src(obj, &canvas->dsc);
 
@@ -789,6 +840,13 @@ static void lv_canvas_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
     lv_img_cache_invalidate_src(&canvas->dsc);
+
+    /*A batch left open*/
+    if(canvas->batch && !canvas->batch->single) {
+        deinit_fake_disp(obj, &canvas->batch->disp);
+        lv_mem_free(canvas->batch);
+        canvas->batch = NULL;
+    }
 }
 
 
@@ -801,7 +859,7 @@ static void init_fake_disp(lv_obj_t * canvas, lv_disp_t * disp, lv_disp_drv_t *
     clip_area->y1 = 0;
     clip_area->y2 = dsc->header.h - 1;
 
-    /*Allocate the fake driver on the stack as the entire display doesn't outlive this function*/
+    /*The fake display and driver are stored in the batch as they outlive this function*/
     lv_memset_00(disp, sizeof(lv_disp_t));
     disp->driver = drv;
 
@@ -831,6 +889,169 @@ static void deinit_fake_disp(lv_obj_t * canvas, lv_disp_t * disp)
     lv_mem_free(disp->driver->draw_ctx);
 }
 
+static bool batch_init(lv_obj_t * canvas, lv_canvas_batch_t * batch)
+{
+    init_fake_disp(canvas, &batch->disp, &batch->driver, &batch->clip_area);
+    if(batch->driver.draw_ctx == NULL) return false;
+
+    batch->antialiasing = batch->driver.antialiasing;
+    return true;
+}
+
+static void batch_open(lv_obj_t * obj)
+{
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    if(canvas->batch) {
+        canvas->batch->nest_cnt++;
+        return;
+    }
+
+    lv_canvas_batch_t * batch = lv_mem_alloc(sizeof(lv_canvas_batch_t));
+    LV_ASSERT_MALLOC(batch);
+    if(batch == NULL) return;
+
+    if(!batch_init(obj, batch)) {
+        lv_mem_free(batch);
+        return;
+    }
+
+    batch->nest_cnt = 1;
+    batch->inv = 0;
+    batch->single = 0;
+    canvas->batch = batch;
+}
+
+static void batch_close(lv_obj_t * obj)
+{
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    lv_canvas_batch_t * batch = canvas->batch;
+    if(batch == NULL) return;
+
+    batch->nest_cnt--;
+    if(batch->nest_cnt > 0) return;
+
+    canvas->batch = NULL;
+    deinit_fake_disp(obj, &batch->disp);
+    if(batch->single) {
+        lv_obj_invalidate(obj);
+    }
+    else {
+        if(batch->inv) invalidate_buf_area(obj, &batch->inv_area);
+        lv_mem_free(batch);
+    }
+}
+
+/**
+ * Join the open batch or start a batch for a single drawing function.
+ * @param canvas        pointer to a canvas
+ * @param single_batch  a batch on the stack of the drawing function to use if there is no open batch
+ * @return              the batch to draw with or `NULL` if it couldn't be created.
+ *                      `batch_close` needs to be called only if not `NULL`
+ */
+static lv_canvas_batch_t * batch_begin(lv_obj_t * canvas, lv_canvas_batch_t * single_batch)
+{
+    lv_canvas_t * c = (lv_canvas_t *)canvas;
+    if(c->batch) {
+        c->batch->nest_cnt++;
+        return c->batch;
+    }
+
+    if(!batch_init(canvas, single_batch)) return NULL;
+
+    single_batch->nest_cnt = 1;
+    single_batch->inv = 0;
+    single_batch->single = 1;
+    c->batch = single_batch;
+    return single_batch;
+}
+
+/**
+ * Make the fake display of the batch the refreshing one to fool the lv_draw functions.
+ * They will think they draw to real screen.
+ * @param batch     pointer to a batch
+ * @param antialias false: disable anti-aliasing for the next primitive
+ * @return          the original refreshing display to restore after drawing
+ */
+static lv_disp_t * batch_set_refreshing(lv_canvas_batch_t * batch, bool antialias)
+{
+    batch->driver.antialiasing = antialias ? batch->antialiasing : 0;
+
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&batch->disp);
+    return refr_ori;
+}
+
+/**
+ * Add an area of the buffer to the invalidated area of the open batch or invalidate the whole canvas without a batch.
+ * @param canvas    pointer to a canvas
+ * @param area      the changed area in buffer coordinates or `NULL` for the whole buffer
+ */
+static void add_inv_area(lv_obj_t * canvas, const lv_area_t * area)
+{
+    lv_img_dsc_t * dsc = &((lv_canvas_t *)canvas)->dsc;
+
+    lv_area_t a;
+    a.x1 = 0;
+    a.y1 = 0;
+    a.x2 = dsc->header.w - 1;
+    a.y2 = dsc->header.h - 1;
+    if(area && !_lv_area_intersect(&a, &a, area)) return;
+
+    lv_canvas_batch_t * batch = ((lv_canvas_t *)canvas)->batch;
+    if(batch == NULL) {
+        lv_obj_invalidate(canvas);
+    }
+    else if(batch->inv) {
+        _lv_area_join(&batch->inv_area, &batch->inv_area, &a);
+    }
+    else {
+        lv_area_copy(&batch->inv_area, &a);
+        batch->inv = 1;
+    }
+}
+
+/**
+ * Invalidate the part of the canvas where an area of the buffer is shown.
+ * Invalidate the whole canvas if the image is transformed, shifted or tiled.
+ * @param canvas    pointer to a canvas
+ * @param area      an area in buffer coordinates
+ */
+static void invalidate_buf_area(lv_obj_t * canvas, const lv_area_t * area)
+{
+    lv_img_t * img = (lv_img_t *)canvas;
+    if(img->zoom != LV_IMG_ZOOM_NONE || img->angle != 0 || img->offset.x != 0 || img->offset.y != 0 ||
+       lv_obj_get_content_width(canvas) > img->w || lv_obj_get_content_height(canvas) > img->h) {
+        lv_obj_invalidate(canvas);
+        return;
+    }
+
+    /*The image is drawn to the top left corner of the content area*/
+    lv_coord_t border_width = lv_obj_get_style_border_width(canvas, LV_PART_MAIN);
+    lv_area_t a;
+    lv_area_copy(&a, area);
+    lv_area_move(&a, canvas->coords.x1 + lv_obj_get_style_pad_left(canvas, LV_PART_MAIN) + border_width,
+                 canvas->coords.y1 + lv_obj_get_style_pad_top(canvas, LV_PART_MAIN) + border_width);
+    lv_obj_invalidate_area(canvas, &a);
+}
+
+static void get_points_area(const lv_point_t points[], uint32_t point_cnt, lv_coord_t ext, lv_area_t * area)
+{
+    area->x1 = points[0].x;
+    area->y1 = points[0].y;
+    area->x2 = points[0].x;
+    area->y2 = points[0].y;
+
+    uint32_t i;
+    for(i = 1; i < point_cnt; i++) {
+        area->x1 = LV_MIN(area->x1, points[i].x);
+        area->y1 = LV_MIN(area->y1, points[i].y);
+        area->x2 = LV_MAX(area->x2, points[i].x);
+        area->y2 = LV_MAX(area->y2, points[i].y);
+    }
+
+    lv_area_increase(area, ext, ext);
+}
+
 
 
 #endif
@@ -30,10 +30,13 @@ extern "C" {
  **********************/
 extern const lv_obj_class_t lv_canvas_class;
 
+struct _lv_canvas_batch_t;
+
 /*Data of canvas*/
 typedef struct {
     lv_img_t img;
     lv_img_dsc_t dsc;
+    struct _lv_canvas_batch_t * batch;  /*Draw context kept between `lv_canvas_draw_begin/end`*/
 } lv_canvas_t;
 
 /**********************
@@ -184,6 +187,22 @@ void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r);
  */
 void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa);
 
+/**
+ * Start drawing a batch of primitives on the canvas.
+ * The draw context is created only once here and used by all the `lv_canvas_draw_...` calls until
+ * `lv_canvas_draw_end`. The canvas is invalidated only there and only in the union of the drawn areas.
+ * Can be nested, only the last `lv_canvas_draw_end` closes the batch.
+ * @param canvas   pointer to a canvas object
+ */
+void lv_canvas_draw_begin(lv_obj_t * canvas);
+
+/**
+ * Finish drawing a batch of primitives started by `lv_canvas_draw_begin`
+ * and invalidate the areas drawn since then.
+ * @param canvas   pointer to a canvas object
+ */
+void lv_canvas_draw_end(lv_obj_t * canvas);
+
 /**
  * Draw a rectangle on the canvas
  * @param canvas   pointer to a canvas object
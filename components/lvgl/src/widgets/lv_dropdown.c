@@ -26,6 +26,7 @@
  *********************/
 #define MY_CLASS &lv_dropdown_class
 #define MY_CLASS_LIST &lv_dropdownlist_class
+#define MY_CLASS_LIST_LABEL &lv_dropdownlist_label_class
 
 #define LV_DROPDOWN_PR_NONE 0xFFFF
 
@@ -46,6 +47,10 @@ static void lv_dropdownlist_constructor(const lv_obj_class_t * class_p, lv_obj_t
 static void lv_dropdownlist_destructor(const lv_obj_class_t * class_p, lv_obj_t * list_obj);
 static void lv_dropdown_list_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_list(lv_event_t * e);
+static void lv_dropdownlist_label_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void draw_list_label(lv_event_t * e);
+static void draw_rows(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                      const lv_area_t * coords);
 
 static void draw_box(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t id, lv_state_t state);
 static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t id, lv_state_t state);
@@ -55,6 +60,7 @@ static void list_press_handler(lv_obj_t * page);
 static uint16_t get_id_on_point(lv_obj_t * dropdown_obj, lv_coord_t y);
 static void position_to_selected(lv_obj_t * obj);
 static lv_obj_t * get_label(const lv_obj_t * obj);
+static void index_options(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -79,6 +85,12 @@ const lv_obj_class_t lv_dropdownlist_class = {
     .base_class = &lv_obj_class
 };
 
+const lv_obj_class_t lv_dropdownlist_label_class = {
+    .event_cb = lv_dropdownlist_label_event,
+    .instance_size = sizeof(lv_label_t),
+    .base_class = &lv_label_class
+};
+
 
 /**********************
  *      MACROS
@@ -118,13 +130,6 @@ void lv_dropdown_set_options(lv_obj_t * obj, const char * options)
 
     lv_dropdown_t * dropdown = (lv_dropdown_t *)obj;
 
-    /*Count the '\n'-s to determine the number of options*/
-    dropdown->option_cnt = 0;
-    uint32_t i;
-    for(i = 0; options[i] != '\0'; i++) {
-        if(options[i] == '\n') dropdown->option_cnt++;
-    }
-    dropdown->option_cnt++;   /*Last option has no `\n`*/
     dropdown->sel_opt_id      = 0;
     dropdown->sel_opt_id_orig = 0;
 
@@ -143,7 +148,10 @@ void lv_dropdown_set_options(lv_obj_t * obj, const char * options)
     dropdown->options = lv_mem_alloc(len);
 
     LV_ASSERT_MALLOC(dropdown->options);
-    if(dropdown->options == NULL) return;
+    if(dropdown->options == NULL) {
+        index_options(obj);
+        return;
+    }
 
 #if LV_USE_ARABIC_PERSIAN_CHARS == 0
     strcpy(dropdown->options, options);
@@ -153,6 +161,7 @@ void lv_dropdown_set_options(lv_obj_t * obj, const char * options)
 
     /*Now the text is dynamically allocated*/
     dropdown->static_txt = 0;
+    index_options(obj);
 
     lv_obj_invalidate(obj);
     if(dropdown->list) lv_obj_invalidate(dropdown->list);
@@ -165,13 +174,6 @@ void lv_dropdown_set_options_static(lv_obj_t * obj, const char * options)
 
     lv_dropdown_t * dropdown = (lv_dropdown_t *)obj;
 
-    /*Count the '\n'-s to determine the number of options*/
-    dropdown->option_cnt = 0;
-    uint32_t i;
-    for(i = 0; options[i] != '\0'; i++) {
-        if(options[i] == '\n') dropdown->option_cnt++;
-    }
-    dropdown->option_cnt++;   /*Last option has no `\n`*/
     dropdown->sel_opt_id      = 0;
     dropdown->sel_opt_id_orig = 0;
 
@@ -182,6 +184,7 @@ void lv_dropdown_set_options_static(lv_obj_t * obj, const char * options)
 
     dropdown->static_txt = 1;
     dropdown->options = (char *)options;
+    index_options(obj);
 
     lv_obj_invalidate(obj);
     if(dropdown->list) lv_obj_invalidate(dropdown->list);
@@ -224,15 +227,7 @@ void lv_dropdown_add_option(lv_obj_t * obj, const char * option, uint32_t pos)
 
     /*Find the insert character position*/
     uint32_t insert_pos = old_len;
-    if(pos != LV_DROPDOWN_POS_LAST) {
-        uint32_t opcnt = 0;
-        for(insert_pos = 0; dropdown->options[insert_pos] != 0; insert_pos++) {
-            if(opcnt == pos)
-                break;
-            if(dropdown->options[insert_pos] == '\n')
-                opcnt++;
-        }
-    }
+    if(pos < dropdown->option_cnt && dropdown->option_ofs) insert_pos = dropdown->option_ofs[pos];
 
     /*Add delimiter to existing options*/
     if((insert_pos > 0) && (pos >= dropdown->option_cnt))
@@ -252,7 +247,7 @@ void lv_dropdown_add_option(lv_obj_t * obj, const char * option, uint32_t pos)
     _lv_txt_ins(dropdown->options, _lv_txt_encoded_get_char_id(dropdown->options, insert_pos), ins_buf);
     lv_mem_buf_release(ins_buf);
 
-    dropdown->option_cnt++;
+    index_options(obj);
 
     lv_obj_invalidate(obj);
     if(dropdown->list) lv_obj_invalidate(dropdown->list);
@@ -269,7 +264,7 @@ void lv_dropdown_clear_options(lv_obj_t * obj)
 
     dropdown->options = NULL;
     dropdown->static_txt = 0;
-    dropdown->option_cnt = 0;
+    index_options(obj);
 
     lv_obj_invalidate(obj);
     if(dropdown->list) lv_obj_invalidate(dropdown->list);
@@ -370,48 +365,35 @@ void lv_dropdown_get_selected_str(const lv_obj_t * obj, char * buf, uint32_t buf
 
     lv_dropdown_t * dropdown = (lv_dropdown_t *)obj;
 
-    uint32_t i;
-    uint32_t line        = 0;
-    size_t txt_len;
-
-    if(dropdown->options)  {
-        txt_len     = strlen(dropdown->options);
-    }
-    else {
+    uint16_t id = dropdown->sel_opt_id_orig;
+    if(dropdown->option_ofs == NULL || id >= dropdown->option_cnt) {
         buf[0] = '\0';
         return;
     }
 
-    for(i = 0; i < txt_len && line != dropdown->sel_opt_id_orig; i++) {
-        if(dropdown->options[i] == '\n') line++;
+    uint32_t len = dropdown->option_ofs[id + 1] - dropdown->option_ofs[id] - 1;
+    if(buf_size && len >= buf_size) {
+        LV_LOG_WARN("lv_dropdown_get_selected_str: the buffer was too small");
+        len = buf_size - 1;
     }
 
-    uint32_t c;
-    for(c = 0; i < txt_len && dropdown->options[i] != '\n'; c++, i++) {
-        if(buf_size && c >= buf_size - 1) {
-            LV_LOG_WARN("lv_dropdown_get_selected_str: the buffer was too small");
-            break;
-        }
-        buf[c] = dropdown->options[i];
-    }
-
-    buf[c] = '\0';
+    lv_memcpy(buf, &dropdown->options[dropdown->option_ofs[id]], len);
+    buf[len] = '\0';
 }
 
 int32_t lv_dropdown_get_option_index(lv_obj_t * obj, const char * option)
 {
-    const char * opts = lv_dropdown_get_options(obj);
-    uint32_t char_i = 0;
-    uint32_t opt_i = 0;
-    const char * start = opts;
-
-    while(start[char_i] != '\0') {
-        for(char_i = 0; (start[char_i] != '\n') && (start[char_i] != '\0'); char_i++);
-
-        if(memcmp(start, option, LV_MIN(strlen(option), char_i)) == 0) return opt_i;
-        start = &start[char_i];
-        if(start[0] == '\n') start++;
-        opt_i++;
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_dropdown_t * dropdown = (lv_dropdown_t *)obj;
+    if(dropdown->option_ofs == NULL) return -1;
+
+    size_t option_len = strlen(option);
+    uint32_t opt_i;
+    for(opt_i = 0; opt_i < dropdown->option_cnt; opt_i++) {
+        uint32_t len = dropdown->option_ofs[opt_i + 1] - dropdown->option_ofs[opt_i] - 1;
+        if(len == 0) continue;
+        if(memcmp(&dropdown->options[dropdown->option_ofs[opt_i]], option, LV_MIN(option_len, len)) == 0) return opt_i;
     }
 
     return -1;
@@ -458,7 +440,7 @@ void lv_dropdown_open(lv_obj_t * dropdown_obj)
     lv_event_send(dropdown_obj, LV_EVENT_READY, NULL);
 
     lv_obj_t * label = get_label(dropdown_obj);
-    lv_label_set_text_static(label, dropdown->options);
+    lv_obj_refresh_self_size(label);
     lv_obj_set_width(dropdown->list, LV_SIZE_CONTENT);
 
     lv_obj_update_layout(label);
@@ -584,6 +566,7 @@ static void lv_dropdown_constructor(const lv_obj_class_t * class_p, lv_obj_t * o
     /*Initialize the allocated 'ext'*/
     dropdown->list          = NULL;
     dropdown->options     = NULL;
+    dropdown->option_ofs  = NULL;
     dropdown->symbol         = LV_SYMBOL_DOWN;
     dropdown->text         = NULL;
     dropdown->static_txt = 1;
@@ -618,6 +601,9 @@ static void lv_dropdown_destructor(const lv_obj_class_t * class_p, lv_obj_t * ob
         lv_mem_free(dropdown->options);
         dropdown->options = NULL;
     }
+
+    lv_mem_free(dropdown->option_ofs);
+    dropdown->option_ofs = NULL;
 }
 
 static void lv_dropdownlist_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
@@ -630,7 +616,10 @@ static void lv_dropdownlist_constructor(const lv_obj_class_t * class_p, lv_obj_t
     lv_obj_add_flag(obj, LV_OBJ_FLAG_IGNORE_LAYOUT);
     lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
 
-    lv_label_create(obj);
+    /*The label has no text, the options are drawn from the dropdown*/
+    lv_obj_t * label = lv_obj_class_create_obj(MY_CLASS_LIST_LABEL, obj);
+    lv_obj_class_init_obj(label);
+    lv_label_set_text_static(label, "");
 
     LV_TRACE_OBJ_CREATE("finished");
 }
@@ -769,6 +758,45 @@ static void lv_dropdown_list_event(const lv_obj_class_t * class_p, lv_event_t *
     }
 }
 
+static void lv_dropdownlist_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    /*The label has no text, the visible options are drawn instead*/
+    if(code != LV_EVENT_DRAW_MAIN) {
+        /*Call the ancestor's event handler*/
+        res = lv_obj_event_base(MY_CLASS_LIST_LABEL, e);
+        if(res != LV_RES_OK) return;
+    }
+
+    lv_obj_t * label = lv_event_get_target(e);
+    lv_obj_t * dropdown_obj = ((lv_dropdown_list_t *)lv_obj_get_parent(label))->dropdown;
+    if(dropdown_obj == NULL) return;
+    lv_dropdown_t * dropdown = (lv_dropdown_t *)dropdown_obj;
+
+    if(code == LV_EVENT_GET_SELF_SIZE) {
+        /*Be as large as the options*/
+        if(dropdown->options == NULL) return;
+
+        const lv_font_t * font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+        lv_coord_t letter_space = lv_obj_get_style_text_letter_space(label, LV_PART_MAIN);
+        lv_coord_t line_space = lv_obj_get_style_text_line_space(label, LV_PART_MAIN);
+        lv_text_flag_t flag = lv_label_get_recolor(label) ? LV_TEXT_FLAG_RECOLOR : LV_TEXT_FLAG_NONE;
+        lv_point_t size;
+        lv_txt_get_size(&size, dropdown->options, font, letter_space, line_space, LV_COORD_MAX, flag);
+
+        lv_point_t * p = lv_event_get_param(e);
+        p->x = LV_MAX(p->x, size.x);
+        p->y = LV_MAX(p->y, size.y);
+    }
+    else if(code == LV_EVENT_DRAW_MAIN) {
+        draw_list_label(e);
+    }
+}
+
 
 static void draw_main(lv_event_t * e)
 {
@@ -920,6 +948,24 @@ static void draw_list(lv_event_t * e)
     }
 }
 
+static void draw_list_label(lv_event_t * e)
+{
+    lv_obj_t * label = lv_event_get_target(e);
+    lv_obj_t * dropdown_obj = ((lv_dropdown_list_t *)lv_obj_get_parent(label))->dropdown;
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(label, LV_PART_MAIN, &label_dsc);
+    if(lv_label_get_recolor(label)) label_dsc.flag |= LV_TEXT_FLAG_RECOLOR;
+
+    lv_area_t txt_coords;
+    lv_obj_get_content_coords(label, &txt_coords);
+    if(!_lv_area_is_on(&txt_coords, draw_ctx->clip_area)) return;
+
+    draw_rows(dropdown_obj, draw_ctx, &label_dsc, &txt_coords);
+}
+
 static void draw_box(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t id, lv_state_t state)
 {
     if(id == LV_DROPDOWN_PR_NONE) return;
@@ -997,13 +1043,59 @@ static void draw_box_label(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, ui
     if(area_ok) {
         const lv_area_t * clip_area_ori = draw_ctx->clip_area;
         draw_ctx->clip_area = &mask_sel;
-        lv_draw_label(draw_ctx, &label_dsc, &label->coords, lv_label_get_text(label), NULL);
+        draw_rows(dropdown_obj, draw_ctx, &label_dsc, &label->coords);
         draw_ctx->clip_area = clip_area_ori;
     }
     list_obj->state = state_orig;
     list_obj->skip_trans = 0;
 }
 
+/**
+ * Draw only the options in the rows visible on the clip area.
+ * The visible options are copied after each other to draw them at once,
+ * so the number of options doesn't matter.
+ * @param dropdown_obj  pointer to a drop-down list object
+ * @param draw_ctx      pointer to the current draw context
+ * @param dsc           descriptor of the text
+ * @param coords        the area of all the options. `y1` is the top of the first option.
+ */
+static void draw_rows(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                      const lv_area_t * coords)
+{
+    lv_dropdown_t * dropdown = (lv_dropdown_t *)dropdown_obj;
+    if(dropdown->option_ofs == NULL) return;
+
+    lv_coord_t row_h = lv_font_get_line_height(dsc->font) + dsc->line_space;
+    if(row_h <= 0) return;
+
+    /*One more row on both sides for the glyphs reaching out of their line*/
+    int32_t first = (draw_ctx->clip_area->y1 - coords->y1) / row_h - 1;
+    int32_t last = (draw_ctx->clip_area->y2 - coords->y1) / row_h + 1;
+    if(first < 0) first = 0;
+    if(last >= dropdown->option_cnt) last = dropdown->option_cnt - 1;
+    if(first > last) return;
+
+    /*The options are stored after each other so they can be copied at once*/
+    uint32_t start = dropdown->option_ofs[first];
+    uint32_t len = dropdown->option_ofs[last + 1] - start;  /*With the closing '\n' or '\0'*/
+    char * txt = lv_mem_buf_get(len);
+    LV_ASSERT_MALLOC(txt);
+    if(txt == NULL) return;
+
+    lv_memcpy(txt, &dropdown->options[start], len - 1);
+    txt[len - 1] = '\0';
+
+    /*Not to wrap the options if the area is narrower*/
+    lv_draw_label_dsc_t rows_dsc = *dsc;
+    rows_dsc.flag |= LV_TEXT_FLAG_EXPAND;
+
+    lv_area_t rows_area = *coords;
+    rows_area.y1 += first * row_h;
+    lv_draw_label(draw_ctx, &rows_dsc, &rows_area, txt, NULL);
+
+    lv_mem_buf_release(txt);
+}
+
 
 static lv_res_t btn_release_handler(lv_obj_t * obj)
 {
@@ -1144,4 +1236,43 @@ static lv_obj_t * get_label(const lv_obj_t * obj)
     return lv_obj_get_child(dropdown->list, 0);
 }
 
+/**
+ * Count the options and save where they start in the options string
+ * @param obj   pointer to a drop-down list object
+ */
+static void index_options(lv_obj_t * obj)
+{
+    lv_dropdown_t * dropdown = (lv_dropdown_t *)obj;
+
+    lv_mem_free(dropdown->option_ofs);
+    dropdown->option_ofs = NULL;
+    dropdown->option_cnt = 0;
+
+    if(dropdown->options) {
+        /*Count the '\n'-s to determine the number of options*/
+        uint32_t cnt = 1;   /*Last option has no `\n`*/
+        uint32_t len;
+        for(len = 0; dropdown->options[len] != '\0'; len++) {
+            if(dropdown->options[len] == '\n') cnt++;
+        }
+
+        dropdown->option_ofs = lv_mem_alloc((cnt + 1) * sizeof(uint32_t));
+        LV_ASSERT_MALLOC(dropdown->option_ofs);
+        if(dropdown->option_ofs) {
+            uint32_t i;
+            uint32_t id = 1;
+            dropdown->option_ofs[0] = 0;
+            for(i = 0; i < len; i++) {
+                if(dropdown->options[i] == '\n') dropdown->option_ofs[id++] = i + 1;
+            }
+            dropdown->option_ofs[cnt] = len + 1;   /*As if the last option had a '\n' too*/
+            dropdown->option_cnt = cnt;
+        }
+    }
+
+    /*The size of the list's label depends on the options*/
+    lv_obj_t * label = get_label(obj);
+    if(label) lv_obj_refresh_self_size(label);
+}
+
 #endif
@@ -27,6 +27,7 @@
 #define LV_LABEL_SCROLL_DELAY       300
 #define LV_LABEL_DOT_END_INV 0xFFFFFFFF
 #define LV_LABEL_HINT_HEIGHT_LIMIT 1024 /*Enable "hint" to buffer info about labels larger than this. (Speed up drawing)*/
+#define LV_LABEL_LINE_CACHE_LIMIT 512 /*Cache the lines of texts longer than this many bytes*/
 
 /**********************
  *      TYPEDEFS
@@ -46,6 +47,29 @@ static void lv_label_revert_dots(lv_obj_t * label);
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
+static void get_text_size(lv_obj_t * obj, lv_point_t * size, lv_coord_t max_w, lv_text_flag_t flag);
+static void line_cache_edit(lv_obj_t * obj, uint32_t pos, uint32_t del_cnt, uint32_t ins_len);
+static void line_cache_invalidate(lv_obj_t * obj);
+#if LV_USE_ARABIC_PERSIAN_CHARS
+static void ap_proc_edited(lv_obj_t * obj);
+#endif
+#if LV_LABEL_LINE_CACHE
+static bool line_cache_get_size(lv_obj_t * obj, lv_point_t * size, const lv_font_t * font, lv_coord_t letter_space,
+                                lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag);
+static const lv_label_line_cache_t * line_cache_get(lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space,
+                                                    lv_coord_t max_w, lv_text_flag_t flag);
+static const lv_label_line_cache_t * line_cache_get_ready(const lv_obj_t * obj, const lv_font_t * font,
+                                                          lv_coord_t letter_space, lv_coord_t max_w,
+                                                          lv_text_flag_t flag);
+static bool line_cache_update(lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_w,
+                              lv_text_flag_t flag);
+static uint32_t line_cache_find_byte(const lv_label_line_cache_t * cache, uint32_t byte_id);
+static uint32_t line_cache_find_y(const lv_label_line_cache_t * cache, int32_t y, lv_coord_t letter_height,
+                                  lv_coord_t line_space);
+static void line_cache_get_line(const lv_label_line_cache_t * cache, const char * txt, uint32_t line,
+                                uint32_t * start, uint32_t * end);
+static void line_cache_free(lv_obj_t * obj);
+#endif
 static void set_ofs_x_anim(void * obj, int32_t v);
 static void set_ofs_y_anim(void * obj, int32_t v);
 
@@ -92,6 +116,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
     /*If text is NULL then just refresh with the current text*/
     if(text == NULL) text = label->text;
 
+    /*The text might be modified in any way*/
+    line_cache_invalidate(obj);
+
     if(label->text == text && label->static_txt == 0) {
         /*If set its own text then reallocate it (maybe its size changed)*/
 #if LV_USE_ARABIC_PERSIAN_CHARS
@@ -101,10 +128,16 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         label->text = lv_mem_realloc(label->text, len);
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
+        label->text_size = len;
 
         _lv_txt_ap_proc(label->text, label->text);
 #else
-        label->text = lv_mem_realloc(label->text, strlen(label->text) + 1);
+        /*Keep the spare space reserved by `lv_label_ins_text` unless too much is unused*/
+        size_t len = strlen(label->text) + 1;
+        if(len > label->text_size || len < label->text_size / 2) {
+            label->text = lv_mem_realloc(label->text, len);
+            label->text_size = len;
+        }
 #endif
 
         LV_ASSERT_MALLOC(label->text);
@@ -136,6 +169,7 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         if(label->text == NULL) return;
         strcpy(label->text, text);
 #endif
+        label->text_size = len;
 
         /*Now the text is dynamically allocated*/
         label->static_txt = 0;
@@ -154,6 +188,7 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
 
     /*If text is NULL then refresh*/
     if(fmt == NULL) {
+        line_cache_invalidate(obj);
         lv_label_refr_text(obj);
         return;
     }
@@ -168,6 +203,8 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     label->text = _lv_txt_set_text_vfmt(fmt, args);
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
+    label->text_size = label->text ? strlen(label->text) + 1 : 0;
+    line_cache_invalidate(obj);
 
     lv_label_refr_text(obj);
 }
@@ -186,7 +223,9 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
         label->static_txt = 1;
         label->text       = (char *)text;
     }
+    label->text_size = 0;
 
+    line_cache_invalidate(obj);
     lv_label_refr_text(obj);
 }
 
@@ -327,14 +366,26 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
 
-    /*Search the line of the index letter*/;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+#if LV_LABEL_LINE_CACHE
+    /*Look up the line of the index letter if the lines are cached*/
+    const lv_label_line_cache_t * cache = line_cache_get((lv_obj_t *)obj, font, letter_space, max_w, flag);
+    if(cache) {
+        uint32_t line = line_cache_find_byte(cache, byte_id);
+        line_cache_get_line(cache, txt, line, &line_start, &new_line_start);
+        y = (lv_coord_t)(line * (letter_height + line_space));
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter*/;
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -428,22 +479,40 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in)
 
     lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, label->text);
 
-    /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+    bool found = false;
+#if LV_LABEL_LINE_CACHE
+    /*Look up the line under the point if the lines are cached*/
+    const lv_label_line_cache_t * cache = NULL;
+    if(letter_height + line_space > 0) cache = line_cache_get((lv_obj_t *)obj, font, letter_space, max_w, flag);
+    if(cache) {
+        uint32_t line = line_cache_find_y(cache, pos.y, letter_height, line_space);
+        line_cache_get_line(cache, txt, line, &line_start, &new_line_start);
+        found = line < cache->cnt;
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter*/;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                found = true;
+                break;
+            }
+            y += letter_height + line_space;
 
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
-            /*Include the NULL terminator in the last line*/
-            uint32_t tmp = new_line_start;
-            uint32_t letter;
-            letter = _lv_txt_encoded_prev(txt, &tmp);
-            if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
+            line_start = new_line_start;
         }
-        y += letter_height + line_space;
+    }
 
-        line_start = new_line_start;
+    if(found) {
+        /*Include the NULL terminator in the last line*/
+        uint32_t tmp = new_line_start;
+        uint32_t letter;
+        letter = _lv_txt_encoded_prev(txt, &tmp);
+        if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
     }
 
 #if LV_USE_BIDI
@@ -546,14 +615,26 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+#if LV_LABEL_LINE_CACHE
+    /*Look up the line under the point if the lines are cached*/
+    const lv_label_line_cache_t * cache = NULL;
+    if(letter_height + line_space > 0) cache = line_cache_get((lv_obj_t *)obj, font, letter_space, max_w, flag);
+    if(cache) {
+        uint32_t line = line_cache_find_y(cache, pos->y, letter_height, line_space);
+        line_cache_get_line(cache, txt, line, &line_start, &new_line_start);
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter*/;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
@@ -647,20 +728,30 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
 
     lv_obj_invalidate(obj);
 
-    /*Allocate space for the new text*/
+    /*Allocate space for the new text.
+     *Grow the buffer geometrically to not reallocate and copy the whole text on every insertion.*/
     size_t old_len = strlen(label->text);
     size_t ins_len = strlen(txt);
     size_t new_len = ins_len + old_len;
-    label->text        = lv_mem_realloc(label->text, new_len + 1);
-    LV_ASSERT_MALLOC(label->text);
-    if(label->text == NULL) return;
+    if(new_len + 1 > label->text_size) {
+        size_t new_size = LV_MAX(new_len + 1, label->text_size + label->text_size / 2);
+        label->text        = lv_mem_realloc(label->text, new_size);
+        LV_ASSERT_MALLOC(label->text);
+        if(label->text == NULL) return;
+        label->text_size = new_size;
+    }
 
     if(pos == LV_LABEL_POS_LAST) {
         pos = _lv_txt_get_encoded_length(label->text);
     }
 
+    line_cache_edit(obj, pos, 0, ins_len);
     _lv_txt_ins(label->text, pos, txt);
-    lv_label_set_text(obj, NULL);
+
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    ap_proc_edited(obj);
+#endif
+    lv_label_refr_text(obj);
 }
 
 void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
@@ -675,9 +766,13 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
 
     char * label_txt = lv_label_get_text(obj);
     /*Delete the characters*/
+    line_cache_edit(obj, pos, cnt, 0);
     _lv_txt_cut(label_txt, pos, cnt);
 
     /*Refresh the label*/
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    ap_proc_edited(obj);
+#endif
     lv_label_refr_text(obj);
 }
 
@@ -693,6 +788,7 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_t * label = (lv_label_t *)obj;
 
     label->text       = NULL;
+    label->text_size  = 0;
     label->static_txt = 0;
     label->recolor    = 0;
     label->dot_end    = LV_LABEL_DOT_END_INV;
@@ -706,6 +802,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_memset_00(&label->line_cache, sizeof(label->line_cache));
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -727,6 +827,9 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_t * label = (lv_label_t *)obj;
 
     lv_label_dot_tmp_free(obj);
+#if LV_LABEL_LINE_CACHE
+    line_cache_free(obj);
+#endif
     if(!label->static_txt) lv_mem_free(label->text);
     label->text = NULL;
 }
@@ -765,9 +868,6 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
     else if(code == LV_EVENT_GET_SELF_SIZE) {
         lv_point_t size;
         lv_label_t * label = (lv_label_t *)obj;
-        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
-        lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
-        lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
         lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
         if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
         if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
@@ -776,7 +876,7 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, label->text, font, letter_space, line_space, w, flag);
+        get_text_size(obj, &size, w, flag);
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
@@ -849,14 +949,47 @@ static void draw_main(lv_event_t * e)
         lv_area_move(&txt_coords, 0, -s);
         txt_coords.y2 = obj->coords.y2;
     }
+
+    const char * txt = label->text;
+#if LV_LABEL_LINE_CACHE
+    /*If the lines are cached draw only the text from the first visible line*/
+    lv_coord_t letter_height = lv_font_get_line_height(label_draw_dsc.font);
+    lv_coord_t line_h = letter_height + label_draw_dsc.line_space;
+    const lv_label_line_cache_t * cache = NULL;
+    if(label->long_mode != LV_LABEL_LONG_SCROLL_CIRCULAR && line_h > 0) {
+        cache = line_cache_get_ready(obj, label_draw_dsc.font, label_draw_dsc.letter_space,
+                                     lv_area_get_width(&txt_coords), flag);
+    }
+    if(cache) {
+        int32_t y = draw_ctx->clip_area->y1 - (txt_coords.y1 + label_draw_dsc.ofs_y);
+        uint32_t line = line_cache_find_y(cache, y, letter_height, label_draw_dsc.line_space);
+        if(line >= cache->cnt) return;
+
+        if(line > 0) {
+            uint32_t start = cache->lines[line].start;
+            txt = &label->text[start];
+            txt_coords.y1 += line * line_h;
+            hint = NULL;    /*The hint is related to the whole text*/
+
+            /*The selection is also relative to the drawn text*/
+            if(label_draw_dsc.sel_start != LV_DRAW_LABEL_NO_TXT_SEL &&
+               label_draw_dsc.sel_end != LV_DRAW_LABEL_NO_TXT_SEL) {
+                uint32_t start_id = _lv_txt_encoded_get_char_id(label->text, start);
+                label_draw_dsc.sel_start = label_draw_dsc.sel_start > start_id ? label_draw_dsc.sel_start - start_id : 0;
+                label_draw_dsc.sel_end = label_draw_dsc.sel_end > start_id ? label_draw_dsc.sel_end - start_id : 0;
+            }
+        }
+    }
+#endif
+
     if(label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         const lv_area_t * clip_area_ori = draw_ctx->clip_area;
         draw_ctx->clip_area = &txt_clip;
-        lv_draw_label(draw_ctx, &label_draw_dsc, &txt_coords, label->text, hint);
+        lv_draw_label(draw_ctx, &label_draw_dsc, &txt_coords, txt, hint);
         draw_ctx->clip_area = clip_area_ori;
     }
     else {
-        lv_draw_label(draw_ctx, &label_draw_dsc, &txt_coords, label->text, hint);
+        lv_draw_label(draw_ctx, &label_draw_dsc, &txt_coords, txt, hint);
     }
 
     const lv_area_t * clip_area_ori = draw_ctx->clip_area;
@@ -907,14 +1040,23 @@ static void lv_label_refr_text(lv_obj_t * obj)
     lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
     lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
 
-    /*Calc. the height and longest line*/
-    lv_point_t size;
+    /*Calc. the height and longest line. Only the scroll and dot modes need it here.*/
+    lv_point_t size = {0, 0};
     lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
     if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    /*The dots will modify the text*/
+    if(label->long_mode == LV_LABEL_LONG_DOT) line_cache_invalidate(obj);
+#if LV_LABEL_LINE_CACHE
+    /*Wrap the changed lines now because the cache is only read while drawing*/
+    else line_cache_get(obj, font, letter_space, max_w, flag);
+#endif
+
+    if(label->long_mode != LV_LABEL_LONG_WRAP && label->long_mode != LV_LABEL_LONG_CLIP) {
+        get_text_size(obj, &size, max_w, flag);
+    }
 
     lv_obj_refresh_self_size(obj);
 
@@ -1255,6 +1397,381 @@ static void lv_label_dot_tmp_free(lv_obj_t * obj)
     label->dot.tmp_ptr   = NULL;
 }
 
+#if LV_USE_ARABIC_PERSIAN_CHARS
+/**
+ * Process the Arabic and Persian letters again after inserting or deleting text
+ * because the form of the letters depends on their neighbors.
+ * @param obj       pointer to a label object
+ */
+static void ap_proc_edited(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    size_t len = _lv_txt_ap_calc_bytes_cnt(label->text);
+    char * tmp = lv_mem_buf_get(len);
+    LV_ASSERT_MALLOC(tmp);
+    if(tmp == NULL) return;
+
+    _lv_txt_ap_proc(label->text, tmp);
+
+    /*Don't wrap all the lines again if nothing was changed (e.g. there are no such letters)*/
+    if(strcmp(tmp, label->text) != 0) {
+        if(len > label->text_size) {
+            label->text = lv_mem_realloc(label->text, len);
+            LV_ASSERT_MALLOC(label->text);
+            if(label->text == NULL) {
+                lv_mem_buf_release(tmp);
+                return;
+            }
+            label->text_size = len;
+        }
+        strcpy(label->text, tmp);
+        line_cache_invalidate(obj);
+    }
+
+    lv_mem_buf_release(tmp);
+}
+#endif
+
+/**
+ * Get the size of the label's text. Use the cached lines if possible.
+ * @param obj       pointer to a label object
+ * @param size      store the result here
+ * @param max_w     max width of the text (break the lines to fit this size)
+ * @param flag      settings for the text from `lv_text_flag_t`
+ */
+static void get_text_size(lv_obj_t * obj, lv_point_t * size, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+
+#if LV_LABEL_LINE_CACHE
+    if(line_cache_get_size(obj, size, font, letter_space, line_space, max_w, flag)) return;
+#endif
+
+    lv_txt_get_size(size, label->text, font, letter_space, line_space, max_w, flag);
+}
+
+/**
+ * Note that some text will be replaced to wrap only the affected lines again.
+ * Should be called before modifying the text.
+ * @param obj       pointer to a label object
+ * @param pos       character index of the first changed letter
+ * @param del_cnt   number of characters to delete from `pos`
+ * @param ins_len   length of the text to insert at `pos` in bytes
+ */
+static void line_cache_edit(lv_obj_t * obj, uint32_t pos, uint32_t del_cnt, uint32_t ins_len)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_label_line_cache_t * cache = &label->line_cache;
+    if(!cache->valid) return;
+
+    uint32_t start = _lv_txt_encoded_get_byte_id(label->text, pos);
+    uint32_t del_len = _lv_txt_encoded_get_byte_id(&label->text[start], del_cnt);
+
+    if(!cache->edited) {
+        cache->edit_start = start;
+        cache->edit_end_old = start + del_len;
+        cache->edit_end_new = start + ins_len;
+        cache->edited = 1;
+    }
+    else {
+        /*Merge with the earlier edits. The text after the changed range is the same as in the old text.*/
+        uint32_t end = LV_MAX(cache->edit_end_new, start + del_len);
+        cache->edit_end_old += end - cache->edit_end_new;
+        cache->edit_end_new = end - del_len + ins_len;
+        cache->edit_start = LV_MIN(cache->edit_start, start);
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(pos);
+    LV_UNUSED(del_cnt);
+    LV_UNUSED(ins_len);
+#endif
+}
+
+/**
+ * Wrap all the lines again next time
+ * @param obj       pointer to a label object
+ */
+static void line_cache_invalidate(lv_obj_t * obj)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_label_t * label = (lv_label_t *)obj;
+    label->line_cache.valid = 0;
+    label->line_cache.edited = 0;
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
+#if LV_LABEL_LINE_CACHE
+
+/**
+ * Get the size of the text from the cached lines like `lv_txt_get_size` would.
+ * @return true: `size` is set; false: the text is not cached, use `lv_txt_get_size`
+ */
+static bool line_cache_get_size(lv_obj_t * obj, lv_point_t * size, const lv_font_t * font, lv_coord_t letter_space,
+                                lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    /*The content width is measured without `LV_TEXT_FLAG_FIT`.
+     *Don't replace the lines wrapped for drawing and hit testing with these.*/
+    if(max_w == LV_COORD_MAX && (flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) == 0) return false;
+
+    const lv_label_line_cache_t * cache = line_cache_get(obj, font, letter_space, max_w, flag);
+    if(cache == NULL) return false;
+
+    uint32_t line_cnt = cache->cnt;
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    size_t len = strlen(label->text);
+    if(label->text[len - 1] == '\n' || label->text[len - 1] == '\r') line_cnt++;
+
+    lv_coord_t letter_height = lv_font_get_line_height(font);
+    int64_t h = (int64_t)line_cnt * (letter_height + line_space);
+    if(h > (int64_t)LV_MAX_OF(lv_coord_t)) return false;    /*Let `lv_txt_get_size` handle the overflow*/
+
+    lv_coord_t w = 0;
+    uint32_t i;
+    for(i = 0; i < cache->cnt; i++) {
+        w = LV_MAX(w, cache->lines[i].width);
+    }
+
+    size->x = w;
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    size->y = h == 0 ? letter_height : (lv_coord_t)h - line_space;
+    return true;
+}
+
+/**
+ * Get the lines of the text wrapped with the given parameters. The lines are wrapped again if required.
+ * @return pointer to the cached lines or NULL if the text is not cached
+ */
+static const lv_label_line_cache_t * line_cache_get(lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space,
+                                                    lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    if(label->text == NULL || font == NULL) return NULL;
+
+    /*Short and static texts are not worth caching. Dots modify the text and
+     *recolor commands can hide break characters so the first changed line couldn't be found.*/
+    if(label->static_txt || label->long_mode == LV_LABEL_LONG_DOT || (flag & LV_TEXT_FLAG_RECOLOR) ||
+       strlen(label->text) < LV_LABEL_LINE_CACHE_LIMIT) {
+        if(label->line_cache.lines) line_cache_free(obj);
+        return NULL;
+    }
+
+    /*The lines are broken only at new line characters so the width doesn't matter*/
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) max_w = LV_COORD_MAX;
+
+    if(!line_cache_update(obj, font, letter_space, max_w, flag)) return NULL;
+
+    return &label->line_cache;
+}
+
+/**
+ * Get the lines of the text only if they are already wrapped with the given parameters.
+ * Doesn't modify the cache so it can be used while drawing.
+ * @return pointer to the cached lines or NULL if they are not up to date
+ */
+static const lv_label_line_cache_t * line_cache_get_ready(const lv_obj_t * obj, const lv_font_t * font,
+                                                          lv_coord_t letter_space, lv_coord_t max_w,
+                                                          lv_text_flag_t flag)
+{
+    const lv_label_t * label = (const lv_label_t *)obj;
+    const lv_label_line_cache_t * cache = &label->line_cache;
+
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) max_w = LV_COORD_MAX;
+
+    if(!cache->valid || cache->edited || cache->cnt == 0) return NULL;
+    if(cache->font != font || cache->max_w != max_w || cache->letter_space != letter_space ||
+       cache->flag != flag) return NULL;
+
+    return cache;
+}
+
+/**
+ * Wrap the text into lines. If only the parameters are the same just the edited lines are wrapped again.
+ * @return true: the lines are up to date; false: out of memory
+ */
+static bool line_cache_update(lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_w,
+                              lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_label_line_cache_t * cache = &label->line_cache;
+    const char * txt = label->text;
+
+    bool reuse = cache->valid && cache->cnt > 0 && cache->font == font && cache->max_w == max_w &&
+                 cache->letter_space == letter_space && cache->flag == flag;
+    if(reuse && !cache->edited) return true;
+
+    uint32_t first = 0;     /*Index of the first line to wrap again*/
+    int32_t diff = 0;       /*Length change of the text*/
+    if(reuse) {
+        /*To wrap a line its words are measured until the first word which doesn't fit,
+         *including the break character after it and the letter after that (for kerning).
+         *So the lines ending before a break character which precedes the letter before the edit can't change.
+         *Start from the line of that break character.*/
+        int32_t j = (int32_t)cache->edit_start - 2;
+        while(j >= 0 && txt[j] != '\n' && txt[j] != '\r' && !_lv_txt_is_break_char((uint8_t)txt[j])) j--;
+
+        if(j > 0) first = line_cache_find_byte(cache, j);
+
+        diff = (int32_t)cache->edit_end_new - (int32_t)cache->edit_end_old;
+    }
+
+    /*Wrap the text again until a line starts at the same letter after the edited range as before.
+     *Wrapping from there would result in the same lines.*/
+    lv_label_line_t * new_lines = NULL;
+    uint32_t new_cnt = 0;
+    uint32_t new_size = 0;
+    uint32_t old_i = first + 1;
+    uint32_t start = reuse ? cache->lines[first].start : 0;
+    bool synced = false;
+    while(txt[start] != '\0') {
+        uint32_t end = start + _lv_txt_get_next_line(&txt[start], font, letter_space, max_w, NULL, flag);
+
+        if(new_cnt == new_size) {
+            new_size = new_size ? new_size * 2 : 8;
+            lv_label_line_t * tmp = lv_mem_realloc(new_lines, new_size * sizeof(lv_label_line_t));
+            LV_ASSERT_MALLOC(tmp);
+            if(tmp == NULL) {
+                lv_mem_free(new_lines);
+                line_cache_free(obj);
+                return false;
+            }
+            new_lines = tmp;
+        }
+
+        new_lines[new_cnt].start = start;
+        new_lines[new_cnt].width = lv_txt_get_width(&txt[start], end - start, font, letter_space, flag);
+        new_cnt++;
+        start = end;
+
+        if(reuse && end >= cache->edit_end_new) {
+            while(old_i < cache->cnt && (int32_t)cache->lines[old_i].start + diff < (int32_t)end) old_i++;
+            if(old_i < cache->cnt && (int32_t)cache->lines[old_i].start + diff == (int32_t)end) {
+                synced = true;
+                break;
+            }
+        }
+    }
+
+    /*Replace the old lines from `first` to `old_i` with the new ones*/
+    if(!reuse) first = 0;
+    if(!synced) old_i = cache->cnt;
+
+    uint32_t tail_cnt = cache->cnt - old_i;
+    uint32_t cnt = first + new_cnt + tail_cnt;
+    if(cnt > cache->size) {
+        uint32_t size = LV_MAX(cnt, cache->size + cache->size / 2);
+        lv_label_line_t * tmp = lv_mem_realloc(cache->lines, size * sizeof(lv_label_line_t));
+        LV_ASSERT_MALLOC(tmp);
+        if(tmp == NULL) {
+            lv_mem_free(new_lines);
+            line_cache_free(obj);
+            return false;
+        }
+        cache->lines = tmp;
+        cache->size = size;
+    }
+
+    if(tail_cnt) {
+        memmove(&cache->lines[first + new_cnt], &cache->lines[old_i], tail_cnt * sizeof(lv_label_line_t));
+        uint32_t i;
+        for(i = first + new_cnt; i < cnt; i++) {
+            cache->lines[i].start += diff;
+        }
+    }
+    if(new_cnt) lv_memcpy(&cache->lines[first], new_lines, new_cnt * sizeof(lv_label_line_t));
+    lv_mem_free(new_lines);
+
+    cache->cnt = cnt;
+    cache->font = font;
+    cache->max_w = max_w;
+    cache->letter_space = letter_space;
+    cache->flag = flag;
+    cache->valid = 1;
+    cache->edited = 0;
+    return true;
+}
+
+/**
+ * Find the line of a letter
+ * @param cache     pointer to up to date cached lines
+ * @param byte_id   byte index of the letter
+ * @return          index of the last line starting at or before `byte_id`
+ */
+static uint32_t line_cache_find_byte(const lv_label_line_cache_t * cache, uint32_t byte_id)
+{
+    uint32_t min = 0;
+    uint32_t max = cache->cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) / 2;
+        if(cache->lines[mid].start <= byte_id) min = mid;
+        else max = mid - 1;
+    }
+    return min;
+}
+
+/**
+ * Find the first line which isn't above a y coordinate
+ * @param cache         pointer to up to date cached lines
+ * @param y             y coordinate relative to the first line
+ * @param letter_height line height of the font
+ * @param line_space    space between the lines. `letter_height + line_space` must be positive.
+ * @return              index of the first line whose bottom is at or below `y`. Can be `cache->cnt` too.
+ */
+static uint32_t line_cache_find_y(const lv_label_line_cache_t * cache, int32_t y, lv_coord_t letter_height,
+                                  lv_coord_t line_space)
+{
+    if(y <= letter_height) return 0;
+
+    int32_t line_h = letter_height + line_space;
+    uint32_t line = (y - letter_height + line_h - 1) / line_h;
+    return LV_MIN(line, cache->cnt);
+}
+
+/**
+ * Get the start and end of a line
+ * @param cache     pointer to up to date cached lines
+ * @param txt       the cached text
+ * @param line      index of the line. If it's after the last line both `start` and `end` will be the end of the text.
+ * @param start     store the byte index of the first letter here
+ * @param end       store the byte index of the next line's first letter here
+ */
+static void line_cache_get_line(const lv_label_line_cache_t * cache, const char * txt, uint32_t line,
+                                uint32_t * start, uint32_t * end)
+{
+    if(line + 1 < cache->cnt) {
+        *start = cache->lines[line].start;
+        *end = cache->lines[line + 1].start;
+    }
+    else {
+        uint32_t len = strlen(txt);
+        *start = line < cache->cnt ? cache->lines[line].start : len;
+        *end = len;
+    }
+}
+
+/**
+ * Free the cached lines
+ * @param obj       pointer to a label object
+ */
+static void line_cache_free(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_mem_free(label->line_cache.lines);
+    lv_memset_00(&label->line_cache, sizeof(label->line_cache));
+}
+
+#endif /*LV_LABEL_LINE_CACHE*/
+
 
 static void set_ofs_x_anim(void * obj, int32_t v)
 {
@@ -50,9 +50,34 @@ enum {
 };
 typedef uint8_t lv_label_long_mode_t;
 
+#if LV_LABEL_LINE_CACHE
+typedef struct {
+    uint32_t start;         /*Byte index of the first letter of the line*/
+    lv_coord_t width;       /*Width of the line*/
+} lv_label_line_t;
+
+/** The wrapped lines of a long text with the parameters they were wrapped with.
+ * After inserting or deleting text only the lines around the edited range are wrapped again.*/
+typedef struct {
+    lv_label_line_t * lines;
+    uint32_t cnt;           /*Number of lines*/
+    uint32_t size;          /*Number of allocated lines*/
+    const lv_font_t * font;
+    lv_coord_t max_w;
+    lv_coord_t letter_space;
+    lv_text_flag_t flag;
+    uint32_t edit_start;    /*Byte range changed since wrapping. The text in `edit_start..edit_end_old`*/
+    uint32_t edit_end_old;  /*was replaced by `edit_start..edit_end_new`*/
+    uint32_t edit_end_new;
+    uint8_t valid : 1;
+    uint8_t edited : 1;
+} lv_label_line_cache_t;
+#endif
+
 typedef struct {
     lv_obj_t obj;
     char * text;
+    uint32_t text_size; /*Allocated size of `text`. Can be larger than the text to insert without reallocation*/
     union {
         char * tmp_ptr; /*Pointer to the allocated memory containing the character replaced by dots*/
         char tmp[LV_LABEL_DOT_NUM + 1]; /*Directly store the characters if <=4 characters*/
@@ -63,6 +88,10 @@ typedef struct {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_label_line_cache_t line_cache;
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
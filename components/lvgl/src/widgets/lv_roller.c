@@ -29,15 +29,19 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_roller_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_roller_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_roller_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void lv_roller_label_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 static void draw_label(lv_event_t * e);
+static void draw_rows(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                      const lv_area_t * coords);
 static void get_sel_area(lv_obj_t * obj, lv_area_t * sel_area);
 static void refr_position(lv_obj_t * obj, lv_anim_enable_t animen);
 static lv_res_t release_handler(lv_obj_t * obj);
 static void inf_normalize(lv_obj_t * obj_scrl);
 static lv_obj_t * get_label(const lv_obj_t * obj);
+static uint16_t get_real_option_cnt(const lv_obj_t * obj);
 static lv_coord_t get_selected_label_width(const lv_obj_t * obj);
 static void scroll_anim_ready_cb(lv_anim_t * a);
 static void set_y_anim(void * obj, int32_t v);
@@ -47,6 +51,7 @@ static void set_y_anim(void * obj, int32_t v);
  **********************/
 const lv_obj_class_t lv_roller_class = {
     .constructor_cb = lv_roller_constructor,
+    .destructor_cb = lv_roller_destructor,
     .event_cb = lv_roller_event,
     .width_def = LV_SIZE_CONTENT,
     .height_def = LV_DPI_DEF,
@@ -105,31 +110,45 @@ void lv_roller_set_options(lv_obj_t * obj, const char * options, lv_roller_mode_
     roller->sel_opt_id_ori = 0;
 
     /*Count the '\n'-s to determine the number of options*/
-    roller->option_cnt = 0;
-    uint32_t cnt;
-    for(cnt = 0; options[cnt] != '\0'; cnt++) {
-        if(options[cnt] == '\n') roller->option_cnt++;
+    uint32_t real_cnt = 1; /*Last option has no `\n`*/
+    uint32_t len;
+    for(len = 0; options[len] != '\0'; len++) {
+        if(options[len] == '\n') real_cnt++;
+    }
+
+    /*Store the options only once (on all the pages in infinite mode too) and index where they start.
+     *`options` might be the current options so allocate the new ones first.*/
+    char * new_options = lv_mem_alloc(len + 1);
+    LV_ASSERT_MALLOC(new_options);
+    uint32_t * new_ofs = lv_mem_alloc((real_cnt + 1) * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(new_ofs);
+    if(new_options == NULL || new_ofs == NULL) {
+        lv_mem_free(new_options);
+        lv_mem_free(new_ofs);
+        return;
     }
-    roller->option_cnt++; /*Last option has no `\n`*/
+
+    lv_memcpy(new_options, options, len + 1);
+    uint32_t i;
+    uint32_t id = 1;
+    new_ofs[0] = 0;
+    for(i = 0; i < len; i++) {
+        if(new_options[i] == '\n') new_ofs[id++] = i + 1;
+    }
+    new_ofs[real_cnt] = len + 1;   /*As if the last option had a '\n' too*/
+
+    lv_mem_free(roller->options);
+    lv_mem_free(roller->option_ofs);
+    roller->options = new_options;
+    roller->option_ofs = new_ofs;
+    roller->option_cnt = real_cnt;
 
     if(mode == LV_ROLLER_MODE_NORMAL) {
         roller->mode = LV_ROLLER_MODE_NORMAL;
-        lv_label_set_text(label, options);
     }
     else {
         roller->mode = LV_ROLLER_MODE_INFINITE;
 
-        size_t opt_len = strlen(options) + 1; /*+1 to add '\n' after option lists*/
-        char * opt_extra = lv_mem_buf_get(opt_len * LV_ROLLER_INF_PAGES);
-        uint8_t i;
-        for(i = 0; i < LV_ROLLER_INF_PAGES; i++) {
-            strcpy(&opt_extra[opt_len * i], options);
-            opt_extra[opt_len * (i + 1) - 1] = '\n';
-        }
-        opt_extra[opt_len * LV_ROLLER_INF_PAGES - 1] = '\0';
-        lv_label_set_text(label, opt_extra);
-        lv_mem_buf_release(opt_extra);
-
         roller->sel_opt_id     = ((LV_ROLLER_INF_PAGES / 2) + 0) * roller->option_cnt;
 
         roller->option_cnt = roller->option_cnt * LV_ROLLER_INF_PAGES;
@@ -138,9 +157,12 @@ void lv_roller_set_options(lv_obj_t * obj, const char * options, lv_roller_mode_
 
     roller->sel_opt_id_ori = roller->sel_opt_id;
 
+    /*The label has no text, its size is calculated from the options*/
+    lv_obj_refresh_self_size(label);
+    lv_obj_invalidate(obj);
+
     /*If the selected text has larger font the label needs some extra draw padding to draw it.*/
     lv_obj_refresh_ext_draw_size(label);
-
 }
 
 /**
@@ -232,26 +254,20 @@ void lv_roller_get_selected_str(const lv_obj_t * obj, char * buf, uint32_t buf_s
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     lv_roller_t * roller = (lv_roller_t *)obj;
-    lv_obj_t * label = get_label(obj);
-    uint32_t i;
-    uint16_t line        = 0;
-    const char * opt_txt = lv_label_get_text(label);
-    size_t txt_len     = strlen(opt_txt);
-
-    for(i = 0; i < txt_len && line != roller->sel_opt_id; i++) {
-        if(opt_txt[i] == '\n') line++;
+    if(roller->options == NULL) {
+        buf[0] = '\0';
+        return;
     }
 
-    uint32_t c;
-    for(c = 0; i < txt_len && opt_txt[i] != '\n'; c++, i++) {
-        if(buf_size && c >= buf_size - 1) {
-            LV_LOG_WARN("lv_dropdown_get_selected_str: the buffer was too small");
-            break;
-        }
-        buf[c] = opt_txt[i];
+    uint16_t id = roller->sel_opt_id % get_real_option_cnt(obj);
+    uint32_t len = roller->option_ofs[id + 1] - roller->option_ofs[id] - 1;
+    if(buf_size && len >= buf_size) {
+        LV_LOG_WARN("lv_roller_get_selected_str: the buffer was too small");
+        len = buf_size - 1;
     }
 
-    buf[c] = '\0';
+    lv_memcpy(buf, &roller->options[roller->option_ofs[id]], len);
+    buf[len] = '\0';
 }
 
 
@@ -264,7 +280,8 @@ const char * lv_roller_get_options(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    return lv_label_get_text(get_label(obj));
+    lv_roller_t * roller = (lv_roller_t *)obj;
+    return roller->options == NULL ? "" : roller->options;
 }
 
 
@@ -297,6 +314,8 @@ static void lv_roller_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     lv_roller_t * roller = (lv_roller_t *)obj;
 
     roller->mode = LV_ROLLER_MODE_NORMAL;
+    roller->options = NULL;
+    roller->option_ofs = NULL;
     roller->option_cnt = 0;
     roller->sel_opt_id = 0;
     roller->sel_opt_id_ori = 0;
@@ -307,11 +326,23 @@ static void lv_roller_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     LV_LOG_INFO("begin");
     lv_obj_t * label = lv_obj_class_create_obj(&lv_roller_label_class, obj);
     lv_obj_class_init_obj(label);
+    lv_label_set_text_static(label, "");    /*The options are drawn by the roller*/
     lv_roller_set_options(obj, "Option 1\nOption 2\nOption 3\nOption 4\nOption 5", LV_ROLLER_MODE_NORMAL);
 
     LV_LOG_TRACE("finshed");
 }
 
+static void lv_roller_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_roller_t * roller = (lv_roller_t *)obj;
+
+    lv_mem_free(roller->options);
+    roller->options = NULL;
+    lv_mem_free(roller->option_ofs);
+    roller->option_ofs = NULL;
+}
+
 static void lv_roller_event(const lv_obj_class_t * class_p, lv_event_t * e)
 {
     LV_UNUSED(class_p);
@@ -438,6 +469,21 @@ static void lv_roller_label_event(const lv_obj_class_t * class_p, lv_event_t * e
         lv_coord_t label_w = lv_obj_get_width(label);
         *s = LV_MAX(*s, sel_w - label_w);
     }
+    else if(code == LV_EVENT_GET_SELF_SIZE) {
+        /*The label has no text but it's as large as the options on all the pages*/
+        lv_point_t * p = lv_event_get_param(e);
+        lv_roller_t * roller = (lv_roller_t *)lv_obj_get_parent(label);
+        if(roller->options == NULL) return;
+
+        const lv_font_t * font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+        lv_coord_t letter_space = lv_obj_get_style_text_letter_space(label, LV_PART_MAIN);
+        lv_coord_t line_space = lv_obj_get_style_text_line_space(label, LV_PART_MAIN);
+        lv_text_flag_t flag = lv_label_get_recolor(label) ? LV_TEXT_FLAG_RECOLOR : LV_TEXT_FLAG_NONE;
+        lv_point_t size;
+        lv_txt_get_size(&size, roller->options, font, letter_space, line_space, LV_COORD_MAX, flag);
+        p->x = LV_MAX(p->x, size.x);
+        p->y = LV_MAX(p->y, roller->option_cnt * (lv_font_get_line_height(font) + line_space) - line_space);
+    }
     else if(code == LV_EVENT_SIZE_CHANGED) {
         refr_position(lv_obj_get_parent(label), LV_ANIM_OFF);
     }
@@ -476,13 +522,13 @@ static void draw_main(lv_event_t * e)
         bool area_ok;
         area_ok = _lv_area_intersect(&mask_sel, draw_ctx->clip_area, &sel_area);
         if(area_ok) {
+            lv_roller_t * roller = (lv_roller_t *)obj;
             lv_obj_t * label = get_label(obj);
             if(lv_label_get_recolor(label)) label_dsc.flag |= LV_TEXT_FLAG_RECOLOR;
 
-            /*Get the size of the "selected text"*/
-            lv_point_t res_p;
-            lv_txt_get_size(&res_p, lv_label_get_text(label), label_dsc.font, label_dsc.letter_space, label_dsc.line_space,
-                            lv_obj_get_width(obj), LV_TEXT_FLAG_EXPAND);
+            /*Get the height of the "selected text" from the number of options without measuring them*/
+            lv_coord_t res_h = roller->option_cnt * (lv_font_get_line_height(label_dsc.font) + label_dsc.line_space) -
+                               label_dsc.line_space;
 
             /*Move the selected label proportionally with the background label*/
             lv_coord_t roller_h = lv_obj_get_height(obj);
@@ -496,9 +542,9 @@ static void draw_main(lv_event_t * e)
             lv_coord_t corr = (label_dsc.font->line_height - normal_label_font->line_height) / 2;
 
             /*Apply the proportional position to the selected text*/
-            res_p.y -= corr;
+            res_h -= corr;
             int32_t label_sel_y = roller_h / 2 + obj->coords.y1;
-            label_sel_y += (label_y_prop * res_p.y) >> 14;
+            label_sel_y += (label_y_prop * res_h) >> 14;
             label_sel_y -= corr;
 
             lv_coord_t bwidth = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
@@ -510,12 +556,11 @@ static void draw_main(lv_event_t * e)
             label_sel_area.x1 = obj->coords.x1 + pleft + bwidth;
             label_sel_area.y1 = label_sel_y;
             label_sel_area.x2 = obj->coords.x2 - pright - bwidth;
-            label_sel_area.y2 = label_sel_area.y1 + res_p.y;
+            label_sel_area.y2 = label_sel_area.y1 + res_h;
 
-            label_dsc.flag |= LV_TEXT_FLAG_EXPAND;
             const lv_area_t * clip_area_ori = draw_ctx->clip_area;
             draw_ctx->clip_area = &mask_sel;
-            lv_draw_label(draw_ctx, &label_dsc, &label_sel_area, lv_label_get_text(label), NULL);
+            draw_rows(obj, draw_ctx, &label_dsc, &label_sel_area);
             draw_ctx->clip_area = clip_area_ori;
         }
     }
@@ -553,7 +598,7 @@ static void draw_label(lv_event_t * e)
     if(_lv_area_intersect(&clip2, draw_ctx->clip_area, &clip2)) {
         const lv_area_t * clip_area_ori2 = draw_ctx->clip_area;
         draw_ctx->clip_area = &clip2;
-        lv_draw_label(draw_ctx, &label_draw_dsc, &label_obj->coords, lv_label_get_text(label_obj), NULL);
+        draw_rows(roller, draw_ctx, &label_draw_dsc, &label_obj->coords);
         draw_ctx->clip_area = clip_area_ori2;
     }
 
@@ -564,13 +609,72 @@ static void draw_label(lv_event_t * e)
     if(_lv_area_intersect(&clip2, draw_ctx->clip_area, &clip2)) {
         const lv_area_t * clip_area_ori2 = draw_ctx->clip_area;
         draw_ctx->clip_area = &clip2;
-        lv_draw_label(draw_ctx, &label_draw_dsc, &label_obj->coords, lv_label_get_text(label_obj), NULL);
+        draw_rows(roller, draw_ctx, &label_draw_dsc, &label_obj->coords);
         draw_ctx->clip_area = clip_area_ori2;
     }
 
     draw_ctx->clip_area = clip_area_ori;
 }
 
+/**
+ * Draw only the options in the rows visible on the clip area.
+ * The visible options are copied after each other to draw them at once,
+ * so the number of options and the infinite pages don't matter.
+ * @param obj       pointer to a roller object
+ * @param draw_ctx  pointer to the current draw context
+ * @param dsc       descriptor of the text
+ * @param coords    the area of all the options. `y1` is the top of the first option.
+ */
+static void draw_rows(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                      const lv_area_t * coords)
+{
+    lv_roller_t * roller = (lv_roller_t *)obj;
+    if(roller->options == NULL) return;
+
+    lv_coord_t row_h = lv_font_get_line_height(dsc->font) + dsc->line_space;
+    if(row_h <= 0) return;
+
+    /*One more row on both sides for the glyphs reaching out of their line*/
+    int32_t first = (draw_ctx->clip_area->y1 - coords->y1) / row_h - 1;
+    int32_t last = (draw_ctx->clip_area->y2 - coords->y1) / row_h + 1;
+    if(first < 0) first = 0;
+    if(last >= roller->option_cnt) last = roller->option_cnt - 1;
+    if(first > last) return;
+
+    uint16_t real_cnt = get_real_option_cnt(obj);
+    uint32_t len = 0;
+    int32_t r;
+    for(r = first; r <= last; r++) {
+        uint32_t id = r % real_cnt;
+        len += roller->option_ofs[id + 1] - roller->option_ofs[id];  /*With a '\n' or the closing '\0'*/
+    }
+
+    char * txt = lv_mem_buf_get(len);
+    LV_ASSERT_MALLOC(txt);
+    if(txt == NULL) return;
+
+    uint32_t i = 0;
+    for(r = first; r <= last; r++) {
+        uint32_t id = r % real_cnt;
+        uint32_t opt_len = roller->option_ofs[id + 1] - roller->option_ofs[id] - 1;
+        lv_memcpy(&txt[i], &roller->options[roller->option_ofs[id]], opt_len);
+        i += opt_len;
+        txt[i] = '\n';
+        i++;
+    }
+    txt[len - 1] = '\0';
+
+    /*Not to wrap the options if the area is narrower*/
+    lv_draw_label_dsc_t rows_dsc = *dsc;
+    rows_dsc.flag |= LV_TEXT_FLAG_EXPAND;
+
+    lv_area_t rows_area = *coords;
+    rows_area.y1 += first * row_h;
+    lv_draw_label(draw_ctx, &rows_dsc, &rows_area, txt, NULL);
+
+    lv_mem_buf_release(txt);
+}
+
 static void get_sel_area(lv_obj_t * obj, lv_area_t * sel_area)
 {
 
@@ -600,7 +704,9 @@ static void refr_position(lv_obj_t * obj, lv_anim_enable_t anim_en)
     lv_obj_t * label = get_label(obj);
     if(label == NULL) return;
 
-    lv_text_align_t align = lv_obj_calculate_style_text_align(label, LV_PART_MAIN, lv_label_get_text(label));
+    lv_roller_t * roller = (lv_roller_t *)obj;
+    const char * options = roller->options == NULL ? "" : roller->options;
+    lv_text_align_t align = lv_obj_calculate_style_text_align(label, LV_PART_MAIN, options);
 
     switch(align) {
         case LV_TEXT_ALIGN_CENTER:
@@ -614,7 +720,6 @@ static void refr_position(lv_obj_t * obj, lv_anim_enable_t anim_en)
             break;
     }
 
-    lv_roller_t * roller = (lv_roller_t *)obj;
     const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
     lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
     lv_coord_t font_h              = lv_font_get_line_height(font);
@@ -673,45 +778,29 @@ static lv_res_t release_handler(lv_obj_t * obj)
 
     if(lv_indev_get_type(indev) == LV_INDEV_TYPE_POINTER || lv_indev_get_type(indev) == LV_INDEV_TYPE_BUTTON) {
         /*Search the clicked option (For KEYPAD and ENCODER the new value should be already set)*/
-        int16_t new_opt  = -1;
+        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+        lv_coord_t font_h              = lv_font_get_line_height(font);
+        lv_coord_t label_unit = font_h + line_space;
+
+        int32_t id;
         if(roller->moved == 0) {
-            new_opt = 0;
+            /*The clicked row*/
             lv_point_t p;
             lv_indev_get_point(indev, &p);
-            p.y -= label->coords.y1;
-            p.x -= label->coords.x1;
-            uint32_t letter_i;
-            letter_i = lv_label_get_letter_on(label, &p);
-
-            const char * txt  = lv_label_get_text(label);
-            uint32_t i        = 0;
-            uint32_t i_prev   = 0;
-
-            uint32_t letter_cnt = 0;
-            for(letter_cnt = 0; letter_cnt < letter_i; letter_cnt++) {
-                uint32_t letter = _lv_txt_encoded_next(txt, &i);
-                /*Count he lines to reach the clicked letter. But ignore the last '\n' because it
-                 * still belongs to the clicked line*/
-                if(letter == '\n' && i_prev != letter_i) new_opt++;
-                i_prev = i;
-            }
+            id = (p.y - label->coords.y1) / label_unit;
         }
         else {
             /*If dragged then align the list to have an element in the middle*/
-            const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
-            lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
-            lv_coord_t font_h              = lv_font_get_line_height(font);
-
-            lv_coord_t label_unit = font_h + line_space;
             lv_coord_t mid        = obj->coords.y1 + (obj->coords.y2 - obj->coords.y1) / 2;
             lv_coord_t label_y1 = label->coords.y1 + lv_indev_scroll_throw_predict(indev, LV_DIR_VER);
-            int32_t id = (mid - label_y1) / label_unit;
+            id = (mid - label_y1) / label_unit;
+        }
 
-            if(id < 0) id = 0;
-            if(id >= roller->option_cnt) id = roller->option_cnt - 1;
+        if(id < 0) id = 0;
+        if(id >= roller->option_cnt) id = roller->option_cnt - 1;
 
-            new_opt = id;
-        }
+        int16_t new_opt = id;
 
         if(new_opt >= 0) {
             lv_roller_set_selected(obj, new_opt, LV_ANIM_ON);
@@ -760,17 +849,28 @@ static lv_obj_t * get_label(const lv_obj_t * obj)
     return lv_obj_get_child(obj, 0);
 }
 
+/**
+ * Get the number of options without the infinite pages
+ * @param obj   pointer to a roller object
+ * @return      number of different options
+ */
+static uint16_t get_real_option_cnt(const lv_obj_t * obj)
+{
+    lv_roller_t * roller = (lv_roller_t *)obj;
+    if(roller->mode == LV_ROLLER_MODE_INFINITE) return roller->option_cnt / LV_ROLLER_INF_PAGES;
+    else return roller->option_cnt;
+}
+
 
 static lv_coord_t get_selected_label_width(const lv_obj_t * obj)
 {
-    lv_obj_t * label = get_label(obj);
-    if(label == NULL) return 0;
+    lv_roller_t * roller = (lv_roller_t *)obj;
+    if(roller->options == NULL) return 0;
 
     const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_SELECTED);
     lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_SELECTED);
-    const char * txt = lv_label_get_text(label);
     lv_point_t size;
-    lv_txt_get_size(&size, txt, font, letter_space, 0, LV_COORD_MAX,  LV_TEXT_FLAG_NONE);
+    lv_txt_get_size(&size, roller->options, font, letter_space, 0, LV_COORD_MAX,  LV_TEXT_FLAG_NONE);
     return size.x;
 }
 
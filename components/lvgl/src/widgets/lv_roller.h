@@ -43,7 +43,9 @@ typedef uint8_t lv_roller_mode_t;
 
 typedef struct {
     lv_obj_t obj;
-    uint16_t option_cnt;          /**< Number of options*/
+    char * options;               /**< The options separated by '\n'. Stored only once in infinite mode too.*/
+    uint32_t * option_ofs;        /**< Start index of every option in `options` and `strlen(options) + 1` at the end*/
+    uint16_t option_cnt;          /**< Number of options (all the pages in infinite mode)*/
     uint16_t sel_opt_id;          /**< Index of the current option*/
     uint16_t sel_opt_id_ori;      /**< Store the original index on focus*/
     lv_roller_mode_t mode : 1;
@@ -114,7 +116,8 @@ void lv_roller_get_selected_str(const lv_obj_t * obj, char * buf, uint32_t buf_s
 /**
  * Get the options of a roller
  * @param obj       pointer to roller object
- * @return          the options separated by '\n'-s (E.g. "Option1\nOption2\nOption3")
+ * @return          the options separated by '\n'-s (E.g. "Option1\nOption2\nOption3").
+ *                  In infinite mode the options are returned only once.
  */
 const char * lv_roller_get_options(const lv_obj_t * obj);
 
@@ -59,6 +59,7 @@ static lv_res_t insert_handler(lv_obj_t * obj, const char * txt);
 static void draw_placeholder(lv_event_t * e);
 static void draw_cursor(lv_event_t * e);
 static void auto_hide_characters(lv_obj_t * obj);
+static bool pwd_tmp_reserve(lv_obj_t * obj, size_t len);
 static inline bool is_valid_but_non_printable_char(const uint32_t letter);
 
 /**********************
@@ -140,11 +141,7 @@ void lv_textarea_add_char(lv_obj_t * obj, uint32_t c)
     lv_textarea_clear_selection(obj); /*Clear selection*/
 
     if(ta->pwd_mode) {
-        /*+2: the new char + \0*/
-        size_t realloc_size = strlen(ta->pwd_tmp) + strlen(letter_buf) + 1;
-        ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, realloc_size);
-        LV_ASSERT_MALLOC(ta->pwd_tmp);
-        if(ta->pwd_tmp == NULL) return;
+        if(!pwd_tmp_reserve(obj, strlen(ta->pwd_tmp) + strlen(letter_buf))) return;
 
         _lv_txt_ins(ta->pwd_tmp, ta->cursor.pos, (const char *)letter_buf);
 
@@ -191,10 +188,7 @@ void lv_textarea_add_text(lv_obj_t * obj, const char * txt)
     lv_textarea_clear_selection(obj);
 
     if(ta->pwd_mode) {
-        size_t realloc_size = strlen(ta->pwd_tmp) + strlen(txt) + 1;
-        ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, realloc_size);
-        LV_ASSERT_MALLOC(ta->pwd_tmp);
-        if(ta->pwd_tmp == NULL) return;
+        if(!pwd_tmp_reserve(obj, strlen(ta->pwd_tmp) + strlen(txt))) return;
 
         _lv_txt_ins(ta->pwd_tmp, ta->cursor.pos, txt);
 
@@ -222,13 +216,8 @@ void lv_textarea_del_char(lv_obj_t * obj)
     lv_res_t res = insert_handler(obj, del_buf);
     if(res != LV_RES_OK) return;
 
-    char * label_txt = lv_label_get_text(ta->label);
-
     /*Delete a character*/
-    _lv_txt_cut(label_txt, ta->cursor.pos - 1, 1);
-
-    /*Refresh the label*/
-    lv_label_set_text(ta->label, label_txt);
+    lv_label_cut_text(ta->label, ta->cursor.pos - 1, 1);
     lv_textarea_clear_selection(obj);
 
     /*If the textarea became empty, invalidate it to hide the placeholder*/
@@ -238,11 +227,8 @@ void lv_textarea_del_char(lv_obj_t * obj)
     }
 
     if(ta->pwd_mode) {
+        /*Keep the allocated space for the next characters*/
         _lv_txt_cut(ta->pwd_tmp, ta->cursor.pos - 1, 1);
-
-        ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, strlen(ta->pwd_tmp) + 1);
-        LV_ASSERT_MALLOC(ta->pwd_tmp);
-        if(ta->pwd_tmp == NULL) return;
     }
 
     /*Move the cursor to the place of the deleted character*/
@@ -303,6 +289,7 @@ void lv_textarea_set_text(lv_obj_t * obj, const char * txt)
         ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, strlen(txt) + 1);
         LV_ASSERT_MALLOC(ta->pwd_tmp);
         if(ta->pwd_tmp == NULL) return;
+        ta->pwd_tmp_size = strlen(txt) + 1;
         strcpy(ta->pwd_tmp, txt);
 
         /*Auto hide characters*/
@@ -417,6 +404,7 @@ void lv_textarea_set_password_mode(lv_obj_t * obj, bool en)
         ta->pwd_tmp = lv_mem_alloc(len + 1);
         LV_ASSERT_MALLOC(ta->pwd_tmp);
         if(ta->pwd_tmp == NULL) return;
+        ta->pwd_tmp_size = len + 1;
 
         strcpy(ta->pwd_tmp, txt);
 
@@ -430,6 +418,7 @@ void lv_textarea_set_password_mode(lv_obj_t * obj, bool en)
         lv_label_set_text(ta->label, ta->pwd_tmp);
         lv_mem_free(ta->pwd_tmp);
         ta->pwd_tmp = NULL;
+        ta->pwd_tmp_size = 0;
     }
 
     refr_cursor_area(obj);
@@ -811,6 +800,7 @@ static void lv_textarea_constructor(const lv_obj_class_t * class_p, lv_obj_t * o
 
     ta->pwd_mode          = 0;
     ta->pwd_tmp           = NULL;
+    ta->pwd_tmp_size      = 0;
     ta->pwd_bullet        = NULL;
     ta->pwd_show_time     = LV_TEXTAREA_DEF_PWD_SHOW_TIME;
     ta->accepted_chars    = NULL;
@@ -1358,6 +1348,27 @@ static void auto_hide_characters(lv_obj_t * obj)
     }
 }
 
+/**
+ * Make sure `pwd_tmp` has space for a text of `len` bytes (without the closing '\0').
+ * Grow it geometrically to not reallocate and copy the password on every new character.
+ * @param obj       pointer to a text area object
+ * @param len       length of the text to store
+ * @return          true: there is enough space; false: out of memory
+ */
+static bool pwd_tmp_reserve(lv_obj_t * obj, size_t len)
+{
+    lv_textarea_t * ta = (lv_textarea_t *) obj;
+    if(len + 1 <= ta->pwd_tmp_size) return true;
+
+    size_t size = LV_MAX(len + 1, ta->pwd_tmp_size + ta->pwd_tmp_size / 2);
+    ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, size);
+    LV_ASSERT_MALLOC(ta->pwd_tmp);
+    if(ta->pwd_tmp == NULL) return false;
+
+    ta->pwd_tmp_size = size;
+    return true;
+}
+
 static inline bool is_valid_but_non_printable_char(const uint32_t letter)
 {
     if(letter == '\0' || letter == '\n' || letter == '\r') {
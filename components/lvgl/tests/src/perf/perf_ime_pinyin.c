@@ -0,0 +1,300 @@
+/**
+ * @file perf_ime_pinyin.c
+ *
+ * Compare the pinyin lookup of the IME (LV_USE_IME_PINYIN) with the linear search it replaced,
+ * typing every prefix of every pinyin of the default dictionary.
+ * Not part of the test suite, run `perf_ime_pinyin` from the build directory.
+ */
+
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../lv_test_init.h"
+
+/*Unity is linked with the test helpers, it needs these*/
+void setUp(void) {}
+void tearDown(void) {}
+
+#if LV_USE_IME_PINYIN && LV_IME_PINYIN_USE_DEFAULT_DICT && LV_IME_PINYIN_USE_K9_MODE
+
+#define SEARCH_ROUNDS   50
+#define PRESS_ROUNDS    2
+#define BUILD_ROUNDS    100
+
+static const char * k9_py_map[8] = {"abc", "def", "ghi", "jkl", "mno", "pqrs", "tuv", "wxyz"};
+static const char * k9_btn_txt[8] = {"abc ", "def", "ghi", "jkl", "mno", "pqrs", "tuv", "wxyz"};
+
+static lv_pinyin_dict_t * dict;
+static uint32_t dict_cnt;
+
+/*The number of found pinyins, printed so the searches can't be optimized out*/
+static uint32_t found_cnt;
+
+/*---------------------------------------------------------------
+ * The linear search of the IME before the prefix tree
+ *--------------------------------------------------------------*/
+
+static uint16_t py_pos[26];
+static uint16_t py_num[26];
+
+static void linear_init(void)
+{
+    lv_memset_00(py_pos, sizeof(py_pos));
+    lv_memset_00(py_num, sizeof(py_num));
+
+    uint32_t i;
+    for(i = 0; i < dict_cnt; i++) {
+        uint8_t letter = dict[i].py[0] - 'a';
+        if(py_num[letter] == 0) py_pos[letter] = i;
+        py_num[letter]++;
+    }
+}
+
+static bool linear_search(const char * py_str)
+{
+    if(*py_str == '\0') return false;
+    if(*py_str == 'i') return false;
+    if(*py_str == 'u') return false;
+    if(*py_str == 'v') return false;
+
+    uint8_t offset = py_str[0] - 'a';
+    uint8_t len = strlen(py_str);
+    const lv_pinyin_dict_t * cpHZ = &dict[py_pos[offset]];
+    uint16_t count = py_num[offset];
+
+    while(count--) {
+        uint8_t index;
+        for(index = 0; index < len; index++) {
+            if(py_str[index] != cpHZ->py[index]) break;
+        }
+
+        if(len == 1 || index == len) return true;
+        cpHZ++;
+    }
+    return false;
+}
+
+/*Check every letter combination of the pressed keys*/
+static void linear_k9_search(const char * k9_input)
+{
+    uint32_t len = strlen(k9_input);
+    char py_comp[LV_IME_PINYIN_K9_MAX_INPUT] = {0};
+    uint8_t mark[LV_IME_PINYIN_K9_MAX_INPUT] = {0};
+    int32_t index = 0;
+
+    while(index != -1) {
+        if(index == (int32_t)len) {
+            if(linear_search(py_comp)) found_cnt++;
+            index--;
+        }
+        else {
+            const char * letters = k9_py_map[k9_input[index] - '2'];
+            if(mark[index] < strlen(letters)) {
+                py_comp[index] = letters[mark[index]];
+                mark[index]++;
+                index++;
+            }
+            else {
+                mark[index] = 0;
+                index--;
+            }
+        }
+    }
+}
+
+/*---------------------------------------------------------------
+ * The prefix tree built by the IME
+ *--------------------------------------------------------------*/
+
+static uint16_t tree_get_child(const lv_ime_pinyin_node_t * trie, uint16_t node, char c)
+{
+    uint16_t child;
+    for(child = trie[node].child; child != 0; child = trie[child].sibling) {
+        if(trie[child].c == c) return child;
+    }
+    return 0;
+}
+
+/*Walk the letters of the pressed keys and stop at the first letter without a node*/
+static void tree_k9_search(const lv_ime_pinyin_node_t * trie, const char * k9_input, uint16_t node)
+{
+    if(*k9_input == '\0') {
+        found_cnt++;
+        return;
+    }
+
+    const char * letters = k9_py_map[*k9_input - '2'];
+    for(; *letters != '\0'; letters++) {
+        uint16_t child = tree_get_child(trie, node, *letters);
+        if(child != 0) tree_k9_search(trie, k9_input + 1, child);
+    }
+}
+
+static uint32_t tree_node_cnt(const lv_ime_pinyin_node_t * trie, uint16_t node)
+{
+    uint32_t cnt = 1;
+    uint16_t child;
+    for(child = trie[node].child; child != 0; child = trie[child].sibling) {
+        cnt += tree_node_cnt(trie, child);
+    }
+    return cnt;
+}
+
+/*---------------------------------------------------------------
+ * Benchmarks
+ *--------------------------------------------------------------*/
+
+static void to_k9(char * k9_input, const char * py_str, uint32_t len)
+{
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t k;
+        for(k = 0; strchr(k9_py_map[k], py_str[i]) == NULL; k++);
+        k9_input[i] = '2' + k;
+    }
+    k9_input[len] = '\0';
+}
+
+/**
+ * Search every prefix of the pinyins `SEARCH_ROUNDS` times.
+ * Like in the IME, the 26-key search in the tree steps one node from the previous prefix
+ * and the 9-key search starts from the root on each key.
+ */
+static uint32_t search_all(const lv_ime_pinyin_node_t * trie, bool k9)
+{
+    uint32_t t = custom_tick_get();
+    uint32_t round;
+    for(round = 0; round < SEARCH_ROUNDS; round++) {
+        uint32_t i;
+        for(i = 0; i < dict_cnt; i++) {
+            uint16_t node = 0;
+            uint32_t len;
+            for(len = 1; len <= strlen(dict[i].py); len++) {
+                char prefix[LV_IME_PINYIN_K9_MAX_INPUT];
+                if(k9) {
+                    to_k9(prefix, dict[i].py, len);
+                    if(trie) tree_k9_search(trie, prefix, 0);
+                    else linear_k9_search(prefix);
+                }
+                else if(trie) {
+                    node = tree_get_child(trie, node, dict[i].py[len - 1]);
+                    if(node != 0) found_cnt++;
+                }
+                else {
+                    lv_memcpy(prefix, dict[i].py, len);
+                    prefix[len] = '\0';
+                    if(linear_search(prefix)) found_cnt++;
+                }
+            }
+        }
+    }
+    return custom_tick_get() - t;
+}
+
+static uint16_t find_btn(lv_obj_t * kb, const char * txt)
+{
+    uint16_t i;
+    for(i = 0; i < ((lv_btnmatrix_t *)kb)->btn_cnt; i++) {
+        if(strcmp(lv_btnmatrix_get_btn_text(kb, i), txt) == 0) return i;
+    }
+    return LV_BTNMATRIX_BTN_NONE;
+}
+
+static void press(lv_obj_t * kb, uint16_t btn_id)
+{
+    lv_btnmatrix_set_selected_btn(kb, btn_id);
+    lv_event_send(kb, LV_EVENT_VALUE_CHANGED, NULL);
+}
+
+/*Type every pinyin letter by letter on the keyboard of the IME, so it's looked up after each key*/
+static uint32_t press_all(lv_obj_t * kb, lv_obj_t * ta, bool k9)
+{
+    uint16_t letter_btns[26];
+    uint16_t done_btn = find_btn(kb, k9 ? LV_SYMBOL_NEW_LINE : LV_SYMBOL_OK);
+    uint32_t i;
+    for(i = 0; i < 26; i++) {
+        if(k9) {
+            uint32_t k;
+            for(k = 0; strchr(k9_py_map[k], 'a' + i) == NULL; k++);
+            letter_btns[i] = find_btn(kb, k9_btn_txt[k]);
+        }
+        else {
+            char txt[2] = {'a' + i, '\0'};
+            letter_btns[i] = find_btn(kb, txt);
+        }
+    }
+
+    uint32_t t = custom_tick_get();
+    uint32_t round;
+    for(round = 0; round < PRESS_ROUNDS; round++) {
+        for(i = 0; i < dict_cnt; i++) {
+            const char * py;
+            for(py = dict[i].py; *py != '\0'; py++) {
+                press(kb, letter_btns[*py - 'a']);
+            }
+            press(kb, done_btn);
+            lv_textarea_set_text(ta, "");
+        }
+    }
+    return custom_tick_get() - t;
+}
+
+int main(void)
+{
+    lv_test_init();
+
+    lv_obj_t * ta = lv_textarea_create(lv_scr_act());
+    lv_obj_t * ime = lv_ime_pinyin_create(lv_scr_act());
+    lv_obj_t * kb = lv_keyboard_create(lv_scr_act());
+    lv_ime_pinyin_set_keyboard(ime, kb);
+    lv_keyboard_set_textarea(kb, ta);
+
+    dict = lv_ime_pinyin_get_dict(ime);
+    for(dict_cnt = 0; dict[dict_cnt].py != NULL && dict[dict_cnt].py_mb != NULL; dict_cnt++);
+
+    uint32_t t_build = custom_tick_get();
+    uint32_t round;
+    for(round = 0; round < BUILD_ROUNDS; round++) {
+        lv_ime_pinyin_set_dict(ime, dict);
+    }
+    t_build = custom_tick_get() - t_build;
+
+    const lv_ime_pinyin_node_t * trie = ((lv_ime_pinyin_t *)ime)->trie;
+    uint32_t node_cnt = tree_node_cnt(trie, 0);
+
+    printf("%d pinyins in the dictionary, every prefix is typed\n", (int)dict_cnt);
+    printf("prefix tree: %d nodes, %d bytes, %d builds take %d ms\n\n", (int)node_cnt,
+           (int)(node_cnt * sizeof(lv_ime_pinyin_node_t)), BUILD_ROUNDS, (int)t_build);
+
+    printf("The searches run %d rounds, the key presses %d rounds\n", SEARCH_ROUNDS, PRESS_ROUNDS);
+    printf("mode   | linear search [ms] | prefix tree search [ms] | key presses [ms]\n");
+
+    linear_init();
+    uint32_t t_linear = search_all(NULL, false);
+    uint32_t t_tree = search_all(trie, false);
+    uint32_t t_press = press_all(kb, ta, false);
+    printf("26-key | %18d | %23d | %16d\n", (int)t_linear, (int)t_tree, (int)t_press);
+
+    lv_ime_pinyin_set_mode(ime, LV_IME_PINYIN_MODE_K9);
+    t_linear = search_all(NULL, true);
+    t_tree = search_all(trie, true);
+    t_press = press_all(kb, ta, true);
+    printf("9-key  | %18d | %23d | %16d\n", (int)t_linear, (int)t_tree, (int)t_press);
+
+    printf("\n(%d pinyins found)\n", (int)found_cnt);
+
+    lv_obj_clean(lv_scr_act());
+    lv_test_deinit();
+    return 0;
+}
+
+#else /*LV_USE_IME_PINYIN && LV_IME_PINYIN_USE_DEFAULT_DICT && LV_IME_PINYIN_USE_K9_MODE*/
+
+int main(void)
+{
+    printf("LV_USE_IME_PINYIN with LV_IME_PINYIN_USE_DEFAULT_DICT and LV_IME_PINYIN_USE_K9_MODE is not enabled\n");
+    return 0;
+}
+
+#endif /*LV_USE_IME_PINYIN && LV_IME_PINYIN_USE_DEFAULT_DICT && LV_IME_PINYIN_USE_K9_MODE*/
+
+#endif /*LV_BUILD_TEST*/
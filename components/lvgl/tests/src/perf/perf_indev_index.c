@@ -0,0 +1,110 @@
+/**
+ * @file perf_indev_index.c
+ *
+ * Compare the pointer search with and without the hit-test index (LV_USE_INDEV_INDEX).
+ * Not part of the test suite, run `perf_indev_index` from the build directory.
+ */
+
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../lv_test_init.h"
+
+/*Unity is linked with the test helpers, it needs these*/
+void setUp(void) {}
+void tearDown(void) {}
+
+#if LV_USE_INDEV_INDEX
+
+#define LOOKUP_STEP     13
+#define LOOKUP_CNT      ((800 / LOOKUP_STEP + 1) * (480 / LOOKUP_STEP + 1))
+#define ROUNDS          5
+
+static void search_all(void)
+{
+    lv_coord_t x, y;
+    for(y = 0; y < 480; y += LOOKUP_STEP) {
+        for(x = 0; x < 800; x += LOOKUP_STEP) {
+            lv_point_t p = {x, y};
+            lv_indev_search_obj(lv_scr_act(), &p);
+        }
+    }
+}
+
+static lv_obj_t * create_dense_screen(uint32_t btn_cnt)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(cont, 2, 0);
+    lv_obj_set_style_pad_gap(cont, 0, 0);
+
+    uint32_t i;
+    for(i = 0; i < btn_cnt; i++) {
+        lv_obj_t * btn = lv_btn_create(cont);
+        lv_obj_set_size(btn, 36, 22);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "%d", (int)i);
+    }
+
+    lv_obj_update_layout(lv_scr_act());
+    return cont;
+}
+
+/**
+ * Time `ROUNDS` rounds of a scroll followed by a lookup on every point of a grid. The scroll moves all the buttons,
+ * so with the index it measures the updates of the moved objects too.
+ */
+static uint32_t scroll_and_search(lv_obj_t * cont)
+{
+    uint32_t t = custom_tick_get();
+    uint32_t round;
+    for(round = 0; round < ROUNDS; round++) {
+        lv_obj_scroll_by(cont, 0, round % 2 ? 10 : -10, LV_ANIM_OFF);
+        search_all();
+    }
+    return custom_tick_get() - t;
+}
+
+int main(void)
+{
+    lv_test_init();
+
+    printf("%d rounds of a scroll and %d lookups\n", ROUNDS, LOOKUP_CNT);
+    printf("objects | tree walk [ms] | index build + first lookup [ms] | index [ms]\n");
+
+    static const uint32_t cnts[] = {100, 400, 1600};
+    uint32_t c;
+    for(c = 0; c < sizeof(cnts) / sizeof(cnts[0]); c++) {
+        lv_obj_t * cont = create_dense_screen(cnts[c]);
+
+        uint32_t t_walk = scroll_and_search(cont);
+
+        lv_indev_index_enable(lv_scr_act(), true);
+        uint32_t t_build = custom_tick_get();
+        lv_point_t p = {0, 0};
+        lv_indev_search_obj(lv_scr_act(), &p);
+        t_build = custom_tick_get() - t_build;
+
+        uint32_t t_index = scroll_and_search(cont);
+
+        printf("%7d | %14d | %31d | %10d\n", (int)cnts[c] * 2 + 1, (int)t_walk, (int)t_build, (int)t_index);
+
+        lv_indev_index_enable(lv_scr_act(), false);
+        lv_obj_clean(lv_scr_act());
+    }
+
+    lv_test_deinit();
+    return 0;
+}
+
+#else /*LV_USE_INDEV_INDEX*/
+
+int main(void)
+{
+    printf("LV_USE_INDEV_INDEX is not enabled\n");
+    return 0;
+}
+
+#endif /*LV_USE_INDEV_INDEX*/
+
+#endif /*LV_BUILD_TEST*/
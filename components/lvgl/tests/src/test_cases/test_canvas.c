@@ -0,0 +1,211 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#define CANVAS_W    200
+#define CANVAS_H    150
+#define INV_MARGIN  5
+
+static lv_color_t buf1[LV_CANVAS_BUF_SIZE_TRUE_COLOR(CANVAS_W, CANVAS_H)];
+static lv_color_t buf2[LV_CANVAS_BUF_SIZE_TRUE_COLOR(CANVAS_W, CANVAS_H)];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+static lv_obj_t * canvas_create(lv_color_t * buf, lv_img_cf_t cf)
+{
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, buf, CANVAS_W, CANVAS_H, cf);
+    lv_canvas_fill_bg(canvas, lv_palette_lighten(LV_PALETTE_GREY, 3), LV_OPA_COVER);
+    return canvas;
+}
+
+/*A plot, a grid, some shapes, text and pixels*/
+static void draw_primitives(lv_obj_t * canvas)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.radius = 5;
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_RED);
+    rect_dsc.border_width = 2;
+    rect_dsc.outline_width = 3;
+    rect_dsc.outline_pad = 2;
+    rect_dsc.outline_color = lv_palette_main(LV_PALETTE_BLUE);
+    rect_dsc.shadow_width = 15;
+    rect_dsc.shadow_ofs_x = 5;
+    rect_dsc.shadow_ofs_y = 8;
+    lv_canvas_draw_rect(canvas, 20, 20, 50, 30, &rect_dsc);
+
+    /*Transparent color on a chroma keyed canvas disables anti-aliasing only for this primitive*/
+    rect_dsc.bg_color = LV_COLOR_CHROMA_KEY;
+    rect_dsc.outline_width = 0;
+    rect_dsc.shadow_width = 0;
+    lv_canvas_draw_rect(canvas, 100, 10, 40, 40, &rect_dsc);
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.color = lv_palette_main(LV_PALETTE_GREEN);
+    line_dsc.width = 1;
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_point_t grid[2] = {{i * 20, 0}, {i * 20, CANVAS_H - 1}};
+        lv_canvas_draw_line(canvas, grid, 2, &line_dsc);
+    }
+
+    static lv_point_t plot[100];
+    for(i = 0; i < 100; i++) {
+        plot[i].x = i * 2;
+        plot[i].y = 100 + lv_trigo_sin(i * 10) / 1000;
+    }
+    line_dsc.width = 3;
+    line_dsc.round_end = 1;
+    line_dsc.color = lv_palette_main(LV_PALETTE_INDIGO);
+    lv_canvas_draw_line(canvas, plot, 100, &line_dsc);
+
+    lv_point_t poly[] = {{150, 60}, {190, 70}, {170, 110}, {140, 90}};
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_ORANGE);
+    rect_dsc.radius = 0;
+    rect_dsc.border_width = 0;
+    lv_canvas_draw_polygon(canvas, poly, 4, &rect_dsc);
+
+    lv_draw_arc_dsc_t arc_dsc;
+    lv_draw_arc_dsc_init(&arc_dsc);
+    arc_dsc.color = lv_palette_main(LV_PALETTE_PURPLE);
+    arc_dsc.width = 6;
+    lv_canvas_draw_arc(canvas, 120, 120, 20, 0, 270, &arc_dsc);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_canvas_draw_text(canvas, 10, 125, 100, &label_dsc, "Batched text");
+
+    for(i = 0; i < 50; i++) {
+        lv_canvas_set_px_color(canvas, 60 + i, 70 + i / 2, lv_color_black());
+    }
+}
+
+void test_canvas_batch_draws_the_same(void)
+{
+    lv_img_cf_t cfs[] = {LV_IMG_CF_TRUE_COLOR, LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED};
+    uint32_t i;
+    for(i = 0; i < sizeof(cfs) / sizeof(cfs[0]); i++) {
+        lv_obj_t * canvas1 = canvas_create(buf1, cfs[i]);
+        lv_obj_t * canvas2 = canvas_create(buf2, cfs[i]);
+
+        draw_primitives(canvas1);
+
+        lv_canvas_draw_begin(canvas2);
+        draw_primitives(canvas2);
+        lv_canvas_draw_end(canvas2);
+
+        TEST_ASSERT_EQUAL_MEMORY(buf1, buf2, sizeof(buf1));
+
+        lv_obj_del(canvas1);
+        lv_obj_del(canvas2);
+    }
+}
+
+void test_canvas_batch_invalidates_the_drawn_area_at_the_end(void)
+{
+    lv_obj_t * canvas = canvas_create(buf1, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_set_pos(canvas, 100, 50);
+    lv_obj_set_style_pad_all(canvas, 10, 0);
+    lv_obj_set_style_border_width(canvas, 3, 0);
+    lv_obj_set_style_bg_opa(canvas, LV_OPA_COVER, 0);
+    lv_refr_now(NULL);
+
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+
+    lv_canvas_draw_begin(canvas);
+    lv_canvas_draw_rect(canvas, 10, 20, 30, 40, &rect_dsc);
+    lv_canvas_draw_begin(canvas);
+    lv_canvas_set_px_color(canvas, 60, 70, lv_color_black());
+    lv_canvas_draw_end(canvas);
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+    lv_canvas_draw_end(canvas);
+
+    /*Only the union of the drawn areas is invalidated (with the margin of the object invalidation)*/
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    TEST_ASSERT_EQUAL_INT(100 + 13 + 10 - INV_MARGIN, disp->inv_areas[0].x1);
+    TEST_ASSERT_EQUAL_INT(50 + 13 + 20 - INV_MARGIN, disp->inv_areas[0].y1);
+    TEST_ASSERT_EQUAL_INT(100 + 13 + 60 + INV_MARGIN, disp->inv_areas[0].x2);
+    TEST_ASSERT_EQUAL_INT(50 + 13 + 70 + INV_MARGIN, disp->inv_areas[0].y2);
+    lv_refr_now(NULL);
+
+    /*A zoomed canvas is invalidated entirely*/
+    lv_img_set_zoom(canvas, 512);
+    lv_refr_now(NULL);
+    lv_canvas_set_px_color(canvas, 0, 0, lv_color_black());
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    TEST_ASSERT_TRUE(lv_area_get_width(&disp->inv_areas[0]) > CANVAS_W);
+    lv_refr_now(NULL);
+}
+
+void test_canvas_batch_invalidates_everything_drawn(void)
+{
+    lv_obj_t * canvas = canvas_create(buf1, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_set_pos(canvas, 300, 200);
+    lv_obj_set_style_pad_all(canvas, INV_MARGIN * 2, 0);
+    lv_refr_now(NULL);
+    memcpy(buf2, buf1, sizeof(buf1));
+
+    lv_canvas_draw_begin(canvas);
+    draw_primitives(canvas);
+    lv_canvas_draw_end(canvas);
+
+    /*All the changed pixels are in the invalidated area*/
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    lv_area_t inv_area = disp->inv_areas[0];
+    lv_area_move(&inv_area, -300 - INV_MARGIN * 2, -200 - INV_MARGIN * 2);
+    lv_area_increase(&inv_area, -INV_MARGIN, -INV_MARGIN);
+    lv_coord_t x;
+    lv_coord_t y;
+    uint32_t changed_cnt = 0;
+    for(y = 0; y < CANVAS_H; y++) {
+        for(x = 0; x < CANVAS_W; x++) {
+            if(buf1[y * CANVAS_W + x].full != buf2[y * CANVAS_W + x].full) {
+                lv_point_t p = {x, y};
+                TEST_ASSERT_TRUE(_lv_area_is_point_on(&inv_area, &p, 0));
+                changed_cnt++;
+            }
+        }
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(1000, changed_cnt);
+}
+
+void test_canvas_batch_del_while_open(void)
+{
+    uint32_t free_mem = lv_test_get_free_mem();
+
+    lv_obj_t * canvas = canvas_create(buf1, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_draw_begin(canvas);
+    draw_primitives(canvas);
+
+    /*Changing the buffer in a batch draws to the new buffer*/
+    lv_canvas_set_buffer(canvas, buf2, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_color_black();
+    lv_canvas_draw_rect(canvas, 0, 0, 10, 10, &rect_dsc);
+    TEST_ASSERT_EQUAL_UINT32(lv_color_black().full, lv_canvas_get_px(canvas, 5, 5).full);
+
+    lv_obj_del(canvas);
+    TEST_ASSERT_EQUAL_UINT32(free_mem, lv_test_get_free_mem());
+}
+
+#endif
@@ -0,0 +1,115 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <string.h>
+
+#if LV_DRAW_COMPLEX
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+
+/*Rounded rectangles and arcs with much more radii than the cache size*/
+static void create_scene(void)
+{
+    uint32_t i;
+    for(i = 0; i < 24; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_set_size(obj, 110, 70);
+        lv_obj_set_pos(obj, (i % 6) * 130 + 10, (i / 6) * 85 + 10);
+        lv_obj_set_style_radius(obj, 3 + i * 2, 0);
+        lv_obj_set_style_border_width(obj, 0, 0);
+        lv_obj_set_style_bg_opa(obj, i % 3 == 0 ? LV_OPA_50 : LV_OPA_COVER, 0);
+        if(i % 4 == 1) {
+            lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+            lv_obj_set_style_bg_grad_dir(obj, i % 8 == 1 ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER, 0);
+        }
+    }
+
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * arc = lv_arc_create(lv_scr_act());
+        lv_obj_set_size(arc, 60 + i * 30, 60 + i * 30);
+        lv_obj_set_pos(arc, 10 + i * 190, 350);
+        lv_arc_set_value(arc, 30 + i * 20);
+    }
+}
+
+static void get_mask(lv_opa_t * buf, lv_coord_t radius)
+{
+    lv_area_t a = {0, 0, 99, 59};
+    lv_draw_mask_radius_param_t param;
+    lv_draw_mask_radius_init(&param, &a, radius, false);
+    int16_t id = lv_draw_mask_add(&param, NULL);
+
+    lv_coord_t y;
+    for(y = 0; y < 60; y++) {
+        lv_memset_ff(&buf[y * 100], 100);
+        lv_draw_mask_apply(&buf[y * 100], 0, y, 100);
+    }
+
+    lv_draw_mask_remove_id(id);
+}
+
+#endif /*LV_DRAW_COMPLEX*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_circle_cache_many_radii(void)
+{
+#if LV_DRAW_COMPLEX
+    create_scene();
+
+    lv_test_render();
+    memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*With the circles cached in the previous refresh*/
+    lv_test_render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    _lv_draw_mask_cleanup();
+    lv_test_render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+#endif
+}
+
+void test_circle_cache_preset(void)
+{
+#if LV_DRAW_COMPLEX
+    static lv_opa_t ref_mask[100 * 60];
+    static lv_opa_t mask[100 * 60];
+
+    get_mask(ref_mask, 27);
+    lv_draw_mask_circle_preset_add(27);
+    get_mask(mask, 27);
+    TEST_ASSERT_EQUAL_MEMORY(ref_mask, mask, sizeof(mask));
+
+    /*The same shared circle is used every time*/
+    lv_area_t a = {0, 0, 99, 59};
+    lv_draw_mask_radius_param_t param1;
+    lv_draw_mask_radius_param_t param2;
+    lv_draw_mask_radius_init(&param1, &a, 27, false);
+    lv_draw_mask_radius_init(&param2, &a, 27, true);
+    TEST_ASSERT_EQUAL_PTR(param1.circle, param2.circle);
+    lv_draw_mask_free_param(&param1);
+    lv_draw_mask_free_param(&param2);
+
+    get_mask(mask, 27);
+    TEST_ASSERT_EQUAL_MEMORY(ref_mask, mask, sizeof(mask));
+#endif
+}
+
+#endif
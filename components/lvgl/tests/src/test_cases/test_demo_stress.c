@@ -18,7 +18,8 @@ void test_demo_stress(void)
 #if LV_USE_DEMO_STRESS
     lv_demo_stress();
 #endif
-    /* loop once to allow objects to be created */
+    /* loop twice to allow objects to be created and the caches and the object pool to settle */
+    loop_through_stress_test();
     loop_through_stress_test();
     uint32_t mem_before = lv_test_get_free_mem();
     /* loop 10 more times */
@@ -0,0 +1,187 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <string.h>
+
+#if LV_USE_DRAW_REC
+
+#define HOR_RES     800
+#define VER_RES     480
+#define BUF_ROWS    40
+
+static lv_color_t fb[HOR_RES * VER_RES];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static lv_color_t part_buf[HOR_RES * BUF_ROWS];
+static lv_disp_draw_buf_t part_draw_buf;
+
+static lv_disp_drv_t * driver;
+static lv_disp_draw_buf_t * draw_buf_ori;
+static void (*flush_cb_ori)(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void create_scene(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_grad_color(scr, lv_palette_main(LV_PALETTE_TEAL), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    /*Its children are clipped with a radius mask*/
+    lv_obj_t * cont = lv_obj_create(scr);
+    lv_obj_set_size(cont, 300, 400);
+    lv_obj_set_pos(cont, 20, 40);
+    lv_obj_set_style_radius(cont, 40, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_set_style_shadow_width(cont, 30, 0);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * btn = lv_btn_create(cont);
+        lv_obj_set_width(btn, lv_pct(100));
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, LV_SYMBOL_AUDIO " Item %"LV_PRIu32, i);
+    }
+
+    lv_obj_t * arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, 220, 220);
+    lv_obj_set_pos(arc, 360, 30);
+    lv_arc_set_value(arc, 65);
+
+    lv_obj_t * slider = lv_slider_create(scr);
+    lv_obj_set_width(slider, 300);
+    lv_obj_set_pos(slider, 380, 300);
+    lv_slider_set_value(slider, 40, LV_ANIM_OFF);
+
+    static lv_point_t line_points[] = {{0, 0}, {100, 130}, {200, 20}, {350, 120}};
+    lv_obj_t * line = lv_line_create(scr);
+    lv_line_set_points(line, line_points, 4);
+    lv_obj_set_pos(line, 400, 330);
+    lv_obj_set_style_line_width(line, 6, 0);
+
+    lv_obj_t * label = lv_label_create(scr);
+    lv_label_set_text(label, "A label over\nmore buffer parts\nwith " LV_SYMBOL_OK " symbols");
+    lv_obj_set_pos(label, 620, 50);
+    lv_obj_set_style_text_line_space(label, 25, 0);
+
+    lv_obj_t * img = lv_img_create(scr);
+    lv_img_set_src(img, LV_SYMBOL_SETTINGS);
+    lv_obj_set_pos(img, 650, 250);
+}
+
+#endif /*LV_USE_DRAW_REC*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_USE_DRAW_REC
+    driver = lv_disp_get_default()->driver;
+    draw_buf_ori = driver->draw_buf;
+    flush_cb_ori = driver->flush_cb;
+
+    /*Render in parts of `BUF_ROWS` rows*/
+    lv_disp_draw_buf_init(&part_draw_buf, part_buf, NULL, HOR_RES * BUF_ROWS);
+    driver->draw_buf = &part_draw_buf;
+    driver->flush_cb = flush_cb;
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+#if LV_USE_DRAW_REC
+    driver->draw_buf = draw_buf_ori;
+    driver->flush_cb = flush_cb_ori;
+    lv_draw_rec_enable(true);
+#endif
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_rec_same_as_direct(void)
+{
+#if LV_USE_DRAW_REC
+    create_scene();
+
+    lv_draw_rec_enable(false);
+    lv_test_render();
+    memcpy(ref_fb, fb, sizeof(ref_fb));
+
+    lv_draw_rec_stats_t stats;
+    lv_draw_rec_get_stats(&stats);
+    uint32_t fail_cnt = stats.fail_cnt;
+
+    lv_draw_rec_enable(true);
+    memset(fb, 0, sizeof(fb));
+    lv_test_render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, fb, sizeof(ref_fb));
+
+    /*Recorded once, replayed for each part*/
+    lv_draw_rec_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(fail_cnt, stats.fail_cnt);
+    TEST_ASSERT_EQUAL_UINT32(VER_RES / BUF_ROWS, stats.replay_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.cmd_cnt);
+#endif
+}
+
+void test_draw_rec_partial_area(void)
+{
+#if LV_USE_DRAW_REC
+    create_scene();
+    lv_draw_rec_enable(false);
+    lv_test_render();
+    memcpy(ref_fb, fb, sizeof(ref_fb));
+
+    /*Invalidate only some rows of the screen crossing more buffer parts*/
+    lv_draw_rec_enable(true);
+    lv_area_t a = {0, 70, HOR_RES - 1, 310};
+    lv_obj_invalidate_area(lv_scr_act(), &a);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, fb, sizeof(ref_fb));
+
+    lv_draw_rec_stats_t stats;
+    lv_draw_rec_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32((310 - 70 + BUF_ROWS) / BUF_ROWS, stats.replay_cnt);
+#endif
+}
+
+void test_draw_rec_too_many_commands(void)
+{
+#if LV_USE_DRAW_REC
+    /*Each letter is a command: a long text doesn't fit into the command list*/
+    static char txt[4001];
+    memset(txt, 'x', sizeof(txt) - 1);
+    txt[sizeof(txt) - 1] = '\0';
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, HOR_RES);
+    lv_label_set_text_static(label, txt);
+
+    lv_draw_rec_enable(false);
+    lv_test_render();
+    memcpy(ref_fb, fb, sizeof(ref_fb));
+
+    lv_draw_rec_stats_t stats;
+    lv_draw_rec_get_stats(&stats);
+    uint32_t fail_cnt = stats.fail_cnt;
+
+    /*Drawn directly instead*/
+    lv_draw_rec_enable(true);
+    lv_test_render();
+    lv_draw_rec_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(fail_cnt + 1, stats.fail_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, fb, sizeof(ref_fb));
+#endif
+}
+
+#endif
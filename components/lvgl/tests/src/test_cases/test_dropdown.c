@@ -50,6 +50,7 @@ void test_dropdown_create_delete(void)
 void test_dropdown_set_options(void)
 {
 
+    lv_obj_pool_flush();
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
 
@@ -107,6 +108,7 @@ void test_dropdown_set_options(void)
     TEST_ASSERT_EQUAL(0, lv_dropdown_get_option_cnt(dd1));
 
     lv_obj_del(dd1);
+    lv_obj_pool_flush();
 
     lv_mem_monitor_t m2;
     lv_mem_monitor(&m2);
@@ -134,6 +136,44 @@ void test_dropdown_select(void)
     TEST_ASSERT_EQUAL(2, lv_dropdown_get_selected(dd1));
 }
 
+void test_dropdown_option_index(void)
+{
+    lv_obj_t * dd1 = lv_dropdown_create(lv_scr_act());
+    lv_dropdown_set_options(dd1, "a1\nb2\n\nd4");
+    TEST_ASSERT_EQUAL(0, lv_dropdown_get_option_index(dd1, "a1"));
+    TEST_ASSERT_EQUAL(1, lv_dropdown_get_option_index(dd1, "b2"));
+    TEST_ASSERT_EQUAL(3, lv_dropdown_get_option_index(dd1, "d4"));
+    TEST_ASSERT_EQUAL(-1, lv_dropdown_get_option_index(dd1, "x"));
+
+    lv_dropdown_add_option(dd1, "c3", 2);
+    TEST_ASSERT_EQUAL(2, lv_dropdown_get_option_index(dd1, "c3"));
+    TEST_ASSERT_EQUAL(4, lv_dropdown_get_option_index(dd1, "d4"));
+
+    char buf[8];
+    lv_dropdown_set_selected(dd1, 4);
+    lv_dropdown_get_selected_str(dd1, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("d4", buf);
+    lv_dropdown_set_selected(dd1, 3);
+    lv_dropdown_get_selected_str(dd1, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("", buf);
+
+    /*The list follows the options while open*/
+    lv_dropdown_open(dd1);
+    lv_obj_update_layout(dd1);
+    lv_obj_t * label = lv_obj_get_child(lv_dropdown_get_list(dd1), 0);
+    lv_coord_t h = lv_obj_get_height(label);
+    lv_dropdown_add_option(dd1, "e5", LV_DROPDOWN_POS_LAST);
+    lv_obj_update_layout(label);
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(label, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_INT(h + lv_font_get_line_height(font) + line_space, lv_obj_get_height(label));
+
+    lv_dropdown_clear_options(dd1);
+    TEST_ASSERT_EQUAL(-1, lv_dropdown_get_option_index(dd1, "a1"));
+    lv_dropdown_get_selected_str(dd1, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("", buf);
+}
+
 void test_dropdown_click(void)
 {
     lv_obj_clean(lv_scr_act());
@@ -441,5 +481,40 @@ void test_dropdown_should_list_on_top(void)
     TEST_ASSERT_EQUAL_INT(2, lv_obj_get_index(list));
 }
 
+void test_dropdown_render_many_options(void)
+{
+    static char opts[1000 * 12];
+    uint32_t i;
+    char * p = opts;
+    for(i = 0; i < 1000; i++) {
+        p += lv_snprintf(p, sizeof(opts) - (p - opts), i == 0 ? "Item %d" : "\nItem %d", i);
+    }
+
+    lv_obj_t * dd1 = lv_dropdown_create(lv_scr_act());
+    lv_dropdown_set_options_static(dd1, opts);
+    lv_dropdown_set_selected(dd1, 600);
+    lv_obj_set_pos(dd1, 10, 10);
+    lv_dropdown_open(dd1);
+
+    lv_obj_t * dd2 = lv_dropdown_create(lv_scr_act());
+    lv_dropdown_set_options(dd2, opts);
+    lv_dropdown_set_selected(dd2, 998);
+    lv_obj_set_pos(dd2, 250, 10);
+    lv_obj_t * list = lv_dropdown_get_list(dd2);
+    lv_obj_set_style_text_line_space(list, 8, 0);
+    lv_obj_set_style_text_align(list, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_dropdown_open(dd2);
+
+    /*Press an option to highlight it*/
+    lv_obj_update_layout(list);
+    lv_test_mouse_move_to(list->coords.x1 + 20, list->coords.y1 + 60);
+    lv_test_mouse_press();
+    lv_test_indev_wait(50);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("dropdown_3.png");
+
+    lv_test_mouse_release();
+    lv_test_indev_wait(50);
+}
 
 #endif
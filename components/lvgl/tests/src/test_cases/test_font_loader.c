@@ -25,11 +25,16 @@
  **********************/
 
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void compare_glyph_bitmaps(lv_font_t * f1, lv_font_t * f2);
+static void compare_rendering(lv_font_t * f1, lv_font_t * f2);
 void test_font_loader(void);
+void test_font_loader_paged(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint8_t bitmap_buf[4096];
+static lv_color_t fb_ref[800 * 480];
 
 /**********************
  *      MACROS
@@ -42,6 +47,7 @@ void test_font_loader(void);
 extern lv_font_t font_1;
 extern lv_font_t font_2;
 extern lv_font_t font_3;
+extern lv_color_t test_fb[];
 
 void test_font_loader(void)
 {
@@ -72,6 +78,85 @@ void test_font_loader(void)
     lv_font_free(font_3_bin);
 }
 
+void test_font_loader_paged(void)
+{
+    /*Not more than a few bitmaps are cached*/
+    lv_font_t * font_1_bin = lv_font_load_paged("A:src/test_fonts/font_1.fnt", 300);
+    lv_font_t * font_2_bin = lv_font_load_paged("B:src/test_fonts/font_2.fnt", 300);
+    lv_font_t * font_3_bin = lv_font_load_paged("A:src/test_fonts/font_3.fnt", 0);
+
+    TEST_ASSERT_NOT_NULL(font_1_bin);
+    TEST_ASSERT_NOT_NULL(font_2_bin);
+    TEST_ASSERT_NOT_NULL(font_3_bin);
+
+    compare_glyph_bitmaps(&font_1, font_1_bin);
+    compare_glyph_bitmaps(&font_2, font_2_bin);
+    compare_glyph_bitmaps(&font_3, font_3_bin);
+
+    /*Drawn from the paged cache the letters look the same*/
+    compare_rendering(&font_1, font_1_bin);
+    compare_rendering(&font_2, font_2_bin);
+
+    lv_font_free(font_1_bin);
+    lv_font_free(font_2_bin);
+    lv_font_free(font_3_bin);
+}
+
+static void compare_glyph_bitmaps(lv_font_t * f1, lv_font_t * f2)
+{
+    lv_font_fmt_txt_dsc_t * dsc1 = (lv_font_fmt_txt_dsc_t *)f1->dsc;
+    lv_font_fmt_txt_dsc_t * dsc2 = (lv_font_fmt_txt_dsc_t *)f2->dsc;
+    TEST_ASSERT_NULL(dsc2->glyph_bitmap);
+
+    /*Go through the letters twice to read them from the cache and the file too*/
+    for(int pass = 0; pass < 2; pass++) {
+        for(int i = 0; i < dsc1->cmap_num; ++i) {
+            const lv_font_fmt_txt_cmap_t * cmap = &dsc1->cmaps[i];
+            uint32_t cnt = cmap->unicode_list ? cmap->list_length : cmap->range_length;
+            for(uint32_t k = 0; k < cnt; k++) {
+                uint32_t letter = cmap->range_start + (cmap->unicode_list ? cmap->unicode_list[k] : k);
+                lv_font_glyph_dsc_t g1;
+                lv_font_glyph_dsc_t g2;
+                TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(f1, &g1, letter, 0));
+                TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(f2, &g2, letter, 0));
+                TEST_ASSERT_EQUAL_INT(g1.adv_w, g2.adv_w);
+                TEST_ASSERT_EQUAL_INT(g1.box_w, g2.box_w);
+                TEST_ASSERT_EQUAL_INT(g1.box_h, g2.box_h);
+                TEST_ASSERT_EQUAL_INT(g1.ofs_x, g2.ofs_x);
+                TEST_ASSERT_EQUAL_INT(g1.ofs_y, g2.ofs_y);
+                if(g1.box_w * g1.box_h == 0) continue;
+
+                /*The decompressed bitmaps are in the same buffer*/
+                uint32_t size = (g1.box_w * g1.box_h * g1.bpp) / 8;
+                TEST_ASSERT_LESS_THAN(sizeof(bitmap_buf), size);
+                lv_memcpy(bitmap_buf, lv_font_get_glyph_bitmap(f1, letter), size);
+                const uint8_t * bitmap2 = lv_font_get_glyph_bitmap(f2, letter);
+                TEST_ASSERT_NOT_NULL(bitmap2);
+                TEST_ASSERT_EQUAL_MEMORY(bitmap_buf, bitmap2, size);
+            }
+        }
+    }
+}
+
+static void compare_rendering(lv_font_t * f1, lv_font_t * f2)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, lv_pct(100));
+    lv_label_set_text(label, "The quick brown fox jumps over the lazy dog. 0123456789\n"
+                      "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG! (+-*/=%)\n"
+                      "Pack my box with five dozen liquor jugs.");
+
+    lv_obj_set_style_text_font(label, f1, 0);
+    lv_refr_now(NULL);
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_obj_set_style_text_font(label, f2, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_obj_del(label);
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(f1, "font not null");
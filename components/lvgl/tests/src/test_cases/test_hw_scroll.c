@@ -0,0 +1,205 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <string.h>
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+/*A display with vertical scrolling: the rows of the scroll area are shown from a start row, wrapping around*/
+static lv_color_t gram[HOR_RES * VER_RES];
+static lv_color_t shown[HOR_RES * VER_RES];
+static lv_coord_t scroll_top;
+static lv_coord_t scroll_height = VER_RES;
+static lv_coord_t scroll_start;
+static uint32_t scroll_cnt;
+static uint32_t flush_px;
+
+static void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *);
+static lv_obj_t * list;
+
+static lv_coord_t gram_row(lv_coord_t y)
+{
+    if(y < scroll_top || y >= scroll_top + scroll_height) return y;
+    return scroll_top + (y - scroll_top + scroll_start - scroll_top) % scroll_height;
+}
+
+static void panel_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&gram[gram_row(y) * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    flush_px += lv_area_get_size(area);
+    lv_disp_flush_ready(disp_drv);
+}
+
+static bool panel_hw_scroll_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dy)
+{
+    LV_UNUSED(disp_drv);
+
+    lv_coord_t h = lv_area_get_height(area);
+    if(area->y1 != scroll_top || h != scroll_height) {
+        /*Can't be changed while scrolled*/
+        if(scroll_start != scroll_top) return false;
+        scroll_top = area->y1;
+        scroll_height = h;
+        scroll_start = area->y1;
+    }
+
+    lv_coord_t ofs = (scroll_start - scroll_top - dy) % scroll_height;
+    if(ofs < 0) ofs += scroll_height;
+    scroll_start = scroll_top + ofs;
+    scroll_cnt++;
+    return true;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    flush_cb_ori = drv->flush_cb;
+    drv->flush_cb = panel_flush_cb;
+    drv->hw_scroll_cb = panel_hw_scroll_cb;
+
+    scroll_top = 0;
+    scroll_height = VER_RES;
+    scroll_start = 0;
+    scroll_cnt = 0;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->flush_cb = flush_cb_ori;
+    drv->hw_scroll_cb = NULL;
+    lv_obj_clean(lv_scr_act());
+}
+
+static void create_scene(void)
+{
+    lv_obj_t * header = lv_label_create(lv_scr_act());
+    lv_label_set_text(header, "Header");
+
+    list = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(list, HOR_RES, 400);
+    lv_obj_set_pos(list, 0, 40);
+    lv_obj_set_style_radius(list, 10, 0);
+    lv_obj_set_style_border_width(list, 2, 0);
+    lv_obj_set_scrollbar_mode(list, LV_SCROLLBAR_MODE_ON);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_obj_t * btn = lv_btn_create(list);
+        lv_obj_set_width(btn, lv_pct(i % 3 == 0 ? 100 : 60));
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Item %d", (int)i);
+    }
+
+    lv_obj_t * footer = lv_label_create(lv_scr_act());
+    lv_label_set_text(footer, "Footer");
+    lv_obj_align(footer, LV_ALIGN_BOTTOM_MID, 0, 0);
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Compare what the panel shows with a normal redraw of the screen*/
+static void check_shown(void)
+{
+    lv_coord_t y;
+    for(y = 0; y < VER_RES; y++) {
+        lv_memcpy(&shown[y * HOR_RES], &gram[gram_row(y) * HOR_RES], HOR_RES * sizeof(lv_color_t));
+    }
+
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->flush_cb = flush_cb_ori;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    drv->flush_cb = panel_flush_cb;
+
+    TEST_ASSERT_EQUAL_MEMORY(test_fb, shown, sizeof(shown));
+}
+
+void test_hw_scroll_redraws_only_uncovered_rows(void)
+{
+    create_scene();
+
+    static const lv_coord_t dys[] = {-37, -100, 25, -3, -250, 120};
+    uint32_t i;
+    for(i = 0; i < sizeof(dys) / sizeof(dys[0]); i++) {
+        uint32_t scroll_cnt_ori = scroll_cnt;
+        lv_obj_scroll_by(list, 0, dys[i], LV_ANIM_OFF);
+        TEST_ASSERT_EQUAL_UINT32(scroll_cnt_ori + 1, scroll_cnt);
+
+        flush_px = 0;
+        lv_refr_now(NULL);
+        TEST_ASSERT_LESS_THAN(HOR_RES * (LV_ABS(dys[i]) + 60), flush_px);
+        check_shown();
+    }
+
+    /*More than the area's height is redrawn normally*/
+    lv_obj_scroll_by(list, 0, 420, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(6, scroll_cnt);
+    lv_refr_now(NULL);
+    check_shown();
+}
+
+void test_hw_scroll_pending_areas(void)
+{
+    create_scene();
+
+    /*Changed but not redrawn before the scrolls*/
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(list, 4), 0);
+    lv_label_set_text(label, "Changed text");
+    lv_obj_scroll_by(list, 0, -30, LV_ANIM_OFF);
+    lv_obj_scroll_by(list, 0, -45, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(2, scroll_cnt);
+
+    lv_refr_now(NULL);
+    check_shown();
+}
+
+void test_hw_scroll_not_used(void)
+{
+    create_scene();
+
+    /*A floating child doesn't move with the others*/
+    lv_obj_t * btn = lv_btn_create(list);
+    lv_obj_add_flag(btn, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, -20, -20);
+    lv_refr_now(NULL);
+
+    lv_obj_scroll_by(list, 0, -50, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+    lv_obj_del(btn);
+
+    /*Not full width*/
+    lv_obj_set_width(list, HOR_RES - 10);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(list, 0, -50, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+
+    /*Covered by an other object*/
+    lv_obj_set_width(list, HOR_RES);
+    lv_obj_t * cover = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(cover, 300, 200);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by(list, 0, -50, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+
+    TEST_ASSERT_EQUAL_UINT32(0, scroll_cnt);
+}
+
+#endif
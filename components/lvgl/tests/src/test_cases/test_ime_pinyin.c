@@ -0,0 +1,168 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IME_PINYIN
+
+static lv_pinyin_dict_t dict[] = {
+    { "a", "啊" },
+    { "ai", "愛" },
+    { "an", "安暗案" },
+    { "ba", "吧把爸八" },
+    { "bai", "百白敗" },
+    { "ban", "半般" },
+    { "bi", "比必" },
+    { "ci", "此次" },
+    { "zhong", "中种" },
+    { "zhe", "这着" },
+    { "zhi", "之只" },
+    {NULL, NULL}
+};
+
+static lv_obj_t * ta;
+static lv_obj_t * kb;
+static lv_obj_t * ime;
+
+static void press(const char * txt)
+{
+    lv_btnmatrix_t * btnm = (lv_btnmatrix_t *)kb;
+    uint16_t i;
+    for(i = 0; i < btnm->btn_cnt; i++) {
+        if(strcmp(lv_btnmatrix_get_btn_text(kb, i), txt) == 0) break;
+    }
+    TEST_ASSERT_LESS_THAN_UINT16(btnm->btn_cnt, i);
+
+    lv_btnmatrix_set_selected_btn(kb, i);
+    lv_event_send(kb, LV_EVENT_VALUE_CHANGED, NULL);
+}
+
+static const char * get_cand(uint16_t i)
+{
+    return lv_btnmatrix_get_btn_text(lv_ime_pinyin_get_cand_panel(ime), i + 1);
+}
+
+#endif /*LV_USE_IME_PINYIN*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_USE_IME_PINYIN
+    ta = lv_textarea_create(lv_scr_act());
+    ime = lv_ime_pinyin_create(lv_scr_act());
+    kb = lv_keyboard_create(lv_scr_act());
+    lv_ime_pinyin_set_keyboard(ime, kb);
+    lv_ime_pinyin_set_dict(ime, dict);
+    lv_keyboard_set_textarea(kb, ta);
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_ime_pinyin_search(void)
+{
+#if LV_USE_IME_PINYIN
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)ime;
+
+    /*The first entry starting with the input is used*/
+    press("z");
+    press("h");
+    TEST_ASSERT_EQUAL_STRING("中", get_cand(0));
+    TEST_ASSERT_EQUAL_STRING("种", get_cand(1));
+    TEST_ASSERT_EQUAL_UINT16(2, pinyin_ime->cand_num);
+
+    press("e");
+    TEST_ASSERT_EQUAL_STRING("这", get_cand(0));
+
+    press(LV_SYMBOL_BACKSPACE);
+    TEST_ASSERT_EQUAL_STRING("中", get_cand(0));
+
+    press("i");
+    TEST_ASSERT_EQUAL_STRING("之", get_cand(0));
+
+    /*No entry starts with "zhix"*/
+    press("x");
+    TEST_ASSERT_NULL(pinyin_ime->cand_str);
+
+    press(LV_SYMBOL_BACKSPACE);
+    press(LV_SYMBOL_BACKSPACE);
+    press("o");
+    TEST_ASSERT_EQUAL_STRING("中", get_cand(0));
+    press(LV_SYMBOL_OK);
+
+    press("b");
+    TEST_ASSERT_EQUAL_STRING("吧", get_cand(0));
+    TEST_ASSERT_EQUAL_UINT16(4, pinyin_ime->cand_num);
+    press("a");
+    press("n");
+    TEST_ASSERT_EQUAL_STRING("半", get_cand(0));
+    press(LV_SYMBOL_OK);
+
+    /*No pinyin starts with 'i'*/
+    press("i");
+    TEST_ASSERT_NULL(pinyin_ime->cand_str);
+#endif
+}
+
+void test_ime_pinyin_set_dict(void)
+{
+#if LV_USE_IME_PINYIN
+    static lv_pinyin_dict_t dict2[] = {
+        { "zhe", "者" },
+        {NULL, NULL}
+    };
+
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)ime;
+
+    press("z");
+    press("h");
+    TEST_ASSERT_EQUAL_STRING("中", get_cand(0));
+    press(LV_SYMBOL_OK);
+
+    lv_ime_pinyin_set_dict(ime, dict2);
+    TEST_ASSERT_EQUAL_PTR(dict2, lv_ime_pinyin_get_dict(ime));
+    press("z");
+    press("h");
+    TEST_ASSERT_EQUAL_STRING("者", get_cand(0));
+    TEST_ASSERT_EQUAL_UINT16(1, pinyin_ime->cand_num);
+    press(LV_SYMBOL_OK);
+
+    press("a");
+    TEST_ASSERT_NULL(pinyin_ime->cand_str);
+#endif
+}
+
+void test_ime_pinyin_k9(void)
+{
+#if LV_USE_IME_PINYIN
+    lv_ime_pinyin_t * pinyin_ime = (lv_ime_pinyin_t *)ime;
+    lv_ime_pinyin_set_mode(ime, LV_IME_PINYIN_MODE_K9);
+
+    /*The candidate pinyins are after the left arrow*/
+    press("abc ");
+    TEST_ASSERT_EQUAL_UINT16(3, pinyin_ime->k9_legal_py_count);
+    TEST_ASSERT_EQUAL_STRING("a", lv_btnmatrix_get_btn_text(kb, 16));
+    TEST_ASSERT_EQUAL_STRING("b", lv_btnmatrix_get_btn_text(kb, 17));
+    TEST_ASSERT_EQUAL_STRING("c", lv_btnmatrix_get_btn_text(kb, 18));
+    TEST_ASSERT_EQUAL_STRING("啊", get_cand(0));
+
+    press("ghi");
+    TEST_ASSERT_EQUAL_UINT16(3, pinyin_ime->k9_legal_py_count);
+    TEST_ASSERT_EQUAL_STRING("ai", lv_btnmatrix_get_btn_text(kb, 16));
+    TEST_ASSERT_EQUAL_STRING("bi", lv_btnmatrix_get_btn_text(kb, 17));
+    TEST_ASSERT_EQUAL_STRING("ci", lv_btnmatrix_get_btn_text(kb, 18));
+    TEST_ASSERT_EQUAL_STRING("ai", pinyin_ime->input_char);
+    TEST_ASSERT_EQUAL_STRING("愛", get_cand(0));
+
+    /*Select an other pinyin*/
+    lv_btnmatrix_set_selected_btn(kb, 18);
+    lv_event_send(kb, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_STRING("此", get_cand(0));
+#endif
+}
+
+#endif
@@ -0,0 +1,183 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_INDEV_INDEX
+
+#define STEP    7
+#define COLS    (800 / STEP + 1)
+#define ROWS    (480 / STEP + 1)
+
+static lv_obj_t * walk_res[ROWS][COLS];
+
+static lv_obj_t * search(lv_coord_t x, lv_coord_t y)
+{
+    lv_point_t p = {x, y};
+    return lv_indev_search_obj(lv_scr_act(), &p);
+}
+
+/*Compare the indexed search with the tree walk on a grid of points*/
+static void assert_same_as_walk(void)
+{
+    lv_obj_update_layout(lv_scr_act());
+
+    lv_indev_index_enable(lv_scr_act(), false);
+    uint32_t row, col;
+    for(row = 0; row < ROWS; row++) {
+        for(col = 0; col < COLS; col++) {
+            walk_res[row][col] = search(col * STEP, row * STEP);
+        }
+    }
+
+    lv_indev_index_enable(lv_scr_act(), true);
+    for(row = 0; row < ROWS; row++) {
+        for(col = 0; col < COLS; col++) {
+            TEST_ASSERT_EQUAL_PTR(walk_res[row][col], search(col * STEP, row * STEP));
+        }
+    }
+}
+
+static lv_obj_t * create_dense_screen(uint32_t btn_cnt)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(cont, 2, 0);
+    lv_obj_set_style_pad_gap(cont, 2, 0);
+
+    uint32_t i;
+    for(i = 0; i < btn_cnt; i++) {
+        lv_obj_t * btn = lv_btn_create(cont);
+        lv_obj_set_size(btn, 36, 22);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "%d", (int)i);
+    }
+
+    return cont;
+}
+
+#endif /*LV_USE_INDEV_INDEX*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+#if LV_USE_INDEV_INDEX
+    lv_indev_index_enable(lv_scr_act(), false);
+#endif
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_indev_index_matches_tree_walk(void)
+{
+#if LV_USE_INDEV_INDEX
+    lv_obj_t * cont = create_dense_screen(300);
+
+    /*Objects the search has to skip or treat specially*/
+    lv_obj_add_flag(lv_obj_get_child(cont, 3), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_state(lv_obj_get_child(cont, 5), LV_STATE_DISABLED);
+    lv_obj_clear_flag(lv_obj_get_child(cont, 7), LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_ext_click_area(lv_obj_get_child(cont, 9), 10);
+
+    /*Floating children sticking out of a parent, with and without overflow*/
+    lv_obj_t * clip_parent = lv_obj_get_child(cont, 20);
+    lv_obj_t * out = lv_obj_create(clip_parent);
+    lv_obj_add_flag(out, LV_OBJ_FLAG_FLOATING);
+    lv_obj_set_pos(out, 20, 10);
+    lv_obj_set_size(out, 60, 40);
+
+    lv_obj_t * ov_parent = lv_obj_get_child(cont, 40);
+    lv_obj_add_flag(ov_parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    out = lv_obj_create(ov_parent);
+    lv_obj_add_flag(out, LV_OBJ_FLAG_FLOATING);
+    lv_obj_set_pos(out, 20, 10);
+    lv_obj_set_size(out, 60, 40);
+
+    /*Overlapping siblings on the top layer of the screen*/
+    lv_obj_t * card = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(card, 200, 150);
+    lv_obj_center(card);
+    lv_obj_t * card2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(card2, 200, 150);
+    lv_obj_align(card2, LV_ALIGN_CENTER, 60, 40);
+
+    assert_same_as_walk();
+#endif
+}
+
+void test_indev_index_follows_changes(void)
+{
+#if LV_USE_INDEV_INDEX
+    lv_obj_t * cont = create_dense_screen(200);
+    assert_same_as_walk();
+
+    /*Scroll, so every button moves*/
+    lv_obj_scroll_by(cont, 0, -100, LV_ANIM_OFF);
+    assert_same_as_walk();
+
+    /*Move, hide, delete and reorder objects with the index enabled*/
+    lv_obj_t * btn = lv_obj_get_child(cont, 10);
+    lv_obj_add_flag(btn, LV_OBJ_FLAG_FLOATING);
+    lv_obj_set_pos(btn, 300, 200);
+    lv_obj_set_size(btn, 150, 100);
+    lv_obj_add_flag(lv_obj_get_child(cont, 20), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_del(lv_obj_get_child(cont, 30));
+    lv_obj_move_to_index(lv_obj_get_child(cont, 0), -1);
+    lv_obj_add_state(lv_obj_get_child(cont, 40), LV_STATE_DISABLED);
+    assert_same_as_walk();
+
+    lv_obj_set_parent(btn, lv_scr_act());
+    assert_same_as_walk();
+#endif
+}
+
+void test_indev_index_transformed_fallback(void)
+{
+#if LV_USE_INDEV_INDEX
+    lv_obj_t * cont = create_dense_screen(100);
+    lv_obj_t * btn = lv_obj_get_child(cont, 12);
+    lv_obj_set_style_transform_zoom(btn, 512, 0);
+    lv_obj_set_style_transform_pivot_x(btn, 18, 0);
+    lv_obj_set_style_transform_pivot_y(btn, 11, 0);
+
+    assert_same_as_walk();
+#endif
+}
+
+void test_indev_index_tree_order(void)
+{
+#if LV_USE_INDEV_INDEX
+    /*Overlapping siblings, so the order decides which one is on top*/
+    lv_obj_t * cards[4];
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        cards[i] = lv_obj_create(lv_scr_act());
+        lv_obj_set_size(cards[i], 200, 150);
+        lv_obj_set_pos(cards[i], 100 + i * 40, 100 + i * 30);
+        lv_obj_t * btn = lv_btn_create(cards[i]);
+        lv_obj_set_size(btn, 100, 60);
+    }
+    assert_same_as_walk();
+
+    /*Reordering doesn't touch the index, the lookup compares the tree order*/
+    lv_obj_move_to_index(cards[3], 0);
+    assert_same_as_walk();
+    lv_obj_move_foreground(cards[1]);
+    assert_same_as_walk();
+    lv_obj_swap(cards[0], cards[2]);
+    assert_same_as_walk();
+
+    /*Move a card into an other one and to the top layer*/
+    lv_obj_set_parent(cards[2], cards[0]);
+    assert_same_as_walk();
+    lv_obj_set_parent(cards[1], lv_layer_top());
+    assert_same_as_walk();
+    lv_obj_del(cards[1]);
+#endif
+}
+
+#endif
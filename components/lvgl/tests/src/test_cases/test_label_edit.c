@@ -0,0 +1,315 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define TEXT_MAX    8192
+#define HOR_RES     800
+#define VER_RES     480
+
+extern lv_color_t test_fb[];
+
+static char shadow[TEXT_MAX];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static uint32_t rnd_state;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    rnd_state = 12345;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 8) % max;
+}
+
+/*Words, break characters, new lines, long words, kerning pairs and multi byte letters*/
+static const char * random_piece(void)
+{
+    static const char * pieces[] = {"Lorem ", "ipsum ", "dolor", " ", "  ", "\n", "AV", "To ", "Wa.", "x", "-",
+                                    "verylongwordwhichdoesnotfitintoasinglelineofthelabel", "\xC3\xA1rv\xC3\xADz ", "\r\n", ","
+                                   };
+    return pieces[rnd(sizeof(pieces) / sizeof(pieces[0]))];
+}
+
+/*Insert and delete in the shadow text too with byte indices*/
+static void label_ins(lv_obj_t * label, uint32_t byte_pos, const char * txt)
+{
+    lv_label_ins_text(label, _lv_txt_encoded_get_char_id(shadow, byte_pos), txt);
+
+    size_t len = strlen(txt);
+    memmove(&shadow[byte_pos + len], &shadow[byte_pos], strlen(shadow) - byte_pos + 1);
+    memcpy(&shadow[byte_pos], txt, len);
+}
+
+static void label_cut(lv_obj_t * label, uint32_t byte_pos, uint32_t cnt)
+{
+    lv_label_cut_text(label, _lv_txt_encoded_get_char_id(shadow, byte_pos), cnt);
+
+    uint32_t len = _lv_txt_encoded_get_byte_id(&shadow[byte_pos], cnt);
+    memmove(&shadow[byte_pos], &shadow[byte_pos + len], strlen(shadow) - byte_pos - len + 1);
+}
+
+/*Random letter boundary*/
+static uint32_t random_pos(void)
+{
+    uint32_t len = _lv_txt_get_encoded_length(shadow);
+    return _lv_txt_encoded_get_byte_id(shadow, rnd(len + 1));
+}
+
+static void random_edit(lv_obj_t * label)
+{
+    if(strlen(shadow) < TEXT_MAX / 2 && rnd(3) != 0) {
+        label_ins(label, random_pos(), random_piece());
+    }
+    else {
+        label_cut(label, random_pos(), 1 + rnd(20));
+    }
+}
+
+/*Compare the size of the label and the cached lines with wrapping the whole text*/
+static void check_label(lv_obj_t * label, lv_text_flag_t flag)
+{
+    lv_label_t * l = (lv_label_t *)label;
+    TEST_ASSERT_EQUAL_STRING(shadow, l->text);
+
+    lv_obj_update_layout(label);
+
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(label, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(label, LV_PART_MAIN);
+    lv_coord_t max_w = lv_obj_get_content_width(label);
+
+    lv_point_t size;
+    lv_txt_get_size(&size, shadow, font, letter_space, line_space, max_w, flag);
+    TEST_ASSERT_EQUAL(size.y, lv_obj_get_content_height(label));
+    TEST_ASSERT_EQUAL(size.y, lv_obj_get_self_height(label));
+
+#if LV_LABEL_LINE_CACHE
+    lv_label_line_cache_t * cache = &l->line_cache;
+    TEST_ASSERT_TRUE(cache->valid);
+    TEST_ASSERT_FALSE(cache->edited);
+
+    uint32_t start = 0;
+    uint32_t i = 0;
+    while(shadow[start] != '\0') {
+        uint32_t end = start + _lv_txt_get_next_line(&shadow[start], font, letter_space,
+                                                     (flag & LV_TEXT_FLAG_EXPAND) ? LV_COORD_MAX : max_w, NULL, flag);
+        TEST_ASSERT_LESS_THAN_UINT32(cache->cnt, i);
+        TEST_ASSERT_EQUAL_UINT32(start, cache->lines[i].start);
+        TEST_ASSERT_EQUAL(lv_txt_get_width(&shadow[start], end - start, font, letter_space, flag), cache->lines[i].width);
+        start = end;
+        i++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(i, cache->cnt);
+#endif
+}
+
+static lv_obj_t * create_label(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 300);
+
+    shadow[0] = '\0';
+    while(strlen(shadow) < 2000) strcat(shadow, random_piece());
+    lv_label_set_text(label, shadow);
+
+    return label;
+}
+
+void test_label_edit_wrap(void)
+{
+    lv_obj_t * label = create_label();
+    check_label(label, LV_TEXT_FLAG_NONE);
+
+    uint32_t i;
+    for(i = 0; i < 400; i++) {
+        random_edit(label);
+        check_label(label, LV_TEXT_FLAG_NONE);
+    }
+
+    /*Several edits between two updates*/
+    for(i = 0; i < 200; i++) {
+        uint32_t j;
+        uint32_t cnt = 1 + rnd(5);
+        for(j = 0; j < cnt; j++) random_edit(label);
+        check_label(label, LV_TEXT_FLAG_NONE);
+    }
+
+    /*Type at the end and delete backwards like in a text area*/
+    for(i = 0; i < 100; i++) {
+        label_ins(label, strlen(shadow), random_piece());
+        check_label(label, LV_TEXT_FLAG_NONE);
+    }
+    for(i = 0; i < 100; i++) {
+        label_cut(label, _lv_txt_encoded_get_byte_id(shadow, _lv_txt_get_encoded_length(shadow) - 1), 1);
+        check_label(label, LV_TEXT_FLAG_NONE);
+    }
+
+    /*The lines are wrapped again with a new width*/
+    lv_obj_set_width(label, 123);
+    check_label(label, LV_TEXT_FLAG_NONE);
+    random_edit(label);
+    check_label(label, LV_TEXT_FLAG_NONE);
+}
+
+void test_label_edit_scroll(void)
+{
+    lv_obj_t * label = create_label();
+    lv_label_set_long_mode(label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    check_label(label, LV_TEXT_FLAG_EXPAND);
+
+    uint32_t i;
+    for(i = 0; i < 150; i++) {
+        random_edit(label);
+        check_label(label, LV_TEXT_FLAG_EXPAND);
+    }
+}
+
+void test_label_edit_textarea(void)
+{
+    lv_obj_t * ta = lv_textarea_create(lv_scr_act());
+    lv_obj_set_size(ta, 300, 200);
+    lv_textarea_set_password_mode(ta, true);
+    lv_textarea_set_password_show_time(ta, 0);
+
+    shadow[0] = '\0';
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        const char * piece = random_piece();
+        lv_textarea_add_text(ta, piece);
+        strcat(shadow, piece);
+    }
+    TEST_ASSERT_EQUAL_STRING(shadow, lv_textarea_get_text(ta));
+
+    /*The password buffer is grown geometrically*/
+    lv_textarea_t * ta_p = (lv_textarea_t *)ta;
+    TEST_ASSERT_GREATER_THAN_UINT32(strlen(shadow), ta_p->pwd_tmp_size);
+
+    lv_textarea_set_cursor_pos(ta, 100);
+    for(i = 0; i < 50; i++) lv_textarea_del_char(ta);
+    lv_textarea_set_cursor_pos(ta, 10);
+    lv_textarea_add_text(ta, "inserted");
+
+    uint32_t pos = _lv_txt_encoded_get_byte_id(shadow, 50);
+    uint32_t end = _lv_txt_encoded_get_byte_id(shadow, 100);
+    memmove(&shadow[pos], &shadow[end], strlen(shadow) - end + 1);
+    pos = _lv_txt_encoded_get_byte_id(shadow, 10);
+    memmove(&shadow[pos + 8], &shadow[pos], strlen(shadow) - pos + 1);
+    memcpy(&shadow[pos], "inserted", 8);
+    TEST_ASSERT_EQUAL_STRING(shadow, lv_textarea_get_text(ta));
+
+    /*The label shows the real text without password mode*/
+    lv_textarea_set_password_mode(ta, false);
+    lv_obj_t * label = lv_textarea_get_label(ta);
+    check_label(label, LV_TEXT_FLAG_NONE);
+
+    for(i = 0; i < 100; i++) {
+        lv_textarea_set_cursor_pos(ta, _lv_txt_encoded_get_char_id(shadow, random_pos()));
+        uint32_t cur = lv_textarea_get_cursor_pos(ta);
+        if(rnd(2) && cur > 0) {
+            lv_textarea_del_char(ta);
+            pos = _lv_txt_encoded_get_byte_id(shadow, cur - 1);
+            end = _lv_txt_encoded_get_byte_id(shadow, cur);
+            memmove(&shadow[pos], &shadow[end], strlen(shadow) - end + 1);
+        }
+        else {
+            lv_textarea_add_char(ta, 'x');
+            pos = _lv_txt_encoded_get_byte_id(shadow, cur);
+            memmove(&shadow[pos + 1], &shadow[pos], strlen(shadow) - pos + 1);
+            shadow[pos] = 'x';
+        }
+        check_label(label, LV_TEXT_FLAG_NONE);
+    }
+}
+
+/*Compare the hit testing on the cached lines with a static copy of the text which is not cached*/
+static void check_hit_test(lv_obj_t * label, lv_obj_t * ref)
+{
+    lv_obj_update_layout(lv_scr_act());
+#if LV_LABEL_LINE_CACHE
+    TEST_ASSERT_TRUE(((lv_label_t *)label)->line_cache.valid);
+    TEST_ASSERT_FALSE(((lv_label_t *)ref)->line_cache.valid);
+#endif
+
+    uint32_t len = _lv_txt_get_encoded_length(shadow);
+    uint32_t i;
+    for(i = 0; i <= len; i += (i < len - 20 ? 7 : 1)) {
+        lv_point_t p1;
+        lv_point_t p2;
+        lv_label_get_letter_pos(label, i, &p1);
+        lv_label_get_letter_pos(ref, i, &p2);
+        TEST_ASSERT_EQUAL(p2.x, p1.x);
+        TEST_ASSERT_EQUAL(p2.y, p1.y);
+    }
+
+    static const lv_coord_t xs[] = {-5, 0, 7, 37, 150, 299, 320};
+    lv_coord_t h = lv_obj_get_height(label);
+    lv_point_t p;
+    for(p.y = -10; p.y < h + 30; p.y += 7) {
+        for(i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+            p.x = xs[i];
+            TEST_ASSERT_EQUAL_UINT32(lv_label_get_letter_on(ref, &p), lv_label_get_letter_on(label, &p));
+            TEST_ASSERT_EQUAL(lv_label_is_char_under_pos(ref, &p), lv_label_is_char_under_pos(label, &p));
+        }
+    }
+}
+
+void test_label_edit_hit_test(void)
+{
+    lv_obj_t * label = create_label();
+    lv_obj_t * ref = lv_label_create(lv_scr_act());
+    lv_obj_set_width(ref, 300);
+    lv_label_set_text_static(ref, shadow);
+    check_hit_test(label, ref);
+
+    /*Other alignment and line space*/
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_align(ref, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_line_space(label, 5, 0);
+    lv_obj_set_style_text_line_space(ref, 5, 0);
+    check_hit_test(label, ref);
+
+    /*The text ends with a new line*/
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, "\n");
+    strcat(shadow, "\n");
+    lv_label_set_text_static(ref, shadow);
+    check_hit_test(label, ref);
+}
+
+void test_label_edit_draw(void)
+{
+    lv_obj_t * label = create_label();
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_text_sel_start(label, 500);
+    lv_label_set_text_sel_end(label, 1200);
+
+    static const lv_coord_t scrolls[] = {0, 300, 1000, 1234, 3000};
+    uint32_t i;
+    for(i = 0; i < sizeof(scrolls) / sizeof(scrolls[0]); i++) {
+        lv_label_set_text(label, shadow);
+        lv_obj_scroll_to_y(lv_scr_act(), scrolls[i], LV_ANIM_OFF);
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+#if LV_LABEL_LINE_CACHE
+        TEST_ASSERT_TRUE(((lv_label_t *)label)->line_cache.valid);
+#endif
+        memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+        /*Draw the not cached static text from the first line*/
+        lv_label_set_text_static(label, shadow);
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    }
+}
+
+#endif
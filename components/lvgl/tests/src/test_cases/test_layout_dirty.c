@@ -0,0 +1,142 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define COORDS_MAX  2000
+
+static lv_area_t coords[COORDS_MAX];
+static lv_area_t coords_ref[COORDS_MAX];
+static uint32_t coords_cnt;
+static lv_obj_t * sections[6];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+static void collect(lv_obj_t * obj, lv_area_t * buf)
+{
+    /*Nothing is left to update*/
+    TEST_ASSERT_FALSE(obj->layout_inv);
+    TEST_ASSERT_FALSE(obj->child_layout_inv);
+
+    TEST_ASSERT_LESS_THAN(COORDS_MAX, coords_cnt);
+    buf[coords_cnt] = obj->coords;
+    coords_cnt++;
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        collect(lv_obj_get_child(obj, i), buf);
+    }
+}
+
+static void mark_all(lv_obj_t * obj)
+{
+    lv_obj_mark_layout_as_dirty(obj);
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        mark_all(lv_obj_get_child(obj, i));
+    }
+}
+
+/*Update the layout normally then compare it with updating every object*/
+static void check_layout(void)
+{
+    lv_obj_update_layout(lv_scr_act());
+    coords_cnt = 0;
+    collect(lv_scr_act(), coords);
+
+    mark_all(lv_scr_act());
+    lv_obj_update_layout(lv_scr_act());
+    uint32_t cnt = coords_cnt;
+    coords_cnt = 0;
+    collect(lv_scr_act(), coords_ref);
+    TEST_ASSERT_EQUAL_UINT32(cnt, coords_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(coords_ref, coords, cnt * sizeof(lv_area_t));
+}
+
+static void create_scene(void)
+{
+    static lv_coord_t col_dsc[] = {LV_GRID_CONTENT, LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
+    static lv_coord_t row_dsc[] = {LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
+
+    lv_obj_t * page = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(page, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(page, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t s;
+    for(s = 0; s < 6; s++) {
+        lv_obj_t * section = lv_obj_create(page);
+        sections[s] = section;
+        lv_obj_set_size(section, lv_pct(100), LV_SIZE_CONTENT);
+        if(s == 5) {
+            lv_obj_set_grid_dsc_array(section, col_dsc, row_dsc);
+        }
+        else {
+            lv_obj_set_flex_flow(section, LV_FLEX_FLOW_COLUMN);
+        }
+
+        uint32_t i;
+        for(i = 0; i < (s == 5 ? 3 : 20); i++) {
+            lv_obj_t * row = lv_obj_create(section);
+            lv_obj_set_size(row, s == 5 ? LV_SIZE_CONTENT : lv_pct(100), LV_SIZE_CONTENT);
+            lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+            if(s == 5) lv_obj_set_grid_cell(row, LV_GRID_ALIGN_STRETCH, i % 2, 1, LV_GRID_ALIGN_CENTER, i, 1);
+
+            lv_obj_t * label = lv_label_create(row);
+            lv_label_set_text_fmt(label, "Row %d", (int)i);
+            lv_obj_set_flex_grow(label, 1);
+            lv_switch_create(row);
+        }
+    }
+
+    check_layout();
+}
+
+void test_layout_dirty_label_change(void)
+{
+    create_scene();
+
+    /*Same size*/
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(sections[2], 7), 0);
+    lv_label_set_text(label, "Row X");
+    check_layout();
+
+    /*Taller, the section and the ones below move*/
+    lv_label_set_text(label, "Row 7\nwith\nmore lines");
+    check_layout();
+
+    /*Wider in a grid cell with content size*/
+    label = lv_obj_get_child(lv_obj_get_child(sections[5], 0), 0);
+    lv_label_set_text(label, "A much longer text in the grid");
+    check_layout();
+}
+
+void test_layout_dirty_tree_change(void)
+{
+    create_scene();
+
+    /*Dirty objects moved to an other clean subtree*/
+    lv_obj_t * row = lv_obj_get_child(sections[1], 3);
+    lv_label_set_text(lv_obj_get_child(row, 0), "Moved\nrow");
+    lv_obj_set_parent(row, sections[4]);
+    check_layout();
+
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(sections[3], 0), 0);
+    lv_label_set_text(label, "Deleted");
+    lv_obj_del(lv_obj_get_parent(label));
+    check_layout();
+
+    lv_obj_add_flag(sections[0], LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_style_pad_row(sections[3], 20, 0);
+    check_layout();
+}
+
+#endif
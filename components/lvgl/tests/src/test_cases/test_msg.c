@@ -0,0 +1,245 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <pthread.h>
+
+#if LV_USE_MSG
+
+#define ID_CNT      100
+#define POST_CNT    10000
+
+static uint32_t log_buf[64];
+static uint32_t log_cnt;
+static const void * last_payload;
+static void * sub_to_remove;
+static volatile bool thread_done;
+
+/*Log the ID and the user data of the received messages*/
+static void log_cb(void * s, lv_msg_t * m)
+{
+    LV_UNUSED(s);
+    if(log_cnt < sizeof(log_buf) / sizeof(log_buf[0])) {
+        log_buf[log_cnt] = lv_msg_get_id(m) * 100 + (uint32_t)(uintptr_t)lv_msg_get_user_data(m);
+        log_cnt++;
+    }
+    last_payload = lv_msg_get_payload(m);
+}
+
+static void unsubscribe_cb(void * s, lv_msg_t * m)
+{
+    log_cb(s, m);
+    lv_msg_unsubscribe(s);
+    if(sub_to_remove) lv_msg_unsubscribe(sub_to_remove);
+    sub_to_remove = NULL;
+}
+
+static void resend_cb(void * s, lv_msg_t * m)
+{
+    log_cb(s, m);
+    if(log_cnt < 3) lv_msg_send(lv_msg_get_id(m), NULL);
+}
+
+static void obj_event_cb(lv_event_t * e)
+{
+    lv_msg_t * m = lv_event_get_msg(e);
+    log_buf[log_cnt] = lv_msg_get_id(m);
+    log_cnt++;
+}
+
+static void deliver_posted(void)
+{
+    lv_tick_inc(LV_MSG_POST_PERIOD);
+    lv_timer_handler();
+}
+
+static void * post_thread(void * param)
+{
+    LV_UNUSED(param);
+    static uint32_t values[POST_CNT];
+    uint32_t i;
+    for(i = 0; i < POST_CNT; i++) {
+        values[i] = i;
+        lv_msg_post(30, &values[i]);
+    }
+    thread_done = true;
+    return NULL;
+}
+
+#endif /*LV_USE_MSG*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_USE_MSG
+    log_cnt = 0;
+    last_payload = NULL;
+    sub_to_remove = NULL;
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_msg_send_to_the_subscribers_of_the_id(void)
+{
+#if LV_USE_MSG
+    void * subs[ID_CNT * 2];
+    uint32_t i;
+    for(i = 0; i < ID_CNT; i++) {
+        subs[i * 2] = lv_msg_subscribe(1000 + i * 256, log_cb, (void *)1);
+        subs[i * 2 + 1] = lv_msg_subscribe(1000 + i * 256, log_cb, (void *)2);
+    }
+
+    for(i = 0; i < ID_CNT; i++) {
+        log_cnt = 0;
+        lv_msg_send(1000 + i * 256, &i);
+        TEST_ASSERT_EQUAL_UINT32(2, log_cnt);
+        TEST_ASSERT_EQUAL_UINT32((1000 + i * 256) * 100 + 1, log_buf[0]);
+        TEST_ASSERT_EQUAL_UINT32((1000 + i * 256) * 100 + 2, log_buf[1]);
+        TEST_ASSERT_EQUAL_PTR(&i, last_payload);
+    }
+
+    /*No subscribers*/
+    log_cnt = 0;
+    lv_msg_send(999, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, log_cnt);
+
+    for(i = 0; i < ID_CNT * 2; i++) lv_msg_unsubscribe(subs[i]);
+    lv_msg_send(1000, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, log_cnt);
+#endif
+}
+
+void test_msg_unsubscribe_in_callback(void)
+{
+#if LV_USE_MSG
+    lv_msg_subscribe(1, log_cb, (void *)1);
+    lv_msg_subscribe(1, unsubscribe_cb, (void *)2);
+    void * s3 = lv_msg_subscribe(1, log_cb, (void *)3);
+    void * s4 = lv_msg_subscribe(1, log_cb, (void *)4);
+
+    /*The 2nd subscriber unsubscribes itself and the 3rd one which is not called anymore*/
+    sub_to_remove = s3;
+    lv_msg_send(1, NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, log_cnt);
+    TEST_ASSERT_EQUAL_UINT32(101, log_buf[0]);
+    TEST_ASSERT_EQUAL_UINT32(102, log_buf[1]);
+    TEST_ASSERT_EQUAL_UINT32(104, log_buf[2]);
+
+    log_cnt = 0;
+    lv_msg_send(1, NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, log_cnt);
+    TEST_ASSERT_EQUAL_UINT32(101, log_buf[0]);
+    TEST_ASSERT_EQUAL_UINT32(104, log_buf[1]);
+
+    lv_msg_unsubscribe(s4);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_msg_unsubscribe_obj(1, NULL));
+#endif
+}
+
+void test_msg_send_in_callback(void)
+{
+#if LV_USE_MSG
+    void * s = lv_msg_subscribe(2, resend_cb, (void *)1);
+    lv_msg_send(2, NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, log_cnt);
+    lv_msg_unsubscribe(s);
+#endif
+}
+
+void test_msg_obj(void)
+{
+#if LV_USE_MSG
+    lv_obj_t * obj1 = lv_obj_create(lv_scr_act());
+    lv_obj_t * obj2 = lv_obj_create(lv_scr_act());
+    lv_obj_add_event_cb(obj1, obj_event_cb, LV_EVENT_MSG_RECEIVED, NULL);
+    lv_obj_add_event_cb(obj2, obj_event_cb, LV_EVENT_MSG_RECEIVED, NULL);
+    lv_msg_subscribe_obj(10, obj1, NULL);
+    lv_msg_subscribe_obj(11, obj1, NULL);
+    lv_msg_subscribe_obj(10, obj2, NULL);
+    lv_msg_subscribe_obj(11, obj2, NULL);
+
+    lv_msg_send(10, NULL);
+    lv_msg_send(11, NULL);
+    TEST_ASSERT_EQUAL_UINT32(4, log_cnt);
+
+    /*Unsubscribe from any ID*/
+    TEST_ASSERT_EQUAL_UINT32(2, lv_msg_unsubscribe_obj(LV_MSG_ID_ANY, obj1));
+    log_cnt = 0;
+    lv_msg_send(10, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, log_cnt);
+
+    /*Deleting the object unsubscribes it*/
+    lv_obj_del(obj2);
+    log_cnt = 0;
+    lv_msg_send(10, NULL);
+    lv_msg_send(11, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, log_cnt);
+#endif
+}
+
+void test_msg_post_is_coalesced(void)
+{
+#if LV_USE_MSG
+    static const int32_t values[] = {1, 2, 3};
+    void * s1 = lv_msg_subscribe(20, log_cb, (void *)1);
+    void * s2 = lv_msg_subscribe(21, log_cb, (void *)2);
+
+    lv_msg_post(20, &values[0]);
+    lv_msg_post(21, &values[1]);
+    lv_msg_post(20, &values[2]);
+    lv_msg_post(22, &values[0]);    /*No subscribers*/
+    TEST_ASSERT_EQUAL_UINT32(0, log_cnt);
+
+    /*Delivered once in the order of the first posts with the last payload*/
+    deliver_posted();
+    TEST_ASSERT_EQUAL_UINT32(2, log_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2001, log_buf[0]);
+    TEST_ASSERT_EQUAL_UINT32(2102, log_buf[1]);
+    TEST_ASSERT_EQUAL_PTR(&values[1], last_payload);
+
+    deliver_posted();
+    TEST_ASSERT_EQUAL_UINT32(2, log_cnt);
+
+    /*Unsubscribed before the delivery*/
+    lv_msg_post(20, &values[0]);
+    lv_msg_unsubscribe(s1);
+    deliver_posted();
+    TEST_ASSERT_EQUAL_UINT32(2, log_cnt);
+
+    lv_msg_unsubscribe(s2);
+#endif
+}
+
+void test_msg_post_from_thread(void)
+{
+#if LV_USE_MSG
+    void * s = lv_msg_subscribe(30, log_cb, NULL);
+
+    thread_done = false;
+    pthread_t thread;
+    pthread_create(&thread, NULL, post_thread, NULL);
+    while(!thread_done) {
+        deliver_posted();
+        /*Subscribe and unsubscribe to other IDs to resize the hash table meanwhile*/
+        uint32_t i;
+        void * subs[40];
+        for(i = 0; i < 40; i++) subs[i] = lv_msg_subscribe(100 + i, log_cb, NULL);
+        for(i = 0; i < 40; i++) lv_msg_unsubscribe(subs[i]);
+    }
+    pthread_join(thread, NULL);
+
+    deliver_posted();
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, log_cnt);
+    TEST_ASSERT_EQUAL_UINT32(POST_CNT - 1, *(const uint32_t *)last_payload);
+
+    lv_msg_unsubscribe(s);
+#endif
+}
+
+#endif
@@ -0,0 +1,203 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <string.h>
+
+#if LV_USE_OBJ_CACHE
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static uint32_t draw_cnt;
+
+static void draw_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+/*A card with shadow, gradient and text*/
+static lv_obj_t * card_create(lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * card = lv_test_card_create(lv_scr_act(), 100, 80, w, h);
+    lv_obj_set_style_radius(card, 16, 0);
+    lv_obj_set_style_shadow_width(card, 20, 0);
+    lv_obj_set_style_shadow_ofs_y(card, 6, 0);
+    lv_obj_set_style_bg_grad_color(card, lv_palette_main(LV_PALETTE_ORANGE), 0);
+    lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_HOR, 0);
+    lv_obj_set_style_bg_dither_mode(card, LV_DITHER_NONE, 0);
+
+    lv_obj_t * label = lv_label_create(card);
+    lv_label_set_text(label, "Cached card");
+    lv_obj_add_event_cb(label, draw_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+
+    lv_obj_t * btn = lv_btn_create(card);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    return card;
+}
+
+#endif /*LV_USE_OBJ_CACHE*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_USE_OBJ_CACHE
+    draw_cnt = 0;
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_obj_cache_reuse(void)
+{
+#if LV_USE_OBJ_CACHE
+    lv_obj_t * card = card_create(240, 160);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHED);
+
+    lv_obj_cache_stats_t stats_ori;
+    lv_obj_cache_get_stats(&stats_ori);
+
+    lv_test_render();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    /*Not drawn again, only its bitmap*/
+    lv_test_render();
+    lv_test_render();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    lv_obj_cache_stats_t stats;
+    lv_obj_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.render_cnt + 1, stats.render_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.hit_cnt + 2, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.entry_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.size);
+#endif
+}
+
+void test_obj_cache_same_as_direct(void)
+{
+#if LV_USE_OBJ_CACHE
+    lv_obj_t * card = card_create(240, 160);
+    lv_test_render();
+    memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHED);
+    lv_test_render();
+    lv_test_render();
+
+    /*The semi-transparent pixels (shadow, anti-aliasing) are blended twice: the rounding is slightly different*/
+    uint32_t i;
+    uint32_t diff_max = 0;
+    for(i = 0; i < HOR_RES * VER_RES; i++) {
+        int32_t d_r = LV_ABS((int32_t)ref_fb[i].ch.red - test_fb[i].ch.red);
+        int32_t d_g = LV_ABS((int32_t)ref_fb[i].ch.green - test_fb[i].ch.green);
+        int32_t d_b = LV_ABS((int32_t)ref_fb[i].ch.blue - test_fb[i].ch.blue);
+        diff_max = LV_MAX(diff_max, (uint32_t)LV_MAX3(d_r, d_g, d_b));
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(4, diff_max);
+#endif
+}
+
+void test_obj_cache_child_change(void)
+{
+#if LV_USE_OBJ_CACHE
+    lv_obj_t * card = card_create(240, 160);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHED);
+    lv_test_render();
+
+    lv_obj_cache_stats_t stats_ori;
+    lv_obj_cache_get_stats(&stats_ori);
+
+    /*A descendant changed: rendered again*/
+    lv_label_set_text(lv_obj_get_child(card, 0), "Changed");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+
+    /*A style changed*/
+    lv_obj_set_style_bg_color(card, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, draw_cnt);
+
+    lv_obj_cache_stats_t stats;
+    lv_obj_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.render_cnt + 2, stats.render_cnt);
+
+    /*Only a sibling changed*/
+    lv_obj_t * other = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(other, 500, 300);
+    lv_refr_now(NULL);
+    lv_test_render();
+    TEST_ASSERT_EQUAL_UINT32(3, draw_cnt);
+#endif
+}
+
+void test_obj_cache_resize(void)
+{
+#if LV_USE_OBJ_CACHE
+    lv_obj_t * card = card_create(160, 100);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHED);
+    lv_test_render();
+
+    lv_obj_cache_stats_t stats_small;
+    lv_obj_cache_get_stats(&stats_small);
+
+    lv_obj_set_size(card, 200, 120);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+
+    lv_obj_cache_stats_t stats;
+    lv_obj_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(stats_small.size, stats.size);
+#endif
+}
+
+void test_obj_cache_too_large(void)
+{
+#if LV_USE_OBJ_CACHE
+    /*Doesn't fit into LV_OBJ_CACHE_MAX_SIZE: drawn normally*/
+    lv_obj_t * card = card_create(600, 360);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHED);
+
+    lv_test_render();
+    lv_test_render();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+
+    lv_obj_cache_stats_t stats;
+    lv_obj_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+#endif
+}
+
+void test_obj_cache_free(void)
+{
+#if LV_USE_OBJ_CACHE
+    lv_obj_t * card1 = card_create(240, 160);
+    lv_obj_add_flag(card1, LV_OBJ_FLAG_CACHED);
+    lv_obj_t * card2 = card_create(100, 100);
+    lv_obj_set_pos(card2, 500, 100);
+    lv_obj_add_flag(card2, LV_OBJ_FLAG_CACHED);
+    lv_test_render();
+
+    lv_obj_cache_stats_t stats;
+    lv_obj_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+
+    lv_obj_clear_flag(card1, LV_OBJ_FLAG_CACHED);
+    lv_obj_del(card2);
+
+    lv_obj_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+#endif
+}
+
+#endif
@@ -0,0 +1,218 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#define CHILD_CNT   100
+
+static uint32_t del_order[CHILD_CNT];
+static uint32_t del_cnt;
+static uint32_t event_mask;
+static bool del_check_index;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    del_cnt = 0;
+    event_mask = 0;
+    del_check_index = false;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+static void del_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    uint32_t id = (uint32_t)(lv_uintptr_t)lv_event_get_user_data(e);
+    if(del_check_index) {
+        /*The siblings before it are already removed*/
+        TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_index(obj));
+        TEST_ASSERT_EQUAL_UINT32(CHILD_CNT - id, lv_obj_get_child_cnt(lv_obj_get_parent(obj)));
+    }
+
+    del_order[del_cnt] = id;
+    del_cnt++;
+}
+
+static void mask_event_cb(lv_event_t * e)
+{
+    event_mask |= (uint32_t)(lv_uintptr_t)lv_event_get_user_data(e);
+}
+
+static void other_event_cb(lv_event_t * e)
+{
+    event_mask |= 0x100 | (uint32_t)(lv_uintptr_t)lv_event_get_user_data(e);
+}
+
+static lv_obj_t * children_create(lv_obj_t * parent)
+{
+    uint32_t i;
+    for(i = 0; i < CHILD_CNT; i++) {
+        lv_obj_t * obj = lv_obj_create(parent);
+        lv_obj_add_event_cb(obj, del_event_cb, LV_EVENT_DELETE, (void *)(lv_uintptr_t)i);
+    }
+
+    return parent;
+}
+
+static void check_order(lv_obj_t * parent, uint32_t start, uint32_t step)
+{
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(parent); i++) {
+        lv_obj_t * obj = lv_obj_get_child(parent, i);
+        TEST_ASSERT_EQUAL_UINT32(i, lv_obj_get_index(obj));
+        TEST_ASSERT_EQUAL_PTR(parent, lv_obj_get_parent(obj));
+        TEST_ASSERT_EQUAL_PTR((void *)(lv_uintptr_t)(start + i * step), lv_obj_get_event_user_data(obj, del_event_cb));
+    }
+}
+
+void test_obj_pool_reuse(void)
+{
+#if LV_USE_OBJ_POOL
+    lv_obj_pool_flush();
+
+    lv_obj_t * obj1 = lv_obj_create(lv_scr_act());
+    lv_obj_del(obj1);
+
+    lv_obj_pool_stats_t stats_ori;
+    lv_obj_pool_get_stats(&stats_ori);
+    TEST_ASSERT_GREATER_THAN(0, stats_ori.free_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats_ori.size);
+
+    /*The same memory is used again*/
+    lv_obj_t * obj2 = lv_obj_create(lv_scr_act());
+    TEST_ASSERT_EQUAL_PTR(obj1, obj2);
+
+    lv_obj_pool_stats_t stats;
+    lv_obj_pool_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(stats_ori.hit_cnt, stats.hit_cnt);
+    TEST_ASSERT_LESS_THAN(stats_ori.size, stats.size);
+#endif
+}
+
+void test_obj_pool_flush(void)
+{
+#if LV_USE_OBJ_POOL
+    lv_obj_t * parent = children_create(lv_obj_create(lv_scr_act()));
+    lv_obj_del(parent);
+
+    lv_obj_pool_stats_t stats;
+    lv_obj_pool_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.free_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(LV_OBJ_POOL_MAX_SIZE, stats.size);
+
+    lv_obj_pool_flush();
+    lv_obj_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.free_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+#endif
+}
+
+void test_obj_pool_no_leak(void)
+{
+    /*The deleted objects are only kept until the pool is flushed*/
+    lv_obj_pool_flush();
+    uint32_t free_mem = lv_test_get_free_mem();
+
+    lv_obj_t * parent = children_create(lv_obj_create(lv_scr_act()));
+    lv_obj_del(parent);
+    lv_obj_pool_flush();
+
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL_UINT32(free_mem, lv_test_get_free_mem()));
+}
+
+void test_obj_pool_children_order(void)
+{
+    lv_obj_t * parent = children_create(lv_obj_create(lv_scr_act()));
+    check_order(parent, 0, 1);
+
+    /*Delete the odd children from the end and the even ones remain*/
+    int32_t i;
+    for(i = CHILD_CNT - 1; i > 0; i -= 2) {
+        lv_obj_del(lv_obj_get_child(parent, i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(CHILD_CNT / 2, lv_obj_get_child_cnt(parent));
+    check_order(parent, 0, 2);
+
+    /*Move all to an other parent and back*/
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act());
+    while(lv_obj_get_child_cnt(parent)) {
+        lv_obj_set_parent(lv_obj_get_child(parent, 0), parent2);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_cnt(parent));
+    check_order(parent2, 0, 2);
+
+    while(lv_obj_get_child_cnt(parent2)) {
+        lv_obj_set_parent(lv_obj_get_child(parent2, 0), parent);
+    }
+    check_order(parent, 0, 2);
+
+    lv_obj_move_to_index(lv_obj_get_child(parent, 0), -1);
+    lv_obj_move_to_index(lv_obj_get_child(parent, -1), 0);
+    check_order(parent, 0, 2);
+}
+
+void test_obj_pool_del_order(void)
+{
+    /*The children get LV_EVENT_DELETE in their order*/
+    del_check_index = true;
+    lv_obj_t * parent = children_create(lv_obj_create(lv_scr_act()));
+    lv_obj_del(parent);
+
+    TEST_ASSERT_EQUAL_UINT32(CHILD_CNT, del_cnt);
+    uint32_t i;
+    for(i = 0; i < CHILD_CNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, del_order[i]);
+    }
+
+    del_cnt = 0;
+    parent = children_create(lv_obj_create(lv_scr_act()));
+    lv_obj_clean(parent);
+
+    TEST_ASSERT_EQUAL_UINT32(CHILD_CNT, del_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_cnt(parent));
+    for(i = 0; i < CHILD_CNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, del_order[i]);
+    }
+}
+
+void test_obj_pool_event_remove(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_add_event_cb(obj, mask_event_cb, LV_EVENT_VALUE_CHANGED, (void *)(lv_uintptr_t)(1 << i));
+    }
+    struct _lv_event_dsc_t * dsc = lv_obj_add_event_cb(obj, other_event_cb, LV_EVENT_VALUE_CHANGED, (void *)0x20);
+
+    lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_HEX32(0x13f, event_mask);
+
+    TEST_ASSERT_TRUE(lv_obj_remove_event_dsc(obj, dsc));
+    TEST_ASSERT_TRUE(lv_obj_remove_event_cb_with_user_data(obj, mask_event_cb, (void *)0x04));
+    TEST_ASSERT_TRUE(lv_obj_remove_event_cb(obj, mask_event_cb));
+
+    event_mask = 0;
+    lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_HEX32(0x1a, event_mask);
+
+    /*Remove all*/
+    while(lv_obj_remove_event_cb(obj, NULL));
+    TEST_ASSERT_FALSE(lv_obj_remove_event_cb(obj, mask_event_cb));
+
+    event_mask = 0;
+    lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_HEX32(0, event_mask);
+
+    lv_obj_add_event_cb(obj, mask_event_cb, LV_EVENT_VALUE_CHANGED, (void *)0x40);
+    lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_HEX32(0x40, event_mask);
+}
+
+#endif
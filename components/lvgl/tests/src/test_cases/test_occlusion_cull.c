@@ -0,0 +1,196 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <string.h>
+
+#if LV_USE_OCCLUSION_CULL
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static uint32_t draw_cnt;
+static char json[64 * 1024];
+static uint32_t json_len;
+
+static void draw_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+static lv_res_t write_cb(const char * buf, uint32_t len, void * user_data)
+{
+    LV_UNUSED(user_data);
+    if(json_len + len >= sizeof(json)) return LV_RES_INV;
+    memcpy(&json[json_len], buf, len);
+    json_len += len;
+    json[json_len] = '\0';
+    return LV_RES_OK;
+}
+
+/*A list of buttons*/
+static lv_obj_t * list_create(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * list = lv_list_create(lv_scr_act());
+    lv_obj_set_pos(list, x, y);
+    lv_obj_set_size(list, w, h);
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_t * btn = lv_list_add_btn(list, LV_SYMBOL_FILE, "Item");
+        lv_obj_add_event_cb(btn, draw_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+    }
+
+    return list;
+}
+
+/*Render with and without culling and compare the results*/
+static void render_and_compare(lv_refr_occlusion_stats_t * stats_off, lv_refr_occlusion_stats_t * stats_on)
+{
+    lv_refr_occlusion_cull_enable(false);
+    lv_test_render();
+    memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_refr_get_occlusion_stats(stats_off);
+
+    lv_refr_occlusion_cull_enable(true);
+    lv_test_render();
+    lv_refr_get_occlusion_stats(stats_on);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+#endif /*LV_USE_OCCLUSION_CULL*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_USE_OCCLUSION_CULL
+    draw_cnt = 0;
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+#if LV_USE_OCCLUSION_CULL
+    lv_refr_occlusion_cull_enable(true);
+    lv_trace_stop();
+    lv_trace_clear();
+#endif
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_occlusion_cull_hidden_list(void)
+{
+#if LV_USE_OCCLUSION_CULL
+    list_create(50, 50, 300, 380);
+    lv_test_card_create(lv_scr_act(), 0, 0, 400, VER_RES);
+
+    lv_refr_occlusion_stats_t stats_off;
+    lv_refr_occlusion_stats_t stats_on;
+
+    lv_refr_occlusion_cull_enable(false);
+    lv_test_render();
+    lv_refr_get_occlusion_stats(&stats_off);
+    TEST_ASSERT_GREATER_THAN(0, draw_cnt);
+
+    /*The buttons are not drawn at all*/
+    draw_cnt = 0;
+    lv_refr_occlusion_cull_enable(true);
+    lv_test_render();
+    lv_refr_get_occlusion_stats(&stats_on);
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt);
+
+    TEST_ASSERT_EQUAL_UINT32(HOR_RES * VER_RES, stats_on.area_px);
+    TEST_ASSERT_EQUAL_UINT32(0, stats_off.culled_px);
+    TEST_ASSERT_GREATER_THAN(0, stats_on.culled_px);
+    TEST_ASSERT_EQUAL_UINT32(stats_off.drawn_px, stats_on.drawn_px + stats_on.culled_px);
+#endif
+}
+
+void test_occlusion_cull_same_result(void)
+{
+#if LV_USE_OCCLUSION_CULL
+    /*Stacked opaque containers partially covering each other*/
+    list_create(20, 20, 360, 440);
+    lv_obj_t * panel = lv_test_card_create(lv_scr_act(), 0, 0, HOR_RES, 200);
+    lv_obj_set_style_bg_color(panel, lv_palette_main(LV_PALETTE_BLUE), 0);
+
+    lv_obj_t * card = lv_test_card_create(lv_scr_act(), 300, 100, 450, 330);
+    lv_obj_set_style_radius(card, 30, 0);
+    lv_obj_set_style_shadow_width(card, 20, 0);
+    lv_obj_t * label = lv_label_create(card);
+    lv_label_set_text(label, "Card on top");
+
+    /*Its children are masked by the rounded corners: they don't cover anything*/
+    lv_obj_t * clip_cont = lv_test_card_create(card, 20, 40, 300, 200);
+    lv_obj_set_style_radius(clip_cont, 40, 0);
+    lv_obj_set_style_clip_corner(clip_cont, true, 0);
+    lv_obj_t * inner = lv_test_card_create(clip_cont, -20, -20, 400, 300);
+    lv_obj_set_style_bg_color(inner, lv_palette_main(LV_PALETTE_RED), 0);
+
+    lv_refr_occlusion_stats_t stats_off;
+    lv_refr_occlusion_stats_t stats_on;
+    render_and_compare(&stats_off, &stats_on);
+
+    TEST_ASSERT_GREATER_THAN(0, stats_on.culled_px);
+    TEST_ASSERT_LESS_THAN(stats_off.drawn_px, stats_on.drawn_px);
+#endif
+}
+
+void test_occlusion_cull_partially_covered(void)
+{
+#if LV_USE_OCCLUSION_CULL
+    /*The top half of the list is covered on its full width: only the bottom is drawn*/
+    list_create(100, 40, 400, 400);
+    lv_obj_t * card = lv_test_card_create(lv_scr_act(), 50, 0, 500, 240);
+    lv_obj_set_style_radius(card, 0, 0);
+
+    lv_refr_occlusion_stats_t stats_off;
+    lv_refr_occlusion_stats_t stats_on;
+    render_and_compare(&stats_off, &stats_on);
+
+    /*The list and the screen are clipped*/
+    TEST_ASSERT_GREATER_OR_EQUAL(400 * 200, stats_on.culled_px);
+    TEST_ASSERT_EQUAL_UINT32(stats_off.drawn_px, stats_on.drawn_px + stats_on.culled_px);
+#endif
+}
+
+void test_occlusion_cull_semi_transparent_cover(void)
+{
+#if LV_USE_OCCLUSION_CULL
+    list_create(50, 50, 300, 380);
+    lv_obj_t * card = lv_test_card_create(lv_scr_act(), 0, 0, 400, VER_RES);
+    lv_obj_set_style_bg_opa(card, LV_OPA_50, 0);
+
+    /*The list is visible through the card*/
+    lv_refr_occlusion_stats_t stats_off;
+    lv_refr_occlusion_stats_t stats_on;
+    render_and_compare(&stats_off, &stats_on);
+    TEST_ASSERT_GREATER_THAN(0, draw_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats_on.culled_px);
+#endif
+}
+
+void test_occlusion_cull_trace_counters(void)
+{
+#if LV_USE_OCCLUSION_CULL
+    list_create(50, 50, 300, 380);
+    lv_test_card_create(lv_scr_act(), 0, 0, 400, VER_RES);
+
+    lv_trace_start();
+    lv_test_render();
+    lv_trace_stop();
+
+    json_len = 0;
+    lv_trace_export(write_cb, NULL);
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"name\":\"overdraw %\",\"ph\":\"C\""));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"name\":\"culled px\",\"ph\":\"C\""));
+#endif
+}
+
+#endif
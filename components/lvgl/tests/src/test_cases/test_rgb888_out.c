@@ -0,0 +1,231 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+#include <string.h>
+
+#if LV_COLOR_RGB888_OUT
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+static uint8_t buf888[HOR_RES * VER_RES * 3];
+static uint8_t out888[HOR_RES * VER_RES * 3];
+static uint8_t ref888[HOR_RES * VER_RES * 3];
+static lv_disp_draw_buf_t draw_buf888;
+static lv_disp_draw_buf_t * draw_buf_ori;
+static void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *);
+static uint32_t flush_cnt;
+
+static void flush_cb_888(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    /*The pixels of the area are packed after each other*/
+    const uint8_t * src = (const uint8_t *)color_p;
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&out888[(y * HOR_RES + area->x1) * 3], src, w * 3);
+        src += w * 3;
+    }
+
+    flush_cnt++;
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void render_565_path(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES; i++) {
+        lv_draw_sw_rgb888_set(&ref888[i * 3], test_fb[i]);
+    }
+}
+
+static void render_rgb888(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->rgb888_out = 1;
+    drv->draw_buf = &draw_buf888;
+    drv->flush_cb = flush_cb_888;
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    drv->rgb888_out = 0;
+    drv->draw_buf = draw_buf_ori;
+    drv->flush_cb = flush_cb_ori;
+}
+
+static void create_scene(void)
+{
+    static lv_color_t img_map[32 * 32 * LV_IMG_PX_SIZE_ALPHA_BYTE / sizeof(lv_color_t) + 1];
+    static lv_img_dsc_t img_dsc;
+    uint8_t * px = (uint8_t *)img_map;
+    uint32_t i;
+    for(i = 0; i < 32 * 32; i++) {
+        lv_color_t c = lv_color_hsv_to_rgb((i * 7) % 360, 80, 90);
+        lv_memcpy(px, &c, sizeof(lv_color_t));
+        px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = (uint8_t)(i % 32 * 8);
+        px += LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img_dsc.header.w = 32;
+    img_dsc.header.h = 32;
+    img_dsc.data_size = 32 * 32 * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    img_dsc.data = (const uint8_t *)img_map;
+
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_palette_lighten(LV_PALETTE_BLUE_GREY, 3), 0);
+
+    lv_obj_t * card = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(card, 300, 200);
+    lv_obj_set_pos(card, 30, 30);
+    lv_obj_set_style_radius(card, 24, 0);
+    lv_obj_set_style_shadow_width(card, 30, 0);
+    lv_obj_set_style_bg_grad_color(card, lv_palette_main(LV_PALETTE_TEAL), 0);
+    lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_border_width(card, 5, 0);
+    lv_obj_set_style_border_opa(card, LV_OPA_60, 0);
+
+    lv_obj_t * label = lv_label_create(card);
+    lv_label_set_text(label, "Packed RGB output\nSecond line");
+
+#if LV_FONT_MONTSERRAT_12_SUBPX
+    lv_obj_t * label_subpx = lv_label_create(card);
+    lv_obj_set_style_text_font(label_subpx, &lv_font_montserrat_12_subpx, 0);
+    lv_label_set_text(label_subpx, "Sub-pixel rendered text");
+    lv_obj_align(label_subpx, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+#endif
+
+    lv_obj_t * semi = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(semi, 200, 120);
+    lv_obj_set_pos(semi, 250, 150);
+    lv_obj_set_style_bg_color(semi, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_opa(semi, LV_OPA_40, 0);
+    lv_obj_set_style_radius(semi, LV_RADIUS_CIRCLE, 0);
+
+    lv_obj_t * additive = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(additive, 150, 150);
+    lv_obj_set_pos(additive, 400, 60);
+    lv_obj_set_style_bg_color(additive, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_set_style_blend_mode(additive, LV_BLEND_MODE_ADDITIVE, 0);
+
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_obj_set_pos(btn, 600, 50);
+    lv_obj_t * btn_label = lv_label_create(btn);
+    lv_label_set_text(btn_label, "Button");
+
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_obj_set_size(arc, 150, 150);
+    lv_obj_set_pos(arc, 50, 290);
+    lv_arc_set_value(arc, 70);
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, 300, 330);
+
+    lv_obj_t * img_rot = lv_img_create(lv_scr_act());
+    lv_img_set_src(img_rot, &img_dsc);
+    lv_obj_set_pos(img_rot, 400, 330);
+    lv_img_set_angle(img_rot, 300);
+    lv_img_set_zoom(img_rot, 400);
+
+    static lv_point_t points[] = {{0, 0}, {100, 60}, {200, 10}};
+    lv_obj_t * line = lv_line_create(lv_scr_act());
+    lv_line_set_points(line, points, 3);
+    lv_obj_set_style_line_width(line, 7, 0);
+    lv_obj_set_style_line_rounded(line, true, 0);
+    lv_obj_set_pos(line, 520, 300);
+}
+
+#endif /*LV_COLOR_RGB888_OUT*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_COLOR_RGB888_OUT
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    draw_buf_ori = drv->draw_buf;
+    flush_cb_ori = drv->flush_cb;
+    lv_disp_draw_buf_init(&draw_buf888, buf888, NULL, HOR_RES * VER_RES);
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+#if LV_COLOR_RGB888_OUT
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->rgb888_out = 0;
+    drv->draw_buf = draw_buf_ori;
+    drv->flush_cb = flush_cb_ori;
+#endif
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_rgb888_out_same_as_565_path(void)
+{
+#if LV_COLOR_RGB888_OUT
+    create_scene();
+
+    render_565_path();
+    render_rgb888();
+
+    TEST_ASSERT_EQUAL_MEMORY(ref888, out888, sizeof(out888));
+#endif
+}
+
+void test_rgb888_out_partial_update(void)
+{
+#if LV_COLOR_RGB888_OUT
+    create_scene();
+    render_rgb888();
+
+    /*Redraw only a small area on the previous content*/
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->rgb888_out = 1;
+    drv->draw_buf = &draw_buf888;
+    drv->flush_cb = flush_cb_888;
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "12:34");
+    lv_obj_set_pos(label, 100, 250);
+    flush_cnt = 0;
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN(0, flush_cnt);
+
+    drv->rgb888_out = 0;
+    drv->draw_buf = draw_buf_ori;
+    drv->flush_cb = flush_cb_ori;
+
+    render_565_path();
+    TEST_ASSERT_EQUAL_MEMORY(ref888, out888, sizeof(out888));
+#endif
+}
+
+void test_rgb888_out_565_packing(void)
+{
+#if LV_COLOR_RGB888_OUT && LV_COLOR_16_SWAP == 0
+    /*The same bytes as the RGB565 -> RGB666 conversion of the ILI9488's old flush_cb*/
+    uint32_t i;
+    for(i = 0; i <= 0xFFFF; i++) {
+        uint16_t ld = (uint16_t)i;
+        uint8_t ref[3];
+        ref[0] = (uint8_t)(((ld & 0xF800) >> 8) | ((ld & 0x8000) >> 13));
+        ref[1] = (uint8_t)((ld & 0x07E0) >> 3);
+        ref[2] = (uint8_t)(((ld & 0x001F) << 3) | ((ld & 0x0010) >> 2));
+
+        lv_color16_t c;
+        c.full = ld;
+        uint8_t px[3];
+        lv_draw_sw_rgb888_set_16(px, c);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, px, 3);
+    }
+#endif
+}
+
+#endif
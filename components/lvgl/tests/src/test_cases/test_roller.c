@@ -0,0 +1,166 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_indev.h"
+
+#define MANY_OPT_CNT    1000
+
+static const char * months = "January\nFebruary\nMarch\nApril\nMay\nJune\n"
+                             "July\nAugust\nSeptember\nOctober\nNovember\nDecember";
+static const char * digits = "0\n1\n2\n3\n4\n5\n6\n7\n8\n9";
+
+static char many_opts[MANY_OPT_CNT * 8];
+
+void setUp(void)
+{
+    /* Function run before every test */
+    uint32_t i;
+    char * p = many_opts;
+    for(i = 0; i < MANY_OPT_CNT; i++) {
+        p += lv_snprintf(p, sizeof(many_opts) - (p - many_opts), i == 0 ? "%d" : "\n%d", i);
+    }
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_roller_render(void)
+{
+#if LV_FONT_MONTSERRAT_16 && LV_FONT_MONTSERRAT_18 && LV_FONT_MONTSERRAT_24
+    lv_obj_t * roller1 = lv_roller_create(lv_scr_act());
+    lv_obj_set_pos(roller1, 10, 10);
+
+    lv_obj_t * roller2 = lv_roller_create(lv_scr_act());
+    lv_roller_set_options(roller2, digits, LV_ROLLER_MODE_INFINITE);
+    lv_roller_set_visible_row_count(roller2, 5);
+    lv_roller_set_selected(roller2, 8, LV_ANIM_OFF);
+    lv_obj_set_pos(roller2, 150, 10);
+
+    /*Larger selected font, line space and a roller narrower than the options*/
+    lv_obj_t * roller3 = lv_roller_create(lv_scr_act());
+    lv_roller_set_options(roller3, months, LV_ROLLER_MODE_NORMAL);
+    lv_obj_set_style_text_font(roller3, &lv_font_montserrat_24, LV_PART_SELECTED);
+    lv_obj_set_style_text_line_space(roller3, 10, 0);
+    lv_obj_set_style_text_align(roller3, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_width(roller3, 100);
+    lv_roller_set_selected(roller3, 8, LV_ANIM_OFF);
+    lv_obj_set_pos(roller3, 250, 10);
+
+    lv_obj_t * roller4 = lv_roller_create(lv_scr_act());
+    lv_roller_set_options(roller4, months, LV_ROLLER_MODE_INFINITE);
+    lv_obj_set_style_text_align(roller4, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_obj_set_style_text_font(roller4, &lv_font_montserrat_18, 0);
+    lv_roller_set_visible_row_count(roller4, 7);
+    lv_roller_set_selected(roller4, 1, LV_ANIM_OFF);
+    lv_obj_set_pos(roller4, 400, 10);
+
+    lv_obj_t * roller5 = lv_roller_create(lv_scr_act());
+    lv_roller_set_options(roller5, many_opts, LV_ROLLER_MODE_NORMAL);
+    lv_roller_set_selected(roller5, 500, LV_ANIM_OFF);
+    lv_obj_set_pos(roller5, 550, 10);
+
+    lv_obj_t * roller6 = lv_roller_create(lv_scr_act());
+    lv_roller_set_options(roller6, "#ff0000 Red#\nGreen\n#0000ff Blue#\nLast", LV_ROLLER_MODE_NORMAL);
+    lv_label_set_recolor(lv_obj_get_child(roller6, 0), true);
+    lv_obj_set_style_text_font(roller6, &lv_font_montserrat_16, LV_PART_SELECTED);
+    lv_roller_set_selected(roller6, 3, LV_ANIM_OFF);
+    lv_obj_set_pos(roller6, 10, 250);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("roller_1.png");
+#endif
+}
+
+void test_roller_options_are_stored_once(void)
+{
+    lv_obj_t * roller = lv_roller_create(lv_scr_act());
+    lv_roller_set_options(roller, months, LV_ROLLER_MODE_INFINITE);
+    TEST_ASSERT_EQUAL_STRING(months, lv_roller_get_options(roller));
+    TEST_ASSERT_EQUAL_UINT16(12, lv_roller_get_option_cnt(roller));
+
+    char buf[32];
+    lv_roller_set_selected(roller, 11, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT16(11, lv_roller_get_selected(roller));
+    lv_roller_get_selected_str(roller, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("December", buf);
+
+    /*Too small buffer*/
+    lv_roller_get_selected_str(roller, buf, 4);
+    TEST_ASSERT_EQUAL_STRING("Dec", buf);
+
+    /*Set its own options again*/
+    lv_roller_set_options(roller, lv_roller_get_options(roller), LV_ROLLER_MODE_NORMAL);
+    TEST_ASSERT_EQUAL_STRING(months, lv_roller_get_options(roller));
+    lv_roller_get_selected_str(roller, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("January", buf);
+
+    lv_roller_set_options(roller, "", LV_ROLLER_MODE_NORMAL);
+    TEST_ASSERT_EQUAL_UINT16(1, lv_roller_get_option_cnt(roller));
+    lv_roller_get_selected_str(roller, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("", buf);
+}
+
+void test_roller_many_options(void)
+{
+    lv_obj_pool_flush();
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor(&mon1);
+
+    lv_obj_t * roller = lv_roller_create(lv_scr_act());
+    lv_roller_set_options(roller, many_opts, LV_ROLLER_MODE_INFINITE);
+    TEST_ASSERT_EQUAL_UINT16(MANY_OPT_CNT, lv_roller_get_option_cnt(roller));
+
+    lv_roller_set_selected(roller, 999, LV_ANIM_OFF);
+    char buf[8];
+    lv_roller_get_selected_str(roller, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("999", buf);
+
+    /*The label is as large as the options on all the pages*/
+    lv_obj_update_layout(roller);
+    lv_obj_t * label = lv_obj_get_child(roller, 0);
+    const lv_font_t * font = lv_obj_get_style_text_font(roller, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(roller, LV_PART_MAIN);
+    lv_coord_t row_h = lv_font_get_line_height(font) + line_space;
+    TEST_ASSERT_EQUAL_INT(MANY_OPT_CNT * LV_ROLLER_INF_PAGES * row_h - line_space, lv_obj_get_height(label));
+
+    lv_obj_del(roller);
+    lv_obj_pool_flush();
+
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_EQUAL_UINT32(mon1.free_size, mon2.free_size);
+}
+
+void test_roller_click_selects_the_row(void)
+{
+    lv_obj_t * roller = lv_roller_create(lv_scr_act());
+    lv_roller_set_options(roller, digits, LV_ROLLER_MODE_INFINITE);
+    lv_roller_set_visible_row_count(roller, 5);
+    lv_obj_set_style_anim_time(roller, 0, 0);
+    lv_obj_set_pos(roller, 100, 100);
+    lv_obj_update_layout(roller);
+
+    const lv_font_t * font = lv_obj_get_style_text_font(roller, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(roller, LV_PART_MAIN);
+    lv_coord_t row_h = lv_font_get_line_height(font) + line_space;
+    lv_coord_t mid_y = roller->coords.y1 + lv_obj_get_height(roller) / 2;
+
+    /*Two rows below the selected (0)*/
+    lv_test_mouse_click_at(roller->coords.x1 + 10, mid_y + 2 * row_h);
+    TEST_ASSERT_EQUAL_UINT16(2, lv_roller_get_selected(roller));
+
+    /*Three rows above the selected (2) on the previous page*/
+    lv_test_mouse_click_at(roller->coords.x1 + 10, mid_y - 2 * row_h);
+    TEST_ASSERT_EQUAL_UINT16(0, lv_roller_get_selected(roller));
+    lv_test_mouse_click_at(roller->coords.x1 + 10, mid_y - 1 * row_h);
+    TEST_ASSERT_EQUAL_UINT16(9, lv_roller_get_selected(roller));
+
+    char buf[4];
+    lv_roller_get_selected_str(roller, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("9", buf);
+}
+
+#endif
@@ -0,0 +1,130 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <string.h>
+
+#if LV_DRAW_COMPLEX
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+
+static lv_obj_t * card_create(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, lv_coord_t radius,
+                              lv_coord_t shadow_w)
+{
+    lv_obj_t * obj = lv_test_card_create(lv_scr_act(), x, y, w, h);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_shadow_width(obj, shadow_w, 0);
+    lv_obj_set_style_shadow_ofs_y(obj, 4, 0);
+    return obj;
+}
+
+#endif /*LV_DRAW_COMPLEX*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_DRAW_COMPLEX
+    lv_draw_sw_shadow_cache_clear();
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_shadow_cache_same_result(void)
+{
+#if LV_DRAW_COMPLEX
+    card_create(40, 40, 200, 120, 10, 20);
+    card_create(300, 40, 200, 120, 20, 30);
+    card_create(560, 40, 200, 120, 0, 15);
+    /*Same corner as the first card*/
+    card_create(40, 260, 300, 160, 10, 20);
+
+    lv_test_render();
+    memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_draw_sw_shadow_cache_stats_t stats_ori;
+    lv_draw_sw_shadow_cache_get_stats(&stats_ori);
+    TEST_ASSERT_EQUAL_UINT32(3, stats_ori.entry_cnt);
+
+    lv_test_render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Nothing was blurred again*/
+    lv_draw_sw_shadow_cache_stats_t stats;
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.miss_cnt, stats.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(stats_ori.hit_cnt, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.size, stats.size);
+#endif
+}
+
+void test_shadow_cache_small_objects(void)
+{
+#if LV_DRAW_COMPLEX
+    /*The size of small objects changes the corner too*/
+    lv_obj_t * obj = card_create(100, 100, 10, 10, 0, 40);
+    lv_test_render();
+
+    lv_obj_set_size(obj, 16, 30);
+    lv_test_render();
+    memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_draw_sw_shadow_cache_stats_t stats;
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+
+    lv_draw_sw_shadow_cache_clear();
+    lv_test_render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+#endif
+}
+
+void test_shadow_cache_evict(void)
+{
+#if LV_DRAW_COMPLEX
+    /*110 * 110 bytes: only one of them fits into LV_SHADOW_CACHE_BUF_MAX_SIZE*/
+    lv_obj_t * obj1 = card_create(50, 50, 250, 250, 10, 100);
+    lv_test_render();
+    lv_obj_add_flag(obj1, LV_OBJ_FLAG_HIDDEN);
+
+    card_create(450, 50, 250, 250, 12, 100);
+    lv_test_render();
+
+    lv_draw_sw_shadow_cache_stats_t stats;
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(112 * 112, stats.size);
+    TEST_ASSERT_LESS_OR_EQUAL(LV_SHADOW_CACHE_BUF_MAX_SIZE, stats.size);
+#endif
+}
+
+void test_shadow_cache_too_large(void)
+{
+#if LV_DRAW_COMPLEX
+    lv_draw_sw_shadow_cache_stats_t stats_ori;
+    lv_draw_sw_shadow_cache_get_stats(&stats_ori);
+
+    card_create(200, 100, 300, 250, 10, 200);
+    lv_test_render();
+    lv_test_render();
+
+    lv_draw_sw_shadow_cache_stats_t stats;
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.hit_cnt, stats.hit_cnt);
+#endif
+}
+
+#endif
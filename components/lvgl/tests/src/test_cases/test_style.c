@@ -106,4 +106,93 @@ void test_inherit_meta_with_lower_precedence_style(void)
     TEST_ASSERT_EQUAL_HEX(lv_color_hex(0xff0000).full, lv_obj_get_style_text_color(grandchild, LV_PART_MAIN).full);
 }
 
+void test_style_many_props(void)
+{
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor(&mon1);
+
+    lv_style_t style;
+    lv_style_init(&style);
+
+    /*Add the odd properties in a mixed order*/
+    uint32_t prop_cnt = _LV_STYLE_LAST_BUILT_IN_PROP;
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_prop_t prop = (i * 53) % prop_cnt + 1;
+        if(prop & 1) {
+            lv_style_value_t v = {.num = prop * 3};
+            lv_style_set_prop(&style, prop, v);
+        }
+    }
+
+    /*The even properties are not found even if their lower bits are the same as an odd one's*/
+    lv_style_value_t v;
+    lv_style_prop_t prop;
+    for(prop = 1; prop <= prop_cnt; prop++) {
+        v.num = -1;
+        if(prop & 1) {
+            TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, prop, &v));
+            TEST_ASSERT_EQUAL(prop * 3, v.num);
+        }
+        else {
+            TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, prop, &v));
+            TEST_ASSERT_EQUAL(-1, v.num);
+        }
+    }
+
+    /*Overwrite, set meta, remove and add again*/
+    v.num = 1000;
+    lv_style_set_prop(&style, 65, v);
+    lv_style_set_prop_meta(&style, 1, LV_STYLE_PROP_META_INHERIT);
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, 3));
+    TEST_ASSERT_FALSE(lv_style_remove_prop(&style, 4));
+    lv_style_set_prop(&style, 4, v);
+
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 65, &v));
+    TEST_ASSERT_EQUAL(1000, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_INHERIT, lv_style_get_prop(&style, 1, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, 3, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 4, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 5, &v));
+    TEST_ASSERT_EQUAL(15, v.num);
+
+    /*Remove everything from the end and from the beginning*/
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_prop_t to_remove = (i & 1) ? prop_cnt - i / 2 : i / 2 + 1;
+        lv_style_remove_prop(&style, to_remove);
+        TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, to_remove, &v));
+    }
+    TEST_ASSERT_TRUE(lv_style_is_empty(&style));
+    lv_style_reset(&style);
+
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_EQUAL_UINT32(mon1.free_size, mon2.free_size);
+}
+
+void test_style_two_props(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_width(&style, 10);
+    lv_style_set_height(&style, 20);
+    lv_style_set_x(&style, 30);
+    TEST_ASSERT_EQUAL(3, style.prop_cnt);
+
+    lv_style_value_t v;
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_X));
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_WIDTH));
+    TEST_ASSERT_EQUAL(1, style.prop_cnt);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_HEIGHT, &v));
+    TEST_ASSERT_EQUAL(20, v.num);
+
+    /*Add a property with lower ID than the existing one*/
+    lv_style_set_width(&style, 40);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_WIDTH, &v));
+    TEST_ASSERT_EQUAL(40, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_HEIGHT, &v));
+    TEST_ASSERT_EQUAL(20, v.num);
+    lv_style_reset(&style);
+}
+
 #endif
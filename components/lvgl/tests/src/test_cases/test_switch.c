@@ -64,6 +64,7 @@ void test_switch_should_not_leak_memory_after_deletion(void)
     for(idx = 0; idx < SWITCHES_CNT; idx++) {
         lv_obj_del(switches[idx]);
     }
+    lv_obj_pool_flush();
 
     lv_mem_monitor(&monitor);
     final_available_memory = monitor.free_size;
@@ -0,0 +1,165 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <string.h>
+
+#if LV_USE_TRACE
+
+static char json[64 * 1024];
+static uint32_t json_len;
+
+static lv_res_t write_cb(const char * buf, uint32_t len, void * user_data)
+{
+    LV_UNUSED(user_data);
+    if(json_len + len >= sizeof(json)) return LV_RES_INV;
+    memcpy(&json[json_len], buf, len);
+    json_len += len;
+    json[json_len] = '\0';
+    return LV_RES_OK;
+}
+
+static uint32_t count(const char * str)
+{
+    uint32_t cnt = 0;
+    const char * p = json;
+    while((p = strstr(p, str)) != NULL) {
+        cnt++;
+        p += strlen(str);
+    }
+    return cnt;
+}
+
+static lv_res_t failing_write_cb(const char * buf, uint32_t len, void * user_data)
+{
+    LV_UNUSED(buf);
+    LV_UNUSED(len);
+    uint32_t * calls = user_data;
+    (*calls)++;
+    return LV_RES_INV;
+}
+
+#endif /*LV_USE_TRACE*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_USE_TRACE
+    json_len = 0;
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_TRACE
+    lv_trace_stop();
+    lv_trace_clear();
+#endif
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_trace_records_refresh(void)
+{
+#if LV_USE_TRACE
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Trace");
+    lv_refr_now(NULL);
+
+    lv_trace_start();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_trace_stop();
+
+    uint32_t cnt = lv_trace_export(write_cb, NULL);
+    TEST_ASSERT_GREATER_THAN(0, cnt);
+    TEST_ASSERT_EQUAL_STRING_LEN("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", json, 39);
+    TEST_ASSERT_EQUAL_STRING("\n]}\n", &json[json_len - 4]);
+
+    TEST_ASSERT_GREATER_THAN(0, count("\"name\":\"layout\""));
+    TEST_ASSERT_GREATER_THAN(0, count("\"name\":\"refr_area\""));
+    TEST_ASSERT_GREATER_THAN(0, count("\"name\":\"flush_cb\""));
+    TEST_ASSERT_GREATER_THAN(0, count("\"name\":\"draw_rect\""));
+    TEST_ASSERT_GREATER_THAN(0, count("\"name\":\"draw_label\""));
+    TEST_ASSERT_GREATER_THAN(0, count("\"name\":\"btn\""));
+    TEST_ASSERT_GREATER_THAN(0, count("\"name\":\"label\""));
+
+    /*Every span is closed*/
+    TEST_ASSERT_EQUAL_UINT32(count("\"ph\":\"B\""), count("\"ph\":\"E\""));
+    TEST_ASSERT_EQUAL_UINT32(cnt, count("\"ph\":"));
+#endif
+}
+
+void test_trace_custom_class_uses_base_name(void)
+{
+#if LV_USE_TRACE
+    static const lv_obj_class_t my_class = {
+        .base_class = &lv_btn_class,
+    };
+
+    lv_obj_t * obj = lv_obj_class_create_obj(&my_class, lv_scr_act());
+    lv_obj_class_init_obj(obj);
+    lv_refr_now(NULL);
+
+    lv_trace_start();
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    lv_trace_stop();
+
+    lv_trace_export(write_cb, NULL);
+    TEST_ASSERT_GREATER_THAN(0, count("\"name\":\"btn\""));
+    TEST_ASSERT_EQUAL_UINT32(0, count("unknown"));
+#endif
+}
+
+void test_trace_ring_keeps_last_events(void)
+{
+#if LV_USE_TRACE
+    uint32_t i;
+    for(i = 0; i < 10; i++) lv_btn_create(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_trace_start();
+    for(i = 0; i < 3 * LV_TRACE_BUF_SIZE / 10; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    lv_trace_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(LV_TRACE_BUF_SIZE, lv_trace_export(write_cb, NULL));
+
+    lv_trace_clear();
+    json_len = 0;
+    TEST_ASSERT_EQUAL_UINT32(0, lv_trace_export(write_cb, NULL));
+#endif
+}
+
+void test_trace_not_recording_when_stopped(void)
+{
+#if LV_USE_TRACE
+    lv_btn_create(lv_scr_act());
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, lv_trace_export(write_cb, NULL));
+#endif
+}
+
+void test_trace_export_stops_on_error(void)
+{
+#if LV_USE_TRACE
+    uint32_t i;
+    for(i = 0; i < 10; i++) lv_btn_create(lv_scr_act());
+    lv_trace_start();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_trace_stop();
+
+    uint32_t calls = 0;
+    uint32_t cnt = lv_trace_export(failing_write_cb, &calls);
+    TEST_ASSERT_EQUAL_UINT32(1, calls);
+    TEST_ASSERT_LESS_THAN(lv_trace_export(write_cb, NULL), cnt);
+#endif
+}
+
+#endif
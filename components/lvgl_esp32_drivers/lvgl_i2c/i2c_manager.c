@@ -33,6 +33,7 @@ SOFTWARE.
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "freertos/task.h"
 #include <driver/i2c.h>
 
@@ -47,6 +48,9 @@ SOFTWARE.
 		#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 3, 0)
 			#define HAS_CLK_FLAGS
 		#endif
+		#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 4, 0)
+			#define HAS_STATIC_CMD_LINK
+		#endif
 		/* ESP-IDF v5.1 Define */
 		#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
 			#define I2C_NUM_MAX		(2)
@@ -62,8 +66,28 @@ static const char* TAG = I2C_TAG;
 static SemaphoreHandle_t I2C_FN(_local_mutex)[2] = { NULL, NULL };
 static SemaphoreHandle_t* I2C_FN(_mutex) = &I2C_FN(_local_mutex)[0];
 
+// Guards publishing a port's mutex and async worker, so concurrent first users create them once.
+static portMUX_TYPE I2C_FN(_init_spinlock) = portMUX_INITIALIZER_UNLOCKED;
+
 static const uint8_t ACK_CHECK_EN = 1;
 
+#if defined (HAS_STATIC_CMD_LINK)
+	// Address + register, repeated start, read. One spare transaction covers
+	// 10-bit addresses and 16-bit registers.
+	#define I2C_CMD_LINK_SIZE	I2C_LINK_RECOMMENDED_SIZE(3)
+	// One command link buffer per port, only touched while the port lock is held.
+	static uint8_t I2C_FN(_cmd_buf)[2][I2C_CMD_LINK_SIZE];
+#endif
+
+static esp_err_t i2c_bus_xfer_idf(const I2C_FN(_xfer_t) *xfer, TickType_t timeout);
+static I2C_FN(_bus_xfer_t) I2C_FN(_bus_xfer) = i2c_bus_xfer_idf;
+
+#if defined (CONFIG_I2C_MANAGER_ASYNC)
+	static bool i2c_async_started(i2c_port_t port);
+	static esp_err_t i2c_async_start(i2c_port_t port);
+	static void i2c_async_stop(i2c_port_t port);
+#endif
+
 #if defined (I2C_NUM_0) && defined (CONFIG_I2C_MANAGER_0_ENABLED)
 	#define I2C_ZERO 					I2C_NUM_0
 	#if defined (CONFIG_I2C_MANAGER_0_PULLUPS)
@@ -126,74 +150,106 @@ static void i2c_send_register(i2c_cmd_handle_t cmd, uint32_t reg) {
     i2c_master_write_byte(cmd, reg & 0xFF, ACK_CHECK_EN);
 }
 
-esp_err_t I2C_FN(_init)(i2c_port_t port) {
-
-	I2C_PORT_CHECK(port, ESP_FAIL);
+static esp_err_t i2c_driver_start(i2c_port_t port) {
 
-	esp_err_t ret = ESP_OK;
+	ESP_LOGI(TAG, "Starting I2C master at port %d.", (int)port);
 
-	if (I2C_FN(_mutex)[port] == 0) {
+	i2c_config_t conf = {0};
+	
+	#ifdef HAS_CLK_FLAGS
+		conf.clk_flags = 0;
+	#endif
 
-		ESP_LOGI(TAG, "Starting I2C master at port %d.", (int)port);
+	#if defined (I2C_ZERO)
+		if (port == I2C_NUM_0) {
+			conf.sda_io_num = CONFIG_I2C_MANAGER_0_SDA;
+			conf.scl_io_num = CONFIG_I2C_MANAGER_0_SCL;
+			conf.sda_pullup_en = I2C_MANAGER_0_PULLUPS ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
+			conf.scl_pullup_en = conf.sda_pullup_en;
+			conf.master.clk_speed = CONFIG_I2C_MANAGER_0_FREQ_HZ;
+		}
+	#endif
 
-		I2C_FN(_mutex)[port] = xSemaphoreCreateMutex();
+	#if defined (I2C_ONE)
+		if (port == I2C_NUM_1) {
+			conf.sda_io_num = CONFIG_I2C_MANAGER_1_SDA;
+			conf.scl_io_num = CONFIG_I2C_MANAGER_1_SCL;
+			conf.sda_pullup_en = I2C_MANAGER_1_PULLUPS ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
+			conf.scl_pullup_en = conf.sda_pullup_en;
+			conf.master.clk_speed = CONFIG_I2C_MANAGER_1_FREQ_HZ;
+		}
+	#endif
 
-		i2c_config_t conf = {0};
-		
-		#ifdef HAS_CLK_FLAGS
-			conf.clk_flags = 0;
-		#endif
+	conf.mode = I2C_MODE_MASTER;
 
-		#if defined (I2C_ZERO)
-			if (port == I2C_NUM_0) {
-				conf.sda_io_num = CONFIG_I2C_MANAGER_0_SDA;
-				conf.scl_io_num = CONFIG_I2C_MANAGER_0_SCL;
-				conf.sda_pullup_en = I2C_MANAGER_0_PULLUPS ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
-				conf.scl_pullup_en = conf.sda_pullup_en;
-				conf.master.clk_speed = CONFIG_I2C_MANAGER_0_FREQ_HZ;
-			}
-		#endif
+	esp_err_t ret = i2c_param_config(port, &conf);
+	ret |= i2c_driver_install(port, conf.mode, 0, 0, 0);
 
-		#if defined (I2C_ONE)
-			if (port == I2C_NUM_1) {
-				conf.sda_io_num = CONFIG_I2C_MANAGER_1_SDA;
-				conf.scl_io_num = CONFIG_I2C_MANAGER_1_SCL;
-				conf.sda_pullup_en = I2C_MANAGER_1_PULLUPS ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
-				conf.scl_pullup_en = conf.sda_pullup_en;
-				conf.master.clk_speed = CONFIG_I2C_MANAGER_1_FREQ_HZ;
-			}
-		#endif
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Failed to initialise I2C port %d.", (int)port);
+		ESP_LOGW(TAG, "If it was already open, we'll use it with whatever settings were used "
+		              "to open it. See I2C Manager README for details.");
+	} else {
+		// ESP_LOGI(TAG, "Initialised port %d (SDA: %d, SCL: %d, speed: %d Hz.)",
+		// 		 port, conf.sda_io_num, conf.scl_io_num, conf.master.clk_speed);
+	}
 
-		conf.mode = I2C_MODE_MASTER;
+	return ret;
+}
 
-		ret = i2c_param_config(port, &conf);
-		ret |= i2c_driver_install(port, conf.mode, 0, 0, 0);
+esp_err_t I2C_FN(_init)(i2c_port_t port) {
 
-		if (ret != ESP_OK) {
-			ESP_LOGE(TAG, "Failed to initialise I2C port %d.", (int)port);
-			ESP_LOGW(TAG, "If it was already open, we'll use it with whatever settings were used "
-			              "to open it. See I2C Manager README for details.");
-		} else {
-			// ESP_LOGI(TAG, "Initialised port %d (SDA: %d, SCL: %d, speed: %d Hz.)",
-			// 		 port, conf.sda_io_num, conf.scl_io_num, conf.master.clk_speed);
-		}
+	I2C_PORT_CHECK(port, ESP_FAIL);
 
-	}
+	esp_err_t ret = ESP_OK;
 
-    return ret;
-}
+	if (I2C_FN(_mutex)[port] == 0) {
 
-esp_err_t I2C_FN(_read)(i2c_port_t port, uint16_t addr, uint32_t reg, uint8_t *buffer, uint16_t size) {
+		// The mutex is published already taken, so that tasks starting to use
+		// the port at the same time wait until the driver is installed.
+		SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+		if (mutex == NULL) {
+			ESP_LOGE(TAG, "Failed to create mutex for port %d.", (int)port);
+			return ESP_ERR_NO_MEM;
+		}
+		xSemaphoreTake(mutex, portMAX_DELAY);
 
-	I2C_PORT_CHECK(port, ESP_FAIL);
+		taskENTER_CRITICAL(&I2C_FN(_init_spinlock));
+		bool first = I2C_FN(_mutex)[port] == NULL;
+		if (first) {
+			I2C_FN(_mutex)[port] = mutex;
+		}
+		taskEXIT_CRITICAL(&I2C_FN(_init_spinlock));
 
-    esp_err_t result;
+		if (first) {
+			ret = i2c_driver_start(port);
+			xSemaphoreGive(mutex);
+		} else {
+			xSemaphoreGive(mutex);
+			vSemaphoreDelete(mutex);
+		}
+	}
 
-    // May seem weird, but init starts with a check if it's needed, no need for that check twice.
-	I2C_FN(_init)(port);
+	#if defined (CONFIG_I2C_MANAGER_ASYNC)
+		if (!i2c_async_started(port)) {
+			if (I2C_FN(_lock)(port) != ESP_OK) {
+				return ESP_ERR_TIMEOUT;
+			}
+			// Check again, an other task may have started it while we waited for the lock.
+			if (!i2c_async_started(port)) {
+				esp_err_t async_ret = i2c_async_start(port);
+				if (ret == ESP_OK) {
+					ret = async_ret;
+				}
+			}
+			I2C_FN(_unlock)(port);
+		}
+	#endif
 
-   	// ESP_LOGV(TAG, "Reading port %d, addr 0x%03x, reg 0x%04x", port, addr, reg);
+    return ret;
+}
 
+static TickType_t i2c_xfer_timeout(i2c_port_t port) {
 	TickType_t timeout = 0;
 	#if defined (I2C_ZERO)
 		if (port == I2C_NUM_0) {
@@ -205,25 +261,59 @@ esp_err_t I2C_FN(_read)(i2c_port_t port, uint16_t addr, uint32_t reg, uint8_t *b
 			timeout = I2C_MANAGER_1_TIMEOUT;
 		}
 	#endif
+	return timeout;
+}
+
+static esp_err_t i2c_bus_xfer_idf(const I2C_FN(_xfer_t) *xfer, TickType_t timeout) {
 
-	if (I2C_FN(_lock)((int)port) == ESP_OK) {
+	#if defined (HAS_STATIC_CMD_LINK)
+		i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(I2C_FN(_cmd_buf)[xfer->port], I2C_CMD_LINK_SIZE);
+	#else
 		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-		if (!(reg & I2C_NO_REG)) {
+	#endif
+	if (cmd == NULL) {
+		return ESP_ERR_NO_MEM;
+	}
+
+	if (xfer->write) {
+		i2c_master_start(cmd);
+		i2c_send_address(cmd, xfer->addr, I2C_MASTER_WRITE);
+		if (!(xfer->reg & I2C_NO_REG)) {
+			i2c_send_register(cmd, xfer->reg);
+		}
+		i2c_master_write(cmd, xfer->buffer, xfer->size, ACK_CHECK_EN);
+	} else {
+		if (!(xfer->reg & I2C_NO_REG)) {
 			/* When reading specific register set the addr pointer first. */
 			i2c_master_start(cmd);
-			i2c_send_address(cmd, addr, I2C_MASTER_WRITE);
-			i2c_send_register(cmd, reg);
+			i2c_send_address(cmd, xfer->addr, I2C_MASTER_WRITE);
+			i2c_send_register(cmd, xfer->reg);
 		}
 		/* Read size bytes from the current pointer. */
 		i2c_master_start(cmd);
-		i2c_send_address(cmd, addr, I2C_MASTER_READ);
-		i2c_master_read(cmd, buffer, size, I2C_MASTER_LAST_NACK);
-		i2c_master_stop(cmd);
-		result = i2c_master_cmd_begin(port, cmd, timeout);
+		i2c_send_address(cmd, xfer->addr, I2C_MASTER_READ);
+		i2c_master_read(cmd, xfer->buffer, xfer->size, I2C_MASTER_LAST_NACK);
+	}
+	i2c_master_stop(cmd);
+	esp_err_t result = i2c_master_cmd_begin(xfer->port, cmd, timeout);
+
+	#if defined (HAS_STATIC_CMD_LINK)
+		i2c_cmd_link_delete_static(cmd);
+	#else
 		i2c_cmd_link_delete(cmd);
-		I2C_FN(_unlock)((int)port);
+	#endif
+	return result;
+}
+
+static esp_err_t i2c_xfer_locked(const I2C_FN(_xfer_t) *xfer) {
+
+	esp_err_t result;
+
+	if (I2C_FN(_lock)((int)xfer->port) == ESP_OK) {
+		result = I2C_FN(_bus_xfer)(xfer, i2c_xfer_timeout(xfer->port));
+		I2C_FN(_unlock)((int)xfer->port);
 	} else {
-		ESP_LOGE(TAG, "Lock could not be obtained for port %d.", (int)port);
+		ESP_LOGE(TAG, "Lock could not be obtained for port %d.", (int)xfer->port);
 		return ESP_ERR_TIMEOUT;
 	}
 
@@ -231,62 +321,226 @@ esp_err_t I2C_FN(_read)(i2c_port_t port, uint16_t addr, uint32_t reg, uint8_t *b
     	ESP_LOGW(TAG, "Error: %d", result);
     }
 
-	ESP_LOG_BUFFER_HEX_LEVEL(TAG, buffer, size, ESP_LOG_VERBOSE);
+	ESP_LOG_BUFFER_HEX_LEVEL(TAG, xfer->buffer, xfer->size, ESP_LOG_VERBOSE);
 
     return result;
 }
 
-esp_err_t I2C_FN(_write)(i2c_port_t port, uint16_t addr, uint32_t reg, const uint8_t *buffer, uint16_t size) {
+esp_err_t I2C_FN(_read)(i2c_port_t port, uint16_t addr, uint32_t reg, uint8_t *buffer, uint16_t size) {
 
 	I2C_PORT_CHECK(port, ESP_FAIL);
 
-    esp_err_t result;
+    // May seem weird, but init starts with a check if it's needed, no need for that check twice.
+	I2C_FN(_init)(port);
+
+   	// ESP_LOGV(TAG, "Reading port %d, addr 0x%03x, reg 0x%04x", port, addr, reg);
+
+	I2C_FN(_xfer_t) xfer = {
+		.port = port,
+		.addr = addr,
+		.reg = reg,
+		.buffer = buffer,
+		.size = size,
+		.write = false,
+	};
+	return i2c_xfer_locked(&xfer);
+}
+
+esp_err_t I2C_FN(_write)(i2c_port_t port, uint16_t addr, uint32_t reg, const uint8_t *buffer, uint16_t size) {
+
+	I2C_PORT_CHECK(port, ESP_FAIL);
 
     // May seem weird, but init starts with a check if it's needed, no need for that check twice.
 	I2C_FN(_init)(port);
 
     // ESP_LOGV(TAG, "Writing port %d, addr 0x%03x, reg 0x%04x", port, addr, reg);
 
-	TickType_t timeout = 0;
-	#if defined (I2C_ZERO)
-		if (port == I2C_NUM_0) {
-			timeout = (CONFIG_I2C_MANAGER_0_TIMEOUT) / portTICK_PERIOD_MS;
+	I2C_FN(_xfer_t) xfer = {
+		.port = port,
+		.addr = addr,
+		.reg = reg,
+		.buffer = (uint8_t *)buffer,
+		.size = size,
+		.write = true,
+	};
+	return i2c_xfer_locked(&xfer);
+}
+
+void I2C_FN(_set_bus)(I2C_FN(_bus_xfer_t) xfer) {
+	I2C_FN(_bus_xfer) = xfer ? xfer : i2c_bus_xfer_idf;
+}
+
+
+#if defined (CONFIG_I2C_MANAGER_ASYNC)
+
+typedef struct {
+	I2C_FN(_xfer_t) xfer;
+	I2C_FN(_async_cb_t) cb;
+	void *user_data;
+} i2c_async_desc_t;
+
+typedef struct {
+	i2c_async_desc_t desc[CONFIG_I2C_MANAGER_ASYNC_QUEUE_LEN];
+	QueueHandle_t free_q;		// descriptors ready for reuse
+	QueueHandle_t work_q;		// descriptors waiting for the bus
+	TaskHandle_t task;
+	TaskHandle_t closer;		// notified by the worker when it stops
+	bool started;				// set by _init() once all of the above exist
+} i2c_async_port_t;
+
+static i2c_async_port_t I2C_FN(_async)[2];
+
+static void i2c_async_task(void *arg) {
+	i2c_async_port_t *ap = (i2c_async_port_t *)arg;
+	i2c_async_desc_t *desc;
+	while (1) {
+		xQueueReceive(ap->work_q, &desc, portMAX_DELAY);
+		if (desc == NULL) {
+			break;				// stop descriptor from _close()
 		}
-	#endif
-	#if defined (I2C_ONE)
-		if (port == I2C_NUM_1) {
-			timeout = (CONFIG_I2C_MANAGER_1_TIMEOUT) / portTICK_PERIOD_MS;
+		esp_err_t result = i2c_xfer_locked(&desc->xfer);
+		I2C_FN(_async_cb_t) cb = desc->cb;
+		void *user_data = desc->user_data;
+		// Hand the descriptor back first so the callback may submit the next transfer.
+		xQueueSend(ap->free_q, &desc, 0);
+		if (cb) {
+			cb(result, user_data);
 		}
-	#endif
+	}
+	xTaskNotifyGive(ap->closer);
+	vTaskDelete(NULL);
+}
 
-	if (I2C_FN(_lock)((int)port) == ESP_OK) {
-		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-		i2c_master_start(cmd);
-		i2c_send_address(cmd, addr, I2C_MASTER_WRITE);
-		if (!(reg & I2C_NO_REG)) {
-			i2c_send_register(cmd, reg);
-		}
-		i2c_master_write(cmd, (uint8_t *)buffer, size, ACK_CHECK_EN);
-		i2c_master_stop(cmd);
-		result = i2c_master_cmd_begin( port, cmd, timeout);
-		i2c_cmd_link_delete(cmd);
-		I2C_FN(_unlock)((int)port);
-	} else {
-		ESP_LOGE(TAG, "Lock could not be obtained for port %d.", (int)port);
-		return ESP_ERR_TIMEOUT;
+static bool i2c_async_started(i2c_port_t port) {
+	taskENTER_CRITICAL(&I2C_FN(_init_spinlock));
+	bool started = I2C_FN(_async)[port].started;
+	taskEXIT_CRITICAL(&I2C_FN(_init_spinlock));
+	return started;
+}
+
+static void i2c_async_free(i2c_async_port_t *ap) {
+	if (ap->free_q) {
+		vQueueDelete(ap->free_q);
+		ap->free_q = NULL;
 	}
+	if (ap->work_q) {
+		vQueueDelete(ap->work_q);
+		ap->work_q = NULL;
+	}
+}
 
-    if (result != ESP_OK) {
-    	ESP_LOGW(TAG, "Error: %d", result);
-    }
+// Called by _init() with the port lock held.
+static esp_err_t i2c_async_start(i2c_port_t port) {
+	i2c_async_port_t *ap = &I2C_FN(_async)[port];
 
-	ESP_LOG_BUFFER_HEX_LEVEL(TAG, buffer, size, ESP_LOG_VERBOSE);
+	ap->free_q = xQueueCreate(CONFIG_I2C_MANAGER_ASYNC_QUEUE_LEN, sizeof(i2c_async_desc_t *));
+	ap->work_q = xQueueCreate(CONFIG_I2C_MANAGER_ASYNC_QUEUE_LEN, sizeof(i2c_async_desc_t *));
+	if (ap->free_q == NULL || ap->work_q == NULL) {
+		ESP_LOGE(TAG, "Failed to create async queues for port %d.", (int)port);
+		i2c_async_free(ap);
+		return ESP_ERR_NO_MEM;
+	}
+	for (int i = 0; i < CONFIG_I2C_MANAGER_ASYNC_QUEUE_LEN; i++) {
+		i2c_async_desc_t *desc = &ap->desc[i];
+		xQueueSend(ap->free_q, &desc, 0);
+	}
 
-    return result;
+	if (xTaskCreate(i2c_async_task, "i2c_async", CONFIG_I2C_MANAGER_ASYNC_TASK_STACK, ap,
+	                CONFIG_I2C_MANAGER_ASYNC_TASK_PRIORITY, &ap->task) != pdPASS) {
+		ESP_LOGE(TAG, "Failed to create async task for port %d.", (int)port);
+		ap->task = NULL;
+		i2c_async_free(ap);
+		return ESP_ERR_NO_MEM;
+	}
+
+	taskENTER_CRITICAL(&I2C_FN(_init_spinlock));
+	ap->started = true;
+	taskEXIT_CRITICAL(&I2C_FN(_init_spinlock));
+	return ESP_OK;
 }
 
+// Called by _close(). The transfers queued before are finished, then the worker exits.
+static void i2c_async_stop(i2c_port_t port) {
+	i2c_async_port_t *ap = &I2C_FN(_async)[port];
+
+	taskENTER_CRITICAL(&I2C_FN(_init_spinlock));
+	bool started = ap->started;
+	ap->started = false;
+	taskEXIT_CRITICAL(&I2C_FN(_init_spinlock));
+	if (!started) {
+		return;
+	}
+
+	i2c_async_desc_t *stop = NULL;
+	ap->closer = xTaskGetCurrentTaskHandle();
+	xQueueSend(ap->work_q, &stop, portMAX_DELAY);
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+	ap->task = NULL;
+	ap->closer = NULL;
+	i2c_async_free(ap);
+}
+
+static esp_err_t i2c_async_submit(const I2C_FN(_xfer_t) *xfer, I2C_FN(_async_cb_t) cb, void *user_data) {
+
+	// May seem weird, but init starts with a check if it's needed, no need for that check twice.
+	esp_err_t ret = I2C_FN(_init)(xfer->port);
+	if (!i2c_async_started(xfer->port)) {
+		return ret != ESP_OK ? ret : ESP_FAIL;
+	}
+
+	i2c_async_port_t *ap = &I2C_FN(_async)[xfer->port];
+	i2c_async_desc_t *desc;
+	if (xQueueReceive(ap->free_q, &desc, 0) != pdTRUE) {
+		return ESP_ERR_NO_MEM;
+	}
+	desc->xfer = *xfer;
+	desc->cb = cb;
+	desc->user_data = user_data;
+	xQueueSend(ap->work_q, &desc, 0);
+	return ESP_OK;
+}
+
+esp_err_t I2C_FN(_read_async)(i2c_port_t port, uint16_t addr, uint32_t reg, uint8_t *buffer, uint16_t size,
+                              I2C_FN(_async_cb_t) cb, void *user_data) {
+
+	I2C_PORT_CHECK(port, ESP_FAIL);
+
+	I2C_FN(_xfer_t) xfer = {
+		.port = port,
+		.addr = addr,
+		.reg = reg,
+		.buffer = buffer,
+		.size = size,
+		.write = false,
+	};
+	return i2c_async_submit(&xfer, cb, user_data);
+}
+
+esp_err_t I2C_FN(_write_async)(i2c_port_t port, uint16_t addr, uint32_t reg, const uint8_t *buffer, uint16_t size,
+                               I2C_FN(_async_cb_t) cb, void *user_data) {
+
+	I2C_PORT_CHECK(port, ESP_FAIL);
+
+	I2C_FN(_xfer_t) xfer = {
+		.port = port,
+		.addr = addr,
+		.reg = reg,
+		.buffer = (uint8_t *)buffer,
+		.size = size,
+		.write = true,
+	};
+	return i2c_async_submit(&xfer, cb, user_data);
+}
+
+#endif
+
 esp_err_t I2C_FN(_close)(i2c_port_t port) {
 	I2C_PORT_CHECK(port, ESP_FAIL);
+	#if defined (CONFIG_I2C_MANAGER_ASYNC)
+		// The worker takes the port lock for each transfer, so it goes before the mutex.
+		i2c_async_stop(port);
+	#endif
     vSemaphoreDelete(I2C_FN(_mutex)[port]);
     I2C_FN(_mutex)[port] = NULL;
     ESP_LOGI(TAG, "Closing I2C master at port %d", port);
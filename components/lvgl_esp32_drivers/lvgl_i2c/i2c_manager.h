@@ -19,8 +19,12 @@ extern "C" {
 #define I2C_OEM lvgl
 
 
+#include <stdbool.h>
+
 // Only here to get the I2C_NUM_0 and I2C_NUM_1 defines.
 #include <driver/i2c.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
 
 #define CONCATX(A, B) A ## B
 #define CONCAT(A, B) CONCATX(A, B)
@@ -51,6 +55,55 @@ esp_err_t I2C_FN(_unlock)(i2c_port_t port);
 esp_err_t I2C_FN(_force_unlock)(i2c_port_t port);
 
 
+/*
+	A single bus transaction as handed to the bus backend. `write` selects
+	between a register write of `size` bytes from `buffer` and a register
+	read of `size` bytes into it. `reg` uses the same I2C_REG_16 and
+	I2C_NO_REG flags as the blocking API.
+*/
+typedef struct {
+	i2c_port_t port;
+	uint16_t addr;
+	uint32_t reg;
+	uint8_t *buffer;
+	uint16_t size;
+	bool write;
+} I2C_FN(_xfer_t);
+
+/*
+	The bus backend performs one transaction while the caller holds the port
+	lock. The default backend drives the ESP-IDF I2C master driver from a
+	preallocated command link. A different backend (e.g. a fake bus that
+	simulates transfer latency on the host) can be installed with _set_bus().
+*/
+typedef esp_err_t (* I2C_FN(_bus_xfer_t))(const I2C_FN(_xfer_t) *xfer, TickType_t timeout);
+
+void I2C_FN(_set_bus)(I2C_FN(_bus_xfer_t) xfer);
+
+
+#if defined (CONFIG_I2C_MANAGER_ASYNC)
+
+	/*
+		Completion callback of an asynchronous transaction. It is called from
+		the port worker task once the transfer has finished, so keep it short:
+		copy the data, set a flag or notify the waiting task.
+	*/
+	typedef void (* I2C_FN(_async_cb_t))(esp_err_t result, void *user_data);
+
+	/*
+		Queue a read or write without blocking the caller. The transaction is
+		taken from a fixed pool of CONFIG_I2C_MANAGER_ASYNC_QUEUE_LEN
+		descriptors per port, ESP_ERR_NO_MEM is returned when all of them are
+		in flight. `buffer` must stay valid until the callback has run.
+	*/
+	esp_err_t I2C_FN(_read_async)(i2c_port_t port, uint16_t addr, uint32_t reg, uint8_t *buffer, uint16_t size,
+	                              I2C_FN(_async_cb_t) cb, void *user_data);
+	esp_err_t I2C_FN(_write_async)(i2c_port_t port, uint16_t addr, uint32_t reg, const uint8_t *buffer, uint16_t size,
+	                               I2C_FN(_async_cb_t) cb, void *user_data);
+
+#endif
+
+
 #ifdef I2C_OEM
 
     void I2C_FN(_locking)(void* leader);
@@ -11,6 +11,8 @@
 #include "esp_log.h"
 #include "esp_heap_caps.h"
 
+#include <string.h>
+
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -19,6 +21,28 @@
  *********************/
  #define TAG "ILI9488"
 
+#define MAX_PACKAGE_SIZE	25600
+
+/*Bytes of a CASET + PASET + RAMWR sequence with their arguments*/
+#define WINDOW_CMD_BYTES    11
+
+#if CONFIG_LV_ILI9488_SHADOW_FB
+#define SHADOW_FB_WINDOW_COST   CONFIG_LV_ILI9488_SHADOW_FB_WINDOW_COST
+#define SHADOW_FB_MAX_SPANS     8
+#define SHADOW_FB_ROWS          LV_MAX(LV_HOR_RES_MAX, LV_VER_RES_MAX)
+#endif
+
+#if CONFIG_LV_ILI9488_HW_SCROLL
+#define SCROLL_ROWS             480     /*Lines of the frame memory in the direction of the vertical scroll*/
+#endif
+
+/*Bytes of a pixel in the rendered buffers: LVGL can draw the 3 bytes of the panel directly*/
+#if LV_COLOR_RGB888_OUT
+#define BUF_PX_SIZE             LV_MAX(3, sizeof(lv_color_t))
+#else
+#define BUF_PX_SIZE             sizeof(lv_color_t)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -38,11 +62,37 @@ static void ili9488_set_orientation(uint8_t orientation);
 static void ili9488_send_cmd(uint8_t cmd);
 static void ili9488_send_data(void * data, uint16_t length);
 static void ili9488_send_color(void * data, uint16_t length);
+static void ili9488_flush_rows(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map, bool last);
+static uint32_t ili9488_px_size(lv_disp_drv_t * drv);
+static lv_coord_t ili9488_gram_row(lv_coord_t y);
+static void ili9488_convert(uint8_t * dest, const lv_color_t * src, uint32_t px_cnt);
+#if CONFIG_LV_ILI9488_SHADOW_FB || LV_COLOR_RGB888_OUT
+static void ili9488_send_packed(const uint8_t * data, uint32_t size, bool last);
+#endif
+
+#if CONFIG_LV_ILI9488_SHADOW_FB
+static void ili9488_flush_diff(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map, bool last);
+static void ili9488_send_rect(lv_disp_drv_t * drv, const lv_area_t * area, const lv_color_t * color_map,
+                              const lv_area_t * rect, bool last);
+#endif
 
 void ili9488_full_clear(uint16_t color);
 /**********************
  *  STATIC VARIABLES
  **********************/
+static ili9488_flush_stats_t flush_stats;
+
+#if CONFIG_LV_ILI9488_SHADOW_FB
+static uint8_t * shadow_fb;             /*What the panel shows, LV_HOR_RES_MAX * LV_VER_RES_MAX pixels*/
+static uint8_t * shadow_row_valid;      /*1: the row of the shadow framebuffer matches the panel*/
+static uint8_t * shadow_send_buf;       /*The converted pixels of one window*/
+#endif
+
+#if CONFIG_LV_ILI9488_HW_SCROLL
+static lv_coord_t scroll_top;                       /*First row of the vertical scroll area*/
+static lv_coord_t scroll_height = SCROLL_ROWS;
+static lv_coord_t scroll_ofs;                       /*The first row of the area shows this row of it*/
+#endif
 
 /**********************
  *      MACROS
@@ -110,41 +160,162 @@ void ili9488_init(void)
 
     ili9488_set_orientation(CONFIG_LV_DISPLAY_ORIENTATION);
 
-}
+#if CONFIG_LV_ILI9488_HW_SCROLL
+    /*Reset by the software reset*/
+    scroll_top = 0;
+    scroll_height = SCROLL_ROWS;
+    scroll_ofs = 0;
+#endif
 
-#define MAX_PACKAGE_SIZE	25600
+#if CONFIG_LV_ILI9488_SHADOW_FB
+    if (shadow_fb == NULL) {
+        shadow_fb = heap_caps_malloc(LV_HOR_RES_MAX * LV_VER_RES_MAX * BUF_PX_SIZE, MALLOC_CAP_SPIRAM);
+        shadow_row_valid = heap_caps_calloc(SHADOW_FB_ROWS, 1, MALLOC_CAP_8BIT);
+        shadow_send_buf = heap_caps_malloc(DISP_BUF_SIZE * 3, MALLOC_CAP_SPIRAM);
+        if (shadow_fb == NULL || shadow_row_valid == NULL || shadow_send_buf == NULL) {
+            ESP_LOGW(TAG, "Could not allocate the shadow framebuffer, every flushed pixel will be sent");
+            heap_caps_free(shadow_fb);
+            heap_caps_free(shadow_row_valid);
+            heap_caps_free(shadow_send_buf);
+            shadow_fb = NULL;
+            shadow_row_valid = NULL;
+            shadow_send_buf = NULL;
+        }
+    }
+#endif
+    ili9488_shadow_invalidate();
+}
 
 // Flush function based on mvturnho repo
 void ili9488_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map)
 {
     uint32_t size = lv_area_get_width(area) * lv_area_get_height(area) * 3;
-	
-    lv_color16_t *buffer_16bit = (lv_color16_t *) color_map;
+
+    flush_stats.flush_cnt++;
+    flush_stats.bytes_full += size + WINDOW_CMD_BYTES;
+
+#if CONFIG_LV_ILI9488_HW_SCROLL
+    /*The rows of the scroll area are continuous in the frame memory only until it wraps around*/
+    const uint8_t * map = (const uint8_t *) color_map;
+    uint32_t row_size = lv_area_get_width(area) * ili9488_px_size(drv);
+    lv_area_t rows = *area;
+    while (rows.y1 <= area->y2) {
+        rows.y2 = area->y2;
+        if (rows.y1 < scroll_top) {
+            rows.y2 = LV_MIN(rows.y2, scroll_top - 1);
+        } else if (rows.y1 < scroll_top + scroll_height) {
+            lv_coord_t wrap = scroll_top + scroll_height - scroll_ofs;
+            rows.y2 = LV_MIN(rows.y2, (rows.y1 < wrap ? wrap : scroll_top + scroll_height) - 1);
+        }
+
+        lv_area_t gram_area = rows;
+        gram_area.y1 = ili9488_gram_row(rows.y1);
+        gram_area.y2 = gram_area.y1 + rows.y2 - rows.y1;
+        ili9488_flush_rows(drv, &gram_area, (lv_color_t *) &map[(rows.y1 - area->y1) * row_size],
+                           rows.y2 == area->y2);
+        rows.y1 = rows.y2 + 1;
+    }
+#else
+    ili9488_flush_rows(drv, area, color_map, true);
+#endif
+}
+
+void ili9488_get_flush_stats(ili9488_flush_stats_t * stats)
+{
+    *stats = flush_stats;
+}
+
+void ili9488_shadow_invalidate(void)
+{
+#if CONFIG_LV_ILI9488_SHADOW_FB
+    if (shadow_row_valid) memset(shadow_row_valid, 0, SHADOW_FB_ROWS);
+#endif
+}
+
+bool ili9488_hw_scroll(lv_disp_drv_t * drv, const lv_area_t * area, lv_coord_t dy)
+{
+    LV_UNUSED(drv);
+
+#if CONFIG_LV_ILI9488_HW_SCROLL
+    lv_coord_t h = lv_area_get_height(area);
+    if (area->y1 != scroll_top || h != scroll_height) {
+        /*The content of the current area would jump*/
+        if (scroll_ofs != 0) return false;
+
+        uint16_t bottom = SCROLL_ROWS - area->y1 - h;
+        uint8_t def[] = {
+            (uint8_t) (area->y1 >> 8) & 0xFF,
+            (uint8_t) (area->y1) & 0xFF,
+            (uint8_t) (h >> 8) & 0xFF,
+            (uint8_t) (h) & 0xFF,
+            (uint8_t) (bottom >> 8) & 0xFF,
+            (uint8_t) (bottom) & 0xFF,
+        };
+        ili9488_send_cmd(ILI9488_CMD_VERT_SCROLL_DEFINITION);
+        ili9488_send_data(def, 6);
+
+        scroll_top = area->y1;
+        scroll_height = h;
+    }
+
+    scroll_ofs = (scroll_ofs - dy) % scroll_height;
+    if (scroll_ofs < 0) scroll_ofs += scroll_height;
+
+    uint16_t start = scroll_top + scroll_ofs;
+    uint8_t start_data[] = {
+        (uint8_t) (start >> 8) & 0xFF,
+        (uint8_t) (start) & 0xFF,
+    };
+    ili9488_send_cmd(ILI9488_CMD_VERT_SCROLL_START_ADDRESS);
+    ili9488_send_data(start_data, 2);
+
+    return true;
+#else
+    LV_UNUSED(area);
+    LV_UNUSED(dy);
+    return false;
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/* Send rows which are continuous in the frame memory. With `last` the end of the transfer signals the flush. */
+static void ili9488_flush_rows(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map, bool last)
+{
+    uint32_t size = lv_area_get_width(area) * lv_area_get_height(area) * 3;
+
+#if CONFIG_LV_ILI9488_SHADOW_FB
+    if (shadow_fb && (uint32_t)drv->hor_res * drv->ver_res <= LV_HOR_RES_MAX * LV_VER_RES_MAX &&
+        size <= DISP_BUF_SIZE * 3) {
+        ili9488_flush_diff(drv, area, color_map, last);
+        return;
+    }
+#endif
+
+    flush_stats.bytes_sent += size + WINDOW_CMD_BYTES;
+    flush_stats.window_cnt++;
+
+#if LV_COLOR_RGB888_OUT
+    /*Already in the format of the panel, send it as it is*/
+    if (drv->rgb888_out) {
+        ili9488_set_windows(area->x1, area->y1, area->x2, area->y2);
+        ili9488_send_packed((const uint8_t *) color_map, size, last);
+        return;
+    }
+#else
+    LV_UNUSED(drv);
+    LV_UNUSED(last);
+#endif
+
     uint8_t *mybuf = NULL;
     do {
         mybuf = (uint8_t *) heap_caps_malloc(size * sizeof(uint8_t), MALLOC_CAP_SPIRAM);
         if (mybuf == NULL)  ESP_LOGW(TAG, "Could not allocate enough DMA memory!");
     } while (mybuf == NULL);
 
-    uint16_t LD = 0;
-    uint32_t j = 0;
-
-    for (uint32_t i = 0; i < size / 3; i++) {
-        LD = buffer_16bit[i].full;
-        mybuf[j] = (uint8_t) (((LD & 0xF800) >> 8) | ((LD & 0x8000) >> 13));
-        j++;
-        mybuf[j] = (uint8_t) ((LD & 0x07E0) >> 3);
-        j++;
-        mybuf[j] = (uint8_t) (((LD & 0x001F) << 3) | ((LD & 0x0010) >> 2));
-        j++;
-
-		// mybuf[j] = (uint8_t) (LD >> 8) & 0xF8;
-        // j++;
-        // mybuf[j] = (uint8_t) (LD >> 3) & 0xFC;
-        // j++;
-        // mybuf[j] = (uint8_t) (LD << 3);
-        // j++;
-    }
+    ili9488_convert(mybuf, color_map, size / 3);
 
 	/* Column addresses  */
 	uint8_t xb[] = {
@@ -186,9 +357,211 @@ void ili9488_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * col
 
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+static uint32_t ili9488_px_size(lv_disp_drv_t * drv)
+{
+#if LV_COLOR_RGB888_OUT
+    if (drv->rgb888_out) return 3;
+#else
+    LV_UNUSED(drv);
+#endif
+    return sizeof(lv_color_t);
+}
+
+/* The row of the frame memory shown in a row of the display */
+static lv_coord_t ili9488_gram_row(lv_coord_t y)
+{
+#if CONFIG_LV_ILI9488_HW_SCROLL
+    if (y >= scroll_top && y < scroll_top + scroll_height) {
+        y += scroll_ofs;
+        if (y >= scroll_top + scroll_height) y -= scroll_height;
+    }
+#endif
+    return y;
+}
+
+/* RGB565 to the 3 bytes/pixel format of the panel, the low bits are filled from the high ones */
+static void ili9488_convert(uint8_t * dest, const lv_color_t * src, uint32_t px_cnt)
+{
+    const lv_color16_t *buffer_16bit = (const lv_color16_t *) src;
+    uint16_t LD = 0;
+    uint32_t j = 0;
+
+    for (uint32_t i = 0; i < px_cnt; i++) {
+        LD = buffer_16bit[i].full;
+        dest[j] = (uint8_t) (((LD & 0xF800) >> 8) | ((LD & 0x8000) >> 13));
+        j++;
+        dest[j] = (uint8_t) ((LD & 0x07E0) >> 3);
+        j++;
+        dest[j] = (uint8_t) (((LD & 0x001F) << 3) | ((LD & 0x0010) >> 2));
+        j++;
+    }
+}
+
+#if CONFIG_LV_ILI9488_SHADOW_FB || LV_COLOR_RGB888_OUT
+/* Send converted pixels after a window was set. With `last` the end of the transfer signals the flush. */
+static void ili9488_send_packed(const uint8_t * data, uint32_t size, bool last)
+{
+    for (uint32_t i = 0; i < size; i += MAX_PACKAGE_SIZE) {
+        uint32_t len = LV_MIN(size - i, MAX_PACKAGE_SIZE);
+        disp_spi_send_flag_t flags = DISP_SPI_SEND_QUEUED;
+        if (last && i + len == size) flags |= DISP_SPI_SIGNAL_FLUSH;
+
+        disp_wait_for_pending_transactions();
+        gpio_set_level(ILI9488_DC, 1);   /*Data mode*/
+        disp_spi_transaction(&data[i], len, flags, NULL, 0, 0);
+    }
+}
+#endif
+
+#if CONFIG_LV_ILI9488_SHADOW_FB
+/*
+ * Compare the rows of the area with the shadow framebuffer and send only the changed spans.
+ * Spans closer than the cost of a new window are merged, and the spans of consecutive rows
+ * are merged into one rectangle while the extra pixels are cheaper than a new window.
+ */
+static void ili9488_flush_diff(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map, bool last)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t stride = drv->hor_res;
+    uint32_t px_size = ili9488_px_size(drv);
+    bool full_rows = area->x1 == 0 && area->x2 == drv->hor_res - 1;
+
+    lv_area_t open[SHADOW_FB_MAX_SPANS];     /*Rectangles which can still grow downwards*/
+    uint32_t open_cnt = 0;
+    lv_area_t pending = {0};                    /*Closed but not sent yet: the last one signals the flush*/
+    bool has_pending = false;
+
+    for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+        const uint8_t * row_new = &((const uint8_t *) color_map)[(y - area->y1) * w * px_size];
+        uint8_t * row_old = &shadow_fb[(y * stride + area->x1) * px_size];
+
+        /*Collect the changed spans of the row*/
+        lv_area_t spans[SHADOW_FB_MAX_SPANS];
+        uint32_t span_cnt = 0;
+        if (y >= SHADOW_FB_ROWS || !shadow_row_valid[y]) {
+            spans[0].x1 = area->x1;
+            spans[0].x2 = area->x2;
+            span_cnt = 1;
+        } else {
+            for (lv_coord_t x = 0; x < w; x++) {
+                if (px_size == 3) {
+                    const uint8_t * n = &row_new[x * 3];
+                    const uint8_t * o = &row_old[x * 3];
+                    if (n[0] == o[0] && n[1] == o[1] && n[2] == o[2]) continue;
+                } else if (((const lv_color_t *) row_new)[x].full == ((const lv_color_t *) row_old)[x].full) {
+                    continue;
+                }
+
+                lv_coord_t abs_x = area->x1 + x;
+                if (span_cnt > 0 &&
+                    ((abs_x - spans[span_cnt - 1].x2 - 1) * 3 <= SHADOW_FB_WINDOW_COST || span_cnt == SHADOW_FB_MAX_SPANS)) {
+                    spans[span_cnt - 1].x2 = abs_x;
+                } else {
+                    spans[span_cnt].x1 = abs_x;
+                    spans[span_cnt].x2 = abs_x;
+                    span_cnt++;
+                }
+            }
+        }
+
+        memcpy(row_old, row_new, w * px_size);
+        if (full_rows && y < SHADOW_FB_ROWS) shadow_row_valid[y] = 1;
+
+        /*Grow the open rectangles with the spans or start new ones*/
+        lv_area_t next_open[SHADOW_FB_MAX_SPANS];
+        bool used[SHADOW_FB_MAX_SPANS] = {false};
+        for (uint32_t s = 0; s < span_cnt; s++) {
+            lv_coord_t span_w = spans[s].x2 - spans[s].x1 + 1;
+            uint32_t i;
+            for (i = 0; i < open_cnt; i++) {
+                if (used[i]) continue;
+                lv_coord_t x1 = LV_MIN(open[i].x1, spans[s].x1);
+                lv_coord_t x2 = LV_MAX(open[i].x2, spans[s].x2);
+                int32_t extra = (int32_t)(x2 - x1 + 1 - lv_area_get_width(&open[i])) * lv_area_get_height(&open[i]) +
+                                (x2 - x1 + 1 - span_w);
+                if (extra * 3 <= SHADOW_FB_WINDOW_COST) break;
+            }
+
+            if (i < open_cnt) {
+                used[i] = true;
+                next_open[s] = open[i];
+                next_open[s].x1 = LV_MIN(open[i].x1, spans[s].x1);
+                next_open[s].x2 = LV_MAX(open[i].x2, spans[s].x2);
+                next_open[s].y2 = y;
+            } else {
+                next_open[s].x1 = spans[s].x1;
+                next_open[s].x2 = spans[s].x2;
+                next_open[s].y1 = y;
+                next_open[s].y2 = y;
+            }
+        }
+
+        /*The rectangles which didn't grow are complete*/
+        for (uint32_t i = 0; i < open_cnt; i++) {
+            if (used[i]) continue;
+            if (has_pending) ili9488_send_rect(drv, area, color_map, &pending, false);
+            pending = open[i];
+            has_pending = true;
+        }
+
+        lv_memcpy(open, next_open, span_cnt * sizeof(lv_area_t));
+        open_cnt = span_cnt;
+    }
+
+    for (uint32_t i = 0; i < open_cnt; i++) {
+        if (has_pending) ili9488_send_rect(drv, area, color_map, &pending, false);
+        pending = open[i];
+        has_pending = true;
+    }
+
+    if (has_pending) ili9488_send_rect(drv, area, color_map, &pending, last);
+    else if (last) lv_disp_flush_ready(drv);
+}
+
+/* Send a part of the flushed area. With `last` the end of the transfer signals the flush. */
+static void ili9488_send_rect(lv_disp_drv_t * drv, const lv_area_t * area, const lv_color_t * color_map,
+                              const lv_area_t * rect, bool last)
+{
+    lv_coord_t area_w = lv_area_get_width(area);
+    lv_coord_t rect_w = lv_area_get_width(rect);
+    uint32_t size = lv_area_get_size(rect) * 3;
+
+    /*Waits for the previous window, so its buffer can be reused*/
+    ili9488_set_windows(rect->x1, rect->y1, rect->x2, rect->y2);
+
+#if LV_COLOR_RGB888_OUT
+    if (drv->rgb888_out) {
+        const uint8_t * map = (const uint8_t *) color_map;
+        /*Whole rows are continuous in the draw buffer which stays valid until the flush is ready*/
+        if (rect_w == area_w) {
+            ili9488_send_packed(&map[(rect->y1 - area->y1) * area_w * 3], size, last);
+        } else {
+            for (lv_coord_t y = rect->y1; y <= rect->y2; y++) {
+                memcpy(&shadow_send_buf[(y - rect->y1) * rect_w * 3],
+                       &map[((y - area->y1) * area_w + (rect->x1 - area->x1)) * 3], rect_w * 3);
+            }
+            ili9488_send_packed(shadow_send_buf, size, last);
+        }
+
+        flush_stats.bytes_sent += size + WINDOW_CMD_BYTES;
+        flush_stats.window_cnt++;
+        return;
+    }
+#else
+    LV_UNUSED(drv);
+#endif
+
+    for (lv_coord_t y = rect->y1; y <= rect->y2; y++) {
+        const lv_color_t * src = &color_map[(y - area->y1) * area_w + (rect->x1 - area->x1)];
+        ili9488_convert(&shadow_send_buf[(y - rect->y1) * rect_w * 3], src, rect_w);
+    }
+
+    ili9488_send_packed(shadow_send_buf, size, last);
+
+    flush_stats.bytes_sent += size + WINDOW_CMD_BYTES;
+    flush_stats.window_cnt++;
+}
+#endif
 
 
 static void ili9488_send_cmd(uint8_t cmd)
@@ -263,6 +636,7 @@ void ili9488_set_windows(uint16_t x_start, uint16_t y_start, uint16_t x_end, uin
 
 void ili9488_full_clear(uint16_t color)
 {
+	ili9488_shadow_invalidate();
 	ili9488_set_windows(0, 0, 319, 479);
 	uint8_t temp[3] = {0};
 	temp[0] = (uint8_t) (color >> 8) & 0xF8;
@@ -278,6 +652,8 @@ void ili9488_full_clear(uint16_t color)
 
 void ili9488_put_px(uint16_t x, uint16_t y, uint16_t color)
 {
+	ili9488_shadow_invalidate();
+	y = ili9488_gram_row(y);
 	ili9488_set_windows(x, y, x, y);
 	uint8_t temp[3] = {0};
 	temp[0] = (uint8_t) (color >> 8) & 0xF8;
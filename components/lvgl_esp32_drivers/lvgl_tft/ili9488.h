@@ -140,6 +140,14 @@ typedef struct {
     uint8_t blue;
 } lv_color_custom_t;
 
+/* Byte counters of the flush path. `bytes_full` is what sending every flushed pixel would cost. */
+typedef struct {
+    uint32_t flush_cnt;
+    uint32_t window_cnt;        /* CASET/PASET windows sent */
+    uint64_t bytes_full;
+    uint64_t bytes_sent;        /* pixel and window command bytes actually sent */
+} ili9488_flush_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -147,8 +155,15 @@ typedef struct {
 void ili9488_init(void);
 void ili9488_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map);
 
+void ili9488_set_windows(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end);
 void ili9488_put_px(uint16_t x, uint16_t y, uint16_t color);
 
+void ili9488_get_flush_stats(ili9488_flush_stats_t * stats);
+/* Forget the shadow framebuffer, e.g. after writing to the panel directly. The next flushes send every pixel. */
+void ili9488_shadow_invalidate(void);
+/* Shift the rows of `area` by `dy` with the vertical scroll of the panel. Can be used as `hw_scroll_cb`. */
+bool ili9488_hw_scroll(lv_disp_drv_t * drv, const lv_area_t * area, lv_coord_t dy);
+
 /**********************
  *      MACROS
  **********************/
@@ -18,6 +18,7 @@
 * SOFTWARE.
 */
 
+#include <string.h>
 #include <esp_log.h>
 #ifdef LV_LVGL_H_INCLUDE_SIMPLE
 #include <lvgl.h>
@@ -37,6 +38,39 @@ static ft6x36_touch_t touch_inputs = { -1, -1, LV_INDEV_STATE_REL };    // -1 co
 #if CONFIG_LV_FT6X36_COORDINATES_QUEUE
 QueueHandle_t ft6x36_touch_queue_handle;
 #endif
+#if CONFIG_LV_FT6X36_ASYNC_READ
+typedef struct {
+    esp_err_t result;
+    uint8_t data[5];                        // 1 byte status, 2 bytes X, 2 bytes Y
+} ft6x36_sample_t;
+
+static uint8_t async_buf[5];                // only used by the I2C worker task while a read is in flight
+static QueueHandle_t async_sample_q;        // hands the completed sample to the LVGL task
+static bool async_pending;                  // a read is queued or on the bus, only used by the LVGL task
+
+static void ft6x36_async_done(esp_err_t result, void *user_data) {
+    ft6x36_sample_t sample;
+    sample.result = result;
+    memcpy(sample.data, async_buf, sizeof(sample.data));
+    xQueueOverwrite(async_sample_q, &sample);
+}
+
+/* Take the last completed sample (if any) and queue the next read. */
+static esp_err_t ft6x36_read_async(uint8_t *data_buf) {
+    esp_err_t ret = ESP_ERR_NOT_FINISHED;
+    ft6x36_sample_t sample;
+    if (xQueueReceive(async_sample_q, &sample, 0) == pdTRUE) {
+        memcpy(data_buf, sample.data, sizeof(sample.data));
+        ret = sample.result;
+        async_pending = false;
+    }
+    if (!async_pending) {
+        async_pending = lvgl_i2c_read_async(CONFIG_LV_I2C_TOUCH_PORT, current_dev_addr, FT6X36_TD_STAT_REG,
+                                            async_buf, sizeof(async_buf), ft6x36_async_done, NULL) == ESP_OK;
+    }
+    return ret;
+}
+#endif
 
 static esp_err_t ft6x06_i2c_read8(uint8_t slave_addr, uint8_t register_addr, uint8_t *data_buf) {
     return lvgl_i2c_read(CONFIG_LV_I2C_TOUCH_PORT, slave_addr, register_addr, data_buf, 1);
@@ -87,6 +121,15 @@ void ft6x06_init(uint16_t dev_addr) {
 
     ft6x06_i2c_read8(dev_addr, FT6X36_RELEASECODE_REG, &data_buf);
     ESP_LOGI(TAG, "\tRelease code: 0x%02x", data_buf);
+
+#if CONFIG_LV_FT6X36_ASYNC_READ
+    if (async_sample_q == NULL) {
+        async_sample_q = xQueueCreate(1, sizeof(ft6x36_sample_t));
+    }
+    if (async_sample_q == NULL) {
+        ESP_LOGE(TAG, "\tError creating touch sample queue, reading synchronously");
+    }
+#endif
     
 #if CONFIG_LV_FT6X36_COORDINATES_QUEUE
     ft6x36_touch_queue_handle = xQueueCreate( FT6X36_TOUCH_QUEUE_ELEMENTS, sizeof( ft6x36_touch_t ) );
@@ -112,7 +155,19 @@ bool ft6x36_read(lv_indev_drv_t *drv, lv_indev_data_t *data) {
     }
     uint8_t data_buf[5];        // 1 byte status, 2 bytes X, 2 bytes Y
 
+#if CONFIG_LV_FT6X36_ASYNC_READ
+    esp_err_t ret = async_sample_q ? ft6x36_read_async(&data_buf[0])
+                    : lvgl_i2c_read(CONFIG_LV_I2C_TOUCH_PORT, current_dev_addr, FT6X36_TD_STAT_REG, &data_buf[0], 5);
+    if (ret == ESP_ERR_NOT_FINISHED) {
+        /* No new sample yet, report the previous state. */
+        data->point.x = touch_inputs.last_x;
+        data->point.y = touch_inputs.last_y;
+        data->state = touch_inputs.current_state;
+        return false;
+    }
+#else
     esp_err_t ret = lvgl_i2c_read(CONFIG_LV_I2C_TOUCH_PORT, current_dev_addr, FT6X36_TD_STAT_REG, &data_buf[0], 5);
+#endif
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Error talking to touch IC: %s", esp_err_to_name(ret));
     }
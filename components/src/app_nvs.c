@@ -24,11 +24,14 @@ esp_err_t nvs_store_data(const char *namespace, const char *key,
     err = nvs_set_blob(nvs_handle, key, data, size);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error (%s) writing data to NVS!", esp_err_to_name(err));
-        return err;
+    } else {
+        err = nvs_commit(nvs_handle);     // 更改写入物理存储
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Error (%s) committing NVS!", esp_err_to_name(err));
+        }
     }
-    nvs_commit(nvs_handle);     // 更改写入物理存储
     nvs_close(nvs_handle);
-    return ESP_OK;
+    return err;
 }
 
 
@@ -39,7 +42,7 @@ esp_err_t nvs_load_data(const char *namespace, const char *key,
                         void *data, size_t size)
 {
     nvs_handle_t nvs_handle;
-    esp_err_t err = nvs_open(namespace, NVS_READWRITE, &nvs_handle);
+    esp_err_t err = nvs_open(namespace, NVS_READONLY, &nvs_handle);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error (%s) opening NVS handle!", esp_err_to_name(err));
         return err;
@@ -48,10 +51,9 @@ esp_err_t nvs_load_data(const char *namespace, const char *key,
     err = nvs_get_blob(nvs_handle, key, data, &size);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error (%s) loading data to NVS!", esp_err_to_name(err));
-        return err;
     }
     nvs_close(nvs_handle);
-    return ESP_OK;
+    return err;
 }
 
 
@@ -0,0 +1,499 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "nvs.h"
+
+#include "app_settings.h"
+
+#define TAG                     "app_settings"
+
+#define SETTINGS_TASK_STACK     (3 * 1024)
+#define SETTINGS_TASK_PRIORITY  2
+
+
+typedef struct {
+    char key[SETTINGS_KEY_LEN];
+    uint8_t used;
+    uint8_t dirty;              // RAM中的值尚未写入后端
+    uint8_t type;
+    uint16_t size;
+    uint32_t gen;               // 每次修改递增，用于判断提交期间是否又被修改
+    uint8_t value[SETTINGS_VALUE_MAX];
+} settings_entry_t;
+
+/* 提交时的快照，提交期间不持有缓存锁，不阻塞调用者 */
+typedef struct {
+    uint16_t index;
+    uint16_t size;
+    uint32_t gen;
+    char key[SETTINGS_KEY_LEN];
+    uint8_t value[SETTINGS_VALUE_MAX];
+} settings_stage_t;
+
+typedef struct {
+    SemaphoreHandle_t lock;             // 保护缓存和统计
+    SemaphoreHandle_t flush_lock;       // 串行化提交
+    TaskHandle_t task;
+    const settings_backend_t *backend;
+    char namespace[SETTINGS_KEY_LEN];
+    settings_entry_t entries[SETTINGS_MAX_KEYS];
+    settings_stage_t stage[SETTINGS_MAX_KEYS];
+    settings_item_t items[SETTINGS_MAX_KEYS];
+    settings_stats_t stats;
+} settings_t;
+
+static settings_t *s_settings = NULL;
+
+
+/*--------------------------NVS backend--------------------------*/
+
+static esp_err_t nvs_backend_load(void *ctx, const char *namespace, const char *key, void *data, size_t *size)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(namespace, NVS_READONLY, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = nvs_get_blob(handle, key, data, size);
+    nvs_close(handle);
+    return err;
+}
+
+static esp_err_t nvs_backend_commit(void *ctx, const char *namespace, const settings_item_t *items, size_t count)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(namespace, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error (%s) opening NVS handle!", esp_err_to_name(err));
+        return err;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        err = nvs_set_blob(handle, items[i].key, items[i].data, items[i].size);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Error (%s) writing key %s!", esp_err_to_name(err), items[i].key);
+            break;
+        }
+    }
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return err;
+}
+
+static const settings_backend_t nvs_backend = {
+    .load = nvs_backend_load,
+    .commit = nvs_backend_commit,
+    .ctx = NULL,
+};
+
+
+/*--------------------------RAM backend--------------------------*/
+
+typedef struct ram_node {
+    struct ram_node *next;
+    char namespace[SETTINGS_KEY_LEN];
+    char key[SETTINGS_KEY_LEN];
+    size_t size;
+    uint8_t data[SETTINGS_VALUE_MAX];
+} ram_node_t;
+
+static ram_node_t *ram_nodes = NULL;
+
+static ram_node_t *ram_find(const char *namespace, const char *key)
+{
+    for (ram_node_t *node = ram_nodes; node != NULL; node = node->next) {
+        if (strcmp(node->namespace, namespace) == 0 && strcmp(node->key, key) == 0) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+static esp_err_t ram_backend_load(void *ctx, const char *namespace, const char *key, void *data, size_t *size)
+{
+    ram_node_t *node = ram_find(namespace, key);
+    if (node == NULL) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (*size < node->size) {
+        *size = node->size;
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    memcpy(data, node->data, node->size);
+    *size = node->size;
+    return ESP_OK;
+}
+
+static esp_err_t ram_backend_commit(void *ctx, const char *namespace, const settings_item_t *items, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        ram_node_t *node = ram_find(namespace, items[i].key);
+        if (node == NULL) {
+            node = calloc(1, sizeof(ram_node_t));
+            if (node == NULL) {
+                return ESP_ERR_NO_MEM;
+            }
+            strlcpy(node->namespace, namespace, sizeof(node->namespace));
+            strlcpy(node->key, items[i].key, sizeof(node->key));
+            node->next = ram_nodes;
+            ram_nodes = node;
+        }
+        memcpy(node->data, items[i].data, items[i].size);
+        node->size = items[i].size;
+    }
+    return ESP_OK;
+}
+
+static const settings_backend_t ram_backend = {
+    .load = ram_backend_load,
+    .commit = ram_backend_commit,
+    .ctx = NULL,
+};
+
+const settings_backend_t *settings_ram_backend(void)
+{
+    return &ram_backend;
+}
+
+
+/*--------------------------cache--------------------------*/
+
+static settings_entry_t *entry_find(const char *key)
+{
+    for (int i = 0; i < SETTINGS_MAX_KEYS; i++) {
+        settings_entry_t *entry = &s_settings->entries[i];
+        if (entry->used && strcmp(entry->key, key) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static settings_entry_t *entry_alloc(const char *key)
+{
+    for (int i = 0; i < SETTINGS_MAX_KEYS; i++) {
+        settings_entry_t *entry = &s_settings->entries[i];
+        if (!entry->used) {
+            memset(entry, 0, sizeof(settings_entry_t));
+            strlcpy(entry->key, key, sizeof(entry->key));
+            entry->used = 1;
+            return entry;
+        }
+    }
+    ESP_LOGE(TAG, "cache full, can't add key %s", key);
+    return NULL;
+}
+
+static esp_err_t check_key(const char *key, size_t size)
+{
+    if (s_settings == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (key == NULL || strlen(key) >= SETTINGS_KEY_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (size == 0 || size > SETTINGS_VALUE_MAX) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+
+/**
+ * 从缓存读取，未命中时从后端加载
+ * size: 定长类型为期望长度，blob为缓存大小并输出实际长度
+ */
+static esp_err_t settings_get(const char *key, settings_type_t type, void *data, size_t *size)
+{
+    esp_err_t err = check_key(key, *size > SETTINGS_VALUE_MAX ? SETTINGS_VALUE_MAX : *size);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    xSemaphoreTake(s_settings->lock, portMAX_DELAY);
+    settings_entry_t *entry = entry_find(key);
+    if (entry == NULL) {
+        entry = entry_alloc(key);
+        if (entry == NULL) {
+            err = ESP_ERR_NO_MEM;
+            goto exit;
+        }
+        size_t len = SETTINGS_VALUE_MAX;
+        err = s_settings->backend->load(s_settings->backend->ctx, s_settings->namespace, key, entry->value, &len);
+        if (err != ESP_OK) {
+            entry->used = 0;
+            goto exit;
+        }
+        entry->type = type;
+        entry->size = len;
+    }
+
+    if (entry->type != type || (type != SETTINGS_TYPE_BLOB && entry->size != *size)) {
+        err = ESP_ERR_INVALID_ARG;
+        goto exit;
+    }
+    if (entry->size > *size) {
+        *size = entry->size;
+        err = ESP_ERR_INVALID_SIZE;
+        goto exit;
+    }
+    memcpy(data, entry->value, entry->size);
+    *size = entry->size;
+
+exit:
+    xSemaphoreGive(s_settings->lock);
+    return err;
+}
+
+static esp_err_t settings_set(const char *key, settings_type_t type, const void *data, size_t size)
+{
+    esp_err_t err = check_key(key, size);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    xSemaphoreTake(s_settings->lock, portMAX_DELAY);
+    s_settings->stats.set_calls++;
+    settings_entry_t *entry = entry_find(key);
+    if (entry != NULL && entry->type == type && entry->size == size && memcmp(entry->value, data, size) == 0) {
+        s_settings->stats.set_skipped++;
+        xSemaphoreGive(s_settings->lock);
+        return ESP_OK;
+    }
+    if (entry == NULL) {
+        entry = entry_alloc(key);
+        if (entry == NULL) {
+            xSemaphoreGive(s_settings->lock);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    memcpy(entry->value, data, size);
+    entry->type = type;
+    entry->size = size;
+    entry->dirty = 1;
+    entry->gen++;
+    xSemaphoreGive(s_settings->lock);
+
+    // 重新开始延时
+    xTaskNotifyGive(s_settings->task);
+    return ESP_OK;
+}
+
+/**
+ * 延时提交任务：每次修改后等待SETTINGS_COMMIT_DELAY_MS，期间再有修改则重新计时
+ */
+static void settings_task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SETTINGS_COMMIT_DELAY_MS)) != 0) {
+        }
+        settings_flush();
+    }
+}
+
+static void settings_shutdown_handler(void)
+{
+    settings_flush();
+}
+
+
+/*--------------------------public--------------------------*/
+
+esp_err_t settings_init(const char *namespace, const settings_backend_t *backend)
+{
+    if (s_settings != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (namespace == NULL) {
+        namespace = SETTINGS_NAMESPACE;
+    }
+    if (strlen(namespace) >= SETTINGS_KEY_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    s_settings = calloc(1, sizeof(settings_t));
+    if (s_settings == NULL) {
+        ESP_LOGE(TAG, "settings malloc failed!");
+        return ESP_ERR_NO_MEM;
+    }
+    strlcpy(s_settings->namespace, namespace, sizeof(s_settings->namespace));
+    s_settings->backend = backend ? backend : &nvs_backend;
+    s_settings->lock = xSemaphoreCreateMutex();
+    s_settings->flush_lock = xSemaphoreCreateMutex();
+    if (s_settings->lock == NULL || s_settings->flush_lock == NULL) {
+        goto fail;
+    }
+    if (xTaskCreate(settings_task, "settings_task", SETTINGS_TASK_STACK, NULL,
+                    SETTINGS_TASK_PRIORITY, &s_settings->task) != pdPASS) {
+        goto fail;
+    }
+    esp_err_t err = esp_register_shutdown_handler(settings_shutdown_handler);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGW(TAG, "Error (%s) registering shutdown handler", esp_err_to_name(err));
+    }
+    return ESP_OK;
+
+fail:
+    ESP_LOGE(TAG, "settings init failed!");
+    if (s_settings->lock) vSemaphoreDelete(s_settings->lock);
+    if (s_settings->flush_lock) vSemaphoreDelete(s_settings->flush_lock);
+    free(s_settings);
+    s_settings = NULL;
+    return ESP_FAIL;
+}
+
+esp_err_t settings_flush(void)
+{
+    if (s_settings == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(s_settings->flush_lock, portMAX_DELAY);
+
+    // 在锁内拍快照，提交时调用者可以继续读写缓存
+    size_t count = 0;
+    xSemaphoreTake(s_settings->lock, portMAX_DELAY);
+    for (int i = 0; i < SETTINGS_MAX_KEYS; i++) {
+        settings_entry_t *entry = &s_settings->entries[i];
+        if (!entry->used || !entry->dirty) {
+            continue;
+        }
+        settings_stage_t *stage = &s_settings->stage[count];
+        stage->index = i;
+        stage->size = entry->size;
+        stage->gen = entry->gen;
+        memcpy(stage->key, entry->key, sizeof(stage->key));
+        memcpy(stage->value, entry->value, entry->size);
+        s_settings->items[count].key = stage->key;
+        s_settings->items[count].data = stage->value;
+        s_settings->items[count].size = stage->size;
+        entry->dirty = 0;
+        count++;
+    }
+    xSemaphoreGive(s_settings->lock);
+
+    if (count == 0) {
+        xSemaphoreGive(s_settings->flush_lock);
+        return ESP_OK;
+    }
+
+    int64_t start = esp_timer_get_time();
+    esp_err_t err = s_settings->backend->commit(s_settings->backend->ctx, s_settings->namespace,
+                                                s_settings->items, count);
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+
+    xSemaphoreTake(s_settings->lock, portMAX_DELAY);
+    settings_stats_t *stats = &s_settings->stats;
+    stats->last_commit_us = elapsed;
+    if (elapsed > stats->max_commit_us) {
+        stats->max_commit_us = elapsed;
+    }
+    if (err == ESP_OK) {
+        stats->commits++;
+        stats->key_writes += count;
+        for (size_t i = 0; i < count; i++) {
+            stats->bytes_written += s_settings->stage[i].size;
+        }
+    } else {
+        // 提交失败，未被再次修改的键重新标记，等待下一次提交
+        stats->commit_errors++;
+        for (size_t i = 0; i < count; i++) {
+            settings_entry_t *entry = &s_settings->entries[s_settings->stage[i].index];
+            if (entry->used && entry->gen == s_settings->stage[i].gen) {
+                entry->dirty = 1;
+            }
+        }
+    }
+    xSemaphoreGive(s_settings->lock);
+    xSemaphoreGive(s_settings->flush_lock);
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error (%s) committing %d keys", esp_err_to_name(err), (int)count);
+    } else {
+        ESP_LOGD(TAG, "committed %d keys in %u us", (int)count, (unsigned)elapsed);
+    }
+    return err;
+}
+
+esp_err_t settings_deinit(void)
+{
+    if (s_settings == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = settings_flush();
+
+    esp_unregister_shutdown_handler(settings_shutdown_handler);
+    xSemaphoreTake(s_settings->flush_lock, portMAX_DELAY);
+    vTaskDelete(s_settings->task);
+    vSemaphoreDelete(s_settings->lock);
+    vSemaphoreDelete(s_settings->flush_lock);
+    free(s_settings);
+    s_settings = NULL;
+    return err;
+}
+
+esp_err_t settings_get_u8(const char *key, uint8_t *value)
+{
+    size_t size = sizeof(*value);
+    return settings_get(key, SETTINGS_TYPE_U8, value, &size);
+}
+
+esp_err_t settings_get_i32(const char *key, int32_t *value)
+{
+    size_t size = sizeof(*value);
+    return settings_get(key, SETTINGS_TYPE_I32, value, &size);
+}
+
+esp_err_t settings_get_u32(const char *key, uint32_t *value)
+{
+    size_t size = sizeof(*value);
+    return settings_get(key, SETTINGS_TYPE_U32, value, &size);
+}
+
+esp_err_t settings_get_blob(const char *key, void *data, size_t *size)
+{
+    return settings_get(key, SETTINGS_TYPE_BLOB, data, size);
+}
+
+esp_err_t settings_set_u8(const char *key, uint8_t value)
+{
+    return settings_set(key, SETTINGS_TYPE_U8, &value, sizeof(value));
+}
+
+esp_err_t settings_set_i32(const char *key, int32_t value)
+{
+    return settings_set(key, SETTINGS_TYPE_I32, &value, sizeof(value));
+}
+
+esp_err_t settings_set_u32(const char *key, uint32_t value)
+{
+    return settings_set(key, SETTINGS_TYPE_U32, &value, sizeof(value));
+}
+
+esp_err_t settings_set_blob(const char *key, const void *data, size_t size)
+{
+    return settings_set(key, SETTINGS_TYPE_BLOB, data, size);
+}
+
+void settings_get_stats(settings_stats_t *stats, bool reset)
+{
+    if (s_settings == NULL) {
+        memset(stats, 0, sizeof(settings_stats_t));
+        return;
+    }
+    xSemaphoreTake(s_settings->lock, portMAX_DELAY);
+    *stats = s_settings->stats;
+    if (reset) {
+        memset(&s_settings->stats, 0, sizeof(settings_stats_t));
+    }
+    xSemaphoreGive(s_settings->lock);
+}
@@ -1,25 +1,30 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_ota_ops.h"
 #include "esp_http_client.h"
-#include "esp_https_ota.h"
 #include "freertos/event_groups.h"
 
 #include "wifi_wrapper.h"
+#include "app_settings.h"
+#include "ota_stream.h"
 #include "http_ota_wrapper.h"
 
 
 static const char *TAG = "app_http_ota";
 static EventGroupHandle_t ota_event_group;
-static esp_https_ota_handle_t https_ota_handle = NULL;
 static char ota_upgrade_url[256] = {0};
 static int interval_ms = 0;
 static ota_service_mode_t mode;
+static ota_progress_callback_t progress_cb = NULL;
+static ota_progress_t progress;
+static portMUX_TYPE progress_lock = portMUX_INITIALIZER_UNLOCKED;
 
 #define OTA_ENABLE_BIT  BIT0
 #define OTA_BEGIN_BIT   BIT1
@@ -27,6 +32,26 @@ static ota_service_mode_t mode;
 #define OTA_FINISH_BIT  BIT3
 #define OTA_FAIL_BIT    BIT4
 
+#define OTA_BUF_SIZE            4096
+#define OTA_ETAG_MAX            SETTINGS_VALUE_MAX
+#define OTA_ETAG_KEY            "ota_etag"
+#define OTA_PROGRESS_PERIOD_MS  500         // 进度回调最小间隔
+
+/* 固件头：镜像头 + 第一个段头 + 应用描述，用于在擦除分区前比较版本 */
+#define OTA_IMAGE_HEAD_SIZE     (sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t) + sizeof(esp_app_desc_t))
+
+typedef struct {
+    const esp_partition_t *running;
+    const esp_partition_t *update;
+    esp_ota_handle_t handle;
+    bool started;                           // 已调用esp_ota_begin
+    bool same;                              // 版本相同，放弃更新
+    uint8_t head[OTA_IMAGE_HEAD_SIZE];
+    size_t head_len;
+    char etag[OTA_ETAG_MAX];                // 响应的ETag
+} ota_ctx_t;
+
+
 esp_err_t _http_event_handler(esp_http_client_event_t *evt)
 {
     switch (evt->event_id) {
@@ -41,6 +66,12 @@ esp_err_t _http_event_handler(esp_http_client_event_t *evt)
         break;
     case HTTP_EVENT_ON_HEADER:
         ESP_LOGD(TAG, "HTTP_EVENT_ON_HEADER, key=%s, value=%s", evt->header_key, evt->header_value);
+        if (evt->user_data && strcasecmp(evt->header_key, "ETag") == 0) {
+            ota_ctx_t *ctx = evt->user_data;
+            if (strlen(evt->header_value) < sizeof(ctx->etag)) {
+                strcpy(ctx->etag, evt->header_value);
+            }
+        }
         break;
     case HTTP_EVENT_ON_DATA:
         ESP_LOGD(TAG, "HTTP_EVENT_ON_DATA, len=%d", evt->data_len);
@@ -79,49 +110,256 @@ static esp_err_t validate_image_header(esp_app_desc_t *new_app_info)
     return ESP_OK;
 }
 
-static esp_err_t http_ota_process(esp_https_ota_config_t *ota_config)
+static void progress_update(bool force)
 {
-    https_ota_handle = NULL;
-    esp_err_t err = esp_https_ota_begin(ota_config, &https_ota_handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "ESP HTTPS OTA Begin failed");
-        xEventGroupClearBits(ota_event_group, OTA_BEGIN_BIT);
-        return err;
+    static int64_t last_report = 0;
+    int64_t now = esp_timer_get_time();
+    if (!force && now - last_report < OTA_PROGRESS_PERIOD_MS * 1000) {
+        return;
+    }
+    last_report = now;
+
+    ota_progress_t info;
+    taskENTER_CRITICAL(&progress_lock);
+    info = progress;
+    taskEXIT_CRITICAL(&progress_lock);
+    if (progress_cb) {
+        progress_cb(&info);
     }
-    xEventGroupSetBits(ota_event_group, OTA_BEGIN_BIT);
+    ESP_LOGD(TAG, "received %u/%d, written %u, %u B/s", (unsigned)info.received, (int)info.total,
+             (unsigned)info.written, (unsigned)info.speed);
+}
 
-    esp_app_desc_t app_desc;
-    err = esp_https_ota_get_img_desc(https_ota_handle, &app_desc);
-    if (err != ESP_OK) {
-        return err;
+
+/*--------------------------ota_stream sink--------------------------*/
+
+static esp_err_t ota_sink_begin(void *arg, const ota_stream_info_t *info)
+{
+    ota_ctx_t *ctx = arg;
+
+    taskENTER_CRITICAL(&progress_lock);
+    progress.image_size = info->image_size;
+    taskEXIT_CRITICAL(&progress_lock);
+
+    ESP_LOGI(TAG, "OTA payload: %s%s, image size %u", (info->flags & OTA_PKG_FLAG_DELTA) ? "delta" : "image",
+             (info->flags & OTA_PKG_FLAG_ZLIB) ? " (zlib)" : "", (unsigned)info->image_size);
+
+    if (info->image_size > ctx->update->size) {
+        ESP_LOGE(TAG, "image does not fit partition %s", ctx->update->label);
+        return ESP_ERR_INVALID_SIZE;
     }
-    
-    err = validate_image_header(&app_desc);
-    if (err != ESP_OK) {
-        xEventGroupSetBits(ota_event_group, OTA_SMAE_BIT);
+
+    if (info->flags & OTA_PKG_FLAG_DELTA) {
+        // 差分基准必须是当前运行的固件
+        uint8_t sha256[32];
+        esp_err_t err = esp_partition_get_sha256(ctx->running, sha256);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (memcmp(sha256, info->source_sha256, sizeof(sha256)) != 0) {
+            ESP_LOGE(TAG, "delta base does not match running firmware");
+            return ESP_ERR_INVALID_VERSION;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t ota_sink_write(void *arg, const uint8_t *data, size_t len)
+{
+    ota_ctx_t *ctx = arg;
+    esp_err_t err;
+
+    if (!ctx->started) {
+        size_t n = sizeof(ctx->head) - ctx->head_len;
+        n = len < n ? len : n;
+        memcpy(ctx->head + ctx->head_len, data, n);
+        ctx->head_len += n;
+        data += n;
+        len -= n;
+        if (ctx->head_len < sizeof(ctx->head)) {
+            return ESP_OK;
+        }
+
+        esp_app_desc_t *app_desc = (esp_app_desc_t *)&ctx->head[sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t)];
+        if (validate_image_header(app_desc) != ESP_OK) {
+            ctx->same = true;
+            return ESP_ERR_INVALID_VERSION;
+        }
+
+        // 版本确认后再擦除分区
+        err = esp_ota_begin(ctx->update, OTA_WITH_SEQUENTIAL_WRITES, &ctx->handle);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "esp_ota_begin failed (%s)", esp_err_to_name(err));
+            return err;
+        }
+        ctx->started = true;
+        xEventGroupSetBits(ota_event_group, OTA_BEGIN_BIT);
+        err = esp_ota_write(ctx->handle, ctx->head, ctx->head_len);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    if (len == 0) {
         return ESP_OK;
     }
+    return esp_ota_write(ctx->handle, data, len);
+}
+
+static esp_err_t ota_sink_read_source(void *arg, uint32_t offset, uint8_t *data, size_t len)
+{
+    ota_ctx_t *ctx = arg;
+    if (offset > ctx->running->size || len > ctx->running->size - offset) {
+        ESP_LOGE(TAG, "delta copy out of range");
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    return esp_partition_read(ctx->running, offset, data, len);
+}
+
+
+static esp_err_t http_ota_download(esp_http_client_handle_t client, ota_ctx_t *ctx)
+{
+    ota_stream_sink_t sink = {
+        .begin = ota_sink_begin,
+        .write = ota_sink_write,
+        .read_source = ota_sink_read_source,
+        .ctx = ctx,
+    };
+    ota_stream_t *stream = ota_stream_create(&sink);
+    uint8_t *buffer = malloc(OTA_BUF_SIZE);
+    if (stream == NULL || buffer == NULL) {
+        ESP_LOGE(TAG, "OTA buffer malloc failed!");
+        ota_stream_delete(stream);
+        free(buffer);
+        return ESP_ERR_NO_MEM;
+    }
 
+    esp_err_t err = ESP_OK;
+    int64_t start = esp_timer_get_time();
     while (1) {
-        err = esp_https_ota_perform(https_ota_handle);
-        if (err != ESP_ERR_HTTPS_OTA_IN_PROGRESS) {
+        int len = esp_http_client_read(client, (char *)buffer, OTA_BUF_SIZE);
+        if (len < 0) {
+            ESP_LOGE(TAG, "HTTP read error (%d)", len);
+            err = ESP_FAIL;
+            break;
+        }
+        if (len == 0) {
+            if (!esp_http_client_is_complete_data_received(client)) {
+                ESP_LOGE(TAG, "Complete data was not received.");
+                err = ESP_FAIL;
+            }
+            break;
+        }
+
+        err = ota_stream_feed(stream, buffer, len);
+
+        int64_t elapsed = esp_timer_get_time() - start;
+        taskENTER_CRITICAL(&progress_lock);
+        progress.received += len;
+        progress.written = ota_stream_get_written(stream);
+        progress.speed = elapsed > 0 ? (uint32_t)(progress.received * 1000000LL / elapsed) : 0;
+        taskEXIT_CRITICAL(&progress_lock);
+        progress_update(false);
+
+        if (err != ESP_OK) {
             break;
         }
     }
 
-    if (err != ESP_OK) {
-        return err;
+    if (err == ESP_OK) {
+        err = ota_stream_finish(stream);
     }
+    progress_update(true);
+    ota_stream_delete(stream);
+    free(buffer);
+    return err;
+}
 
-    if (esp_https_ota_is_complete_data_received(https_ota_handle) != true) {
-        // the OTA image was not completely received and user can customise the response to this situation.
-        ESP_LOGE(TAG, "Complete data was not received.");
+static esp_err_t http_ota_process(esp_http_client_config_t *config)
+{
+    ota_ctx_t *ctx = calloc(1, sizeof(ota_ctx_t));
+    if (ctx == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ctx->running = esp_ota_get_running_partition();
+    ctx->update = esp_ota_get_next_update_partition(NULL);
+    if (ctx->update == NULL) {
+        ESP_LOGE(TAG, "no OTA partition");
+        free(ctx);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    taskENTER_CRITICAL(&progress_lock);
+    memset(&progress, 0, sizeof(progress));
+    progress.total = -1;
+    taskEXIT_CRITICAL(&progress_lock);
+
+    config->user_data = ctx;
+    esp_http_client_handle_t client = esp_http_client_init(config);
+    if (client == NULL) {
+        free(ctx);
         return ESP_FAIL;
-    } else {
-        err = esp_https_ota_finish(https_ota_handle);
-        return err;
     }
 
+    // 条件请求，服务器固件未变化时返回304，不下载数据
+    char etag[OTA_ETAG_MAX];
+    size_t etag_len = sizeof(etag) - 1;
+    if (settings_get_blob(OTA_ETAG_KEY, etag, &etag_len) == ESP_OK) {
+        etag[etag_len] = '\0';
+        esp_http_client_set_header(client, "If-None-Match", etag);
+    }
+
+    esp_err_t err = esp_http_client_open(client, 0);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open HTTP connection: %s", esp_err_to_name(err));
+        goto exit;
+    }
+
+    int64_t content_length = esp_http_client_fetch_headers(client);
+    int status = esp_http_client_get_status_code(client);
+    if (status == HttpStatus_NotModified) {
+        ESP_LOGI(TAG, "Firmware not modified.");
+        xEventGroupSetBits(ota_event_group, OTA_SMAE_BIT);
+        goto exit;
+    }
+    if (status != HttpStatus_Ok) {
+        ESP_LOGE(TAG, "HTTP status %d", status);
+        err = ESP_FAIL;
+        goto exit;
+    }
+    taskENTER_CRITICAL(&progress_lock);
+    progress.total = content_length > 0 ? content_length : -1;
+    taskEXIT_CRITICAL(&progress_lock);
+
+    err = http_ota_download(client, ctx);
+    if (ctx->same) {
+        // 记录ETag，之后的请求不再下载相同的固件
+        xEventGroupSetBits(ota_event_group, OTA_SMAE_BIT);
+        err = ESP_OK;
+    } else if (err == ESP_OK) {
+        if (!ctx->started) {
+            ESP_LOGE(TAG, "image too short");
+            err = ESP_ERR_INVALID_SIZE;
+        } else {
+            err = esp_ota_end(ctx->handle);     // 校验镜像
+            ctx->started = false;
+            if (err == ESP_OK) {
+                err = esp_ota_set_boot_partition(ctx->update);
+            }
+        }
+    }
+    if (err == ESP_OK && ctx->etag[0] != '\0') {
+        settings_set_blob(OTA_ETAG_KEY, ctx->etag, strlen(ctx->etag));
+    }
+
+exit:
+    if (ctx->started) {
+        esp_ota_abort(ctx->handle);
+    }
+    esp_http_client_close(client);
+    esp_http_client_cleanup(client);
+    free(ctx);
+    return err;
 }
 
 
@@ -136,10 +374,6 @@ void http_ota_task(void *pvParameter)
         .keep_alive_enable = true,
     };
 
-    esp_https_ota_config_t ota_config = {
-        .http_config = &config,
-    };
-
     while (1)
     {
         if (mode == OTA_AUTOMATIC) {
@@ -155,23 +389,18 @@ void http_ota_task(void *pvParameter)
                                             OTA_SMAE_BIT | OTA_FAIL_BIT | OTA_FINISH_BIT);
 
 
-        esp_err_t err = http_ota_process(&ota_config);
+        esp_err_t err = http_ota_process(&config);
         EventBits_t bits = xEventGroupWaitBits(ota_event_group,
-                        OTA_BEGIN_BIT | OTA_SMAE_BIT,
+                        OTA_SMAE_BIT,
                         pdFALSE, pdFALSE, 0);
-        
+
         if (err != ESP_OK) {
             ESP_LOGE(TAG, "OTA upgrade failed.");
-            ESP_LOGD(TAG, "ESP_HTTPS_OTA upgrade failed 0x%x", err);
-            /* Clean-up HTTPS OTA Firmware upgrade and close HTTPS connection */
-            if (bits & OTA_BEGIN_BIT) {
-                esp_https_ota_abort(https_ota_handle);
-            }
+            ESP_LOGD(TAG, "OTA upgrade failed 0x%x", err);
             xEventGroupSetBits(ota_event_group, OTA_FAIL_BIT);
         } else {
             if (bits & OTA_SMAE_BIT) {
                 ESP_LOGI(TAG, "Cancel app update.");
-                esp_https_ota_abort(https_ota_handle);
             } else {
                 ESP_LOGI(TAG, "OTA upgrade successful.");
                 xEventGroupSetBits(ota_event_group, OTA_FINISH_BIT);
@@ -209,11 +438,19 @@ ota_result_t http_ota_wait_result()
     return status;
 }
 
+void http_ota_get_progress(ota_progress_t *info)
+{
+    taskENTER_CRITICAL(&progress_lock);
+    *info = progress;
+    taskEXIT_CRITICAL(&progress_lock);
+}
+
 void http_ota_service_config(ota_service_config_t *config)
 {
     strcpy(ota_upgrade_url, config->url);
     interval_ms = config->interval;
     mode = config->mode;
+    progress_cb = config->progress_cb;
 }
 
 
@@ -26,6 +26,15 @@
     #define MY_DISP_VER_RES    480
 #endif
 
+/* The ILI9488 takes 3 bytes per pixel, LVGL can render them directly */
+#if LV_COLOR_RGB888_OUT && defined CONFIG_LV_TFT_DISPLAY_CONTROLLER_ILI9488
+    #define DISP_RGB888_OUT     1
+    #define DISP_PX_SIZE        LV_MAX(3, sizeof(lv_color_t))
+#else
+    #define DISP_RGB888_OUT     0
+    #define DISP_PX_SIZE        sizeof(lv_color_t)
+#endif
+
 #define TAG                     "lv_port_disp"
 #define LV_TICK_PERIOD_MS       1
 
@@ -67,10 +76,10 @@ void lv_port_disp_init(void)
     /*-----------------------------
      * Create a buffer for drawing
      *----------------------------*/
-    lv_color_t *buf1 = heap_caps_malloc(DISP_BUF_SIZE * sizeof(lv_color_t), MALLOC_CAP_8BIT | MALLOC_CAP_SPIRAM);
+    lv_color_t *buf1 = heap_caps_malloc(DISP_BUF_SIZE * DISP_PX_SIZE, MALLOC_CAP_8BIT | MALLOC_CAP_SPIRAM);
     assert(buf1 != NULL);
 
-    lv_color_t *buf2 = heap_caps_malloc(DISP_BUF_SIZE * sizeof(lv_color_t), MALLOC_CAP_8BIT | MALLOC_CAP_SPIRAM);
+    lv_color_t *buf2 = heap_caps_malloc(DISP_BUF_SIZE * DISP_PX_SIZE, MALLOC_CAP_8BIT | MALLOC_CAP_SPIRAM);
     assert(buf2 != NULL);
 
     static lv_disp_draw_buf_t disp_buf;
@@ -90,6 +99,11 @@ void lv_port_disp_init(void)
 
     /*Used to copy the buffer's content to the display*/
     disp_drv.flush_cb = disp_driver_flush;
+    disp_drv.rgb888_out = DISP_RGB888_OUT;
+#if CONFIG_LV_ILI9488_HW_SCROLL
+    /*Scroll full width objects with the panel*/
+    disp_drv.hw_scroll_cb = ili9488_hw_scroll;
+#endif
 
     disp_drv.draw_buf = &disp_buf;
     disp_drv.hor_res = LV_HOR_RES_MAX;
@@ -108,6 +122,7 @@ void lv_port_disp_init(void)
     /* If you want to use a task to create the graphic, you NEED to create a Pinned task
      * Otherwise there can be problem such as memory corruption and so on.
      * NOTE: When not using Wi-Fi nor Bluetooth you can pin the gui_disp_task to core 0 */
+    xGuiSemaphore = xSemaphoreCreateMutex();
     xTaskCreatePinnedToCore(gui_disp_task, "gui", 4096 * 1, NULL, 0, NULL, 1);
 
 }
@@ -131,7 +146,6 @@ static void gui_disp_task(void *pvParameter)
 {
     (void) pvParameter;
     ESP_LOGI(TAG, "start GUI diplay task");
-    xGuiSemaphore = xSemaphoreCreateMutex();
 
     /* Create and start a periodic timer interrupt to call lv_tick_inc */
     const esp_timer_create_args_t periodic_timer_args = {
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "rom/miniz.h"
+
+#include "ota_stream.h"
+
+#define TAG                     "ota_stream"
+
+#define IMAGE_MAGIC             0xE9            // ESP_IMAGE_HEADER_MAGIC
+#define COPY_BUF_SIZE           512
+
+typedef enum {
+    STREAM_DETECT,
+    STREAM_HEADER,
+    STREAM_PAYLOAD,
+} stream_state_t;
+
+struct ota_stream {
+    ota_stream_sink_t sink;
+    stream_state_t state;
+    uint8_t flags;
+    uint32_t image_size;
+    uint32_t written;
+
+    ota_pkg_header_t header;
+    size_t header_len;
+
+    /* zlib */
+    tinfl_decompressor *inflator;
+    uint8_t *dict;                          // TINFL_LZ_DICT_SIZE环形缓存
+    size_t dict_ofs;
+    bool inflate_done;
+
+    /* delta */
+    uint8_t op[9];                          // 正在接收的指令
+    size_t op_len;
+    uint32_t insert_remain;                 // INSERT指令剩余数据
+    uint8_t copy_buf[COPY_BUF_SIZE];
+};
+
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* 输出固件数据 */
+static esp_err_t stream_emit(ota_stream_t *stream, const uint8_t *data, size_t len)
+{
+    if (stream->image_size && stream->written + len > stream->image_size) {
+        ESP_LOGE(TAG, "image larger than %u bytes", (unsigned)stream->image_size);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    esp_err_t err = stream->sink.write(stream->sink.ctx, data, len);
+    if (err == ESP_OK) {
+        stream->written += len;
+    }
+    return err;
+}
+
+static esp_err_t delta_copy(ota_stream_t *stream, uint32_t offset, uint32_t len)
+{
+    while (len) {
+        size_t n = len < COPY_BUF_SIZE ? len : COPY_BUF_SIZE;
+        esp_err_t err = stream->sink.read_source(stream->sink.ctx, offset, stream->copy_buf, n);
+        if (err != ESP_OK) {
+            return err;
+        }
+        err = stream_emit(stream, stream->copy_buf, n);
+        if (err != ESP_OK) {
+            return err;
+        }
+        offset += n;
+        len -= n;
+    }
+    return ESP_OK;
+}
+
+/* 处理差分指令流 */
+static esp_err_t delta_feed(ota_stream_t *stream, const uint8_t *data, size_t len)
+{
+    esp_err_t err;
+    while (len) {
+        if (stream->insert_remain) {
+            size_t n = len < stream->insert_remain ? len : stream->insert_remain;
+            err = stream_emit(stream, data, n);
+            if (err != ESP_OK) {
+                return err;
+            }
+            stream->insert_remain -= n;
+            data += n;
+            len -= n;
+            continue;
+        }
+
+        stream->op[stream->op_len++] = *data++;
+        len--;
+
+        size_t need;
+        switch (stream->op[0]) {
+        case OTA_DELTA_OP_COPY:
+            need = 9;
+            break;
+        case OTA_DELTA_OP_INSERT:
+            need = 5;
+            break;
+        default:
+            ESP_LOGE(TAG, "invalid delta op 0x%02x", stream->op[0]);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        if (stream->op_len < need) {
+            continue;
+        }
+
+        stream->op_len = 0;
+        if (stream->op[0] == OTA_DELTA_OP_COPY) {
+            err = delta_copy(stream, get_le32(&stream->op[1]), get_le32(&stream->op[5]));
+            if (err != ESP_OK) {
+                return err;
+            }
+        } else {
+            stream->insert_remain = get_le32(&stream->op[1]);
+        }
+    }
+    return ESP_OK;
+}
+
+/* 解压后的数据 */
+static esp_err_t payload_feed(ota_stream_t *stream, const uint8_t *data, size_t len)
+{
+    if (stream->flags & OTA_PKG_FLAG_DELTA) {
+        return delta_feed(stream, data, len);
+    }
+    return stream_emit(stream, data, len);
+}
+
+static esp_err_t inflate_feed(ota_stream_t *stream, const uint8_t *data, size_t len)
+{
+    if (stream->inflate_done) {
+        return len ? ESP_ERR_INVALID_RESPONSE : ESP_OK;
+    }
+
+    while (1) {
+        size_t in_bytes = len;
+        size_t out_bytes = TINFL_LZ_DICT_SIZE - stream->dict_ofs;
+        tinfl_status status = tinfl_decompress(stream->inflator, data, &in_bytes,
+                                               stream->dict, stream->dict + stream->dict_ofs, &out_bytes,
+                                               TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_HAS_MORE_INPUT);
+        data += in_bytes;
+        len -= in_bytes;
+
+        if (out_bytes) {
+            esp_err_t err = payload_feed(stream, stream->dict + stream->dict_ofs, out_bytes);
+            if (err != ESP_OK) {
+                return err;
+            }
+            stream->dict_ofs = (stream->dict_ofs + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+        }
+
+        if (status == TINFL_STATUS_DONE) {
+            stream->inflate_done = true;
+            return len ? ESP_ERR_INVALID_RESPONSE : ESP_OK;
+        }
+        if (status < 0) {
+            ESP_LOGE(TAG, "inflate failed (%d)", status);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT && len == 0) {
+            return ESP_OK;
+        }
+    }
+}
+
+static esp_err_t header_parse(ota_stream_t *stream)
+{
+    ota_pkg_header_t *header = &stream->header;
+    if (header->magic != OTA_PKG_MAGIC || header->version != OTA_PKG_VERSION) {
+        ESP_LOGE(TAG, "unknown package format");
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    stream->flags = header->flags;
+    stream->image_size = header->image_size;
+
+    if (stream->flags & OTA_PKG_FLAG_ZLIB) {
+        stream->inflator = malloc(sizeof(tinfl_decompressor));
+        stream->dict = malloc(TINFL_LZ_DICT_SIZE);
+        if (stream->inflator == NULL || stream->dict == NULL) {
+            ESP_LOGE(TAG, "inflate malloc failed!");
+            return ESP_ERR_NO_MEM;
+        }
+        tinfl_init(stream->inflator);
+    }
+    if ((stream->flags & OTA_PKG_FLAG_DELTA) && stream->sink.read_source == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    ota_stream_info_t info = {
+        .flags = stream->flags,
+        .image_size = stream->image_size,
+        .source_sha256 = (stream->flags & OTA_PKG_FLAG_DELTA) ? header->source_sha256 : NULL,
+    };
+    return stream->sink.begin(stream->sink.ctx, &info);
+}
+
+
+ota_stream_t *ota_stream_create(const ota_stream_sink_t *sink)
+{
+    ota_stream_t *stream = calloc(1, sizeof(ota_stream_t));
+    if (stream == NULL) {
+        return NULL;
+    }
+    stream->sink = *sink;
+    stream->state = STREAM_DETECT;
+    return stream;
+}
+
+esp_err_t ota_stream_feed(ota_stream_t *stream, const uint8_t *data, size_t len)
+{
+    esp_err_t err;
+    while (len) {
+        switch (stream->state) {
+        case STREAM_DETECT:
+            if (data[0] == IMAGE_MAGIC) {
+                ota_stream_info_t info = {0};
+                err = stream->sink.begin(stream->sink.ctx, &info);
+                if (err != ESP_OK) {
+                    return err;
+                }
+                stream->state = STREAM_PAYLOAD;
+            } else {
+                stream->state = STREAM_HEADER;
+            }
+            break;
+
+        case STREAM_HEADER: {
+            size_t n = sizeof(ota_pkg_header_t) - stream->header_len;
+            n = len < n ? len : n;
+            memcpy((uint8_t *)&stream->header + stream->header_len, data, n);
+            stream->header_len += n;
+            data += n;
+            len -= n;
+            if (stream->header_len == sizeof(ota_pkg_header_t)) {
+                err = header_parse(stream);
+                if (err != ESP_OK) {
+                    return err;
+                }
+                stream->state = STREAM_PAYLOAD;
+            }
+            break;
+        }
+
+        case STREAM_PAYLOAD:
+            if (stream->flags & OTA_PKG_FLAG_ZLIB) {
+                return inflate_feed(stream, data, len);
+            }
+            return payload_feed(stream, data, len);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t ota_stream_finish(ota_stream_t *stream)
+{
+    if (stream->state != STREAM_PAYLOAD) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if ((stream->flags & OTA_PKG_FLAG_ZLIB) && !stream->inflate_done) {
+        ESP_LOGE(TAG, "compressed stream truncated");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (stream->op_len || stream->insert_remain) {
+        ESP_LOGE(TAG, "delta stream truncated");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (stream->image_size && stream->written != stream->image_size) {
+        ESP_LOGE(TAG, "image size %u, expected %u", (unsigned)stream->written, (unsigned)stream->image_size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+
+uint32_t ota_stream_get_written(const ota_stream_t *stream)
+{
+    return stream->written;
+}
+
+void ota_stream_delete(ota_stream_t *stream)
+{
+    if (stream == NULL) {
+        return;
+    }
+    free(stream->inflator);
+    free(stream->dict);
+    free(stream);
+}
@@ -0,0 +1,138 @@
+/*
+ * Host driver of the OTA stream decoder for test_ota.py.
+ *
+ *   ota_stream_cli <package> <image out> [<running partition> <running sha256 hex>]
+ *
+ * Feeds the package in uneven chunks, like the HTTP reads on the device. The
+ * sink stands in for http_ota_wrapper: a delta must name the running firmware by
+ * the digest esp_partition_get_sha256() reports for it, and its copies must stay
+ * within the running partition. Exits with the error of the decoder, if any.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_err.h"
+#include "ota_stream.h"
+
+typedef struct {
+    FILE * out;
+    uint8_t * running;
+    size_t running_size;
+    uint8_t running_sha256[32];
+} cli_sink_t;
+
+static uint8_t * file_read(const char * path, size_t * size)
+{
+    FILE * f = fopen(path, "rb");
+    if(f == NULL) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t * data = malloc(n > 0 ? n : 1);
+    if(data && fread(data, 1, n, f) != (size_t)n) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = n;
+    return data;
+}
+
+static int hex_parse(const char * hex, uint8_t * out, size_t len)
+{
+    size_t i;
+    if(strlen(hex) != len * 2) return -1;
+    for(i = 0; i < len; i++) {
+        unsigned int b;
+        if(sscanf(hex + i * 2, "%2x", &b) != 1) return -1;
+        out[i] = (uint8_t)b;
+    }
+    return 0;
+}
+
+static esp_err_t cli_sink_begin(void * arg, const ota_stream_info_t * info)
+{
+    cli_sink_t * sink = arg;
+    size_t i;
+    printf("flags %u, image size %u", (unsigned)info->flags, (unsigned)info->image_size);
+    if(info->flags & OTA_PKG_FLAG_DELTA) {
+        printf(", source sha256 ");
+        for(i = 0; i < 32; i++) printf("%02x", info->source_sha256[i]);
+        if(sink->running == NULL || memcmp(info->source_sha256, sink->running_sha256, 32) != 0) {
+            printf("\ndelta base does not match running firmware\n");
+            return ESP_ERR_INVALID_VERSION;
+        }
+    }
+    printf("\n");
+    return ESP_OK;
+}
+
+static esp_err_t cli_sink_write(void * arg, const uint8_t * data, size_t len)
+{
+    cli_sink_t * sink = arg;
+    return fwrite(data, 1, len, sink->out) == len ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t cli_sink_read_source(void * arg, uint32_t offset, uint8_t * data, size_t len)
+{
+    cli_sink_t * sink = arg;
+    if(offset > sink->running_size || len > sink->running_size - offset) {
+        printf("delta copy out of range\n");
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    memcpy(data, sink->running + offset, len);
+    return ESP_OK;
+}
+
+int main(int argc, char ** argv)
+{
+    static const size_t chunk_sizes[] = {1, 7, 24, 300, 1460, 4096};
+    cli_sink_t sink = {0};
+    size_t pkg_size;
+    uint8_t * pkg;
+
+    if(argc != 3 && argc != 5) {
+        fprintf(stderr, "usage: %s <package> <image out> [<running partition> <running sha256 hex>]\n", argv[0]);
+        return 2;
+    }
+    pkg = file_read(argv[1], &pkg_size);
+    sink.out = fopen(argv[2], "wb");
+    if(pkg == NULL || sink.out == NULL) {
+        fprintf(stderr, "cannot open %s or %s\n", argv[1], argv[2]);
+        return 2;
+    }
+    if(argc == 5) {
+        sink.running = file_read(argv[3], &sink.running_size);
+        if(sink.running == NULL || hex_parse(argv[4], sink.running_sha256, 32) != 0) {
+            fprintf(stderr, "bad running partition %s or sha256 %s\n", argv[3], argv[4]);
+            return 2;
+        }
+    }
+
+    ota_stream_sink_t stream_sink = {
+        .begin = cli_sink_begin,
+        .write = cli_sink_write,
+        .read_source = cli_sink_read_source,
+        .ctx = &sink,
+    };
+    ota_stream_t * stream = ota_stream_create(&stream_sink);
+    esp_err_t err = stream ? ESP_OK : ESP_ERR_NO_MEM;
+    size_t pos = 0;
+    size_t i = 0;
+    while(err == ESP_OK && pos < pkg_size) {
+        size_t n = chunk_sizes[i++ % (sizeof(chunk_sizes) / sizeof(chunk_sizes[0]))];
+        n = n < pkg_size - pos ? n : pkg_size - pos;
+        err = ota_stream_feed(stream, pkg + pos, n);
+        pos += n;
+    }
+    if(err == ESP_OK) err = ota_stream_finish(stream);
+    if(err == ESP_OK) printf("written %u\n", (unsigned)ota_stream_get_written(stream));
+    else printf("error %s\n", esp_err_to_name(err));
+
+    ota_stream_delete(stream);
+    fclose(sink.out);
+    free(sink.running);
+    free(pkg);
+    return err == ESP_OK ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+/* Host stand-in for the ESP-IDF capability based heap, every capability is the host heap. */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_EXEC     (1 << 0)
+#define MALLOC_CAP_32BIT    (1 << 1)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+void * heap_caps_malloc(size_t size, uint32_t caps);
+void * heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void heap_caps_free(void * ptr);
@@ -0,0 +1,12 @@
+/* Host stand-in for the restart related part of esp_system.h. */
+#pragma once
+
+#include "esp_err.h"
+
+typedef void (*shutdown_handler_t)(void);
+
+esp_err_t esp_register_shutdown_handler(shutdown_handler_t handle);
+esp_err_t esp_unregister_shutdown_handler(shutdown_handler_t handle);
+
+/*Runs the registered shutdown handlers like esp_restart() does, but returns*/
+void esp_restart(void);
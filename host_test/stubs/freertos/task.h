@@ -0,0 +1,20 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *arg);
+
+/*The task runs on its own thread until it is deleted or the process ends*/
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_size, void *arg,
+                       UBaseType_t prio, TaskHandle_t *handle);
+/*An other task is cancelled at its next blocking call, NULL ends the calling one*/
+void vTaskDelete(TaskHandle_t task);
+/*Threads not started by xTaskCreate (e.g. main) get a handle on the first call*/
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
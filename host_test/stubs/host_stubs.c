@@ -0,0 +1,660 @@
+/*
+ * POSIX implementation of the FreeRTOS and ESP-IDF stand-ins.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "driver/i2c.h"
+#include "esp_heap_caps.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "nvs.h"
+#include "host_stubs.h"
+
+static pthread_mutex_t critical_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static host_stubs_stats_t stats;
+static uint32_t task_fail_cnt;
+static uint32_t queue_fail_cnt;
+
+/**********************
+ *   CRITICAL SECTION
+ **********************/
+
+void vPortEnterCritical(portMUX_TYPE * mux)
+{
+    (void)mux;
+    pthread_mutex_lock(&critical_lock);
+}
+
+void vPortExitCritical(portMUX_TYPE * mux)
+{
+    (void)mux;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+void host_stubs_get_stats(host_stubs_stats_t * s)
+{
+    pthread_mutex_lock(&critical_lock);
+    *s = stats;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+void host_stubs_fail_task_create(uint32_t cnt)
+{
+    pthread_mutex_lock(&critical_lock);
+    task_fail_cnt = cnt;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+void host_stubs_fail_queue_create(uint32_t cnt)
+{
+    pthread_mutex_lock(&critical_lock);
+    queue_fail_cnt = cnt;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+/**********************
+ *   TIME
+ **********************/
+
+void host_sleep_ms(uint32_t ms)
+{
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    while(nanosleep(&ts, &ts) == -1 && errno == EINTR);
+}
+
+static struct timespec deadline_get(TickType_t ticks)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += ticks / 1000;
+    ts.tv_nsec += (long)(ticks % 1000) * 1000000L;
+    if(ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+static void unlock_on_cancel(void * lock)
+{
+    pthread_mutex_unlock(lock);
+}
+
+/*Wait on `cond` until `ready` is set, 0 ticks polls and portMAX_DELAY waits forever.
+ *A task deleted while waiting leaves `lock` unlocked.*/
+static bool cond_wait(pthread_cond_t * cond, pthread_mutex_t * lock, const bool * ready, TickType_t ticks)
+{
+    struct timespec deadline = deadline_get(ticks);
+    bool timeout = false;
+    pthread_cleanup_push(unlock_on_cancel, lock);
+    while(!*ready && !timeout) {
+        if(ticks == 0) timeout = true;
+        else if(ticks == portMAX_DELAY) pthread_cond_wait(cond, lock);
+        else timeout = pthread_cond_timedwait(cond, lock, &deadline) == ETIMEDOUT;
+    }
+    pthread_cleanup_pop(0);
+    return *ready;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    host_sleep_ms(ticks);
+}
+
+/**********************
+ *   SEMAPHORE
+ **********************/
+
+struct host_sem {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool free;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    struct host_sem * sem = calloc(1, sizeof(*sem));
+    if(sem == NULL) return NULL;
+    pthread_mutex_init(&sem->lock, NULL);
+    pthread_cond_init(&sem->cond, NULL);
+    sem->free = true;
+
+    pthread_mutex_lock(&critical_lock);
+    stats.sem_live_cnt++;
+    pthread_mutex_unlock(&critical_lock);
+    return sem;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    pthread_mutex_lock(&sem->lock);
+    bool ok = cond_wait(&sem->cond, &sem->lock, &sem->free, ticks);
+    if(ok) sem->free = false;
+    pthread_mutex_unlock(&sem->lock);
+    return ok ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    pthread_mutex_lock(&sem->lock);
+    bool was_taken = !sem->free;
+    sem->free = true;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->lock);
+    return was_taken ? pdTRUE : pdFALSE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    if(sem == NULL) return;
+    pthread_mutex_destroy(&sem->lock);
+    pthread_cond_destroy(&sem->cond);
+    free(sem);
+
+    pthread_mutex_lock(&critical_lock);
+    stats.sem_live_cnt--;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+/**********************
+ *   QUEUE
+ **********************/
+
+struct host_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    UBaseType_t len;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t cnt;
+    bool not_empty;
+    bool not_full;
+    uint8_t * items;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size)
+{
+    pthread_mutex_lock(&critical_lock);
+    bool fail = queue_fail_cnt > 0;
+    if(fail) queue_fail_cnt--;
+    pthread_mutex_unlock(&critical_lock);
+    if(fail) return NULL;
+
+    struct host_queue * q = calloc(1, sizeof(*q));
+    if(q == NULL) return NULL;
+    q->items = calloc(len, item_size);
+    if(q->items == NULL) {
+        free(q);
+        return NULL;
+    }
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->cond, NULL);
+    q->len = len;
+    q->item_size = item_size;
+    q->not_full = len > 0;
+
+    pthread_mutex_lock(&critical_lock);
+    stats.queue_create_cnt++;
+    stats.queue_live_cnt++;
+    pthread_mutex_unlock(&critical_lock);
+    return q;
+}
+
+static void queue_push(QueueHandle_t q, const void * item)
+{
+    memcpy(q->items + ((q->head + q->cnt) % q->len) * q->item_size, item, q->item_size);
+    q->cnt++;
+    q->not_empty = true;
+    q->not_full = q->cnt < q->len;
+    pthread_cond_broadcast(&q->cond);
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void * item, TickType_t ticks)
+{
+    pthread_mutex_lock(&q->lock);
+    bool ok = cond_wait(&q->cond, &q->lock, &q->not_full, ticks);
+    if(ok) queue_push(q, item);
+    pthread_mutex_unlock(&q->lock);
+    return ok ? pdPASS : pdFAIL;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void * item)
+{
+    pthread_mutex_lock(&q->lock);
+    if(q->cnt == q->len) {
+        q->head = (q->head + 1) % q->len;
+        q->cnt--;
+    }
+    queue_push(q, item);
+    pthread_mutex_unlock(&q->lock);
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void * item, TickType_t ticks)
+{
+    pthread_mutex_lock(&q->lock);
+    bool ok = cond_wait(&q->cond, &q->lock, &q->not_empty, ticks);
+    if(ok) {
+        memcpy(item, q->items + q->head * q->item_size, q->item_size);
+        q->head = (q->head + 1) % q->len;
+        q->cnt--;
+        q->not_empty = q->cnt > 0;
+        q->not_full = true;
+        pthread_cond_broadcast(&q->cond);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok ? pdTRUE : pdFALSE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+    pthread_mutex_lock(&q->lock);
+    UBaseType_t cnt = q->cnt;
+    pthread_mutex_unlock(&q->lock);
+    return cnt;
+}
+
+void vQueueDelete(QueueHandle_t q)
+{
+    if(q == NULL) return;
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->cond);
+    free(q->items);
+    free(q);
+
+    pthread_mutex_lock(&critical_lock);
+    stats.queue_live_cnt--;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+/**********************
+ *   TASK
+ **********************/
+
+struct host_task {
+    pthread_t thread;
+    bool own_thread;            /*Started by xTaskCreate, so it can be deleted*/
+    TaskFunction_t fn;
+    void * arg;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify_value;
+    bool notified;
+};
+
+static __thread struct host_task * current_task;
+
+static struct host_task * task_alloc(void)
+{
+    struct host_task * task = calloc(1, sizeof(*task));
+    if(task == NULL) return NULL;
+    pthread_mutex_init(&task->lock, NULL);
+    pthread_cond_init(&task->cond, NULL);
+    return task;
+}
+
+static void * task_entry(void * p)
+{
+    struct host_task * task = p;
+    current_task = task;
+    task->fn(task->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char * name, uint32_t stack_size, void * arg,
+                       UBaseType_t prio, TaskHandle_t * handle)
+{
+    (void)name;
+    (void)stack_size;
+    (void)prio;
+
+    pthread_mutex_lock(&critical_lock);
+    bool fail = task_fail_cnt > 0;
+    if(fail) task_fail_cnt--;
+    pthread_mutex_unlock(&critical_lock);
+    if(fail) return pdFAIL;
+
+    struct host_task * task = task_alloc();
+    if(task == NULL) return pdFAIL;
+    task->own_thread = true;
+    task->fn = fn;
+    task->arg = arg;
+    if(handle) *handle = task;
+    if(pthread_create(&task->thread, NULL, task_entry, task) != 0) {
+        if(handle) *handle = NULL;
+        free(task);
+        return pdFAIL;
+    }
+
+    pthread_mutex_lock(&critical_lock);
+    stats.task_create_cnt++;
+    stats.task_live_cnt++;
+    pthread_mutex_unlock(&critical_lock);
+    return pdPASS;
+}
+
+static void task_free(struct host_task * task)
+{
+    pthread_mutex_destroy(&task->lock);
+    pthread_cond_destroy(&task->cond);
+    free(task);
+
+    pthread_mutex_lock(&critical_lock);
+    stats.task_live_cnt--;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if(task == NULL) task = current_task;
+    if(task == current_task) {
+        /*Nobody joins a task deleting itself*/
+        if(task->own_thread) {
+            pthread_detach(pthread_self());
+            task_free(task);
+            current_task = NULL;
+        }
+        pthread_exit(NULL);
+    }
+    if(!task->own_thread) return;
+
+    pthread_cancel(task->thread);
+    pthread_join(task->thread, NULL);
+    task_free(task);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if(current_task == NULL) current_task = task_alloc();
+    return current_task;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    pthread_mutex_lock(&task->lock);
+    task->notify_value++;
+    task->notified = true;
+    pthread_cond_broadcast(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    struct host_task * task = xTaskGetCurrentTaskHandle();
+    pthread_mutex_lock(&task->lock);
+    uint32_t value = 0;
+    if(cond_wait(&task->cond, &task->lock, &task->notified, ticks)) {
+        value = task->notify_value;
+        task->notify_value = clear_on_exit ? 0 : value - 1;
+        task->notified = task->notify_value > 0;
+    }
+    pthread_mutex_unlock(&task->lock);
+    return value;
+}
+
+/**********************
+ *   ESP-IDF
+ **********************/
+
+const char * esp_err_to_name(esp_err_t code)
+{
+    switch(code) {
+        case ESP_OK:
+            return "ESP_OK";
+        case ESP_FAIL:
+            return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:
+            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:
+            return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:
+            return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:
+            return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_SUPPORTED:
+            return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:
+            return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_RESPONSE:
+            return "ESP_ERR_INVALID_RESPONSE";
+        case ESP_ERR_INVALID_VERSION:
+            return "ESP_ERR_INVALID_VERSION";
+        default:
+            return "UNKNOWN ERROR";
+    }
+}
+
+esp_err_t i2c_param_config(i2c_port_t port, const i2c_config_t * conf)
+{
+    (void)port;
+    (void)conf;
+    return ESP_OK;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t port, i2c_mode_t mode, size_t rx_buf, size_t tx_buf, int flags)
+{
+    (void)mode;
+    (void)rx_buf;
+    (void)tx_buf;
+    (void)flags;
+    if(port < 0 || port >= I2C_NUM_MAX) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&critical_lock);
+    stats.i2c_install_cnt[port]++;
+    pthread_mutex_unlock(&critical_lock);
+    return ESP_OK;
+}
+
+esp_err_t i2c_driver_delete(i2c_port_t port)
+{
+    (void)port;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+#define SHUTDOWN_HANDLERS_NO    5
+static shutdown_handler_t shutdown_handlers[SHUTDOWN_HANDLERS_NO];
+
+esp_err_t esp_register_shutdown_handler(shutdown_handler_t handler)
+{
+    int i;
+    for(i = 0; i < SHUTDOWN_HANDLERS_NO; i++) {
+        if(shutdown_handlers[i] == handler) return ESP_ERR_INVALID_STATE;
+        if(shutdown_handlers[i] == NULL) {
+            shutdown_handlers[i] = handler;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t esp_unregister_shutdown_handler(shutdown_handler_t handler)
+{
+    int i;
+    for(i = 0; i < SHUTDOWN_HANDLERS_NO; i++) {
+        if(shutdown_handlers[i] == handler) {
+            shutdown_handlers[i] = NULL;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_INVALID_STATE;
+}
+
+void esp_restart(void)
+{
+    int i;
+    for(i = SHUTDOWN_HANDLERS_NO - 1; i >= 0; i--) {
+        if(shutdown_handlers[i]) shutdown_handlers[i]();
+    }
+}
+
+esp_err_t nvs_open(const char * namespace_name, nvs_open_mode_t open_mode, nvs_handle_t * out_handle)
+{
+    (void)namespace_name;
+    (void)open_mode;
+    (void)out_handle;
+    return ESP_ERR_NVS_NOT_INITIALIZED;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char * key, void * out_value, size_t * length)
+{
+    (void)handle;
+    (void)key;
+    (void)out_value;
+    (void)length;
+    return ESP_ERR_NVS_NOT_INITIALIZED;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char * key, const void * value, size_t length)
+{
+    (void)handle;
+    (void)key;
+    (void)value;
+    (void)length;
+    return ESP_ERR_NVS_NOT_INITIALIZED;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    (void)handle;
+    return ESP_ERR_NVS_NOT_INITIALIZED;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+    (void)handle;
+}
+
+size_t host_strlcpy(char * dst, const char * src, size_t size)
+{
+    size_t len = strlen(src);
+    if(size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+
+void esp_rom_gpio_pad_select_gpio(uint32_t gpio_num)
+{
+    (void)gpio_num;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+    (void)mode;
+    return gpio_num >= 0 && gpio_num < GPIO_NUM_MAX ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+static uint8_t gpio_level[GPIO_NUM_MAX];
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if(gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    gpio_level[gpio_num] = level ? 1 : 0;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    if(gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) return 0;
+    return gpio_level[gpio_num];
+}
+
+void * heap_caps_malloc(size_t size, uint32_t caps)
+{
+    (void)caps;
+    return malloc(size);
+}
+
+void * heap_caps_calloc(size_t n, size_t size, uint32_t caps)
+{
+    (void)caps;
+    return calloc(n, size);
+}
+
+void heap_caps_free(void * ptr)
+{
+    free(ptr);
+}
+
+/*The tests install a fake bus backend, the command link is never executed*/
+i2c_cmd_handle_t i2c_cmd_link_create(void)
+{
+    return NULL;
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd)
+{
+    (void)cmd;
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd)
+{
+    (void)cmd;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd)
+{
+    (void)cmd;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ack_en)
+{
+    (void)cmd;
+    (void)data;
+    (void)ack_en;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t * data, size_t len, bool ack_en)
+{
+    (void)cmd;
+    (void)data;
+    (void)len;
+    (void)ack_en;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd, uint8_t * data, size_t len, i2c_ack_type_t ack)
+{
+    (void)cmd;
+    (void)data;
+    (void)len;
+    (void)ack;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks)
+{
+    (void)port;
+    (void)cmd;
+    (void)ticks;
+    return ESP_FAIL;
+}
@@ -0,0 +1,26 @@
+/*
+ * Counters and fault injection of the host stand-ins, for the tests to check
+ * what the module under test allocated and how it copes with failures.
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t task_create_cnt;       /*Tasks started by xTaskCreate*/
+    uint32_t task_live_cnt;         /*Tasks started by xTaskCreate and not deleted yet*/
+    uint32_t queue_create_cnt;      /*Queues created by xQueueCreate*/
+    uint32_t queue_live_cnt;        /*Queues created and not deleted yet*/
+    uint32_t sem_live_cnt;          /*Mutexes created and not deleted yet*/
+    uint32_t i2c_install_cnt[2];    /*i2c_driver_install per port*/
+} host_stubs_stats_t;
+
+/*Snapshot of the counters, they are updated under the critical section lock*/
+void host_stubs_get_stats(host_stubs_stats_t * stats);
+
+/*Make the next `cnt` calls of xTaskCreate or xQueueCreate fail*/
+void host_stubs_fail_task_create(uint32_t cnt);
+void host_stubs_fail_queue_create(uint32_t cnt);
+
+/*Sleep the calling thread for `ms` milliseconds*/
+void host_sleep_ms(uint32_t ms);
@@ -0,0 +1,11 @@
+/*
+ * Functions of the ESP-IDF newlib which the host libc may lack. Included in every
+ * host test source with -include, so the modules under test build unchanged.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+size_t host_strlcpy(char * dst, const char * src, size_t size);
+#define strlcpy host_strlcpy
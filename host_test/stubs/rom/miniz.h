@@ -0,0 +1,77 @@
+/*
+ * Host stand-in for the tinfl inflater of the ESP32 ROM, backed by the host zlib.
+ *
+ * zlib allocates its state and window from an arena inside the decompressor, so
+ * freeing the decompressor frees everything, like with the ROM version.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <zlib.h>
+
+#define TINFL_LZ_DICT_SIZE              32768
+#define TINFL_FLAG_PARSE_ZLIB_HEADER    1
+#define TINFL_FLAG_HAS_MORE_INPUT       2
+
+typedef enum {
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2,
+} tinfl_status;
+
+typedef struct {
+    z_stream z;
+    int init_err;
+    size_t arena_used;
+    _Alignas(max_align_t) uint8_t arena[48 * 1024];
+} tinfl_decompressor;
+
+static inline voidpf tinfl_host_alloc(voidpf opaque, uInt items, uInt size)
+{
+    tinfl_decompressor * r = opaque;
+    size_t n = ((size_t)items * size + sizeof(max_align_t) - 1) & ~(sizeof(max_align_t) - 1);
+    if(n > sizeof(r->arena) - r->arena_used) return Z_NULL;
+    voidpf p = r->arena + r->arena_used;
+    r->arena_used += n;
+    return p;
+}
+
+static inline void tinfl_host_free(voidpf opaque, voidpf address)
+{
+    (void)opaque;
+    (void)address;
+}
+
+static inline void tinfl_init(tinfl_decompressor * r)
+{
+    memset(&r->z, 0, sizeof(r->z));
+    r->arena_used = 0;
+    r->z.zalloc = tinfl_host_alloc;
+    r->z.zfree = tinfl_host_free;
+    r->z.opaque = r;
+    r->init_err = inflateInit(&r->z);
+}
+
+/*Only the streaming use of the ROM: zlib header, output into a TINFL_LZ_DICT_SIZE ring*/
+static inline tinfl_status tinfl_decompress(tinfl_decompressor * r, const uint8_t * in, size_t * in_size,
+                                            uint8_t * out_start, uint8_t * out_next, size_t * out_size, uint32_t flags)
+{
+    (void)out_start;
+    (void)flags;
+    if(r->init_err != Z_OK) return TINFL_STATUS_FAILED;
+
+    r->z.next_in = (Bytef *)in;
+    r->z.avail_in = (uInt) * in_size;
+    r->z.next_out = out_next;
+    r->z.avail_out = (uInt) * out_size;
+    int ret = inflate(&r->z, Z_NO_FLUSH);
+    *in_size -= r->z.avail_in;
+    *out_size -= r->z.avail_out;
+
+    if(ret == Z_STREAM_END) return TINFL_STATUS_DONE;
+    if(ret != Z_OK && ret != Z_BUF_ERROR) return TINFL_STATUS_FAILED;
+    return r->z.avail_out == 0 ? TINFL_STATUS_HAS_MORE_OUTPUT : TINFL_STATUS_NEEDS_MORE_INPUT;
+}
@@ -0,0 +1,5 @@
+/*
+ * Host builds take the configuration of the module under test from compile
+ * definitions set in host_test/CMakeLists.txt.
+ */
+#pragma once
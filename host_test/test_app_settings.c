@@ -0,0 +1,210 @@
+/*
+ * Host test of the write coalescing settings store on its RAM backend.
+ *
+ * The RAM backend is wrapped to record the keys of every commit and to inject
+ * commit failures. It keeps the values for the whole process, every test uses
+ * its own namespace.
+ */
+#include <string.h>
+
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_system.h"
+#include "nvs.h"
+#include "app_settings.h"
+
+#define MAX_COMMITS     16
+
+static uint32_t commit_cnt;
+static size_t commit_keys[MAX_COMMITS];     /*Keys written by each commit*/
+static uint32_t commit_fail_cnt;            /*Fail the next commits*/
+static char ns[SETTINGS_KEY_LEN];
+
+static esp_err_t test_backend_load(void * ctx, const char * namespace, const char * key, void * data, size_t * size)
+{
+    (void)ctx;
+    const settings_backend_t * ram = settings_ram_backend();
+    return ram->load(ram->ctx, namespace, key, data, size);
+}
+
+static esp_err_t test_backend_commit(void * ctx, const char * namespace, const settings_item_t * items, size_t count)
+{
+    (void)ctx;
+    if(commit_fail_cnt > 0) {
+        commit_fail_cnt--;
+        return ESP_FAIL;
+    }
+    if(commit_cnt < MAX_COMMITS) commit_keys[commit_cnt] = count;
+    commit_cnt++;
+    const settings_backend_t * ram = settings_ram_backend();
+    return ram->commit(ram->ctx, namespace, items, count);
+}
+
+static const settings_backend_t test_backend = {
+    .load = test_backend_load,
+    .commit = test_backend_commit,
+    .ctx = NULL,
+};
+
+static void restart_store(void)
+{
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_deinit());
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_init(ns, &test_backend));
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    static uint32_t test_cnt;
+    snprintf(ns, sizeof(ns), "test%u", (unsigned)test_cnt++);
+    commit_cnt = 0;
+    commit_fail_cnt = 0;
+    memset(commit_keys, 0, sizeof(commit_keys));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_init(ns, &test_backend));
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    commit_fail_cnt = 0;
+    settings_deinit();
+}
+
+void test_settings_coalesced_sets_write_each_key_once(void)
+{
+    uint8_t cal[12];
+    uint32_t i;
+    for(i = 0; i < 100; i++) TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u8("brightness", (uint8_t)i));
+    for(i = 0; i < 50; i++) TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_i32("page", -(int32_t)i));
+    for(i = 0; i < 10; i++) {
+        memset(cal, (int)i, sizeof(cal));
+        TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_blob("cal", cal, sizeof(cal)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, commit_cnt);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_flush());
+
+    settings_stats_t stats;
+    settings_get_stats(&stats, false);
+    TEST_ASSERT_EQUAL_UINT32(160, stats.set_calls);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.set_skipped);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.commits);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.key_writes);
+    TEST_ASSERT_EQUAL_UINT32(1 + 4 + sizeof(cal), stats.bytes_written);
+    TEST_ASSERT_EQUAL_UINT32(1, commit_cnt);
+    TEST_ASSERT_EQUAL_size_t(3, commit_keys[0]);
+
+    /*The last values were committed*/
+    restart_store();
+    uint8_t u8;
+    int32_t i32;
+    uint8_t cal_read[sizeof(cal)];
+    size_t size = sizeof(cal_read);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_get_u8("brightness", &u8));
+    TEST_ASSERT_EQUAL_UINT8(99, u8);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_get_i32("page", &i32));
+    TEST_ASSERT_EQUAL_INT32(-49, i32);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_get_blob("cal", cal_read, &size));
+    TEST_ASSERT_EQUAL_size_t(sizeof(cal), size);
+    TEST_ASSERT_EQUAL_MEMORY(cal, cal_read, sizeof(cal));
+}
+
+void test_settings_unchanged_values_are_not_written(void)
+{
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u32("lang", 3));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_flush());
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u32("lang", 3));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_flush());
+
+    settings_stats_t stats;
+    settings_get_stats(&stats, true);
+    TEST_ASSERT_EQUAL_UINT32(11, stats.set_calls);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.set_skipped);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.commits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.key_writes);
+
+    /*Only the changed key of the next commit is written*/
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u32("lang", 3));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u32("theme", 1));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_flush());
+    settings_get_stats(&stats, false);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.key_writes);
+    TEST_ASSERT_EQUAL_UINT32(2, commit_cnt);
+    TEST_ASSERT_EQUAL_size_t(1, commit_keys[1]);
+}
+
+void test_settings_commit_waits_until_the_changes_stop(void)
+{
+    /*A change every third of the delay keeps the commit back*/
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u8("slider", (uint8_t)i));
+        TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u8("page", (uint8_t)(i / 2)));
+        vTaskDelay(pdMS_TO_TICKS(SETTINGS_COMMIT_DELAY_MS / 3));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, commit_cnt);
+
+    vTaskDelay(pdMS_TO_TICKS(SETTINGS_COMMIT_DELAY_MS * 3));
+    settings_stats_t stats;
+    settings_get_stats(&stats, false);
+    TEST_ASSERT_EQUAL_UINT32(20, stats.set_calls);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.commits);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.key_writes);
+    TEST_ASSERT_EQUAL_UINT32(1, commit_cnt);
+    TEST_ASSERT_EQUAL_size_t(2, commit_keys[0]);
+}
+
+void test_settings_failed_commit_is_retried(void)
+{
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u8("volume", 7));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u8("mute", 0));
+
+    commit_fail_cnt = 1;
+    TEST_ASSERT_EQUAL_INT(ESP_FAIL, settings_flush());
+    settings_stats_t stats;
+    settings_get_stats(&stats, false);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.commit_errors);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.key_writes);
+
+    /*Both keys are still dirty, the new value of one of them is committed*/
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_u8("volume", 8));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_flush());
+    settings_get_stats(&stats, false);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.commits);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.key_writes);
+
+    restart_store();
+    uint8_t u8;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_get_u8("volume", &u8));
+    TEST_ASSERT_EQUAL_UINT8(8, u8);
+}
+
+void test_settings_pending_changes_are_committed_on_restart(void)
+{
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_set_i32("offset", -5));
+    esp_restart();
+    TEST_ASSERT_EQUAL_UINT32(1, commit_cnt);
+
+    /*The values are loaded once, then read from the cache with the type checked*/
+    restart_store();
+    int32_t i32;
+    uint32_t u32;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, settings_get_i32("offset", &i32));
+    TEST_ASSERT_EQUAL_INT32(-5, i32);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_ARG, settings_get_u32("offset", &u32));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NVS_NOT_FOUND, settings_get_u32("missing", &u32));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_settings_coalesced_sets_write_each_key_once);
+    RUN_TEST(test_settings_unchanged_values_are_not_written);
+    RUN_TEST(test_settings_commit_waits_until_the_changes_stop);
+    RUN_TEST(test_settings_failed_commit_is_retried);
+    RUN_TEST(test_settings_pending_changes_are_committed_on_restart);
+    return UNITY_END();
+}
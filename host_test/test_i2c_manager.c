@@ -0,0 +1,330 @@
+/*
+ * Host test of the asynchronous I2C Manager transactions on a fake bus backend.
+ *
+ * The tests share the state of i2c_manager.c and run in order: the first one
+ * checks the very first use of port 0, the failed start test is the first
+ * user of port 1 and the close test stops it.
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#include "unity.h"
+#include "host_stubs.h"
+#include "freertos/task.h"
+#include "i2c_manager.h"
+
+#define FAKE_BUS_LATENCY_MS     2
+#define SUBMITTER_CNT           8
+#define ASYNC_QUEUE_LEN         CONFIG_I2C_MANAGER_ASYNC_QUEUE_LEN
+#define DONE_TIMEOUT_MS         5000
+
+typedef struct {
+    uint32_t id;
+    esp_err_t submit_ret;
+    esp_err_t result;
+    uint8_t buf[4];
+} request_t;
+
+static atomic_int bus_busy;
+static atomic_int bus_overlap_cnt;
+static atomic_uint bus_xfer_cnt;
+
+static pthread_mutex_t done_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t done_cnt;
+static uint32_t done_order[64];
+
+static host_stubs_stats_t stats_ori;
+
+/*Simulates the transfer latency and reads back `reg + i` from every register*/
+static esp_err_t fake_bus_xfer(const lvgl_i2c_xfer_t * xfer, TickType_t timeout)
+{
+    (void)timeout;
+    if(atomic_fetch_add(&bus_busy, 1) != 0) atomic_fetch_add(&bus_overlap_cnt, 1);
+
+    host_sleep_ms(FAKE_BUS_LATENCY_MS);
+    if(!xfer->write) {
+        uint16_t i;
+        for(i = 0; i < xfer->size; i++) xfer->buffer[i] = (uint8_t)(xfer->reg + i);
+    }
+
+    atomic_fetch_add(&bus_xfer_cnt, 1);
+    atomic_fetch_sub(&bus_busy, 1);
+    return ESP_OK;
+}
+
+static void done_cb(esp_err_t result, void * user_data)
+{
+    request_t * req = user_data;
+    req->result = result;
+
+    pthread_mutex_lock(&done_lock);
+    if(done_cnt < sizeof(done_order) / sizeof(done_order[0])) done_order[done_cnt] = req->id;
+    done_cnt++;
+    pthread_cond_broadcast(&done_cond);
+    pthread_mutex_unlock(&done_lock);
+}
+
+static uint32_t wait_done(uint32_t cnt)
+{
+    TickType_t start = xTaskGetTickCount();
+    pthread_mutex_lock(&done_lock);
+    while(done_cnt < cnt && xTaskGetTickCount() - start < DONE_TIMEOUT_MS) {
+        pthread_mutex_unlock(&done_lock);
+        host_sleep_ms(1);
+        pthread_mutex_lock(&done_lock);
+    }
+    uint32_t res = done_cnt;
+    pthread_mutex_unlock(&done_lock);
+    return res;
+}
+
+static void check_read(const request_t * req, uint32_t reg)
+{
+    TEST_ASSERT_EQUAL_INT(ESP_OK, req->result);
+    uint32_t i;
+    for(i = 0; i < sizeof(req->buf); i++) {
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)(reg + i), req->buf[i]);
+    }
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lvgl_i2c_set_bus(fake_bus_xfer);
+    atomic_store(&bus_overlap_cnt, 0);
+    atomic_store(&bus_xfer_cnt, 0);
+    done_cnt = 0;
+    memset(done_order, 0, sizeof(done_order));
+    host_stubs_get_stats(&stats_ori);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    host_stubs_fail_queue_create(0);
+    host_stubs_fail_task_create(0);
+}
+
+/**********************
+ *   FIRST USE
+ **********************/
+
+static pthread_barrier_t submit_barrier;
+static request_t submit_req[SUBMITTER_CNT];
+
+/*Every submitter starts on the first use of the port, retrying while the pool is empty.
+ *The threads only record the results, the assertions are made by the test itself.*/
+static void * submitter(void * p)
+{
+    request_t * req = p;
+    pthread_barrier_wait(&submit_barrier);
+
+    while((req->submit_ret = lvgl_i2c_read_async(I2C_NUM_0, 0x38, 0x10 + req->id, req->buf, sizeof(req->buf),
+                                                 done_cb, req)) == ESP_ERR_NO_MEM) {
+        host_sleep_ms(1);
+    }
+    return NULL;
+}
+
+void test_i2c_manager_concurrent_first_use_starts_one_worker(void)
+{
+    pthread_t threads[SUBMITTER_CNT];
+    pthread_barrier_init(&submit_barrier, NULL, SUBMITTER_CNT);
+
+    uint32_t i;
+    for(i = 0; i < SUBMITTER_CNT; i++) {
+        submit_req[i].id = i;
+        submit_req[i].result = ESP_FAIL;
+        pthread_create(&threads[i], NULL, submitter, &submit_req[i]);
+    }
+    for(i = 0; i < SUBMITTER_CNT; i++) pthread_join(threads[i], NULL);
+    pthread_barrier_destroy(&submit_barrier);
+
+    for(i = 0; i < SUBMITTER_CNT; i++) TEST_ASSERT_EQUAL_INT(ESP_OK, submit_req[i].submit_ret);
+    TEST_ASSERT_EQUAL_UINT32(SUBMITTER_CNT, wait_done(SUBMITTER_CNT));
+    for(i = 0; i < SUBMITTER_CNT; i++) check_read(&submit_req[i], 0x10 + i);
+
+    /*One driver, one mutex, one worker and its two queues, whoever won the race*/
+    host_stubs_stats_t stats;
+    host_stubs_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.i2c_install_cnt[I2C_NUM_0]);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.sem_live_cnt + 1, stats.sem_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.task_create_cnt + 1, stats.task_create_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.queue_create_cnt + 2, stats.queue_create_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.queue_live_cnt + 2, stats.queue_live_cnt);
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&bus_overlap_cnt));
+
+    /*Later inits find everything in place*/
+    TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_init(I2C_NUM_0));
+    host_stubs_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.task_create_cnt + 1, stats.task_create_cnt);
+}
+
+/**********************
+ *   POOL
+ **********************/
+
+void test_i2c_manager_pool_exhaustion_and_order(void)
+{
+    request_t req[ASYNC_QUEUE_LEN + 1];
+    memset(req, 0, sizeof(req));
+
+    /*Holding the port lock keeps the worker from draining the queue*/
+    TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_lock(I2C_NUM_0));
+    uint32_t i;
+    for(i = 0; i < ASYNC_QUEUE_LEN; i++) {
+        req[i].id = i;
+        TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_read_async(I2C_NUM_0, 0x38, 0x20 + i, req[i].buf, sizeof(req[i].buf),
+                                                          done_cb, &req[i]));
+    }
+    req[i].id = i;
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NO_MEM, lvgl_i2c_read_async(I2C_NUM_0, 0x38, 0x20 + i, req[i].buf, sizeof(req[i].buf),
+                                                              done_cb, &req[i]));
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&bus_xfer_cnt));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_unlock(I2C_NUM_0));
+
+    TEST_ASSERT_EQUAL_UINT32(ASYNC_QUEUE_LEN, wait_done(ASYNC_QUEUE_LEN));
+    for(i = 0; i < ASYNC_QUEUE_LEN; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, done_order[i]);
+        check_read(&req[i], 0x20 + i);
+    }
+
+    /*The descriptors are back in the pool*/
+    TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_read_async(I2C_NUM_0, 0x38, 0x20 + i, req[i].buf, sizeof(req[i].buf),
+                                                      done_cb, &req[i]));
+    TEST_ASSERT_EQUAL_UINT32(ASYNC_QUEUE_LEN + 1, wait_done(ASYNC_QUEUE_LEN + 1));
+    check_read(&req[i], 0x20 + i);
+}
+
+/**********************
+ *   BUS SHARING
+ **********************/
+
+static atomic_bool writer_stop;
+static atomic_uint writer_fail_cnt;
+
+static void * blocking_writer(void * p)
+{
+    (void)p;
+    static const uint8_t data[2] = {0x01, 0x02};
+    while(!atomic_load(&writer_stop)) {
+        if(lvgl_i2c_write(I2C_NUM_0, 0x50, 0x00, data, sizeof(data)) != ESP_OK) atomic_fetch_add(&writer_fail_cnt, 1);
+    }
+    return NULL;
+}
+
+void test_i2c_manager_blocking_and_async_share_the_bus(void)
+{
+    pthread_t writer;
+    atomic_store(&writer_stop, false);
+    atomic_store(&writer_fail_cnt, 0);
+    pthread_create(&writer, NULL, blocking_writer, NULL);
+
+    request_t req[16];
+    uint32_t i;
+    for(i = 0; i < 16; i++) {
+        req[i].id = i;
+        while(lvgl_i2c_read_async(I2C_NUM_0, 0x38, 0x40 + i, req[i].buf, sizeof(req[i].buf),
+                                  done_cb, &req[i]) == ESP_ERR_NO_MEM) {
+            host_sleep_ms(1);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(16, wait_done(16));
+
+    atomic_store(&writer_stop, true);
+    pthread_join(writer, NULL);
+
+    for(i = 0; i < 16; i++) check_read(&req[i], 0x40 + i);
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&writer_fail_cnt));
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&bus_overlap_cnt));
+    TEST_ASSERT_GREATER_THAN_UINT32(16, atomic_load(&bus_xfer_cnt));
+}
+
+/**********************
+ *   FAILED START
+ **********************/
+
+void test_i2c_manager_failed_start_frees_and_is_retried(void)
+{
+    request_t req = {0};
+    host_stubs_stats_t stats;
+
+    /*The first queue fails, the second one must not leak*/
+    host_stubs_fail_queue_create(1);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NO_MEM, lvgl_i2c_read_async(I2C_NUM_1, 0x38, 0x60, req.buf, sizeof(req.buf),
+                                                              done_cb, &req));
+    host_stubs_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.queue_live_cnt, stats.queue_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.task_create_cnt, stats.task_create_cnt);
+
+    /*No worker, both queues must be freed*/
+    host_stubs_fail_task_create(1);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NO_MEM, lvgl_i2c_read_async(I2C_NUM_1, 0x38, 0x60, req.buf, sizeof(req.buf),
+                                                              done_cb, &req));
+    host_stubs_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.queue_live_cnt, stats.queue_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.task_create_cnt, stats.task_create_cnt);
+
+    /*The next submit starts the worker, the driver was installed only once*/
+    TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_read_async(I2C_NUM_1, 0x38, 0x60, req.buf, sizeof(req.buf),
+                                                      done_cb, &req));
+    TEST_ASSERT_EQUAL_UINT32(1, wait_done(1));
+    check_read(&req, 0x60);
+
+    host_stubs_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.i2c_install_cnt[I2C_NUM_1]);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.sem_live_cnt + 1, stats.sem_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.queue_live_cnt + 2, stats.queue_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.task_create_cnt + 1, stats.task_create_cnt);
+}
+
+/**********************
+ *   CLOSE
+ **********************/
+
+void test_i2c_manager_close_stops_the_worker(void)
+{
+    request_t req[ASYNC_QUEUE_LEN] = {0};
+    host_stubs_stats_t stats;
+    uint32_t i;
+
+    /*Port 1 runs since the previous test. The queued transfers finish before the worker stops.*/
+    for(i = 0; i < ASYNC_QUEUE_LEN; i++) {
+        req[i].id = i;
+        TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_read_async(I2C_NUM_1, 0x38, 0x70 + i, req[i].buf, sizeof(req[i].buf),
+                                                          done_cb, &req[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_close(I2C_NUM_1));
+    TEST_ASSERT_EQUAL_UINT32(ASYNC_QUEUE_LEN, done_cnt);
+    for(i = 0; i < ASYNC_QUEUE_LEN; i++) check_read(&req[i], 0x70 + i);
+
+    host_stubs_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.task_live_cnt - 1, stats.task_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.queue_live_cnt - 2, stats.queue_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.sem_live_cnt - 1, stats.sem_live_cnt);
+
+    /*The next use starts everything again*/
+    TEST_ASSERT_EQUAL_INT(ESP_OK, lvgl_i2c_read_async(I2C_NUM_1, 0x38, 0x60, req[0].buf, sizeof(req[0].buf),
+                                                      done_cb, &req[0]));
+    TEST_ASSERT_EQUAL_UINT32(ASYNC_QUEUE_LEN + 1, wait_done(ASYNC_QUEUE_LEN + 1));
+    check_read(&req[0], 0x60);
+
+    host_stubs_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.i2c_install_cnt[I2C_NUM_1]);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.task_live_cnt, stats.task_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.queue_live_cnt, stats.queue_live_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_ori.sem_live_cnt, stats.sem_live_cnt);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_i2c_manager_concurrent_first_use_starts_one_worker);
+    RUN_TEST(test_i2c_manager_pool_exhaustion_and_order);
+    RUN_TEST(test_i2c_manager_blocking_and_async_share_the_bus);
+    RUN_TEST(test_i2c_manager_failed_start_frees_and_is_retried);
+    RUN_TEST(test_i2c_manager_close_stops_the_worker);
+    return UNITY_END();
+}
@@ -0,0 +1,334 @@
+/*
+ * Host test of the ILI9488 shadow framebuffer.
+ *
+ * The SPI layer is replaced by a stub which replays the command and pixel stream
+ * into a simulated GRAM, so every test can check that the panel shows exactly what
+ * was rendered while ili9488_get_flush_stats() reports what was sent for it.
+ * Built once with RGB565 draw buffers and once with LV_COLOR_RGB888_OUT.
+ */
+#include <string.h>
+
+#include "unity.h"
+#include "driver/gpio.h"
+#include "disp_spi.h"
+#include "ili9488.h"
+
+#define HOR_RES         LV_HOR_RES_MAX
+#define VER_RES         LV_VER_RES_MAX
+#define BAND_ROWS       (DISP_BUF_SIZE / HOR_RES)
+#define BAND_CNT        ((VER_RES + BAND_ROWS - 1) / BAND_ROWS)
+#define WINDOW_BYTES    11      /*CASET + PASET + RAMWR with their arguments*/
+
+#if LV_COLOR_RGB888_OUT
+#define BUF_PX_SIZE     3
+#else
+#define BUF_PX_SIZE     sizeof(lv_color_t)
+#endif
+
+static lv_color_t frame[VER_RES][HOR_RES];      /*What LVGL rendered*/
+static uint8_t gram[VER_RES][HOR_RES * 3];      /*What the panel shows, replayed from the SPI stream*/
+static uint8_t draw_buf[DISP_BUF_SIZE * BUF_PX_SIZE];
+static lv_disp_drv_t drv;
+static uint32_t ready_cnt;
+static ili9488_flush_stats_t stats_ori;
+
+/**********************
+ *   SPI STUB
+ **********************/
+
+static uint8_t spi_cmd;
+static uint8_t spi_args[4];
+static uint32_t spi_arg_cnt;
+static lv_area_t win;
+static lv_coord_t cur_x;
+static lv_coord_t cur_y;
+static uint8_t px[3];
+static uint32_t px_byte_cnt;
+static uint32_t px_outside_cnt;     /*Pixels written after the end of the window*/
+
+static void gram_write_px(void)
+{
+    if(cur_y > win.y2 || cur_y >= VER_RES || cur_x >= HOR_RES) {
+        px_outside_cnt++;
+        return;
+    }
+    memcpy(&gram[cur_y][cur_x * 3], px, 3);
+    cur_x++;
+    if(cur_x > win.x2) {
+        cur_x = win.x1;
+        cur_y++;
+    }
+}
+
+void disp_spi_transaction(const uint8_t * data, size_t length, disp_spi_send_flag_t flags, uint8_t * out,
+                          uint64_t addr, uint8_t dummy_bits)
+{
+    (void)out;
+    (void)addr;
+    (void)dummy_bits;
+
+    if(gpio_get_level(CONFIG_LV_DISP_PIN_DC) == 0) {
+        /*Command mode, the arguments follow in data mode*/
+        TEST_ASSERT_EQUAL_size_t(1, length);
+        spi_cmd = data[0];
+        spi_arg_cnt = 0;
+        px_byte_cnt = 0;
+        if(spi_cmd == ILI9488_CMD_MEMORY_WRITE) {
+            cur_x = win.x1;
+            cur_y = win.y1;
+        }
+    }
+    else {
+        size_t i;
+        for(i = 0; i < length; i++) {
+            switch(spi_cmd) {
+                case ILI9488_CMD_COLUMN_ADDRESS_SET:
+                case ILI9488_CMD_PAGE_ADDRESS_SET:
+                    if(spi_arg_cnt >= 4) break;
+                    spi_args[spi_arg_cnt++] = data[i];
+                    if(spi_arg_cnt < 4) break;
+                    if(spi_cmd == ILI9488_CMD_COLUMN_ADDRESS_SET) {
+                        win.x1 = (spi_args[0] << 8) | spi_args[1];
+                        win.x2 = (spi_args[2] << 8) | spi_args[3];
+                    }
+                    else {
+                        win.y1 = (spi_args[0] << 8) | spi_args[1];
+                        win.y2 = (spi_args[2] << 8) | spi_args[3];
+                    }
+                    break;
+                case ILI9488_CMD_MEMORY_WRITE:
+                    px[px_byte_cnt++] = data[i];
+                    if(px_byte_cnt == 3) {
+                        gram_write_px();
+                        px_byte_cnt = 0;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    if(flags & DISP_SPI_SIGNAL_FLUSH) ready_cnt++;
+}
+
+void disp_wait_for_pending_transactions(void)
+{
+}
+
+void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
+{
+    TEST_ASSERT_EQUAL_PTR(&drv, disp_drv);
+    ready_cnt++;
+}
+
+/**********************
+ *   HELPERS
+ **********************/
+
+/*The 3 bytes the panel stores for a color*/
+static void px_convert(uint8_t * dest, lv_color_t c)
+{
+    uint16_t v = c.full;
+    dest[0] = (uint8_t)(((v & 0xF800) >> 8) | ((v & 0x8000) >> 13));
+    dest[1] = (uint8_t)((v & 0x07E0) >> 3);
+    dest[2] = (uint8_t)(((v & 0x001F) << 3) | ((v & 0x0010) >> 2));
+}
+
+/*Render `area` of the frame into the draw buffer, flush it, and check that it was signalled once*/
+static void flush_area(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    lv_area_t area = {x1, y1, x2, y2};
+    uint8_t * p = draw_buf;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = y1; y <= y2; y++) {
+        for(x = x1; x <= x2; x++) {
+#if LV_COLOR_RGB888_OUT
+            px_convert(p, frame[y][x]);
+#else
+            memcpy(p, &frame[y][x], sizeof(lv_color_t));
+#endif
+            p += BUF_PX_SIZE;
+        }
+    }
+
+    uint32_t ready_ori = ready_cnt;
+    ili9488_flush(&drv, &area, (lv_color_t *)draw_buf);
+    TEST_ASSERT_EQUAL_UINT32(ready_ori + 1, ready_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, px_outside_cnt);
+}
+
+static void flush_screen(void)
+{
+    lv_coord_t y;
+    for(y = 0; y < VER_RES; y += BAND_ROWS) {
+        flush_area(0, y, HOR_RES - 1, LV_MIN(y + BAND_ROWS, VER_RES) - 1);
+    }
+}
+
+static void check_gram(void)
+{
+    static uint8_t row[HOR_RES * 3];
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < VER_RES; y++) {
+        for(x = 0; x < HOR_RES; x++) px_convert(&row[x * 3], frame[y][x]);
+        TEST_ASSERT_EQUAL_MEMORY(row, gram[y], sizeof(row));
+    }
+}
+
+static void stats_delta(ili9488_flush_stats_t * delta)
+{
+    ili9488_flush_stats_t stats;
+    ili9488_get_flush_stats(&stats);
+    delta->flush_cnt = stats.flush_cnt - stats_ori.flush_cnt;
+    delta->window_cnt = stats.window_cnt - stats_ori.window_cnt;
+    delta->bytes_full = stats.bytes_full - stats_ori.bytes_full;
+    delta->bytes_sent = stats.bytes_sent - stats_ori.bytes_sent;
+}
+
+static uint32_t rnd_next(uint32_t * seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    memset(&drv, 0, sizeof(drv));
+    drv.hor_res = HOR_RES;
+    drv.ver_res = VER_RES;
+#if LV_COLOR_RGB888_OUT
+    drv.rgb888_out = 1;
+#endif
+    ili9488_init();
+
+    /*Start from a known screen with garbage in the GRAM*/
+    memset(gram, 0x5A, sizeof(gram));
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < VER_RES; y++) {
+        for(x = 0; x < HOR_RES; x++) frame[y][x] = lv_color_make(x, y, x ^ y);
+    }
+    flush_screen();
+    check_gram();
+    ili9488_get_flush_stats(&stats_ori);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+/**********************
+ *   TESTS
+ **********************/
+
+void test_ili9488_unknown_rows_are_sent_entirely(void)
+{
+    ili9488_shadow_invalidate();
+    memset(gram, 0x5A, sizeof(gram));
+    flush_screen();
+    check_gram();
+
+    ili9488_flush_stats_t delta;
+    stats_delta(&delta);
+    TEST_ASSERT_EQUAL_UINT32(BAND_CNT, delta.flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BAND_CNT, delta.window_cnt);
+    TEST_ASSERT_EQUAL_UINT64(HOR_RES * VER_RES * 3 + BAND_CNT * WINDOW_BYTES, delta.bytes_full);
+    TEST_ASSERT_EQUAL_UINT64(delta.bytes_full, delta.bytes_sent);
+}
+
+void test_ili9488_unchanged_frame_sends_nothing(void)
+{
+    flush_screen();
+    check_gram();
+
+    ili9488_flush_stats_t delta;
+    stats_delta(&delta);
+    TEST_ASSERT_EQUAL_UINT32(BAND_CNT, delta.flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, delta.window_cnt);
+    TEST_ASSERT_EQUAL_UINT64(0, delta.bytes_sent);
+}
+
+void test_ili9488_changed_digit_sends_one_window(void)
+{
+    /*A 12x20 digit changes in a 100x40 label*/
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 230; y < 250; y++) {
+        for(x = 150; x < 162; x++) frame[y][x].full ^= 0xFFFF;
+    }
+    flush_area(110, 220, 209, 259);
+    check_gram();
+
+    ili9488_flush_stats_t delta;
+    stats_delta(&delta);
+    TEST_ASSERT_EQUAL_UINT32(1, delta.window_cnt);
+    TEST_ASSERT_EQUAL_UINT64(100 * 40 * 3 + WINDOW_BYTES, delta.bytes_full);
+    TEST_ASSERT_EQUAL_UINT64(12 * 20 * 3 + WINDOW_BYTES, delta.bytes_sent);
+}
+
+void test_ili9488_scattered_pixels_are_sent_in_small_windows(void)
+{
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < 2000; i++) {
+        uint32_t x = rnd_next(&seed) % HOR_RES;
+        uint32_t y = rnd_next(&seed) % VER_RES;
+        frame[y][x].full = ~frame[y][x].full;
+    }
+    flush_screen();
+    check_gram();
+
+    ili9488_flush_stats_t delta;
+    stats_delta(&delta);
+    TEST_ASSERT_GREATER_THAN_UINT32(BAND_CNT, delta.window_cnt);
+    TEST_ASSERT_LESS_THAN_UINT64(delta.bytes_full / 8, delta.bytes_sent);
+}
+
+void test_ili9488_partial_width_flush_does_not_make_rows_known(void)
+{
+    ili9488_shadow_invalidate();
+    ili9488_flush_stats_t delta;
+
+    /*Only the full width flush of a row can tell what the whole row shows*/
+    flush_area(0, 0, 99, 39);
+    flush_area(0, 0, 99, 39);
+    stats_delta(&delta);
+    TEST_ASSERT_EQUAL_UINT64(delta.bytes_full, delta.bytes_sent);
+
+    flush_area(0, 0, HOR_RES - 1, 39);
+    ili9488_get_flush_stats(&stats_ori);
+    flush_area(0, 0, HOR_RES - 1, 39);
+    flush_area(0, 0, 99, 39);
+    stats_delta(&delta);
+    TEST_ASSERT_EQUAL_UINT64(0, delta.bytes_sent);
+    check_gram();
+}
+
+void test_ili9488_put_px_invalidates_the_shadow(void)
+{
+    /*Written around the shadow framebuffer, so the next flushes have to send everything*/
+    ili9488_put_px(5, 5, 0x1234);
+    flush_screen();
+    check_gram();
+
+    ili9488_flush_stats_t delta;
+    stats_delta(&delta);
+    TEST_ASSERT_EQUAL_UINT64(delta.bytes_full, delta.bytes_sent);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_ili9488_unknown_rows_are_sent_entirely);
+    RUN_TEST(test_ili9488_unchanged_frame_sends_nothing);
+    RUN_TEST(test_ili9488_changed_digit_sends_one_window);
+    RUN_TEST(test_ili9488_scattered_pixels_are_sent_in_small_windows);
+    RUN_TEST(test_ili9488_partial_width_flush_does_not_make_rows_known);
+    RUN_TEST(test_ili9488_put_px_invalidates_the_shadow);
+    return UNITY_END();
+}
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""
+Host test of the OTA packages: tools/ota_pack.py builds them, its HTTP server
+serves them and ota_stream decodes them through ota_stream_cli.
+
+  test_ota.py <path of ota_stream_cli>
+"""
+
+import functools
+import hashlib
+import http.server
+import os
+import random
+import struct
+import subprocess
+import sys
+import tempfile
+import threading
+import unittest
+import urllib.error
+import urllib.request
+
+REPO_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+OTA_PACK = os.path.join(REPO_DIR, 'tools', 'ota_pack.py')
+sys.path.insert(0, os.path.dirname(OTA_PACK))
+sys.dont_write_bytecode = True      # keep tools/ clean
+import ota_pack  # noqa: E402
+
+CLI = None
+PARTITION_SIZE = 256 * 1024
+
+
+def make_image(seed, size, hash_appended=True):
+    """A stand-in of an app image: esp_image_header_t, payload and the appended SHA256"""
+    rnd = random.Random(seed)
+    header = bytearray(24)
+    header[0] = 0xE9
+    header[1] = 1
+    header[23] = 1 if hash_appended else 0
+    image = bytes(header) + bytes(rnd.getrandbits(8) for _ in range(size))
+    if hash_appended:
+        image += hashlib.sha256(image).digest()
+    return image
+
+
+def next_version(base):
+    """The base image with a few changed, inserted and removed ranges"""
+    body = bytearray(base[:-32])
+    body[1000:1016] = b'\x5a' * 16
+    body[30000:30000] = bytes(range(256)) * 4
+    del body[60000:61000]
+    body[-500:-400] = bytes(100)
+    return bytes(body) + hashlib.sha256(body).digest()
+
+
+class OtaTest(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.tmp = tempfile.TemporaryDirectory()
+        cls.dir = cls.tmp.name
+        cls.base = make_image(1, 100 * 1024)
+        cls.new = next_version(cls.base)
+        cls.write('base.bin', cls.base)
+        cls.write('new.bin', cls.new)
+        # The running partition is the base image padded with erased flash
+        cls.write('running.part', cls.base + b'\xff' * (PARTITION_SIZE - len(cls.base)))
+
+        handler = functools.partial(ota_pack.EtagHandler, directory=cls.dir)
+        cls.server = http.server.ThreadingHTTPServer(('127.0.0.1', 0), handler)
+        cls.url = 'http://127.0.0.1:%d/' % cls.server.server_address[1]
+        cls.server_thread = threading.Thread(target=cls.server.serve_forever, daemon=True)
+        cls.server_thread.start()
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.server.shutdown()
+        cls.server.server_close()
+        cls.tmp.cleanup()
+
+    @classmethod
+    def write(cls, name, data):
+        with open(os.path.join(cls.dir, name), 'wb') as f:
+            f.write(data)
+
+    def pack(self, name, *args):
+        subprocess.run([sys.executable, OTA_PACK, 'pack', os.path.join(self.dir, 'new.bin'),
+                        os.path.join(self.dir, name)] + list(args),
+                       check=True, stdout=subprocess.DEVNULL)
+
+    def download(self, name):
+        """GET the package, then check the server answers the same ETag with 304"""
+        with urllib.request.urlopen(self.url + name) as rsp:
+            data = rsp.read()
+            etag = rsp.headers['ETag']
+        self.assertTrue(etag)
+        req = urllib.request.Request(self.url + name, headers={'If-None-Match': etag})
+        with self.assertRaises(urllib.error.HTTPError) as cm:
+            urllib.request.urlopen(req)
+        self.assertEqual(cm.exception.code, 304)
+        self.assertEqual(cm.exception.headers['ETag'], etag)
+        cm.exception.close()
+        return data
+
+    def decode(self, data, running_sha256=None):
+        pkg = os.path.join(self.dir, 'download.pkg')
+        out = os.path.join(self.dir, 'decoded.bin')
+        with open(pkg, 'wb') as f:
+            f.write(data)
+        sha = running_sha256 if running_sha256 is not None else self.base[-32:]
+        proc = subprocess.run([CLI, pkg, out, os.path.join(self.dir, 'running.part'), sha.hex()],
+                              stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        with open(out, 'rb') as f:
+            image = f.read()
+        return proc.returncode, proc.stdout, image
+
+    def check_package(self, name, *pack_args):
+        self.pack(name, *pack_args)
+        rc, log, image = self.decode(self.download(name))
+        self.assertEqual(rc, 0, log)
+        self.assertEqual(image, self.new)
+        return log
+
+    def test_source_sha256_is_the_appended_digest(self):
+        self.assertEqual(ota_pack.image_sha256(self.base), self.base[-32:])
+        self.assertNotEqual(ota_pack.image_sha256(self.base), hashlib.sha256(self.base).digest())
+        plain = make_image(2, 4096, hash_appended=False)
+        self.assertEqual(ota_pack.image_sha256(plain), hashlib.sha256(plain).digest())
+
+    def test_raw_image(self):
+        rc, log, image = self.decode(self.download('new.bin'))
+        self.assertEqual(rc, 0, log)
+        self.assertEqual(image, self.new)
+        self.assertIn('flags 0, image size 0', log)
+
+    def test_package(self):
+        log = self.check_package('plain.ota')
+        self.assertIn('flags 0, image size %d' % len(self.new), log)
+
+    def test_zlib_package(self):
+        log = self.check_package('zlib.ota', '--zlib')
+        self.assertIn('flags 1,', log)
+
+    def test_delta_package(self):
+        log = self.check_package('delta.ota', '--base', os.path.join(self.dir, 'base.bin'))
+        self.assertIn('flags 2,', log)
+        self.assertIn('source sha256 ' + self.base[-32:].hex(), log)
+        self.assertLess(os.path.getsize(os.path.join(self.dir, 'delta.ota')), len(self.new) // 10)
+
+    def test_zlib_delta_package(self):
+        log = self.check_package('zdelta.ota', '--zlib', '--base', os.path.join(self.dir, 'base.bin'))
+        self.assertIn('flags 3,', log)
+
+    def test_delta_against_other_firmware_is_rejected(self):
+        self.pack('other.ota', '--base', os.path.join(self.dir, 'base.bin'))
+        other = make_image(3, 100 * 1024)
+        rc, log, image = self.decode(self.download('other.ota'), running_sha256=other[-32:])
+        self.assertEqual(rc, 1)
+        self.assertIn('ESP_ERR_INVALID_VERSION', log)
+        self.assertEqual(image, b'')
+
+    def test_delta_copy_out_of_range_is_rejected(self):
+        sha = self.base[-32:]
+        for offset, length in ((PARTITION_SIZE - 16, 32), (0xFFFFFF00, 0x200)):
+            header = struct.pack('<IBBHI32s', ota_pack.OTA_PKG_MAGIC, ota_pack.OTA_PKG_VERSION,
+                                 ota_pack.OTA_PKG_FLAG_DELTA, 0, length, sha)
+            rc, log, _ = self.decode(header + struct.pack('<BII', ota_pack.OP_COPY, offset, length))
+            self.assertEqual(rc, 1, log)
+            self.assertIn('delta copy out of range', log)
+
+    def test_truncated_zlib_package_is_rejected(self):
+        self.pack('cut.ota', '--zlib')
+        data = self.download('cut.ota')
+        rc, log, _ = self.decode(data[:len(data) // 2])
+        self.assertEqual(rc, 1)
+        self.assertIn('ESP_ERR_INVALID_SIZE', log)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    CLI = os.path.abspath(sys.argv.pop(1))
+    unittest.main()
@@ -18,6 +18,7 @@
 #include "wifi_wrapper.h"
 #include "socket_wrapper.h"
 #include "http_ota_wrapper.h"
+#include "app_settings.h"
 #include "app_config.h"
 
 static const char *TAG = "main";
@@ -29,6 +30,7 @@ static uint8_t local_device_id = FRAME_INVALID_ID;
 static uint8_t camera_id = FRAME_INVALID_ID;
 static uint8_t *tx_rx_buffer = NULL;
 static uint8_t *image_buffer = NULL;
+static lv_obj_t *ota_label = NULL;
 
 #define SERVER_READY_BIT    BIT0        // 服务器状态位
 #define CAMERA_READY_BIT    BIT1
@@ -49,6 +51,21 @@ int data_frame_send(int sock, uint8_t *frame, frame_type_t type, uint8_t target_
     return (socket_send(sock, frame, len + FRAME_HEADER_LEN));
 }
 
+#if LV_USE_TRACE
+/**
+ * @brief 将追踪数据(Chrome trace JSON)分段转发给请求方
+ */
+static lv_res_t trace_export_cb(const char *buf, uint32_t len, void *user_data)
+{
+    uint8_t target_id = *(uint8_t *)user_data;
+    if (data_frame_send(server_socket, tx_rx_buffer, FRAME_TYPE_TRANSMIT, target_id, local_device_id,
+                        len, (uint8_t *)buf) < 0) {
+        return LV_RES_INV;
+    }
+    return LV_RES_OK;
+}
+#endif
+
 static void tcp_socket_connect_callback(socket_connect_info_t info)
 {
     switch (info.mark)
@@ -137,6 +154,15 @@ static void tcp_sock_handle_task(void *arg)
             
             break;
         case FRAME_TYPE_TRANSMIT:
+#if LV_USE_TRACE
+            cJSON *command = cJSON_GetObjectItem(root, CMD_KEY_COMMAND);
+            if (command != NULL && command->type == cJSON_String &&
+                strcmp(command->valuestring, CMD_VALUE_TRACE) == 0) {
+                uint32_t cnt = lv_trace_export(trace_export_cb, &frame.source);
+                ESP_LOGI(TAG, "%u trace events sent", (unsigned)cnt);
+                break;
+            }
+#endif
             // 获取到camera tcp服务器信息
             cJSON *ip = cJSON_GetObjectItem(root, CMD_KEY_IP);
             cJSON *port = cJSON_GetObjectItem(root, CMD_KEY_PORT);
@@ -183,9 +209,36 @@ static void btn_event_cb(lv_event_t * e)
     }
 }
 
+/**
+ * @brief OTA下载进度回调(OTA任务中调用)，加锁后更新屏幕上的进度标签
+ */
+static void ota_progress_cb(const ota_progress_t *progress)
+{
+    if (xSemaphoreTake(xGuiSemaphore, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+    if (ota_label != NULL) {
+        if (progress->total > 0) {
+            lv_label_set_text_fmt(ota_label, "OTA %u%% %u KB/s",
+                                  (unsigned)((uint64_t)progress->received * 100 / progress->total),
+                                  (unsigned)(progress->speed / 1024));
+        } else {
+            lv_label_set_text_fmt(ota_label, "OTA %u KB %u KB/s",
+                                  (unsigned)(progress->received / 1024), (unsigned)(progress->speed / 1024));
+        }
+    }
+    xSemaphoreGive(xGuiSemaphore);
+}
 
 void screen_manage_task(void *pvParameter)
 {
+    /* OTA进度标签，在OTA下载时由ota_progress_cb更新 */
+    xSemaphoreTake(xGuiSemaphore, portMAX_DELAY);
+    ota_label = lv_label_create(lv_scr_act());
+    lv_label_set_text(ota_label, "");
+    lv_obj_align(ota_label, LV_ALIGN_TOP_MID, 0, 10);
+    xSemaphoreGive(xGuiSemaphore);
+
     lv_obj_t * btn = lv_btn_create(lv_scr_act());           /*Add a button the current screen*/
     lv_obj_set_size(btn, 120, 50);                          /*Set its size*/
     lv_obj_align(btn, LV_ALIGN_CENTER, 0, 160);
@@ -239,6 +292,7 @@ void app_main()
         ret = nvs_flash_init();
     }
     ESP_ERROR_CHECK(ret);
+    ESP_ERROR_CHECK(settings_init(NULL, NULL));
 
     /* rgb light */
     rgb_light_init();
@@ -246,6 +300,10 @@ void app_main()
     /* lvgl init */
     lv_init();
     lv_port_disp_init();
+#if LV_USE_TRACE
+    /* 持续记录渲染追踪(环形缓冲区只保留最近的事件), 由trace命令导出 */
+    lv_trace_start();
+#endif
 
     /* wifi sta */
     wifi_account_config_t wifi_config = {
@@ -296,6 +354,7 @@ void app_main()
         .url = APP_OTA_URL,
         .mode = OTA_AUTOMATIC,
         .interval = 120000,
+        .progress_cb = ota_progress_cb,
     };
     http_ota_service_config(&ota_config);
     http_ota_service_start();
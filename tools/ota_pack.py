@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""
+Build OTA packages for http_ota_wrapper and serve them for testing.
+
+  ota_pack.py pack new.bin out.bin [--zlib] [--base old.bin]
+      --zlib          compress the payload
+      --base old.bin  make a delta against the firmware running on the device
+
+  ota_pack.py serve DIR [--port 8070]
+      Minimal HTTP server with ETag / If-None-Match support, a stand-in
+      for the OTA server (APP_OTA_URL) on the host.
+
+Package format: see components/include/ota_stream.h
+"""
+
+import argparse
+import hashlib
+import http.server
+import os
+import struct
+import sys
+import zlib
+
+OTA_PKG_MAGIC = 0x41544F48
+OTA_PKG_VERSION = 1
+OTA_PKG_FLAG_ZLIB = 1 << 0
+OTA_PKG_FLAG_DELTA = 1 << 1
+
+OP_COPY = 0x01
+OP_INSERT = 0x02
+
+IMAGE_MAGIC = 0xE9              # ESP_IMAGE_HEADER_MAGIC
+IMAGE_HEADER_SIZE = 24          # sizeof(esp_image_header_t)
+IMAGE_HASH_APPENDED_OFS = 23    # esp_image_header_t.hash_appended
+
+BLOCK = 64          # match granularity
+MIN_COPY = 24       # shorter matches are cheaper as literals
+
+
+def image_sha256(image):
+    """The digest esp_partition_get_sha256() reports for an app partition holding `image`.
+
+    When the image has its SHA256 appended (the default), that digest is returned
+    instead of hashing the partition contents.
+    """
+    if len(image) >= IMAGE_HEADER_SIZE + 32 and image[0] == IMAGE_MAGIC and image[IMAGE_HASH_APPENDED_OFS] == 1:
+        return image[-32:]
+    return hashlib.sha256(image).digest()
+
+
+def make_delta(base, target):
+    index = {}
+    for off in range(0, len(base) - BLOCK + 1, BLOCK):
+        index.setdefault(base[off:off + BLOCK], off)
+
+    out = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        if literal:
+            out.extend(struct.pack('<BI', OP_INSERT, len(literal)))
+            out.extend(literal)
+            literal.clear()
+
+    pos = 0
+    while pos < len(target):
+        src = index.get(target[pos:pos + BLOCK])
+        if src is None:
+            literal.append(target[pos])
+            pos += 1
+            continue
+        # extend the match backwards into pending literals and forwards
+        back = 0
+        while back < len(literal) and src - back > 0 and base[src - back - 1] == literal[-back - 1]:
+            back += 1
+        length = BLOCK
+        while pos + length < len(target) and src + length < len(base) and \
+                target[pos + length] == base[src + length]:
+            length += 1
+        if length + back < MIN_COPY:
+            literal.append(target[pos])
+            pos += 1
+            continue
+        if back:
+            del literal[-back:]
+        flush_literal()
+        out.extend(struct.pack('<BII', OP_COPY, src - back, length + back))
+        pos += length
+    flush_literal()
+    return bytes(out)
+
+
+def pack(args):
+    with open(args.image, 'rb') as f:
+        image = f.read()
+
+    flags = 0
+    source_sha = bytes(32)
+    payload = image
+    if args.base:
+        with open(args.base, 'rb') as f:
+            base = f.read()
+        flags |= OTA_PKG_FLAG_DELTA
+        source_sha = image_sha256(base)
+        payload = make_delta(base, image)
+    if args.zlib:
+        flags |= OTA_PKG_FLAG_ZLIB
+        payload = zlib.compress(payload, 9)
+
+    header = struct.pack('<IBBHI32s', OTA_PKG_MAGIC, OTA_PKG_VERSION, flags, 0, len(image), source_sha)
+    with open(args.output, 'wb') as f:
+        f.write(header + payload)
+    print('%s: %d -> %d bytes (%.1f%%)' % (args.output, len(image), len(header) + len(payload),
+                                           100.0 * (len(header) + len(payload)) / len(image)))
+
+
+class EtagHandler(http.server.SimpleHTTPRequestHandler):
+
+    def send_head(self):
+        path = self.translate_path(self.path)
+        if os.path.isfile(path):
+            with open(path, 'rb') as f:
+                etag = '"%s"' % hashlib.sha256(f.read()).hexdigest()[:32]
+            if self.headers.get('If-None-Match') == etag:
+                self.send_response(304)
+                self.send_header('ETag', etag)
+                self.end_headers()
+                return None
+            self._etag = etag
+        return super().send_head()
+
+    def end_headers(self):
+        etag = getattr(self, '_etag', None)
+        if etag:
+            self.send_header('ETag', etag)
+            self._etag = None
+        super().end_headers()
+
+
+def serve(args):
+    os.chdir(args.dir)
+    server = http.server.ThreadingHTTPServer(('', args.port), EtagHandler)
+    print('serving %s on port %d' % (args.dir, args.port))
+    server.serve_forever()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest='cmd', required=True)
+
+    p = sub.add_parser('pack', help='build an OTA package')
+    p.add_argument('image', help='new firmware image')
+    p.add_argument('output', help='package file')
+    p.add_argument('--zlib', action='store_true', help='compress the payload')
+    p.add_argument('--base', help='firmware image running on the device, builds a delta')
+    p.set_defaults(func=pack)
+
+    p = sub.add_parser('serve', help='serve a directory with ETag support')
+    p.add_argument('dir')
+    p.add_argument('--port', type=int, default=8070)
+    p.set_defaults(func=serve)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())